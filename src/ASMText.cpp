@@ -113,16 +113,16 @@ ASMText::writeIns(ostream &out, const Element &e)
 
 
 void
-ASMText::emitFunctionStart(const string &functionId, const string &lineNo)
+ASMText::emitFunctionStart(const string &functionId, const string &lineNo, const string &profileKey)
 {
-    addElement(FUNCTION_START, functionId, lineNo);
+    addElement(FUNCTION_START, functionId, lineNo, profileKey);
 }
 
 
 void
-ASMText::emitFunctionEnd(const string &functionId, const string &lineNo)
+ASMText::emitFunctionEnd(const string &functionId, const string &lineNo, const string &profileKey)
 {
-    addElement(FUNCTION_END, functionId, lineNo);
+    addElement(FUNCTION_END, functionId, lineNo, profileKey);
 }
 
 
@@ -152,7 +152,11 @@ ASMText::emitLabel(const string &label, const string &comment)
 void
 ASMText::writeLabel(ostream &out, const Element &e)
 {
-    const string &label = e.fields[0], &comment = e.fields[1];
+    const string &label = e.fields[0], &comment = e.fields[1], &profilingLabel = e.fields[2];
+
+    // Exported so that the linker map gives its address. See layOutBlocks().
+    if (!profilingLabel.empty())
+        out << profilingLabel << "\tEXPORT\n" << profilingLabel << "\tEQU\t*\n";
 
     // Always EQU *, in case a comment follows, so the 1st word of the comment
     // is not taken for an opcode.
@@ -262,6 +266,7 @@ void
 ASMText::optimizeWholeFunctions()
 {
     string curFuncId;  // empty means not currently in a function, as per FUNCTION_START/FUNCTION_END
+    size_t funcStartIndex = 0;  // index of the current function's FUNCTION_START
     size_t blockStartIndex = size_t(-1);  // not inside a block initially
 
     basicBlocks.reserve(1024);
@@ -276,6 +281,7 @@ ASMText::optimizeWholeFunctions()
         case FUNCTION_START:
             curFuncId = e.fields[0];  // remember function's id
             assert(!curFuncId.empty());
+            funcStartIndex = i;
             labelTable.clear();
             basicBlocks.clear();
             break;
@@ -307,6 +313,7 @@ ASMText::optimizeWholeFunctions()
             break;
         case FUNCTION_END:
             processBasicBlocks(curFuncId);
+            layOutBlocks(funcStartIndex, i);
             blockStartIndex = size_t(-1);  // not inside a block anymore
             curFuncId.clear();  // remember that not inside function anymore
             break;
@@ -423,6 +430,350 @@ ASMText::processBasicBlocks(const string & /*functionId*/)
 }
 
 
+// Reorders the blocks of the function whose FUNCTION_START and FUNCTION_END
+// elements are at the given indices, so that the target of a BRA or LBRA follows
+// that branch, which is then removed. The fall-throughs are preserved: a block
+// is only moved with the blocks that fall through into each other, and only if
+// the block that precedes it does not fall through into it. The entry block stays first.
+// The blocks of a loop's header and latch, and a block that falls through into
+// a header, are never moved, nor are they skipped over, so that a loop does not
+// get a longer branch taken at each iteration.
+// The branches of the function are then shortened anew. The new layout is kept
+// only if it takes fewer bytes of branch instructions than the original,
+// and no more cycles, counting the branches of a loop as if they were
+// executed several times (see getLoopWeights()).
+// With an execution profile (see --profile-use) that gives the number of times
+// that each block was entered, those numbers weigh the branches instead, blocks
+// that were never entered are moved to the end of the function, and the new
+// layout is kept if it takes fewer cycles.
+// For the usim target, the first label of each block gets an exported alias
+// that makes the linker map give the block's address for such a profile.
+// Functions that contain inline assembly or data (e.g., a switch jump table)
+// are not modified.
+//
+void
+ASMText::layOutBlocks(size_t functionStartIndex, size_t functionEndIndex)
+{
+    vector<LayoutBlock> blocks;
+    map<string, size_t> blockOfLabel;  // key: label at start of block; value: index in blocks[]
+    set<string> localLabels;
+    blocks.push_back(LayoutBlock(functionStartIndex + 1));
+    for (size_t i = functionStartIndex + 1; i < functionEndIndex; ++i)
+    {
+        const Element &e = elements[i];
+        switch (e.type)
+        {
+        case LABEL:
+            if (i > functionStartIndex + 1 && elements[i - 1].type != LABEL)
+                blocks.push_back(LayoutBlock(i));
+            blockOfLabel[e.fields[0]] = blocks.size() - 1;
+            localLabels.insert(e.fields[0]);
+            break;
+        case INSTR:
+        {
+            if (isDataDirective(e.fields[0]) || e.fields[0] == "FCB")
+                return;
+            LayoutBlock &b = blocks.back();
+            const string &ins = e.fields[0];
+            b.jumpLabel.clear();
+            if (ins == "BRA" || ins == "LBRA" || isConditionalBranch(ins.c_str()))
+                b.branchLabels.push_back(e.fields[1]);
+            if (ins == "BRA" || ins == "LBRA")
+            {
+                b.fallsThrough = false;
+                b.jumpLabel = e.fields[1];
+            }
+            else
+                b.fallsThrough = !(ins == "RTS" || ins == "RTI" || ins == "JMP"
+                                   || (ins == "PULS" && endsWith(e.fields[1], "PC")));
+            break;
+        }
+        case COMMENT:
+        case SEPARATOR:
+            break;
+        default:
+            return;  // inline assembly, etc.
+        }
+        blocks.back().endIndex = i + 1;
+    }
+
+    // Name each block after the function, the source line of its first instruction
+    // and its rank among the blocks of that line, which unlike the label numbers
+    // is the same in the program that was profiled and in this compilation.
+    //
+    TranslationUnit &tu = TranslationUnit::instance();
+    const string &functionKey = elements[functionStartIndex].fields[2];
+    vector<int> blockLineNos(blocks.size(), -1);  // -1 until the block's first instruction is seen
+    int lineNo = 0;
+    for (size_t k = 0; k < blocks.size(); ++k)
+    {
+        for (size_t i = blocks[k].startIndex; i < blocks[k].endIndex; ++i)
+        {
+            const Element &e = elements[i];
+            size_t colonIndex;
+            if (e.type == COMMENT && startsWith(e.fields[0], "Line ") && (colonIndex = e.fields[0].find(':')) != string::npos)
+                lineNo = atoi(e.fields[0].c_str() + colonIndex + 1);
+            else if (e.type == INSTR && blockLineNos[k] == -1)
+                blockLineNos[k] = lineNo;
+        }
+        if (blockLineNos[k] == -1)
+            blockLineNos[k] = lineNo;
+    }
+    vector<string> blockKeys(blocks.size());
+    map<int, size_t> numBlocksOfLine;
+    for (size_t k = 1; k < blocks.size(); ++k)
+        blockKeys[k] = functionKey + "$" + wordToString(uint16_t(blockLineNos[k]))
+                       + "$" + wordToString(uint16_t(numBlocksOfLine[blockLineNos[k]]++));
+    blockKeys[0] = functionKey;
+    if (tu.areProfilingLabelsEmitted())
+        for (size_t k = 1; k < blocks.size(); ++k)
+        {
+            assert(elements[blocks[k].startIndex].type == LABEL);
+            elements[blocks[k].startIndex].fields[2] = "funcblock_" + blockKeys[k];
+        }
+
+    if (blocks.size() < 3 || blocks.back().fallsThrough)
+        return;
+
+    // With a profile that covers each block, a block that was never executed
+    // although its function was is cold.
+    //
+    vector<uint32_t> blockCounts(blocks.size(), 0);
+    bool isProfiled = tu.isExecutionProfileUsed();
+    for (size_t k = 0; k < blocks.size() && isProfiled; ++k)
+        isProfiled = tu.getBlockExecutionCount(blockKeys[k], blockCounts[k]);
+    vector<bool> isCold(blocks.size(), false);
+    if (isProfiled && blockCounts[0] > 0)
+        for (size_t k = 1; k < blocks.size(); ++k)
+            isCold[k] = blockCounts[k] == 0;
+
+    // A branch to a block that is not after the branch's block is a loop's back edge.
+    vector<bool> isLoopHeader(blocks.size(), false);
+    for (size_t k = 0; k < blocks.size(); ++k)
+        for (vector<string>::const_iterator it = blocks[k].branchLabels.begin(); it != blocks[k].branchLabels.end(); ++it)
+        {
+            map<string, size_t>::const_iterator jt = blockOfLabel.find(*it);
+            if (jt != blockOfLabel.end() && jt->second <= k)
+            {
+                isLoopHeader[jt->second] = true;
+                blocks[jt->second].isFixed = true;
+                blocks[k].isFixed = true;  // latch
+            }
+        }
+    for (size_t k = 0; k + 1 < blocks.size(); ++k)
+        if (blocks[k].fallsThrough && isLoopHeader[k + 1])
+            blocks[k].isFixed = true;
+
+    // A sequence of cold blocks that fall through into each other, and that
+    // neither is fallen into nor falls into another block, is placed after
+    // the other blocks, unless one of them must stay where it is.
+    //
+    vector<bool> isDeferred(blocks.size(), false);
+    for (size_t k = 1; k < blocks.size(); ++k)
+    {
+        if (blocks[k - 1].fallsThrough)
+            continue;
+        size_t last = k;
+        while (last < blocks.size() && isCold[last] && !blocks[last].isFixed && blocks[last].fallsThrough)
+            ++last;
+        if (last < blocks.size() && isCold[last] && !blocks[last].isFixed)
+            for (size_t j = k; j <= last; ++j)
+                isDeferred[j] = true;
+    }
+
+    // Place each block after the one that jumps to it, when that preserves the fall-throughs.
+    vector<size_t> order;
+    vector<bool> placed(blocks.size(), false);
+    size_t cur = 0;
+    for (;;)
+    {
+        order.push_back(cur);
+        placed[cur] = true;
+        if (order.size() == blocks.size())
+            break;
+
+        size_t next = size_t(-1);
+        if (blocks[cur].fallsThrough)
+            next = cur + 1;
+        else if (!blocks[cur].jumpLabel.empty())
+        {
+            map<string, size_t>::const_iterator it = blockOfLabel.find(blocks[cur].jumpLabel);
+            if (it != blockOfLabel.end() && !placed[it->second] && !blocks[it->second - 1].fallsThrough
+                    && !blocks[it->second].isFixed && !isDeferred[it->second])
+            {
+                // Only jump over blocks that can be moved.
+                size_t target = it->second;
+                next = target;
+                for (size_t k = min(cur, target) + 1; k < max(cur, target); ++k)
+                    if (!placed[k] && blocks[k].isFixed)
+                        next = size_t(-1);
+            }
+        }
+        if (next == size_t(-1))
+        {
+            next = size_t(find(placed.begin(), placed.end(), false) - placed.begin());
+            for (size_t k = next; k < blocks.size(); ++k)
+                if (!placed[k] && !isDeferred[k])
+                {
+                    next = k;
+                    break;
+                }
+        }
+        assert(next < blocks.size() && !placed[next]);
+        cur = next;
+    }
+
+    bool reordered = false;
+    for (size_t k = 0; k < order.size(); ++k)
+        if (order[k] != k)
+            reordered = true;
+    if (!reordered)
+        return;
+
+    vector<size_t> weights;  // indexed like 'original'
+    if (isProfiled)
+        for (size_t k = 0; k < blocks.size(); ++k)
+            weights.insert(weights.end(), blocks[k].endIndex - blocks[k].startIndex, blockCounts[k]);
+    else
+        getLoopWeights(functionStartIndex + 1, functionEndIndex, weights);
+    size_t originalBranchBytes = getBranchBytes(functionStartIndex + 1, functionEndIndex);
+    size_t originalBranchCycles = getBranchCycles(functionStartIndex + 1, functionEndIndex, weights);
+    vector<Element> original(elements.begin() + functionStartIndex + 1, elements.begin() + functionEndIndex);
+
+    vector<Element> reorderedElements;
+    vector<size_t> reorderedWeights;
+    reorderedElements.reserve(original.size());
+    reorderedWeights.reserve(original.size());
+    for (size_t k = 0; k < order.size(); ++k)
+    {
+        const LayoutBlock &b = blocks[order[k]];
+        reorderedElements.insert(reorderedElements.end(),
+                                 elements.begin() + b.startIndex, elements.begin() + b.endIndex);
+        reorderedWeights.insert(reorderedWeights.end(),
+                                weights.begin() + (b.startIndex - functionStartIndex - 1),
+                                weights.begin() + (b.endIndex - functionStartIndex - 1));
+        if (k + 1 < order.size() && !b.jumpLabel.empty()
+                && blockOfLabel.count(b.jumpLabel) && blockOfLabel[b.jumpLabel] == order[k + 1])
+        {
+            // Comment out the branch, which is the block's last instruction.
+            for (size_t j = reorderedElements.size(); j-- > 0; )
+                if (reorderedElements[j].type == INSTR)
+                {
+                    Element &branch = reorderedElements[j];
+                    branch.type = COMMENT;
+                    branch.fields[0] = "optim: layOutBlocks";
+                    break;
+                }
+        }
+    }
+    assert(reorderedElements.size() == original.size());
+    copy(reorderedElements.begin(), reorderedElements.end(), elements.begin() + functionStartIndex + 1);
+
+    // Lengthen all local branches, then shorten those that can be.
+    for (size_t i = functionStartIndex + 1; i < functionEndIndex; ++i)
+    {
+        Element &e = elements[i];
+        if (e.type == INSTR && localLabels.count(e.fields[1])
+                && (e.fields[0] == "BRA" || (e.fields[0][0] == 'B' && isConditionalBranch(e.fields[0].c_str()))))
+            e.fields[0].insert(0, "L");
+    }
+    for (size_t i = functionStartIndex + 1; i < functionEndIndex; ++i)
+        if (elements[i].type == INSTR && localLabels.count(elements[i].fields[1]))
+            shortenBranch(i);
+
+    size_t branchBytes = getBranchBytes(functionStartIndex + 1, functionEndIndex);
+    size_t branchCycles = getBranchCycles(functionStartIndex + 1, functionEndIndex, reorderedWeights);
+    bool isBetter;
+    if (isProfiled)
+        isBetter = branchCycles < originalBranchCycles || (branchCycles == originalBranchCycles && branchBytes < originalBranchBytes);
+    else
+        isBetter = branchBytes < originalBranchBytes && branchCycles <= originalBranchCycles;
+    if (!isBetter)
+        copy(original.begin(), original.end(), elements.begin() + functionStartIndex + 1);  // restore
+}
+
+
+// Returns the number of bytes taken by the branch instructions
+// in elements[startIndex..endIndex).
+//
+size_t
+ASMText::getBranchBytes(size_t startIndex, size_t endIndex) const
+{
+    size_t numBytes = 0;
+    for (size_t i = startIndex; i < endIndex; ++i)
+    {
+        const Element &e = elements[i];
+        if (e.type != INSTR)
+            continue;
+        const string &ins = e.fields[0];
+        if (ins == "BRA" || (ins[0] == 'B' && isConditionalBranch(ins.c_str())))
+            numBytes += 2;
+        else if (ins == "LBRA")
+            numBytes += 3;
+        else if (ins[0] == 'L' && isConditionalBranch(ins.c_str()))
+            numBytes += 4;
+    }
+    return numBytes;
+}
+
+
+// Gives weights[i - startIndex] the number of times that elements[i] is assumed
+// to be executed: 8 for each loop around it, up to 3 loops. A loop extends
+// from the target of a backward branch to that branch.
+//
+void
+ASMText::getLoopWeights(size_t startIndex, size_t endIndex, vector<size_t> &weights) const
+{
+    map<string, size_t> labelIndex;
+    for (size_t i = startIndex; i < endIndex; ++i)
+        if (elements[i].type == LABEL)
+            labelIndex[elements[i].fields[0]] = i;
+
+    vector<size_t> loopDepth(endIndex - startIndex, 0);
+    for (size_t i = startIndex; i < endIndex; ++i)
+    {
+        const Element &e = elements[i];
+        if (e.type != INSTR || getBranchBytes(i, i + 1) == 0)
+            continue;
+        map<string, size_t>::const_iterator it = labelIndex.find(e.fields[1]);
+        if (it != labelIndex.end() && it->second < i)
+            for (size_t j = it->second; j <= i; ++j)
+                ++loopDepth[j - startIndex];
+    }
+
+    weights.resize(loopDepth.size());
+    for (size_t k = 0; k < loopDepth.size(); ++k)
+        weights[k] = size_t(1) << (3 * min(loopDepth[k], size_t(3)));
+}
+
+
+// Returns the number of cycles taken by the branch instructions
+// in elements[startIndex..endIndex), each one multiplied by its weight
+// (see getLoopWeights()). A conditional branch counts as taken.
+//
+size_t
+ASMText::getBranchCycles(size_t startIndex, size_t endIndex, const vector<size_t> &weights) const
+{
+    size_t numCycles = 0;
+    for (size_t i = startIndex; i < endIndex; ++i)
+    {
+        const Element &e = elements[i];
+        if (e.type != INSTR)
+            continue;
+        const string &ins = e.fields[0];
+        size_t cycles = 0;
+        if (ins == "BRA" || (ins[0] == 'B' && isConditionalBranch(ins.c_str())))
+            cycles = 3;
+        else if (ins == "LBRA")
+            cycles = 5;
+        else if (ins[0] == 'L' && isConditionalBranch(ins.c_str()))
+            cycles = 6;
+        numCycles += cycles * weights[i - startIndex];
+    }
+    return numCycles;
+}
+
+
 size_t
 ASMText::findBlockIndex(size_t elementIndex) const
 {
@@ -503,6 +854,8 @@ ASMText::peepholeOptimize(bool useStage2Optims)
                 modified = true;
             else if (condBranchOverUncondBranch(i))
                 modified = true;
+            else if (threadBranch(i))
+                modified = true;
             else if (shortenBranch(i))
                 modified = true;
             else if (loadCmpZeroBeqOrBne(i))
@@ -647,6 +1000,16 @@ ASMText::peepholeOptimize(bool useStage2Optims)
         if (!modified)
             break;
     }
+
+    // Now that the code of each function is final, except for the removals done
+    // below, determine which registers each function modifies. The removals cannot
+    // make those summaries wrong, because they only make a function modify less.
+    //
+    computeFunctionRegisterUsage();
+
+    if (useStage2Optims)
+        for (size_t i = 0; i < elements.size(); ++i)
+            removeReloadAcrossCall(i);
 }
 
 
@@ -924,6 +1287,14 @@ ASMText::storeLoad(size_t &index)
     if (nextInstrIndex == size_t(-1))
         return false;
     Element &nextInstr = elements[nextInstrIndex];
+    if (isLowByteReloadAfterStoreD(e, nextInstr) && overwritesNZ(findNextInstrBeforeLabel(nextInstrIndex + 1)))
+    {
+        // STD n,U followed by LDB n+1,U: B already contains the loaded byte.
+        // N and Z do not reflect B anymore, so they must be overwritten by the next instruction.
+        commentOut(nextInstrIndex, "optim: storeLoad");
+        index = nextInstrIndex;
+        return true;
+    }
     if (! (nextInstr.fields[0].find("LD") == 0 && nextInstr.fields[0][2] == e.fields[0][2]))  // require LD of same register
         return false;
     if (nextInstr.fields[1] != e.fields[1])  // if not same argument
@@ -936,6 +1307,48 @@ ASMText::storeLoad(size_t &index)
 }
 
 
+// Indicates if the instruction at 'index' sets the N and Z flags
+// without reading them. Conservative: returns false when unsure.
+//
+bool
+ASMText::overwritesNZ(size_t index) const
+{
+    if (index == size_t(-1) || elements[index].type != INSTR)
+        return false;
+    const string &ins = elements[index].fields[0];
+    if (endsWith(ins, "CC"))  // ANDCC, ORCC
+        return false;
+    static const char *prefixes[] =
+    {
+        "AND", "OR", "EOR", "ADD", "SUB", "LD", "ST", "CLR", "COM", "NEG",
+        "INC", "DEC", "TST", "CMP", "LSL", "LSR", "ASL", "ASR", "SEX"
+    };
+    for (size_t i = 0; i < sizeof(prefixes) / sizeof(prefixes[0]); ++i)
+        if (startsWith(ins, prefixes[i]))
+            return true;
+    return false;
+}
+
+
+// Indicates if 'store' is STD n,R and 'load' is LDB n+1,R, where R is U or S.
+//
+bool
+ASMText::isLowByteReloadAfterStoreD(const Element &store, const Element &load)
+{
+    if (store.fields[0] != "STD" || load.fields[0] != "LDB")
+        return false;
+    const string &storeArg = store.fields[1], &loadArg = load.fields[1];
+    if (!endsWith(storeArg, ",U") && !endsWith(storeArg, ",S"))
+        return false;
+    if (!endsWith(loadArg, storeArg.substr(storeArg.length() - 2).c_str()))
+        return false;
+    int storeOffset = 0, loadOffset = 0;
+    if (!parseRelativeOffset(storeArg, storeOffset) || !parseRelativeOffset(loadArg, loadOffset))
+        return false;
+    return loadOffset == storeOffset + 1;
+}
+
+
 // Check for this pattern:
 //      LBxx foo
 //      LBRA bar
@@ -971,6 +1384,78 @@ ASMText::condBranchOverUncondBranch(size_t &index)
 }
 
 
+// If the branch at 'index' leads to a BRA or LBRA, or to a conditional branch
+// whose outcome is implied by the condition of the first branch, makes the
+// first branch go directly to the final destination, e.g.:
+//   BEQ     L1                  becomes LBEQ L2
+//   ...
+// L1 BEQ    L2                  (same condition, so taken)
+// or, when the second branch tests the opposite condition and is followed by label L3:
+// L1 BNE    L2                  (not taken, so BEQ L1 becomes LBEQ L3)
+// L3 ...
+// The branch is made long because the new target may be farther away;
+// shortenBranch() shortens it again if possible.
+//
+bool
+ASMText::threadBranch(size_t index)
+{
+    Element &e = elements[index];
+    if (e.type != INSTR)
+        return false;
+    const bool isLong = (e.fields[0][0] == 'L');
+    const string ins(e.fields[0], isLong ? 1 : 0);
+    const bool isUncond = (ins == "BRA");
+    char inverse[INSTR_NAME_BUFSIZ];
+    if (!isUncond && !isConditionalBranch(index, inverse))
+        return false;
+    const string inverseIns(inverse + (isLong ? 1 : 0));
+
+    string target = e.fields[1];
+    for (size_t numHops = 0; numHops < 8; ++numHops)
+    {
+        size_t labelIndex = findLabelIndex(target);
+        if (labelIndex == size_t(-1))
+            break;
+        size_t j = labelIndex + 1;
+        while (j < elements.size() && (elements[j].type == LABEL || elements[j].isCommentLike()))
+            ++j;
+        if (j >= elements.size() || elements[j].type != INSTR)
+            break;
+        const Element &t = elements[j];
+        const string tIns(t.fields[0], t.fields[0][0] == 'L' ? 1 : 0);
+        string newTarget;
+        if (tIns == "BRA")
+            newTarget = t.fields[1];
+        else if (!isUncond && tIns == ins)
+            newTarget = t.fields[1];
+        else if (!isUncond && tIns == inverseIns)
+        {
+            // Not taken: continue at the label that follows the second branch, if any.
+            size_t k = j + 1;
+            while (k < elements.size() && elements[k].isCommentLike())
+                ++k;
+            if (k >= elements.size() || elements[k].type != LABEL)
+                break;
+            newTarget = elements[k].fields[0];
+        }
+        else
+            break;
+        if (newTarget == target || newTarget == e.fields[1])
+            break;  // loop
+        target = newTarget;
+    }
+
+    if (target == e.fields[1])
+        return false;
+
+    if (!isLong)
+        e.fields[0].insert(0, "L");
+    e.fields[1] = target;
+    e.fields[2] = "optim: threadBranch";
+    return true;
+}
+
+
 // If 'index' is a long branch, try to convert it to a short branch.
 // This is done when the target label is no farther than 28 instructions
 // from the branch. Assuming at most 4 bytes per instruction, this means
@@ -3547,7 +4032,8 @@ ASMText::transformPshsDPshsD(size_t index) {
     }
     if (e3.type != INSTR || e3.fields[0] != "LDD" ||
         e3.fields[1].find("D,") != string::npos ||
-        e3.fields[1].find("B,") != string::npos) {
+        e3.fields[1].find("B,") != string::npos ||
+        (InsEffects(e3).read & X)) {  // 2nd LDD must not use the X that the 1st LDX overwrites
       return false;
     }
     if (e4.type != INSTR || e4.fields[0] != "PSHS" || e4.fields[1] != "B,A") {
@@ -4475,87 +4961,1382 @@ ASMText::removeLoadInComparisonWithTwoValues(size_t index)
 }
 
 
+// Removes a reload of X, Y or D with a constant, or of X or Y with a PCR-relative
+// or U-relative address, when the register still holds that value, including
+// across calls to subroutines known not to modify that register, e.g.:
+//   LEAX    -12,U
+//   LBSR    initDWordFromSignedWord
+//   LEAX    -12,U                       removed
+// Uses the summaries computed by computeFunctionRegisterUsage().
+//
 bool
-ASMText::isInstr(size_t index, const char *ins, const char *arg) const
+ASMText::removeReloadAcrossCall(size_t index)
 {
     const Element &e = elements[index];
-    return e.type == INSTR && e.fields[0] == ins && e.fields[1] == arg;
+    if (e.type != INSTR)
+        return false;
+    const string &ins = e.fields[0];
+    const string &arg = e.fields[1];
+    if (arg.empty())
+        return false;
+
+    uint8_t reg = 0;
+    if (ins == "LEAX" || ins == "LDX")
+        reg = X;
+    else if (ins == "LEAY" || ins == "LDY")
+        reg = Y;
+    else if (ins == "LDD")
+        reg = A | B;
+    else
+        return false;
+
+    const bool isUArg = (endsWith(arg, ",U") && arg[0] != '[');
+    if (ins[1] == 'E')  // LEAX or LEAY
+    {
+        if (!isUArg && !(endsWith(arg, ",PCR") && arg[0] != '['))
+            return false;
+    }
+    else if (arg[0] != '#')
+        return false;
+
+    size_t numChanges = 0;
+    for (++index; index < elements.size(); ++index)
+    {
+        const Element &e1 = elements[index];
+        if (e1.isCommentLike())
+            continue;
+        if (e1.type != INSTR || isBasicBlockEndingInstruction(e1))
+            break;
+        if (e1.fields[0] == ins && e1.fields[1] == arg)
+        {
+            // Keep the reload if the next instruction uses the flags that it sets.
+            size_t nextIndex = findNextInstrBeforeLabel(index + 1);
+            if (nextIndex == size_t(-1) || (InsEffects(elements[nextIndex]).read & CC))
+                break;
+            commentOut(index, "optim: removeReloadAcrossCall");
+            ++numChanges;
+            continue;
+        }
+
+        const InsEffects effects(e1, this);
+        if ((effects.written & reg) || (isUArg && (effects.written & U)))
+            break;
+    }
+
+    return numChanges > 0;
 }
 
 
-bool
-ASMText::isInstrAnyArg(size_t index, const char *ins) const
+// Kinds of memory operands tracked by NonNullState.
+//
+enum NonNullOperandBase { U_BASED_OPERAND, X_BASED_OPERAND, PCR_BASED_OPERAND, OTHER_OPERAND };
+
+
+// Recognizes n,U and n,X (where n is a decimal offset, possibly empty or negative)
+// and label,PCR or label+n,PCR. In the last case, 'symbol' receives the label.
+//
+static NonNullOperandBase
+parseNonNullOperand(const string &arg, int &offset, string &symbol)
 {
-    const Element &e = elements[index];
-    return e.type == INSTR && e.fields[0] == ins;
+    offset = 0;
+    symbol.clear();
+    size_t comma = arg.rfind(',');
+    if (arg.empty() || arg[0] == '[' || arg[0] == '#' || comma == string::npos)
+        return OTHER_OPERAND;
+    string base(arg, comma + 1);
+    string disp(arg, 0, comma);
+    if (base == "PCR")
+    {
+        if (disp.empty())
+            return OTHER_OPERAND;
+        symbol.assign(disp, 0, disp.find('+'));
+        return PCR_BASED_OPERAND;
+    }
+    if (base != "U" && base != "X")
+        return OTHER_OPERAND;
+    size_t firstDigit = (!disp.empty() && disp[0] == '-' ? 1 : 0);
+    if (disp.find_first_not_of("0123456789", firstDigit) != string::npos || (firstDigit == 1 && disp.length() == 1))
+        return OTHER_OPERAND;
+    offset = (disp.empty() ? 0 : atoi(disp.c_str()));
+    return base == "U" ? U_BASED_OPERAND : X_BASED_OPERAND;
 }
 
 
-bool
-ASMText::isInstrWithImmedArg(size_t index, const char *ins) const
+static bool
+isNonNullOperand(const string &arg)
 {
-    const Element &e = elements[index];
-    return e.type == INSTR && e.fields[0] == ins && e.fields[1][0] == '#';
+    int offset;
+    string symbol;
+    return parseNonNullOperand(arg, offset, symbol) != OTHER_OPERAND;
 }
 
 
-bool
-ASMText::isInstrWithVarArg(size_t index, const char *ins) const
+// Determines if storing 'storeSize' bytes at 'storeArg' can modify the word at 'operand'.
+//
+static bool
+mayAlias(const string &storeArg, int16_t storeSize, const string &operand)
 {
-    const Element &e = elements[index];
-    return e.type == INSTR
-        && e.fields[0] == ins
-        && (endsWith(e.fields[1], ",U") || endsWith(e.fields[1], ",PCR"));
+    int storeOffset, offset;
+    string storeSymbol, symbol;
+    NonNullOperandBase storeBase = parseNonNullOperand(storeArg, storeOffset, storeSymbol);
+    NonNullOperandBase base = parseNonNullOperand(operand, offset, symbol);
+    if (storeBase == OTHER_OPERAND || base == OTHER_OPERAND)
+        return true;
+    if (storeBase == PCR_BASED_OPERAND && base == PCR_BASED_OPERAND)
+        return storeSymbol == symbol;
+    if (storeBase != base)  // a local cannot be a global, but X can point to either
+        return storeBase == X_BASED_OPERAND || base == X_BASED_OPERAND;
+    return storeOffset < offset + 2 && offset < storeOffset + storeSize;  // same base register: do intervals overlap?
 }
 
 
-const char *
-ASMText::getInstr(size_t index) const
+static bool
+isZeroImmediate(const string &arg)
 {
-    const Element &e = elements[index];
-    if (e.type != INSTR)
-        return "";
-    return e.fields[0].c_str();
+    return arg == "#0" || arg == "#$00" || arg == "#$0000";
 }
 
 
-const char *
-ASMText::getInstrArg(size_t index) const
+bool
+ASMText::NonNullState::operator == (const NonNullState &s) const
 {
-    const Element &e = elements[index];
-    if (e.type != INSTR)
-        return "";
-    return e.fields[1].c_str();
+    return reached == s.reached && operands == s.operands && xNonNull == s.xNonNull
+           && xSource == s.xSource && dSource == s.dSource && zSource == s.zSource;
 }
 
 
-// None of the instruction names must exceed 6 characters in length.
-// See isConditionalBranch().
+// Keeps only what is known both in this state and in 's'.
 //
-const static struct
-{
-    const char *branchInstr;
-    const char *inverseInstr;
-} branchInstrTable[] =
+void
+ASMText::NonNullState::meet(const NonNullState &s)
 {
-    { "BCC", "BCS" },
-    { "BEQ", "BNE" },
-    { "BGE", "BLT" },
-    { "BGT", "BLE" },
-    { "BHI", "BLS" },
-    { "BHS", "BLO" },
-    { "BMI", "BPL" },
-    { "BVC", "BVS" },
-};
+    if (!s.reached)
+        return;
+    if (!reached)
+    {
+        *this = s;
+        return;
+    }
+    set<string> common;
+    set_intersection(operands.begin(), operands.end(), s.operands.begin(), s.operands.end(),
+                     inserter(common, common.begin()));
+    operands.swap(common);
+    xNonNull = xNonNull && s.xNonNull;
+    if (xSource != s.xSource)
+        xSource.clear();
+    if (dSource != s.dSource)
+        dSource.clear();
+    if (zSource != s.zSource)
+        zSource.clear();
+}
 
 
-// None of the instruction names must exceed 6 characters in length.
-// See isRelativeSizeConditionalBranch().
+// To be called when X receives a new value: operands relative to X no longer apply.
 //
-const static struct
+void
+ASMText::NonNullState::forgetX()
 {
-    const char *branchInstr;
-    const char *invertedOperandsInstr;
+    int offset;
+    string symbol;
+    for (set<string>::iterator it = operands.begin(); it != operands.end(); )
+        if (parseNonNullOperand(*it, offset, symbol) == X_BASED_OPERAND)
+            operands.erase(it++);
+        else
+            ++it;
+    xNonNull = false;
+    xSource.clear();
+    if (parseNonNullOperand(dSource, offset, symbol) == X_BASED_OPERAND)
+        dSource.clear();
+    if (parseNonNullOperand(zSource, offset, symbol) == X_BASED_OPERAND)
+        zSource.clear();
+}
+
+
+void
+ASMText::NonNullState::forgetAll()
+{
+    operands.clear();
+    xNonNull = false;
+    xSource.clear();
+    dSource.clear();
+    zSource.clear();
+}
+
+
+void
+ASMText::NonNullState::addOperand(const string &operand)
+{
+    if (isNonNullOperand(operand))
+        operands.insert(operand);
+}
+
+
+// To be called when 'storeSize' bytes are written at 'storeArg'.
+//
+void
+ASMText::NonNullState::killAliases(const string &storeArg, int16_t storeSize)
+{
+    for (set<string>::iterator it = operands.begin(); it != operands.end(); )
+        if (mayAlias(storeArg, storeSize, *it))
+            operands.erase(it++);
+        else
+            ++it;
+    if (!xSource.empty() && mayAlias(storeArg, storeSize, xSource))
+        xSource.clear();
+    if (!dSource.empty() && mayAlias(storeArg, storeSize, dSource))
+        dSource.clear();
+    if (!zSource.empty() && mayAlias(storeArg, storeSize, zSource))
+        zSource.clear();
+}
+
+
+// Applies the effect of instruction 'e' on 'state'.
+// Branches and instructions that end a path are handled by the caller.
+//
+void
+ASMText::updateNonNullState(const Element &e, NonNullState &state) const
+{
+    const string &ins = e.fields[0];
+    const string &arg = e.fields[1];
+
+    if (ins == "LBSR" || ins == "BSR" || ins == "JSR")
+    {
+        if (arg == "check_null_ptr_x")
+        {
+            // After the check, X is known to be non-null, and so is the operand it was loaded from.
+            state.xNonNull = true;
+            state.addOperand(state.xSource);
+            state.zSource.clear();
+        }
+        else
+            state.forgetAll();  // the subroutine may modify any register and any memory
+        return;
+    }
+
+    // Instructions that write to memory.
+    //
+    static const char *const byteStores[] = { "ASL", "ASR", "CLR", "COM", "DEC", "INC", "LSL", "LSR", "NEG", "ROL", "ROR", "STA", "STB" };
+    static const char *const wordStores[] = { "STD", "STS", "STU", "STX", "STY" };
+    int16_t storeSize = 0;
+    if (!arg.empty())
+    {
+        for (size_t i = 0; i < sizeof(byteStores) / sizeof(byteStores[0]); ++i)
+            if (ins == byteStores[i])
+                storeSize = 1;
+        for (size_t i = 0; i < sizeof(wordStores) / sizeof(wordStores[0]); ++i)
+            if (ins == wordStores[i])
+                storeSize = 2;
+    }
+    if (storeSize > 0)
+    {
+        bool storesNonNull = (ins == "STX" && state.xNonNull)
+                             || (ins == "STD" && !state.dSource.empty() && state.operands.count(state.dSource) > 0);
+        state.killAliases(arg, storeSize);
+        if (storesNonNull)
+            state.addOperand(arg);
+        state.zSource.clear();
+        if (InsEffects(e).written & X)  // e.g., STD ,X++
+            state.forgetX();
+        return;
+    }
+
+    int offset;
+    string symbol;
+    NonNullOperandBase base = parseNonNullOperand(arg, offset, symbol);
+
+    if (ins == "LDX")
+    {
+        bool nonNull = state.operands.count(arg) > 0
+                       || (arg[0] == '#' && !isZeroImmediate(arg) && arg.find_first_of("0123456789$") == 1);
+        if (state.xSource.empty() || arg != state.xSource)  // if X changes value
+            state.forgetX();
+        state.xNonNull = nonNull;
+        state.xSource = (base == U_BASED_OPERAND || base == PCR_BASED_OPERAND ? arg : "");
+        state.zSource = state.xSource;
+        return;
+    }
+    if (ins == "LEAX")
+    {
+        state.forgetX();
+        state.xNonNull = (base == U_BASED_OPERAND || base == PCR_BASED_OPERAND);  // address of a local or global
+        state.zSource.clear();
+        return;
+    }
+    if (ins == "TFR" && arg == "D,X")
+    {
+        bool nonNull = !state.dSource.empty() && state.operands.count(state.dSource) > 0;
+        string source = state.dSource;
+        state.forgetX();
+        state.xNonNull = nonNull;
+        if (parseNonNullOperand(source, offset, symbol) != X_BASED_OPERAND)
+            state.xSource = source;
+        return;
+    }
+    if (ins == "TFR" && arg == "X,D")
+    {
+        state.dSource = state.xSource;
+        return;
+    }
+    if (ins == "LDD")
+    {
+        state.dSource = (base != OTHER_OPERAND ? arg : "");
+        state.zSource = state.dSource;
+        if (InsEffects(e).written & X)  // e.g., LDD ,X++
+            state.forgetX();
+        return;
+    }
+    if ((ins == "ADDD" || ins == "SUBD" || ins == "CMPD") && isZeroImmediate(arg))
+    {
+        state.zSource = state.dSource;  // D unchanged, Z set according to D
+        return;
+    }
+    if (ins == "CMPX" && isZeroImmediate(arg))
+    {
+        state.zSource = state.xSource;
+        return;
+    }
+
+    InsEffects effects(e);
+    if (effects.written & X)
+        state.forgetX();
+    if (effects.written & (A | B))
+        state.dSource.clear();
+    if (effects.written & U)
+        state.forgetAll();
+    if (effects.written & CC)
+        state.zSource.clear();
+}
+
+
+// Removes the calls to check_null_ptr_x (emitted by --check-null) where X is
+// known to be non-null: after an earlier check of the same value, after loading
+// the address of a variable or array, or after a test like if (p), while (p)
+// or if (p->next) that branches when the pointer is null.
+// This is a forward data flow analysis over the whole function: a fact holds
+// at a label only if it holds on every path that leads to that label.
+// A memory operand stays known to be non-null until it is written to,
+// or until a store through a pointer or a call to a subroutine.
+//
+void
+ASMText::removeRedundantNullPointerChecks()
+{
+    size_t funcStartIndex = size_t(-1);
+    for (size_t i = 0; i < elements.size(); ++i)
+    {
+        if (elements[i].type == FUNCTION_START)
+            funcStartIndex = i;
+        else if (elements[i].type == FUNCTION_END && funcStartIndex != size_t(-1))
+        {
+            removeRedundantNullPointerChecks(funcStartIndex, i);
+            funcStartIndex = size_t(-1);
+        }
+    }
+}
+
+
+void
+ASMText::removeRedundantNullPointerChecks(size_t functionStartIndex, size_t functionEndIndex)
+{
+    // Find the labels of the function. Those that are used by something else
+    // than a branch instruction (e.g., FDB L00007-L00015 in a switch jump table)
+    // can be reached from anywhere.
+    //
+    set<string> localLabels, labelsReachedFromAnywhere;
+    bool hasNullCheck = false;
+    for (size_t i = functionStartIndex + 1; i < functionEndIndex; ++i)
+    {
+        const Element &e = elements[i];
+        if (e.type == INLINE_ASM)
+            return;
+        if (e.type == LABEL)
+            localLabels.insert(e.fields[0]);
+        else if (e.type == INSTR && e.fields[1] == "check_null_ptr_x")
+            hasNullCheck = true;
+    }
+    if (!hasNullCheck)
+        return;
+    for (size_t i = functionStartIndex + 1; i < functionEndIndex; ++i)
+    {
+        const Element &e = elements[i];
+        if (e.type != INSTR)
+            continue;
+        const string &ins = e.fields[0];
+        if (ins == "BRA" || ins == "LBRA" || isConditionalBranch(ins.c_str()))
+            continue;
+        string arg = e.fields[1];
+        replace(arg.begin(), arg.end(), '+', ',');
+        replace(arg.begin(), arg.end(), '-', ',');
+        istringstream tokens(arg);
+        string token;
+        while (getline(tokens, token, ','))
+            if (localLabels.count(token) > 0)
+                labelsReachedFromAnywhere.insert(token);
+    }
+
+    // Iterate until the states at the labels stop changing, then make a last pass
+    // that removes the checks.
+    //
+    map<string, NonNullState> labelStates;  // key: label; value: meet of the states of the branches to that label
+    bool converged = false;
+    for (size_t iteration = 0; iteration < 32; ++iteration)
+    {
+        map<string, NonNullState> newLabelStates;
+        NonNullState state;
+        state.reached = true;  // entry point of the function
+
+        for (size_t i = functionStartIndex + 1; i < functionEndIndex; ++i)
+        {
+            const Element &e = elements[i];
+            if (e.type == LABEL)
+            {
+                const string &label = e.fields[0];
+                if (labelsReachedFromAnywhere.count(label) > 0)
+                {
+                    state = NonNullState();
+                    state.reached = true;
+                }
+                else
+                {
+                    map<string, NonNullState>::const_iterator it = labelStates.find(label);
+                    if (it != labelStates.end())
+                        state.meet(it->second);
+                }
+                continue;
+            }
+            if (e.type != INSTR || !state.reached)
+                continue;
+
+            const string &ins = e.fields[0];
+            const string &arg = e.fields[1];
+
+            if (converged && arg == "check_null_ptr_x" && state.xNonNull)
+            {
+                // Keep the check if the next instruction uses the flags that it sets.
+                size_t nextIndex = findNextInstrBeforeLabel(i + 1);
+                if (nextIndex == size_t(-1) || !(InsEffects(elements[nextIndex]).read & CC))
+                {
+                    commentOut(i, "optim: removeRedundantNullPointerChecks");
+                    continue;
+                }
+            }
+
+            if (ins == "BRA" || ins == "LBRA")
+            {
+                newLabelStates[arg].meet(state);
+                state.reached = false;
+            }
+            else if (isConditionalBranch(ins.c_str()))
+            {
+                // If the branch depends on a pointer being null or not,
+                // that pointer is known to be non-null on one side.
+                NonNullState taken = state;
+                if (ins == "BNE" || ins == "LBNE")
+                    taken.addOperand(state.zSource);
+                else if (ins == "BEQ" || ins == "LBEQ")
+                    state.addOperand(state.zSource);
+                newLabelStates[arg].meet(taken);
+            }
+            else if (ins == "RTS" || ins == "RTI" || ins == "JMP" || (ins == "PULS" && endsWith(arg, "PC"))
+                     || isDataDirective(ins) || ins == "FCB")
+                state.reached = false;
+            else
+                updateNonNullState(e, state);
+        }
+
+        if (converged)
+            break;  // checks have been removed
+        converged = (newLabelStates == labelStates);
+        labelStates.swap(newLabelStates);
+    }
+}
+
+
+// Returns the number of bytes pushed or pulled by a PSHS or PULS with the given register list.
+//
+static int
+getNumStackedBytes(const string &regList)
+{
+    int sum = 0;
+    istringstream tokens(regList);
+    string reg;
+    while (getline(tokens, reg, ','))
+    {
+        if (reg == "A" || reg == "B" || reg == "CC" || reg == "DP")
+            sum += 1;
+        else
+            sum += 2;  // D, X, Y, U, S, PC
+    }
+    return sum;
+}
+
+
+// Returns the change in the depth of the stack caused by an auto-increment
+// or auto-decrement on S in the given operand (e.g., ,S++ gives -2).
+//
+static int
+getAutoIncDecOnS(const string &arg)
+{
+    if (endsWith(arg, ",S++"))
+        return -2;
+    if (endsWith(arg, ",S+"))
+        return -1;
+    if (endsWith(arg, ",--S"))
+        return 2;
+    if (endsWith(arg, ",-S"))
+        return 1;
+    return 0;
+}
+
+
+// Follows the depth of the stack through the function, assuming that every path
+// reaches a given label with the same depth, which is what the code generator produces.
+// usage.known is set to false if that assumption does not hold or if S is changed
+// in a way that is not understood.
+// Inline assembly is assumed to leave S unchanged, but sets usage.hasInlineAsm.
+//
+void
+ASMText::computeFunctionStackUsage(size_t functionStartIndex, size_t functionEndIndex, FunctionStackUsage &usage) const
+{
+    // Iterate until the depths at the labels stop changing, because the first label
+    // of a loop may only be reached by a backward branch.
+    //
+    map<string, int> labelDepths;  // depth at the branches to each label, as of the previous iteration
+    for (size_t iteration = 0; iteration < 8; ++iteration)
+    {
+        usage = FunctionStackUsage();
+        map<string, int> newLabelDepths;
+        int depth = 0, frameDepth = -1;  // frameDepth: depth when U was made to point to the stack frame
+        bool reached = true;
+
+        for (size_t i = functionStartIndex + 1; i < functionEndIndex && usage.known; ++i)
+        {
+            const Element &e = elements[i];
+            if (e.type == INLINE_ASM)
+            {
+                usage.hasInlineAsm = true;  // assumed to leave S unchanged
+                continue;
+            }
+            if (e.type == LABEL)
+            {
+                // If no branch to this label is known yet, keep the last depth,
+                // which is right for a loop label or for a jump table entry.
+                map<string, int>::const_iterator it = labelDepths.find(e.fields[0]);
+                if (it != labelDepths.end())
+                {
+                    if (reached && it->second != depth)
+                        usage.known = false;
+                    depth = it->second;
+                }
+                reached = true;
+                continue;
+            }
+            if (e.type != INSTR)
+                continue;
+
+            const string &ins = e.fields[0];
+            const string &arg = e.fields[1];
+
+            if (ins == "BRA" || ins == "LBRA" || isConditionalBranch(ins.c_str()) || isDataDirective(ins))
+            {
+                // A data directive may be a jump table entry.
+                pair<map<string, int>::iterator, bool> p = newLabelDepths.insert(make_pair(arg, depth));
+                if (!p.second && p.first->second != depth)
+                    usage.known = false;
+                if (ins == "BRA" || ins == "LBRA")
+                    reached = false;
+                continue;
+            }
+            if (!reached)
+                continue;
+
+            if (ins == "PSHS")
+                depth += getNumStackedBytes(arg);
+            else if (ins == "PULS")
+            {
+                depth -= getNumStackedBytes(arg);
+                if (endsWith(arg, "PC"))
+                    reached = false;
+            }
+            else if (ins == "LEAS")
+            {
+                int offset = 0;
+                if (arg == ",U" && frameDepth >= 0)
+                    depth = frameDepth;
+                else if (endsWith(arg, ",S") && parseRelativeOffset(arg, offset))
+                    depth -= offset;
+                else
+                    usage.known = false;
+            }
+            else if (ins == "LEAU" && arg == ",S")
+                frameDepth = depth;
+            else if (ins == "LDS" || ((ins == "TFR" || ins == "EXG") && arg.find('S') != string::npos))
+                usage.known = false;
+            else if (ins == "LBSR" || ins == "BSR" || ins == "JSR")
+            {
+                bool isDirect = (arg.find_first_of(",[") == string::npos);
+                if (arg == "check_stack_overflow")
+                {
+                    usage.checkIndex = i;
+                    usage.checkDepth = depth;
+                }
+                else
+                    usage.calls.push_back(StackCallSite(isDirect ? arg : string(), depth));
+            }
+            else if (ins == "RTS" || ins == "RTI" || ins == "JMP")
+                reached = false;
+            else
+                depth += getAutoIncDecOnS(arg);
+
+            usage.maxDepth = max(usage.maxDepth, depth);
+        }
+
+        if (!usage.known || newLabelDepths == labelDepths)
+            return;
+        labelDepths.swap(newLabelDepths);
+    }
+    usage.known = false;
+}
+
+
+// Computes in coveredDepths[label] the deepest point reached below the return address
+// of the given covered function, including the calls it makes to other covered functions.
+// Returns false and sets recursiveLabel if the function is reached again through
+// its own calls.
+//
+bool
+ASMText::getCoveredStackDepth(const string &label,
+                              const StackUsageTable &usages,
+                              const set<string> &covered,
+                              map<string, int> &coveredDepths,
+                              set<string> &inProgress,
+                              string &recursiveLabel)
+{
+    if (coveredDepths.find(label) != coveredDepths.end())
+        return true;
+    if (inProgress.count(label) > 0)
+    {
+        recursiveLabel = label;
+        return false;
+    }
+    inProgress.insert(label);
+
+    const FunctionStackUsage &usage = usages.find(label)->second;
+    int deepest = usage.maxDepth;
+    for (vector<StackCallSite>::const_iterator it = usage.calls.begin(); it != usage.calls.end(); ++it)
+    {
+        int calleeDepth = 0;
+        if (covered.count(it->callee) > 0)
+        {
+            if (!getCoveredStackDepth(it->callee, usages, covered, coveredDepths, inProgress, recursiveLabel))
+                return false;
+            calleeDepth = coveredDepths[it->callee];
+        }
+        deepest = max(deepest, it->depth + 2 + calleeDepth);  // 2 for the return address
+    }
+
+    inProgress.erase(label);
+    coveredDepths[label] = deepest;
+    return true;
+}
+
+
+void
+ASMText::computeStackUsageTable(StackUsageTable &usages) const
+{
+    size_t funcStartIndex = size_t(-1);
+    for (size_t i = 0; i < elements.size(); ++i)
+    {
+        if (elements[i].type == FUNCTION_START)
+            funcStartIndex = i;
+        else if (elements[i].type == FUNCTION_END && funcStartIndex != size_t(-1))
+        {
+            computeFunctionStackUsage(funcStartIndex, i, usages["_" + elements[funcStartIndex].fields[0]]);
+            funcStartIndex = size_t(-1);
+        }
+    }
+}
+
+
+// Computes report[label], after computing the entries of the functions that it calls.
+// callPath: labels of the functions being computed, from the first one down to the caller
+// of 'label'. A call to one of them is a recursion.
+//
+void
+ASMText::addToStackReport(const string &label,
+                          const StackUsageTable &usages,
+                          StackReport &report,
+                          vector<string> &callPath)
+{
+    if (report.find(label) != report.end())
+        return;
+
+    const FunctionStackUsage &usage = usages.find(label)->second;
+    StackReportEntry entry;
+    entry.ownDepth = usage.maxDepth;
+    entry.incomplete = !usage.known || usage.hasInlineAsm;
+    for (vector<StackCallSite>::const_iterator it = usage.calls.begin(); it != usage.calls.end(); ++it)
+        entry.ownDepth = max(entry.ownDepth, it->depth + 2);  // 2 for the return address
+    entry.worstDepth = entry.ownDepth;
+
+    callPath.push_back(label);
+    for (vector<StackCallSite>::const_iterator it = usage.calls.begin(); it != usage.calls.end(); ++it)
+    {
+        const string &callee = it->callee;
+        if (callee.empty())
+        {
+            entry.callsThroughPointer = true;
+            continue;
+        }
+        if (usages.find(callee) == usages.end())
+        {
+            entry.externalCallees.insert(callee);
+            continue;
+        }
+
+        vector<string>::const_iterator cycleStart = find(callPath.begin(), callPath.end(), callee);
+        if (cycleStart != callPath.end())
+        {
+            if (entry.recursion.empty())
+            {
+                for (vector<string>::const_iterator jt = cycleStart; jt != callPath.end(); ++jt)
+                    entry.recursion += *jt + " -> ";
+                entry.recursion += callee;
+            }
+            entry.worstDepth = -1;
+            continue;
+        }
+
+        addToStackReport(callee, usages, report, callPath);
+        const StackReportEntry &calleeEntry = report[callee];
+        if (entry.recursion.empty())
+            entry.recursion = calleeEntry.recursion;
+        entry.incomplete = entry.incomplete || calleeEntry.incomplete;
+        entry.callsThroughPointer = entry.callsThroughPointer || calleeEntry.callsThroughPointer;
+        entry.externalCallees.insert(calleeEntry.externalCallees.begin(), calleeEntry.externalCallees.end());
+        if (calleeEntry.worstDepth < 0)
+            entry.worstDepth = -1;
+        else if (entry.worstDepth >= 0)
+            entry.worstDepth = max(entry.worstDepth, it->depth + 2 + calleeEntry.worstDepth);
+    }
+    callPath.pop_back();
+
+    report[label] = entry;
+}
+
+
+void
+ASMText::computeStackReport(StackReport &report) const
+{
+    StackUsageTable usages;
+    computeStackUsageTable(usages);
+
+    report.clear();
+    for (StackUsageTable::const_iterator it = usages.begin(); it != usages.end(); ++it)
+    {
+        vector<string> callPath;
+        addToStackReport(it->first, usages, report, callPath);
+    }
+}
+
+
+void
+ASMText::hoistStackOverflowChecks()
+{
+    StackUsageTable usages;
+    computeStackUsageTable(usages);
+
+    // A function can be covered by its callers if it is not exported, if its address
+    // is never taken, if all its callers are functions whose stack usage is known,
+    // and if it does not take part in a recursion.
+    //
+    set<string> excluded;
+    map<string, size_t> numCallers;
+    for (vector<Element>::const_iterator it = elements.begin(); it != elements.end(); ++it)
+    {
+        const Element &e = *it;
+        if (e.type == EXPORT)
+            excluded.insert(e.fields[0]);
+        else if (e.type == INLINE_ASM)
+        {
+            for (StackUsageTable::const_iterator jt = usages.begin(); jt != usages.end(); ++jt)
+                if (e.fields[0].find(jt->first) != string::npos)
+                    excluded.insert(jt->first);
+        }
+        else if (e.type == INSTR && e.fields[0] != "LBSR" && e.fields[0] != "BSR" && e.fields[0] != "JSR")
+        {
+            // Any other mention of a function label is taken to be a use of its address.
+            string arg = e.fields[1];
+            replace(arg.begin(), arg.end(), '+', ',');
+            replace(arg.begin(), arg.end(), '[', ',');
+            replace(arg.begin(), arg.end(), ']', ',');
+            istringstream tokens(arg);
+            string token;
+            while (getline(tokens, token, ','))
+                if (usages.find(token) != usages.end())
+                    excluded.insert(token);
+        }
+    }
+    for (StackUsageTable::const_iterator it = usages.begin(); it != usages.end(); ++it)
+    {
+        for (vector<StackCallSite>::const_iterator jt = it->second.calls.begin(); jt != it->second.calls.end(); ++jt)
+        {
+            if (usages.find(jt->callee) == usages.end())
+                continue;
+            ++numCallers[jt->callee];
+            if (!it->second.known || it->second.hasInlineAsm)
+                excluded.insert(jt->callee);
+        }
+    }
+
+    set<string> covered;
+    for (StackUsageTable::const_iterator it = usages.begin(); it != usages.end(); ++it)
+        if (it->second.known && !it->second.hasInlineAsm && it->second.checkIndex != size_t(-1)
+                && numCallers[it->first] > 0 && excluded.count(it->first) == 0)
+            covered.insert(it->first);
+
+    // Remove recursive functions one at a time, until the depths can all be computed.
+    //
+    map<string, int> coveredDepths;
+    for (bool recursionFound = true; recursionFound; )
+    {
+        recursionFound = false;
+        coveredDepths.clear();
+        for (set<string>::const_iterator it = covered.begin(); it != covered.end(); ++it)
+        {
+            set<string> inProgress;
+            string recursiveLabel;
+            if (!getCoveredStackDepth(*it, usages, covered, coveredDepths, inProgress, recursiveLabel))
+            {
+                covered.erase(recursiveLabel);
+                recursionFound = true;
+                break;
+            }
+        }
+    }
+
+    if (covered.empty())
+        return;
+
+    // Process the checks from the last one, so that the insertions do not move
+    // the indices of the checks that remain to be processed.
+    //
+    vector<pair<size_t, string> > checks;  // index of the check and label of its function
+    for (StackUsageTable::const_iterator it = usages.begin(); it != usages.end(); ++it)
+        if (it->second.checkIndex != size_t(-1))
+            checks.push_back(make_pair(it->second.checkIndex, it->first));
+    sort(checks.begin(), checks.end());
+
+    for (vector<pair<size_t, string> >::reverse_iterator it = checks.rbegin(); it != checks.rend(); ++it)
+    {
+        const FunctionStackUsage &usage = usages[it->second];
+        if (covered.count(it->second) > 0)
+        {
+            commentOut(usage.checkIndex, "optim: hoistStackOverflowChecks");
+            continue;
+        }
+
+        int margin = 0;  // bytes needed below the check by the calls to covered functions
+        for (vector<StackCallSite>::const_iterator jt = usage.calls.begin(); jt != usage.calls.end(); ++jt)
+            if (covered.count(jt->callee) > 0)
+                margin = max(margin, jt->depth - usage.checkDepth + 2 + coveredDepths[jt->callee]);
+        if (margin <= 0)
+            continue;
+
+        // LEAS does not affect the condition codes.
+        insertInstr(usage.checkIndex + 1, "LEAS", intToString(margin) + ",S");
+        insertInstr(usage.checkIndex, "LEAS", intToString(-margin) + ",S", "make the check cover the static callees");
+    }
+}
+
+// Cycles taken by 6809 instructions, by addressing mode. -1 means that the mode does not exist.
+// Indexed mode cycles are the base ones, before getIndexedModeExtraCycles().
+//
+const static struct
+{
+    const char *instr;
+    int8_t immediate, direct, indexed, extended;
+} instrCycleTable[] =
+{
+    { "ADCA", 2, 4, 4, 5 }, { "ADCB", 2, 4, 4, 5 }, { "ADDA", 2, 4, 4, 5 }, { "ADDB", 2, 4, 4, 5 },
+    { "ANDA", 2, 4, 4, 5 }, { "ANDB", 2, 4, 4, 5 }, { "BITA", 2, 4, 4, 5 }, { "BITB", 2, 4, 4, 5 },
+    { "CMPA", 2, 4, 4, 5 }, { "CMPB", 2, 4, 4, 5 }, { "EORA", 2, 4, 4, 5 }, { "EORB", 2, 4, 4, 5 },
+    { "LDA",  2, 4, 4, 5 }, { "LDB",  2, 4, 4, 5 }, { "ORA",  2, 4, 4, 5 }, { "ORB",  2, 4, 4, 5 },
+    { "SBCA", 2, 4, 4, 5 }, { "SBCB", 2, 4, 4, 5 }, { "SUBA", 2, 4, 4, 5 }, { "SUBB", 2, 4, 4, 5 },
+    { "STA", -1, 4, 4, 5 }, { "STB", -1, 4, 4, 5 },
+    { "ADDD", 4, 6, 6, 7 }, { "SUBD", 4, 6, 6, 7 }, { "CMPX", 4, 6, 6, 7 },
+    { "CMPD", 5, 7, 7, 8 }, { "CMPY", 5, 7, 7, 8 }, { "CMPU", 5, 7, 7, 8 }, { "CMPS", 5, 7, 7, 8 },
+    { "LDD",  3, 5, 5, 6 }, { "LDX",  3, 5, 5, 6 }, { "LDU",  3, 5, 5, 6 },
+    { "LDY",  4, 6, 6, 7 }, { "LDS",  4, 6, 6, 7 },
+    { "STD", -1, 5, 5, 6 }, { "STX", -1, 5, 5, 6 }, { "STU", -1, 5, 5, 6 },
+    { "STY", -1, 6, 6, 7 }, { "STS", -1, 6, 6, 7 },
+    { "ASL", -1, 6, 6, 7 }, { "ASR", -1, 6, 6, 7 }, { "CLR", -1, 6, 6, 7 }, { "COM", -1, 6, 6, 7 },
+    { "DEC", -1, 6, 6, 7 }, { "INC", -1, 6, 6, 7 }, { "LSL", -1, 6, 6, 7 }, { "LSR", -1, 6, 6, 7 },
+    { "NEG", -1, 6, 6, 7 }, { "ROL", -1, 6, 6, 7 }, { "ROR", -1, 6, 6, 7 }, { "TST", -1, 6, 6, 7 },
+    { "JMP", -1, 3, 3, 4 }, { "JSR", -1, 7, 7, 8 },
+    { "LEAX", -1, -1, 4, -1 }, { "LEAY", -1, -1, 4, -1 }, { "LEAS", -1, -1, 4, -1 }, { "LEAU", -1, -1, 4, -1 },
+    { "ANDCC", 3, -1, -1, -1 }, { "ORCC", 3, -1, -1, -1 },
+};
+
+
+// Inherent mode instructions, other than the accumulator forms (e.g., CLRA) of the
+// read-modify-write instructions of instrCycleTable[], which take 2 cycles.
+//
+const static struct
+{
+    const char *instr;
+    int8_t cycles;
+} inherentCycleTable[] =
+{
+    { "ABX", 3 }, { "DAA", 2 }, { "MUL", 11 }, { "NOP", 2 }, { "SEX", 2 },
+    { "RTS", 5 }, { "RTI", 15 }, { "SWI", 19 }, { "SYNC", 4 }, { "CWAI", 20 },
+    { "TFR", 6 }, { "EXG", 8 },
+    { "BSR", 7 }, { "LBSR", 9 }, { "BRA", 3 }, { "LBRA", 5 }, { "BRN", 3 }, { "LBRN", 5 },
+};
+
+
+// Returns the cycles that an indexed mode operand (e.g., 4,U or [,X++])
+// adds to the base cycles of an instruction.
+// An offset that is a symbol is assumed to take 16 bits.
+//
+int
+ASMText::getIndexedModeExtraCycles(const string &arg)
+{
+    bool indirect = (!arg.empty() && arg[0] == '[');
+    string operand = (indirect ? arg.substr(1, arg.length() - 2) : arg);
+    size_t commaIndex = operand.rfind(',');
+    if (commaIndex == string::npos)
+        return 5;  // extended indirect, e.g., [$FFFE]
+
+    string offset(operand, 0, commaIndex), reg(operand, commaIndex + 1);
+    if (reg.find("++") != string::npos || reg.find("--") != string::npos)
+        return indirect ? 6 : 3;
+    if (reg.find('+') != string::npos || reg.find('-') != string::npos)
+        return 2;
+    if (offset.empty())
+        return indirect ? 3 : 0;
+    if (offset == "A" || offset == "B")
+        return indirect ? 4 : 1;
+    if (offset == "D")
+        return indirect ? 7 : 4;
+
+    char *end = NULL;
+    long n = (offset[0] == '$' ? strtol(offset.c_str() + 1, &end, 16)
+                               : strtol(offset.c_str(), &end, 10));
+    bool isNumber = (end != NULL && *end == '\0');
+    if (reg == "PCR" || reg == "PC")
+    {
+        if (isNumber && n >= -128 && n <= 127)
+            return indirect ? 4 : 1;
+        return indirect ? 8 : 5;
+    }
+    if (isNumber && n == 0)
+        return indirect ? 3 : 0;
+    if (isNumber && n >= -128 && n <= 127)
+        return indirect ? 4 : 1;
+    return indirect ? 7 : 4;
+}
+
+
+// Returns the cycles taken by an instruction, or 0 if it is not known (e.g., a data directive).
+// A conditional branch is assumed not to be taken: a long one takes one more cycle when taken.
+// PSHS and PULS take one cycle per byte pushed or pulled.
+//
+int
+ASMText::getInstructionCycles(const string &ins, const string &arg)
+{
+    if (ins == "PSHS" || ins == "PULS" || ins == "PSHU" || ins == "PULU")
+        return 5 + getNumStackedBytes(arg);
+    if (isConditionalBranch(ins.c_str()))
+        return ins[0] == 'L' ? 5 : 3;
+
+    for (size_t i = 0; i < sizeof(inherentCycleTable) / sizeof(inherentCycleTable[0]); ++i)
+        if (ins == inherentCycleTable[i].instr)
+            return inherentCycleTable[i].cycles;
+
+    for (size_t i = 0; i < sizeof(instrCycleTable) / sizeof(instrCycleTable[0]); ++i)
+    {
+        const char *name = instrCycleTable[i].instr;
+        size_t nameLen = strlen(name);
+        if (ins.compare(0, nameLen, name) != 0)
+            continue;
+        if (ins.length() == nameLen + 1 && (ins[nameLen] == 'A' || ins[nameLen] == 'B')
+                && instrCycleTable[i].immediate < 0 && instrCycleTable[i].direct == 6)
+            return 2;  // accumulator form of a read-modify-write instruction, e.g., CLRB
+        if (ins.length() != nameLen)
+            continue;
+
+        int8_t cycles;
+        if (arg[0] == '#')
+            cycles = instrCycleTable[i].immediate;
+        else if (arg[0] == '<')
+            cycles = instrCycleTable[i].direct;
+        else if (arg.find(',') != string::npos || arg[0] == '[')
+        {
+            cycles = instrCycleTable[i].indexed;
+            if (cycles >= 0)
+                cycles += getIndexedModeExtraCycles(arg);
+        }
+        else
+            cycles = instrCycleTable[i].extended;
+        return max(0, int(cycles));
+    }
+    return 0;
+}
+
+
+// Fills best and worst with the cycles taken by the fastest and the slowest paths
+// that start at elements[startIndex] and end with a return (when backEdgeIndex is size_t(-1))
+// or with the branch at elements[backEdgeIndex].
+// Branches to earlier labels are taken to be loop repetitions, which are not followed.
+// A call to a function of 'table' adds the cycles of that function.
+// best and worst are -1 if no such path exists.
+//
+void
+ASMText::computePathCycles(size_t startIndex, size_t endIndex, size_t backEdgeIndex,
+                           const map<string, size_t> &labelIndices,
+                           const CycleTable &table,
+                           int &best, int &worst) const
+{
+    typedef pair<int, int> Range;  // best and worst cycles up to a point
+    const Range unreached(INT_MAX, -1);
+    map<string, Range> pending;  // ranges of the forward branches to each label
+    Range state(0, 0), result = unreached, jumpTableState = unreached;
+
+    for (size_t i = startIndex; i < endIndex; ++i)
+    {
+        const Element &e = elements[i];
+        if (e.type == LABEL)
+        {
+            map<string, Range>::const_iterator it = pending.find(e.fields[0]);
+            if (it != pending.end())
+                state = Range(min(state.first, it->second.first), max(state.second, it->second.second));
+            continue;
+        }
+        if (e.type != INSTR)
+            continue;
+
+        const string &ins = e.fields[0];
+        const string &arg = e.fields[1];
+
+        if (isDataDirective(ins))
+        {
+            // A jump table entry has the form Lcase-Ltable.
+            size_t dashIndex = arg.find('-');
+            if (dashIndex != string::npos && jumpTableState.second >= 0)
+            {
+                Range &r = pending.insert(make_pair(arg.substr(0, dashIndex), unreached)).first->second;
+                r = Range(min(r.first, jumpTableState.first), max(r.second, jumpTableState.second));
+            }
+            continue;
+        }
+        if (state.second < 0)
+            continue;  // not reached
+
+        int cycles = getInstructionCycles(ins, arg);
+        Range next(state.first + cycles, state.second + cycles);
+
+        if (ins == "LBSR" || ins == "BSR" || ins == "JSR")
+        {
+            CycleTable::const_iterator it = table.find(arg);
+            if (it != table.end() && it->second.worst >= 0)
+            {
+                next.first += it->second.best;
+                next.second += it->second.worst;
+            }
+            state = next;
+            continue;
+        }
+
+        bool isBranch = (ins == "BRA" || ins == "LBRA" || isConditionalBranch(ins.c_str()));
+        if (isBranch)
+        {
+            Range taken(next.first + (ins[0] == 'L' && ins != "LBRA"),
+                        next.second + (ins[0] == 'L' && ins != "LBRA"));
+            map<string, size_t>::const_iterator it = labelIndices.find(arg);
+            if (i == backEdgeIndex)
+            {
+                result = taken;
+                break;
+            }
+            if (it == labelIndices.end())
+            {
+                // Jump out of the function, to a jump table routine or to another function.
+                jumpTableState = taken;
+                size_t nextIndex = findNextInstr(i + 1);
+                if (nextIndex == size_t(-1) || !isDataDirective(elements[nextIndex].fields[0]))
+                    result = Range(min(result.first, taken.first), max(result.second, taken.second));
+            }
+            else if (it->second > i)  // forward branch
+            {
+                Range &r = pending.insert(make_pair(arg, unreached)).first->second;
+                r = Range(min(r.first, taken.first), max(r.second, taken.second));
+            }
+            state = (ins == "BRA" || ins == "LBRA" ? unreached : next);
+            continue;
+        }
+
+        if (ins == "RTS" || ins == "RTI" || ins == "JMP" || (ins == "PULS" && endsWith(arg, "PC")))
+        {
+            if (backEdgeIndex == size_t(-1))
+                result = Range(min(result.first, next.first), max(result.second, next.second));
+            state = unreached;
+            continue;
+        }
+
+        state = next;
+    }
+
+    if (result.second < 0)
+        best = worst = -1;
+    else
+    {
+        best = result.first;
+        worst = result.second;
+    }
+}
+
+
+// Computes table[label], after computing the entries of the functions that it calls.
+//
+void
+ASMText::computeFunctionCycles(const string &label,
+                               const map<string, pair<size_t, size_t> > &functionRanges,
+                               CycleTable &table,
+                               set<string> &inProgress) const
+{
+    if (table.find(label) != table.end() || inProgress.count(label) > 0)
+        return;
+    inProgress.insert(label);
+
+    const pair<size_t, size_t> &range = functionRanges.find(label)->second;
+    FunctionCycles fc;
+    map<string, size_t> labelIndices;  // key: label; value: index in elements[]
+    for (size_t i = range.first + 1; i < range.second; ++i)
+    {
+        const Element &e = elements[i];
+        if (e.type == LABEL)
+            labelIndices[e.fields[0]] = i;
+    }
+
+    map<string, size_t> backEdges;  // key: loop label; value: index of the last branch back to it
+    for (size_t i = range.first + 1; i < range.second; ++i)
+    {
+        const Element &e = elements[i];
+        if (e.type == INLINE_ASM)
+            fc.hasInlineAsm = true;
+        if (e.type != INSTR)
+            continue;
+        const string &ins = e.fields[0];
+        const string &arg = e.fields[1];
+        if (ins == "LBSR" || ins == "BSR" || ins == "JSR" || ins == "LBRA" || ins == "BRA")
+        {
+            if (arg.find_first_of(",[") != string::npos)
+                fc.callsThroughPointer = true;
+            else if (functionRanges.find(arg) != functionRanges.end())
+            {
+                if (inProgress.count(arg) > 0)
+                    fc.recursive = true;
+                else
+                    computeFunctionCycles(arg, functionRanges, table, inProgress);
+            }
+            else if (labelIndices.find(arg) == labelIndices.end())
+                ++fc.externalCalls[arg];
+        }
+        if (ins == "BRA" || ins == "LBRA" || isConditionalBranch(ins.c_str()))
+        {
+            map<string, size_t>::const_iterator it = labelIndices.find(arg);
+            if (it != labelIndices.end() && it->second < i)
+                backEdges[arg] = i;
+        }
+    }
+
+    computePathCycles(range.first + 1, range.second, size_t(-1), labelIndices, table, fc.best, fc.worst);
+
+    for (map<string, size_t>::const_iterator it = backEdges.begin(); it != backEdges.end(); ++it)
+    {
+        LoopCycles loop;
+        size_t loopStartIndex = labelIndices[it->first];
+        computePathCycles(loopStartIndex, it->second + 1, it->second, labelIndices, table, loop.best, loop.worst);
+
+        // Name the loop after the last source line comment that precedes it.
+        for (size_t i = loopStartIndex; i > range.first; --i)
+        {
+            const Element &e = elements[i];
+            if (e.type == COMMENT && startsWith(e.fields[0], "Line "))
+            {
+                string location(e.fields[0], 5);
+                size_t colonIndex = location.find(':');
+                if (colonIndex != string::npos)
+                    location.erase(location.find(':', colonIndex + 1));
+                loop.location = location;
+                break;
+            }
+        }
+        loop.startIndex = loopStartIndex;
+        fc.loops.push_back(loop);
+    }
+    sort(fc.loops.begin(), fc.loops.end());
+
+    inProgress.erase(label);
+    table[label] = fc;
+}
+
+
+void
+ASMText::writeCycleReport(ostream &out, const string &sourceFilename) const
+{
+    vector<string> labels;  // in order of appearance
+    map<string, pair<size_t, size_t> > functionRanges;  // indices of the FUNCTION_START and FUNCTION_END elements
+    size_t funcStartIndex = size_t(-1);
+    for (size_t i = 0; i < elements.size(); ++i)
+    {
+        if (elements[i].type == FUNCTION_START)
+            funcStartIndex = i;
+        else if (elements[i].type == FUNCTION_END && funcStartIndex != size_t(-1))
+        {
+            string label = "_" + elements[funcStartIndex].fields[0];
+            labels.push_back(label);
+            functionRanges[label] = make_pair(funcStartIndex, i);
+            funcStartIndex = size_t(-1);
+        }
+    }
+
+    CycleTable table;
+    for (vector<string>::const_iterator it = labels.begin(); it != labels.end(); ++it)
+    {
+        set<string> inProgress;
+        computeFunctionCycles(*it, functionRanges, table, inProgress);
+    }
+
+    out << "Cycles of " << sourceFilename << ", with the called functions of this file, without loop repetitions:\n";
+    out << "    Best   Worst  Function\n";
+    for (vector<string>::const_iterator it = labels.begin(); it != labels.end(); ++it)
+    {
+        const FunctionCycles &fc = table[*it];
+        if (fc.worst < 0)
+            out << setw(8) << "-" << setw(8) << "-";
+        else
+            out << setw(8) << fc.best << setw(8) << fc.worst;
+        out << "  " << it->substr(1);
+        if (fc.recursive)
+            out << "; recursive calls not counted";
+        if (fc.callsThroughPointer)
+            out << "; calls through a pointer not counted";
+        if (fc.hasInlineAsm)
+            out << "; inline assembly not counted";
+        if (!fc.externalCalls.empty())
+        {
+            // Routines of other modules, starting with the most called ones.
+            vector<pair<int, string> > calls;  // negated number of calls, and label
+            for (map<string, size_t>::const_iterator jt = fc.externalCalls.begin(); jt != fc.externalCalls.end(); ++jt)
+                calls.push_back(make_pair(-int(jt->second), jt->first));
+            sort(calls.begin(), calls.end());
+            out << "; other modules not counted:";
+            for (vector<pair<int, string> >::const_iterator jt = calls.begin(); jt != calls.end(); ++jt)
+            {
+                out << (jt == calls.begin() ? " " : ", ")
+                    << (jt->second[0] == '_' ? jt->second.substr(1) : jt->second);
+                if (jt->first < -1)
+                    out << " (" << -jt->first << " calls)";
+            }
+        }
+        out << '\n';
+
+        for (vector<LoopCycles>::const_iterator jt = fc.loops.begin(); jt != fc.loops.end(); ++jt)
+        {
+            if (jt->worst < 0)
+                out << setw(8) << "-" << setw(8) << "-";
+            else
+                out << setw(8) << jt->best << setw(8) << jt->worst;
+            out << "    per iteration of loop";
+            if (!jt->location.empty())
+                out << " at " << jt->location;
+            out << '\n';
+        }
+    }
+}
+
+bool
+ASMText::isInstr(size_t index, const char *ins, const char *arg) const
+{
+    const Element &e = elements[index];
+    return e.type == INSTR && e.fields[0] == ins && e.fields[1] == arg;
+}
+
+
+bool
+ASMText::isInstrAnyArg(size_t index, const char *ins) const
+{
+    const Element &e = elements[index];
+    return e.type == INSTR && e.fields[0] == ins;
+}
+
+
+bool
+ASMText::isInstrWithImmedArg(size_t index, const char *ins) const
+{
+    const Element &e = elements[index];
+    return e.type == INSTR && e.fields[0] == ins && e.fields[1][0] == '#';
+}
+
+
+bool
+ASMText::isInstrWithVarArg(size_t index, const char *ins) const
+{
+    const Element &e = elements[index];
+    return e.type == INSTR
+        && e.fields[0] == ins
+        && (endsWith(e.fields[1], ",U") || endsWith(e.fields[1], ",PCR"));
+}
+
+
+const char *
+ASMText::getInstr(size_t index) const
+{
+    const Element &e = elements[index];
+    if (e.type != INSTR)
+        return "";
+    return e.fields[0].c_str();
+}
+
+
+const char *
+ASMText::getInstrArg(size_t index) const
+{
+    const Element &e = elements[index];
+    if (e.type != INSTR)
+        return "";
+    return e.fields[1].c_str();
+}
+
+
+// None of the instruction names must exceed 6 characters in length.
+// See isConditionalBranch().
+//
+const static struct
+{
+    const char *branchInstr;
+    const char *inverseInstr;
+} branchInstrTable[] =
+{
+    { "BCC", "BCS" },
+    { "BEQ", "BNE" },
+    { "BGE", "BLT" },
+    { "BGT", "BLE" },
+    { "BHI", "BLS" },
+    { "BHS", "BLO" },
+    { "BMI", "BPL" },
+    { "BVC", "BVS" },
+};
+
+
+// None of the instruction names must exceed 6 characters in length.
+// See isRelativeSizeConditionalBranch().
+//
+const static struct
+{
+    const char *branchInstr;
+    const char *invertedOperandsInstr;
 } relativeSizeBranchInstrTable[] =
 {
     { "BEQ", "BEQ" },
@@ -4852,7 +6633,7 @@ ASMText::isInstrWithPreDecrOrPostIncr(size_t index) const {
 
 
 bool
-ASMText::parseRelativeOffset(const string &s, int &offset)
+ASMText::parseRelativeOffset(const string &s, int &offset) const
 {
   size_t commaIndex = s.find(",");
   if ((commaIndex == string::npos) || (commaIndex == 0) ||
@@ -4903,6 +6684,18 @@ ASMText::isAbsoluteAddress(const string &arg)
 }
 
 
+// The linker map only shows exported symbols, so a static function gets
+// exported funcstart_ and funcend_ labels named after its profile key
+// (see FunctionDef::getProfileKey()) when the program can be profiled.
+// A non-static function is found by its _ and funcend_ labels.
+//
+bool
+ASMText::isStaticFunctionProfiled(const Element &e)
+{
+    return e.fields[2] != e.fields[0] && TranslationUnit::instance().areProfilingLabelsEmitted();
+}
+
+
 void
 ASMText::writeElement(ostream &out, const Element &e)
 {
@@ -4916,12 +6709,22 @@ ASMText::writeElement(ostream &out, const Element &e)
     case INCLUDE:       writeInclude(out, e);             break;
     case FUNCTION_START:
         out << "* FUNCTION " << e.fields[0] << "(): defined at " << e.fields[1] << "\n";
+        if (isStaticFunctionProfiled(e))
+            out << "funcstart_" << e.fields[2] << "\tEXPORT\n" << "funcstart_" << e.fields[2] << "\tEQU\t*\n";
         break;
     case FUNCTION_END  :
         out << "* END FUNCTION " << e.fields[0] << "(): defined at " << e.fields[1] << "\n";
+        {
+            ClobberTable::const_iterator it = functionClobbers.find("_" + e.fields[0]);
+            if (it != functionClobbers.end())
+                out << "* Registers modified by " << e.fields[0] << "(): "
+                    << (it->second ? listRegisters(it->second) : "none") << "\n";
+        }
         // Emit labels that will give the function's size in the assembly listing file.
         out << "funcend_" << e.fields[0] << "\tEQU *\n";
         out << "funcsize_" << e.fields[0] << "\tEQU\tfuncend_" << e.fields[0] << "-_" << e.fields[0] << "\n";
+        if (isStaticFunctionProfiled(e))
+            out << "funcend_" << e.fields[2] << "\tEXPORT\n" << "funcend_" << e.fields[2] << "\tEQU\t*\n";
         break;
     case SECTION_START:
         out << "\n\n\t""SECTION\t" << e.fields[0] << "\n\n\n";
@@ -4975,6 +6778,168 @@ ASMText::listRegisters(uint8_t registers)
 }
 
 
+// Registers used by the utility routines of the standard library that the compiler
+// calls most often, as documented and implemented in src/stdlib/*.asm.
+// Arguments passed in the stack are not listed. None of these routines modifies Y or U.
+// Must be in strcmp() order.
+//
+static const struct UtilityRegisterUsage
+{
+    const char *label;
+    uint8_t read;
+    uint8_t written;
+} utilityRegisterUsage[] =
+{
+    { "MUL16",                      A | B | X,  A | B },
+    { "addDWordDWord",              X,          A | B },
+    { "addDWordInt",                X,          A | B },
+    { "addDWordUnsignedInt",        X,          A | B },
+    { "addIntDWord",                X,          A | B },
+    { "addUnsignedIntDWord",        X,          A | B },
+    { "andDWordDWord",              X,          A | B },
+    { "andDWordWord",               X,          A | B },
+    { "cmpDWordDWord",              0,          A | B },
+    { "cmpDWordSignedInt",          0,          A | B },
+    { "cmpDWordUnsignedInt",        0,          A | B },
+    { "cmpSignedIntDWord",          0,          A | B },
+    { "cmpUnsignedIntDWord",        0,          A | B },
+    { "copyDWord",                  A | B | X,  A | B },
+    { "copyDWordFromXToD",          A | B | X,  A | B },
+    { "copyWordToDWord",            X,          A | B },
+    { "decrementDWord",             X,          A | B },
+    { "incrementDWord",             X,          A | B },
+    { "initByteFromDWord",          A | B | X,  B },
+    { "initDWordFromSignedWord",    A | B | X,  A | B },
+    { "initDWordFromUnsignedWord",  A | B | X,  0 },
+    { "initWordFromDWord",          A | B | X,  A | B },
+    { "isDWordZero",                X,          0 },
+    { "leftShiftDWord",             X,          A | B },
+    { "mulDWordDWord",              X,          A | B },
+    { "mulDWordInt",                X,          A | B },
+    { "mulDWordUnsignedInt",        X,          A | B },
+    { "mulIntDWord",                X,          A | B },
+    { "mulUnsignedIntDWord",        X,          A | B },
+    { "negateDWord",                X,          A | B },
+    { "orDWordDWord",               X,          A | B },
+    { "orDWordWord",                X,          A | B },
+    { "push4ByteStruct",            X,          A | B },
+    { "push5ByteStruct",            X,          A | B },
+    { "rightShiftDWord",            X,          A | B },
+    { "subDWordDWord",              X,          A | B },
+    { "subDWordInt",                X,          A | B },
+    { "subDWordUnsignedInt",        X,          A | B },
+    { "subIntDWord",                X,          A | B },
+    { "subUnsignedIntDWord",        X,          A | B },
+    { "xorDWordDWord",              X,          A | B },
+    { "xorDWordWord",               X,          A | B },
+};
+
+
+inline bool utilityComesBeforeLabel(const UtilityRegisterUsage &u, const char *label)
+{
+    return strcmp(u.label, label) < 0;
+}
+
+
+// Returns false if 'label' is not the name of a utility routine listed in utilityRegisterUsage[].
+//
+bool
+ASMText::getUtilityRegisterUsage(const string &label, RegisterUsage &usage)
+{
+    const UtilityRegisterUsage *end = utilityRegisterUsage + sizeof(utilityRegisterUsage) / sizeof(utilityRegisterUsage[0]);
+    const UtilityRegisterUsage *it = lower_bound(utilityRegisterUsage, end, label.c_str(), utilityComesBeforeLabel);
+    if (it == end || label != it->label)
+        return false;
+    usage.read = it->read;
+    usage.written = it->written;
+    return true;
+}
+
+
+// Returns false if 'label' is not the label of a function of the current
+// translation unit, or if computeFunctionRegisterUsage() has not been called.
+//
+bool
+ASMText::getFunctionRegisterUsage(const string &label, RegisterUsage &usage) const
+{
+    ClobberTable::const_iterator it = functionClobbers.find(label);
+    if (it == functionClobbers.end())
+        return false;
+    usage.read = A | B | X | Y | U;  // arguments may be passed in D and X
+    usage.written = it->second;
+    return true;
+}
+
+
+// Determines which registers among A, B, X and Y each function of the current
+// translation unit may modify, including through the subroutines it calls.
+// U is preserved by the calling convention.
+// A function that contains inline assembly or that calls an unknown subroutine
+// is considered to modify all four registers.
+// The result is a superset as long as instructions are only removed afterwards.
+//
+void
+ASMText::computeFunctionRegisterUsage()
+{
+    const uint8_t clobberable = A | B | X | Y;
+
+    functionClobbers.clear();
+
+    // Start with an empty set for each function, then iterate until no set grows.
+    // Each pass reuses the sets of the callees, so recursion converges.
+    //
+    for (vector<Element>::const_iterator it = elements.begin(); it != elements.end(); ++it)
+        if (it->type == FUNCTION_START)
+            functionClobbers["_" + it->fields[0]] = 0;
+
+    for (bool changed = true; changed; )
+    {
+        changed = false;
+        string curLabel;  // empty means not currently in a function
+        uint8_t clobbered = 0;
+        for (vector<Element>::const_iterator it = elements.begin(); it != elements.end(); ++it)
+        {
+            const Element &e = *it;
+            switch (e.type)
+            {
+            case FUNCTION_START:
+                curLabel = "_" + e.fields[0];
+                clobbered = 0;
+                break;
+            case INLINE_ASM:
+                clobbered |= clobberable;
+                break;
+            case INSTR:
+                if (curLabel.empty())
+                    ;
+                else if (e.fields[0] == "JMP")  // jump out of function, e.g., through a table
+                    clobbered |= clobberable;
+                else
+                {
+                    const InsEffects effects(e, this);
+                    clobbered |= effects.written & clobberable;
+                }
+                break;
+            case FUNCTION_END:
+                if (!curLabel.empty())
+                {
+                    uint8_t &summary = functionClobbers[curLabel];
+                    if ((summary | clobbered) != summary)
+                    {
+                        summary |= clobbered;
+                        changed = true;
+                    }
+                }
+                curLabel.clear();
+                break;
+            default:
+                break;
+            }
+        }
+    }
+}
+
+
 // Fills members 'read' and 'written' with bits representing the registers
 // that are read or written by the instruction in 'e'.
 // Those members remain zero if 'e' is not an instruction.
@@ -4985,7 +6950,7 @@ ASMText::listRegisters(uint8_t registers)
 //                even though B is dead.
 //       Most of the code emitted by the compiler does not handle CC directly.
 //
-ASMText::InsEffects::InsEffects(const Element &e)
+ASMText::InsEffects::InsEffects(const Element &e, const ASMText *text)
 :   read(0), written(0)
 {
     if (e.type != INSTR)
@@ -5006,7 +6971,13 @@ ASMText::InsEffects::InsEffects(const Element &e)
     else if (ins == "BITB" || ins == "TSTB")
         read |= B;
     else if (ins == "BSR" || ins == "LBSR" || ins == "JSR")
-        read |= A | B | X | Y | U, written = read;  // be pessimistic
+    {
+        RegisterUsage usage;
+        if (text && (getUtilityRegisterUsage(arg, usage) || text->getFunctionRegisterUsage(arg, usage)))
+            read |= usage.read, written |= usage.written;
+        else
+            read |= A | B | X | Y | U, written = read;  // be pessimistic
+    }
     else if (ins[0] == 'B')  // all other B instructions are conditional branches
         ;
     else if (ins == "LDD")
@@ -5048,12 +7019,14 @@ ASMText::InsEffects::InsEffects(const Element &e)
     else if (ins == "ADDD" || ins == "SUBD")
         read |= A | B, written |= A | B;
     else if (ins == "ADDA" || ins == "SUBA" || ins == "INCA"
+            || ins == "ADCA" || ins == "SBCA"
             || ins == "COMA" || ins == "NEGA"
             || ins == "LSLA" || ins == "LSRA" || ins == "ASRA"
             || ins == "ROLA" || ins == "RORA"
             || ins == "ANDA" || ins == "ORA" || ins == "EORA")
         read |= A, written |= A;
     else if (ins == "ADDB" || ins == "SUBB" || ins == "INCB"
+            || ins == "ADCB" || ins == "SBCB"
             || ins == "COMB" || ins == "NEGB"
             || ins == "LSLB" || ins == "LSRB" || ins == "ASRB"
             || ins == "ROLB" || ins == "RORB"
@@ -5069,6 +7042,8 @@ ASMText::InsEffects::InsEffects(const Element &e)
         written |= parsePushPullArg(arg);
     else if (ins == "LEAS" || ins == "INC" || ins == "DEC" || ins == "CLR")
         ;
+    else if (ins == "LSL" || ins == "LSR" || ins == "ASR" || ins == "ROL" || ins == "ROR")
+        ;
     else if (ins == "RTS" || ins == "RTI")
         ;
     else if (ins == "TFR" || ins == "EXG")
@@ -5094,6 +7069,11 @@ ASMText::InsEffects::InsEffects(const Element &e)
         getRegPairNames(arg, firstReg, secondReg);
         read    |= firstReg;
         written |= secondReg;
+        if (ins == "EXG")
+        {
+            read    |= secondReg;
+            written |= firstReg;
+        }
     }
 
     if (endsWith(arg, ",X"))
@@ -5103,12 +7083,13 @@ ASMText::InsEffects::InsEffects(const Element &e)
     else if (endsWith(arg, ",U"))
         read |= U;
 
-    if (arg == ",X+" || arg == ",X++")
-        read |= X;
-    else if (arg == ",Y+" || arg == ",Y++")
-        read |= Y;
-    else if (arg == ",U+" || arg == ",U++")
-        read |= U;
+    // Auto-increment and auto-decrement modify the index register.
+    if (arg == ",X+" || arg == ",X++" || arg == ",-X" || arg == ",--X")
+        read |= X, written |= X;
+    else if (arg == ",Y+" || arg == ",Y++" || arg == ",-Y" || arg == ",--Y")
+        read |= Y, written |= Y;
+    else if (arg == ",U+" || arg == ",U++" || arg == ",-U" || arg == ",--U")
+        read |= U, written |= U;
 
     if (ins != "PSHS" && ins != "PULS")
     {
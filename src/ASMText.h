@@ -39,8 +39,9 @@ public:
     ASMText();
     void ins(const std::string &instr, const std::string &arg = "", const std::string &comment = "");
     void emitCMPDImmediate(uint16_t immediateValue, const std::string &comment = "");  // calls ins()
-    void emitFunctionStart(const std::string &functionId, const std::string &lineNo);
-    void emitFunctionEnd(const std::string &functionId, const std::string &lineNo);
+    // profileKey: see FunctionDef::getProfileKey().
+    void emitFunctionStart(const std::string &functionId, const std::string &lineNo, const std::string &profileKey);
+    void emitFunctionEnd(const std::string &functionId, const std::string &lineNo, const std::string &profileKey);
     void emitInlineAssembly(const std::string &text);
     void emitLabel(const std::string &label, const std::string &comment = "");
     void emitComment(const std::string &text);
@@ -57,6 +58,46 @@ public:
     void optimizeWholeFunctions();
     void peepholeOptimize(bool useStage2Optims);
 
+    // Removes the --check-null checks on pointers that are known to be non-null.
+    // Done at every optimization level, so that a null pointer is reported
+    // the same number of times regardless of the level.
+    //
+    void removeRedundantNullPointerChecks();
+
+    // Removes the --check-stack check of each function that is only called
+    // directly by other functions of this translation unit, outside of any
+    // recursion. The callers that keep their check make it account for the
+    // deepest chain of such calls, by checking with S lowered by that amount.
+    //
+    void hoistStackOverflowChecks();
+
+    // Worst-case stack usage of a function, as seen in the emitted code.
+    // Depths are in bytes below the function's return address.
+    //
+    struct StackReportEntry
+    {
+        int ownDepth;                   // deepest point of the function itself, including the return addresses of its calls
+        int worstDepth;                 // same, including the functions of this translation unit that it calls; -1 if unbounded
+        std::string recursion;          // labels of a reachable recursion (e.g., "_f -> _g -> _f"); empty if none
+        bool incomplete;                // reaches inline assembly or code whose stack usage could not be followed
+        bool callsThroughPointer;       // reaches a call through a function pointer, counted as its return address
+        std::set<std::string> externalCallees;  // reachable routines of other modules, counted as their return address
+
+        StackReportEntry() : ownDepth(0), worstDepth(0), recursion(), incomplete(false), callsThroughPointer(false), externalCallees() {}
+    };
+
+    typedef std::map<std::string, StackReportEntry> StackReport;
+        // Key: Assembly label of a function of the current translation unit.
+
+    void computeStackReport(StackReport &report) const;
+
+    // Writes the cycles taken by the fastest and slowest paths through each function,
+    // including the functions of this translation unit that it calls, with each loop
+    // taken once at most, followed by the cycles of one iteration of each loop.
+    // See --cycle-report.
+    //
+    void writeCycleReport(std::ostream &out, const std::string &sourceFilename) const;
+
     // Writes assembly text into 'out'.
     // Does not close 'out'.
     // Returns out.good().
@@ -83,6 +124,15 @@ public:
         bool isCommentLike() const { return type != INSTR && type != LABEL && type != INLINE_ASM && type != INCLUDE; }
     };
 
+    // Registers read and written by a subroutine, as seen by its caller.
+    // Same bit field as InsEffects.
+    //
+    struct RegisterUsage
+    {
+        uint8_t read;
+        uint8_t written;
+    };
+
     // Effects of an instruction on some registers.
     class InsEffects
     {
@@ -91,7 +141,14 @@ public:
         uint8_t read;
         uint8_t written;
 
-        InsEffects(const Element &e);
+        // When 'text' is null, a call is assumed to read and write all registers.
+        // Otherwise, a call to a utility routine listed by getUtilityRegisterUsage(),
+        // or to a function for which text->computeFunctionRegisterUsage() has
+        // computed a summary, only writes the registers given there.
+        // Optimizations that remove an instruction whose results are dead must not
+        // pass 'text', because a call also has side effects on memory.
+        //
+        InsEffects(const Element &e, const ASMText *text = NULL);
         std::string toString() const;
     private:
         static uint8_t parsePushPullArg(const std::string &arg);
@@ -102,6 +159,9 @@ public:
 private:
 
     static std::string listRegisters(uint8_t registers);
+    static bool getUtilityRegisterUsage(const std::string &label, RegisterUsage &usage);
+    bool getFunctionRegisterUsage(const std::string &label, RegisterUsage &usage) const;
+    void computeFunctionRegisterUsage();
     static uint8_t parseRegName(const char *name);
     static void getRegPairNames(const std::string &arg, uint8_t &firstReg, uint8_t &secondReg);
 
@@ -113,6 +173,7 @@ private:
     void writeElement(std::ostream &out, const Element &e);
     void writeIns(std::ostream &out, const Element &e);
     void writeLabel(std::ostream &out, const Element &e);
+    static bool isStaticFunctionProfiled(const Element &e);
     void writeInlineAssembly(std::ostream &out, const Element &e);
     void writeComment(std::ostream &out, const Element &e);
     void writeSeparatorComment(std::ostream &out, const Element &e);
@@ -135,6 +196,7 @@ private:
     bool stripConsecutiveLoadsToSameReg(size_t &index);
     bool storeLoad(size_t &index);
     bool condBranchOverUncondBranch(size_t &index);
+    bool threadBranch(size_t index);
     bool shortenBranch(size_t index);
     bool fasterPointerIndexing(size_t index);
     bool fasterPointerPushing(size_t index);
@@ -190,12 +252,17 @@ private:
     bool removeUselessClrb(size_t index);
     bool optimizeDXAliases(size_t index);
     bool removeLoadInComparisonWithTwoValues(size_t index);
+    bool removeReloadAcrossCall(size_t index);
 
     // Whole-function optimizer:
     bool isBasicBlockEndingInstruction(const Element &e) const;
     void createBasicBlock(size_t startIndex, size_t endIndex);
     void processBasicBlocks(const std::string &functionId);
     size_t findBlockIndex(size_t elementIndex) const;
+    void layOutBlocks(size_t functionStartIndex, size_t functionEndIndex);
+    size_t getBranchBytes(size_t startIndex, size_t endIndex) const;
+    void getLoopWeights(size_t startIndex, size_t endIndex, std::vector<size_t> &weights) const;
+    size_t getBranchCycles(size_t startIndex, size_t endIndex, const std::vector<size_t> &weights) const;
 
     // Utilities:
     void removeUselessLabels();
@@ -219,8 +286,10 @@ private:
     size_t findLabelIndex(const std::string &label) const;
     bool isLabel(size_t index, const std::string &label) const;
     bool isInstrWithPreDecrOrPostIncr(size_t index) const;
-    bool parseRelativeOffset(const std::string &s, int &offset);
+    bool parseRelativeOffset(const std::string &s, int &offset) const;
     bool parseConstantLiteral(const std::string &s, int &literal);
+    bool isLowByteReloadAfterStoreD(const Element &store, const Element &load);
+    bool overwritesNZ(size_t index) const;
     static bool isAbsoluteAddress(const std::string &arg);
     static bool isConstantOffsetFromX(const std::string &arg);
 
@@ -242,6 +311,128 @@ private:
         }
     };
 
+    // Sequence of elements that starts with the function's entry point or with
+    // one or more labels, and that extends up to the next label. Used by layOutBlocks().
+    //
+    struct LayoutBlock
+    {
+        size_t startIndex;      // in elements[]
+        size_t endIndex;        // in elements[]; exclusive
+        bool fallsThrough;      // true if the last instruction can continue into the next block
+        std::string jumpLabel;  // target of the BRA or LBRA that ends the block, if any
+        std::vector<std::string> branchLabels;  // targets of all the branches of the block
+        bool isFixed;           // loop header, loop latch, or block that falls through into a header
+
+        LayoutBlock(size_t _startIndex)
+        :   startIndex(_startIndex), endIndex(_startIndex), fallsThrough(true), jumpLabel(),
+            branchLabels(), isFixed(false)
+        {
+        }
+    };
+
+    // What is known to be non-null at a point of a function.
+    // Used by removeRedundantNullPointerChecks().
+    //
+    struct NonNullState
+    {
+        bool reached;                       // false means no path reaches this point (yet)
+        std::set<std::string> operands;     // memory operands (e.g., 4,U) known to contain a non-null pointer
+        bool xNonNull;                      // true if X is known to be non-null
+        std::string xSource;                // memory operand that X was loaded from and still equals, if any
+        std::string dSource;                // same for D
+        std::string zSource;                // memory operand whose value the Z flag reflects, if any
+
+        NonNullState() : reached(false), operands(), xNonNull(false), xSource(), dSource(), zSource() {}
+        bool operator == (const NonNullState &s) const;
+        void meet(const NonNullState &s);
+        void forgetX();
+        void forgetAll();
+        void addOperand(const std::string &operand);
+        void killAliases(const std::string &storeArg, int16_t storeSize);
+    };
+
+    void removeRedundantNullPointerChecks(size_t functionStartIndex, size_t functionEndIndex);
+    void updateNonNullState(const Element &e, NonNullState &state) const;
+
+    // Stack usage of a function, as seen in its emitted code.
+    // A depth is the number of bytes pushed by the function below its return address.
+    //
+    struct StackCallSite
+    {
+        std::string callee;  // label of the called routine; empty for a call through a pointer
+        int depth;           // depth at the call, not counting the return address that it pushes
+
+        StackCallSite(const std::string &_callee, int _depth) : callee(_callee), depth(_depth) {}
+    };
+
+    struct FunctionStackUsage
+    {
+        bool known;             // false if the depth could not be followed
+        bool hasInlineAsm;
+        int maxDepth;           // deepest point of the function itself, not counting its calls
+        size_t checkIndex;      // index in elements[] of the call to check_stack_overflow, or size_t(-1)
+        int checkDepth;         // depth at that call
+        std::vector<StackCallSite> calls;
+
+        FunctionStackUsage() : known(true), hasInlineAsm(false), maxDepth(0), checkIndex(size_t(-1)), checkDepth(0), calls() {}
+    };
+
+    typedef std::map<std::string, FunctionStackUsage> StackUsageTable;
+        // Key: Assembly label of a function of the current translation unit.
+
+    void computeFunctionStackUsage(size_t functionStartIndex, size_t functionEndIndex, FunctionStackUsage &usage) const;
+    void computeStackUsageTable(StackUsageTable &usages) const;
+    static void addToStackReport(const std::string &label,
+                                 const StackUsageTable &usages,
+                                 StackReport &report,
+                                 std::vector<std::string> &callPath);
+
+    // Cycle estimates, used by writeCycleReport().
+    //
+    struct LoopCycles
+    {
+        size_t startIndex;      // index in elements[] of the label that starts the loop
+        std::string location;   // source file and line number, if known
+        int best;               // one iteration; -1 if no path repeats the loop
+        int worst;
+
+        LoopCycles() : startIndex(0), location(), best(-1), worst(-1) {}
+        bool operator < (const LoopCycles &l) const { return startIndex < l.startIndex; }
+    };
+
+    struct FunctionCycles
+    {
+        int best;               // fastest path from the entry to a return; -1 if the function never returns
+        int worst;              // slowest such path
+        std::vector<LoopCycles> loops;
+        std::map<std::string, size_t> externalCalls;  // key: label of a routine of another module; value: number of calls
+        bool recursive;
+        bool callsThroughPointer;
+        bool hasInlineAsm;
+
+        FunctionCycles() : best(-1), worst(-1), loops(), externalCalls(), recursive(false), callsThroughPointer(false), hasInlineAsm(false) {}
+    };
+
+    typedef std::map<std::string, FunctionCycles> CycleTable;
+        // Key: Assembly label of a function of the current translation unit.
+
+    static int getIndexedModeExtraCycles(const std::string &arg);
+    static int getInstructionCycles(const std::string &ins, const std::string &arg);
+    void computePathCycles(size_t startIndex, size_t endIndex, size_t backEdgeIndex,
+                           const std::map<std::string, size_t> &labelIndices,
+                           const CycleTable &table,
+                           int &best, int &worst) const;
+    void computeFunctionCycles(const std::string &label,
+                               const std::map<std::string, std::pair<size_t, size_t> > &functionRanges,
+                               CycleTable &table,
+                               std::set<std::string> &inProgress) const;
+    static bool getCoveredStackDepth(const std::string &label,
+                                     const StackUsageTable &usages,
+                                     const std::set<std::string> &covered,
+                                     std::map<std::string, int> &coveredDepths,
+                                     std::set<std::string> &inProgress,
+                                     std::string &recursiveLabel);
+
     typedef std::map<std::string, size_t> LabelTable;
         // Key: Assembly label from a LABEL-type Element.
         // Value: Index in elements[].
@@ -259,6 +450,12 @@ private:
 
     std::string currentSection;  // contains non empty name when an assembly SECTION is currently open
 
+    typedef std::map<std::string, uint8_t> ClobberTable;
+        // Key: Assembly label of a function of the current translation unit.
+        // Value: Registers that a call to that function may modify (A, B, X, Y).
+
+    ClobberTable functionClobbers;  // filled by computeFunctionRegisterUsage()
+
     // Used by whole-function optimizer.
 
     LabelTable labelTable;  // key: label; value: index in elements[]
@@ -39,6 +39,8 @@ AssemblerStmt::AssemblerStmt(const std::string &ins,
     scopeOfAsmOnlyFunction(NULL),
     argIsVariable(_argIsVariable)
 {
+    setNodeKind(ASSEMBLER_STMT_NODE);
+
     if (instruction.length() < 3 || instruction.length() > 5)
         errormsg("invalid assembler instruction");
 }
@@ -52,6 +54,8 @@ AssemblerStmt::AssemblerStmt(const char *_asmText)
     scopeOfAsmOnlyFunction(NULL),
     argIsVariable(false)
 {
+    setNodeKind(ASSEMBLER_STMT_NODE);
+
     // Fix the source line number so that it points to the start of the text
     // instead of the end.
     int numNewlines = 0;
@@ -482,6 +486,22 @@ AssemblerStmt::getAllVariableNames(set<string> &varNames) const
 }
 
 
+bool
+AssemblerStmt::mentionsName(const string &name) const
+{
+    string text = (asmText.empty() ? argument : removeComments(asmText));
+    string tokenText;
+    for (size_t i = 0; ; )
+    {
+        Token token = getToken(text, i, tokenText);
+        if (token == END)
+            return false;
+        if (token == WORD && (tokenText == name || tokenText == variableNameEscapeChar + name))
+            return true;
+    }
+}
+
+
 /*virtual*/
 CodeStatus
 AssemblerStmt::emitCode(ASMText &out, bool lValue) const
@@ -52,6 +52,11 @@ public:
     //
     void getAllVariableNames(std::set<std::string> &varNames) const;
 
+    // Indicates if 'name' appears as a word in this statement, outside of comments.
+    // Does not require the SemanticsChecker pass to have been run.
+    //
+    bool mentionsName(const std::string &name) const;
+
     virtual CodeStatus emitCode(ASMText &out, bool lValue) const;
 
     virtual bool isLValue() const { return false; }
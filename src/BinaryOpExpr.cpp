@@ -31,6 +31,7 @@
 #include "ObjectMemberExpr.h"
 #include "FunctionCallExpr.h"
 #include "DWordConstantExpr.h"
+#include "RealConstantExpr.h"
 #include "StringLiteralExpr.h"
 #include "CommaExpr.h"
 
@@ -85,7 +86,8 @@ BinaryOpExpr::BinaryOpExpr(Op op, Tree *left, Tree *right)
     subExpr0(left),
     subExpr1(right),
     numBytesPerElement(0),
-    resultDeclaration(NULL)
+    resultDeclaration(NULL),
+    narrowedToByte(false)
 {
 }
 
@@ -116,7 +118,7 @@ BinaryOpExpr::checkSemantics(Functor &)
     case MOD:
         if (isRealOrLong())
             declareTemporary = true;
-        if (sub0TD->type == BYTE_TYPE && sub1TD->type == BYTE_TYPE && TranslationUnit::instance().warnOnBinaryOpGivingByte())
+        if (sub0TD->type == BYTE_TYPE && sub1TD->type == BYTE_TYPE && !narrowedToByte && TranslationUnit::instance().warnOnBinaryOpGivingByte())
             warnmsg("operator `%s' on two byte-sized arguments gives byte under CMOC, unlike under Standard C", getOperatorName(oper));
         break;
 
@@ -267,14 +269,18 @@ BinaryOpExpr::emitSubExpressions(ASMText &out, bool reverseOrder) const
     Tree *first  = (reverseOrder ? subExpr1 : subExpr0);
     Tree *second = (reverseOrder ? subExpr0 : subExpr1);
 
+    // When an addition or subtraction gives a byte, the high bytes
+    // of the operands are not used, so they need not be promoted.
+    bool promote = (getType() != BYTE_TYPE || (oper != ADD && oper != SUB));
+
     if (!first->emitCode(out, false))
         return false;
-    if (first->getType() == BYTE_TYPE)
+    if (promote && first->getType() == BYTE_TYPE)
         out.ins(first->getConvToWordIns(), "", "promotion of binary operand");
     out.ins("PSHS", "B,A");
     if (!second->emitCode(out, false))
         return false;
-    if (second->getType() == BYTE_TYPE)
+    if (promote && second->getType() == BYTE_TYPE)
         out.ins(second->getConvToWordIns(), "", "promotion of binary operand");
     return true;
 }
@@ -533,6 +539,16 @@ BinaryOpExpr::emitBitwiseOperation(ASMText &out, bool lValue, Op op) const
         }
     }
 
+    // Optimization for byte expression & CONST value.
+    //
+    if (getType() == BYTE_TYPE && subExpr1->evaluateConstantExpr(rightValue))
+    {
+        if (!subExpr0->emitCode(out, false))
+            return false;
+        out.ins(bInstr, "#" + wordToString(rightValue & 0xFF, true));
+        return true;
+    }
+
     // General case.
     //
     if (!emitSubExpressions(out, true))
@@ -627,6 +643,119 @@ getVariantName(const Tree &expr, bool includeSignednessOfLong)
 }
 
 
+// Designates the 4 bytes of an integral operand of a long operation, when
+// those bytes can be used directly as instruction arguments, i.e., when the
+// operand is a long variable, a constant, or an unsigned int variable.
+// This allows emitting the operation inline instead of calling a utility.
+//
+class DWordOperand
+{
+public:
+
+    DWordOperand() : variable(NULL), value(0), isZeroExtendedWord(false) {}
+
+    // Returns false if 'expr' is not one of the supported cases.
+    //
+    bool init(const Tree &expr)
+    {
+        if (!expr.isIntegral())
+            return false;
+        if (const DWordConstantExpr *dce = dynamic_cast<const DWordConstantExpr *>(&expr))
+        {
+            value = dce->getDWordValue();
+            return true;
+        }
+        uint16_t wordValue = 0;
+        if (!expr.isLong() && expr.evaluateConstantExpr(wordValue))
+        {
+            if (expr.getType() == BYTE_TYPE)
+            {
+                wordValue &= 0xFF;
+                if (expr.isSigned() && wordValue >= 0x80)
+                    wordValue |= 0xFF00;
+            }
+            value = wordValue;
+            if (expr.isSigned() && wordValue >= 0x8000)
+                value |= 0xFFFF0000UL;
+            return true;
+        }
+        const VariableExpr *ve = expr.asVariableExpr();
+        if (!ve || ve->isFuncAddrExpr())
+            return false;
+        if (expr.isLong())
+            variable = ve;
+        else if (expr.getType() == WORD_TYPE && !expr.isSigned())
+        {
+            variable = ve;
+            isZeroExtendedWord = true;
+        }
+        return variable != NULL;
+    }
+
+    bool isConstant() const { return variable == NULL; }
+
+    // offset: 0 for the high word, 2 for the low word.
+    //
+    uint16_t getConstantWord(int16_t offset) const
+    {
+        assert(isConstant());
+        return uint16_t(offset == 0 ? value >> 16 : value);
+    }
+
+    // offset: 0 for the high word, 2 for the low word.
+    //
+    string getWordArg(int16_t offset) const
+    {
+        if (isConstant())
+            return "#" + wordToString(getConstantWord(offset), true);
+        if (isZeroExtendedWord)
+            return offset == 0 ? "#0" : variable->getFrameDisplacementArg(0);
+        return variable->getFrameDisplacementArg(offset);
+    }
+
+    // offset: 0 for the highest byte, 3 for the lowest.
+    //
+    string getByteArg(int16_t offset) const
+    {
+        if (isConstant())
+            return "#" + wordToString(uint16_t((value >> (8 * (3 - offset))) & 0xFF), true);
+        if (isZeroExtendedWord)
+            return offset < 2 ? "#0" : variable->getFrameDisplacementArg(offset - 2);
+        return variable->getFrameDisplacementArg(offset);
+    }
+
+    bool isZeroWord(int16_t offset) const
+    {
+        return isConstant() ? getConstantWord(offset) == 0 : isZeroExtendedWord && offset == 0;
+    }
+
+    void emitLoadD(ASMText &out, int16_t offset, const string &comment) const
+    {
+        if (isZeroWord(offset))
+        {
+            out.ins("CLRA", "", comment);
+            out.ins("CLRB");
+        }
+        else
+            out.ins("LDD", getWordArg(offset), comment);
+    }
+
+    void emitCompareD(ASMText &out, int16_t offset) const
+    {
+        if (isConstant() || isZeroWord(offset))
+            out.emitCMPDImmediate(isConstant() ? getConstantWord(offset) : 0);
+        else
+            out.ins("CMPD", getWordArg(offset));
+    }
+
+private:
+
+    const VariableExpr *variable;  // null if constant
+    uint32_t value;  // used if constant
+    bool isZeroExtendedWord;  // true if 'variable' is an unsigned int
+};
+
+
 // Emits the expression, then (if pushRegister is true) pushes a register
 // and returns its name ('X', 'D', or '\0' for error).
 // If it is a real or long, its address is left in X ('X' is returned).
@@ -678,6 +807,29 @@ BinaryOpExpr::emitRealOrLongOp(ASMText &out, const char *opName, bool pushAddres
     assert(subExpr0->isNumerical());
     assert(subExpr1->isNumerical());
 
+    if (!pushAddressOfLeftOperand && isLong() && (strcmp(opName, "add") == 0 || strcmp(opName, "sub") == 0))
+    {
+        // Add or subtract inline if both operands are directly addressable.
+        DWordOperand left, right;
+        if (left.init(*subExpr0) && right.init(*subExpr1) && (resultDeclaration || subExpr0->isLong()))
+        {
+            bool doSub = (opName[0] == 's');
+            if (resultDeclaration)
+                out.ins("LEAX", resultDeclaration->getFrameDisplacementArg(0),
+                                "temporary destination, type " + resultDeclaration->getTypeDesc()->toString());
+            else if (!subExpr0->emitCode(out, true))  // get address of left side long in X
+                return false;
+            left.emitLoadD(out, 2, "low word of left operand of " + string(opName));
+            out.ins(doSub ? "SUBD" : "ADDD", right.getWordArg(2));
+            out.ins("STD", "2,X");
+            out.ins("LDD", left.getWordArg(0), "high word of left operand (preserves carry)");
+            out.ins(doSub ? "SBCB" : "ADCB", right.getByteArg(1));
+            out.ins(doSub ? "SBCA" : "ADCA", right.getByteArg(0));
+            out.ins("STD", ",X");
+            return true;
+        }
+    }
+
     if (pushAddressOfLeftOperand)
         out.ins("LEAS", "-2,S", "slot for pointer to left side");
 
@@ -831,6 +983,14 @@ BinaryOpExpr::emitAdd(ASMText &out, bool lValue, bool doSub) const
     if (ve0 && !ve0->isFuncAddrExpr() && isRightConst)
         return emitAddImmediateToVariable(out, ve0, (doSub ? -1 : +1) * rightValue);
 
+    if (getType() == BYTE_TYPE && isRightConst)
+    {
+        if (!subExpr0->emitCode(out, false))
+            return false;
+        out.ins(doSub ? "SUBB" : "ADDB", "#" + wordToString(rightValue & 0xFF, true));
+        return true;
+    }
+
     const Tree *arrayTree, *subscriptTree;
     if (isArrayRefAndLongSubscript(arrayTree, subscriptTree))
     {
@@ -1603,6 +1763,12 @@ BinaryOpExpr::emitLogicalAnd(ASMText &out, bool lValue) const
     if (lValue)
         return false;
 
+    // If an operand is itself a comparison or a logical operator, branch on the
+    // condition codes instead of materializing that operand's value only to test it.
+    //
+    if (isBooleanExpr(subExpr0) || isBooleanExpr(subExpr1))
+        return emitBoolValue(out, this);
+
     string endLabel = TranslationUnit::instance().generateLabel('L');
 
     if (subExpr0->isRealOrLong())
@@ -1654,6 +1820,9 @@ BinaryOpExpr::emitLogicalOr(ASMText &out, bool lValue) const
     if (lValue)
         return false;
 
+    if (isBooleanExpr(subExpr0) || isBooleanExpr(subExpr1))
+        return emitBoolValue(out, this);
+
     string trueLabel = TranslationUnit::instance().generateLabel('L');
     string endLabel  = TranslationUnit::instance().generateLabel('L');
 
@@ -1711,6 +1880,93 @@ BinaryOpExpr::emitLogicalOr(ASMText &out, bool lValue) const
 }
 
 
+// Returns the argument that designates the byte at 'offset' from X.
+//
+static string
+xOffsetArg(int16_t offset)
+{
+    return offset == 0 ? ",X" : wordToString(offset) + ",X";
+}
+
+
+// Shifts the long at X in place by 'numBits' (< 32), without calling a utility routine.
+// Whole bytes are moved first, then the remaining bits are shifted one at a time.
+// Preserves X.
+//
+static void
+emitConstantDWordShiftAtX(ASMText &out, bool isLeftShift, bool isSigned, uint16_t numBits)
+{
+    assert(numBits < 32);
+    int16_t numBytes = int16_t(numBits / 8);
+
+    if (numBytes > 0 && isLeftShift)
+    {
+        int16_t i = 0;
+        while (i + numBytes < 4)
+        {
+            if (i + numBytes + 1 < 4)
+            {
+                out.ins("LDD", xOffsetArg(i + numBytes), "shift long left by " + wordToString(numBits) + " bits");
+                out.ins("STD", xOffsetArg(i));
+                i += 2;
+            }
+            else
+            {
+                out.ins("LDB", xOffsetArg(i + numBytes));
+                out.ins("STB", xOffsetArg(i));
+                ++i;
+            }
+        }
+        for ( ; i < 4; ++i)
+            out.ins("CLR", xOffsetArg(i));
+    }
+    else if (numBytes > 0)
+    {
+        int16_t i = 3;
+        while (i - numBytes >= 0)
+        {
+            if (i - numBytes - 1 >= 0)
+            {
+                out.ins("LDD", xOffsetArg(i - numBytes - 1), "shift long right by " + wordToString(numBits) + " bits");
+                out.ins("STD", xOffsetArg(i - 1));
+                i -= 2;
+            }
+            else
+            {
+                out.ins("LDB", xOffsetArg(i - numBytes));
+                out.ins("STB", xOffsetArg(i));
+                --i;
+            }
+        }
+        if (isSigned)
+        {
+            out.ins("LDB", xOffsetArg(numBytes), "former high byte");
+            out.ins("SEX", "", "sign extension in A");
+        }
+        for ( ; i >= 0; --i)
+            out.ins(isSigned ? "STA" : "CLR", xOffsetArg(i));
+    }
+
+    for (uint16_t n = numBits % 8; n > 0; --n)
+    {
+        if (isLeftShift)
+        {
+            out.ins("LSL", "3,X");
+            out.ins("ROL", "2,X");
+            out.ins("ROL", "1,X");
+            out.ins("ROL", ",X");
+        }
+        else
+        {
+            out.ins(isSigned ? "ASR" : "LSR", ",X");
+            out.ins("ROR", "1,X");
+            out.ins("ROR", "2,X");
+            out.ins("ROR", "3,X");
+        }
+    }
+}
+
+
 // changeLeftSide: If true, the left side gets the result of the shift AND
 //                 the address of the left side is left in X.
 //                 If false, only an r-value is computed (and left in D or B).
@@ -1726,70 +1982,23 @@ BinaryOpExpr::emitShift(ASMText &out, bool isLeftShift, bool changeLeftSide, boo
         assert(subExpr0->isLong());
         assert(subExpr0->isSigned() == isSigned());
 
-        // Special case: Shifting unsigned long in place by 8, 16 or 24 bits.
-        if (!resultDeclaration && !subExpr0->isSigned() && constShift && (numBits == 8 || numBits == 16 || numBits == 24))
+        // Shift by a constant number of bits: done inline with byte moves and
+        // at most 3 single-bit shifts, i.e., no larger than the utility call.
+        if (constShift && numBits < 32 && numBits % 8 <= 3)
         {
             if (!subExpr0->emitCode(out, true))  // get address of left side long in X
                 return false;
-            if (isLeftShift)
-            {
-                switch (numBits)
-                {
-                case 8:
-                    out.ins("LDD", "1,X", "load middle word of unsigned long");
-                    out.ins("STD", ",X", "store in high word of unsigned long");
-                    out.ins("LDB", "3,X", "load low byte of unsigned long");
-                    out.ins("STB", "2,X", "store in 2nd lowest byte of unsigned long");
-                    out.ins("CLR", "3,X", "clear low byte");
-                    break;
-                case 16:
-                    out.ins("LDD", "2,X", "load low word of unsigned long");
-                    out.ins("STD", ",X", "store in high word of unsigned long");
-                    out.ins("CLR", "2,X", "clear 2nd lowest byte");
-                    out.ins("CLR", "3,X", "clear low byte");
-                    break;
-                case 24:
-                    out.ins("LDB", "3,X", "load low byte of unsigned long");
-                    out.ins("STB", ",X", "store in high byte of unsigned long");
-                    out.ins("CLR", "1,X", "clear 2nd higest byte");
-                    out.ins("CLR", "2,X", "clear 2nd lowest byte");
-                    out.ins("CLR", "3,X", "clear low byte");
-                    break;
-                default:
-                    assert(false);
-                    return false;
-                }
-            }
-            else
+            if (resultDeclaration)  // if result goes into temporary (otherwise, it goes to left side)
             {
-                switch (numBits)
-                {
-                case 8:
-                    out.ins("LDD", "1,X", "load middle word of unsigned long");
-                    out.ins("STD", "2,X", "store in low word of unsigned long");
-                    out.ins("LDB", ",X", "load high byte of unsigned long");
-                    out.ins("STB", "1,X", "store in 2nd highest byte of unsigned long");
-                    out.ins("CLR", ",X", "clear high byte");
-                    break;
-                case 16:
-                    out.ins("LDD", ",X", "load high word of unsigned long");
-                    out.ins("STD", "2,X", "store in low word of unsigned long");
-                    out.ins("CLR", ",X", "clear highest byte");
-                    out.ins("CLR", "1,X", "clear 2nd higest byte");
-                    break;
-                case 24:
-                    out.ins("LDB", ",X", "load high byte of unsigned long");
-                    out.ins("STB", "3,X", "store in low byte of unsigned long");
-                    out.ins("CLR", ",X", "clear highest byte");
-                    out.ins("CLR", "1,X", "clear 2nd higest byte");
-                    out.ins("CLR", "2,X", "clear 2nd lowest byte");
-                    break;
-                default:
-                    assert(false);
-                    return false;
-                }
+                out.ins("LDD", ",X", "copy long to be shifted");
+                out.ins("STD", resultDeclaration->getFrameDisplacementArg(0));
+                out.ins("LDD", "2,X");
+                out.ins("STD", resultDeclaration->getFrameDisplacementArg(2));
+                out.ins("LEAX", resultDeclaration->getFrameDisplacementArg(0),
+                            "temporary destination, type " + resultDeclaration->getTypeDesc()->toString());
             }
-            return true;  // leave with address of unsigned long in X, since we are emitting an l-value
+            emitConstantDWordShiftAtX(out, isLeftShift, isSigned(), numBits);
+            return true;  // leave with address of result in X, since we are emitting an l-value
         }
 
         // Evaluate the number of bits to shift by.
@@ -2242,6 +2451,33 @@ BinaryOpExpr::emitAssignment(ASMText &out, bool lValue, Op op) const
 
         int16_t structSizeInBytes = TranslationUnit::instance().getTypeSize(*getTypeDesc());
 
+        // Copy a small struct with LDD/STD instructions, with the source address in Y.
+        // Not under OS-9, where Y points to the global data.
+        //
+        if (structSizeInBytes <= MAX_INLINE_COPY_SIZE && TranslationUnit::instance().getTargetPlatform() != OS9)
+        {
+            // If the left side is a variable (n = ...) or a dereference of a pointer variable (*ptr = ...),
+            // computing its address does not trash Y. Otherwise, it may involve a function call,
+            // so present the source struct address in the stack.
+            //
+            const VariableExpr *destVarExpr = subExpr0->asVariableExpr();
+            const UnaryOpExpr *unaryOpExpr = dynamic_cast<const UnaryOpExpr *>(subExpr0);
+            bool pullY = !(destVarExpr
+                           || (unaryOpExpr
+                               && unaryOpExpr->getOperator() == UnaryOpExpr::INDIRECTION
+                               && unaryOpExpr->getSubExpr()->asVariableExpr() != NULL));
+            if (pullY)
+                out.ins("PSHS", "X", "source struct");
+            else
+                out.ins("TFR", "X,Y", "source struct");
+            if (!subExpr0->emitCode(out, true))  // get address of left-side struct in X
+                return false;
+            if (pullY)
+                out.ins("PULS", "Y", "source struct");
+            emitInlineCopyFromYToX(out, structSizeInBytes);
+            return true;
+        }
+
         if (structSizeInBytes == 4)
         {
             // Optimize for the 4-byte case, which is useful for longs, by calling copyDWord instead of memcpy().
@@ -3093,9 +3329,71 @@ BinaryOpExpr::emitArrayRef(ASMText &out, bool lValue) const
 }
 
 
+// Emits a comparison of two longs with branches to successLabel or failureLabel,
+// comparing the high words, then the low words if the high words are equal.
+// Only done when both operands are directly addressable (see DWordOperand), which
+// makes the code no slower and about as short as a call to cmpDWordDWord.
+// Returns false, without emitting any code, when this is not possible.
+//
+bool
+BinaryOpExpr::emitInlineDWordComparisonJumps(ASMText &out,
+                                             const string &successLabel,
+                                             const string &failureLabel) const
+{
+    if (!subExpr0->isLong() && !subExpr1->isLong())
+        return false;
+    DWordOperand left, right;
+    if (!left.init(*subExpr0) || !right.init(*subExpr1))
+        return false;
+
+    bool signedBranch = isSignedComparison();
+    bool isEqualityTest = (oper == EQUALITY || oper == INEQUALITY);
+
+    left.emitLoadD(out, 0, "high word of left long of " + string(getOperatorToken(oper)));
+    if (!isEqualityTest || !right.isZeroWord(0))  // LDD already sets Z
+        right.emitCompareD(out, 0);
+
+    const char *lowWordBranch = NULL;
+    switch (oper)
+    {
+    case EQUALITY:
+        out.ins("LBNE", failureLabel);
+        lowWordBranch = "LBEQ";
+        break;
+    case INEQUALITY:
+        out.ins("LBNE", successLabel);
+        lowWordBranch = "LBNE";
+        break;
+    case INFERIOR:
+    case INFERIOR_OR_EQUAL:
+        out.ins(signedBranch ? "LBLT" : "LBLO", successLabel);
+        out.ins("LBNE", failureLabel);
+        lowWordBranch = (oper == INFERIOR ? "LBLO" : "LBLS");
+        break;
+    case SUPERIOR:
+    case SUPERIOR_OR_EQUAL:
+        out.ins(signedBranch ? "LBGT" : "LBHI", successLabel);
+        out.ins("LBNE", failureLabel);
+        lowWordBranch = (oper == SUPERIOR ? "LBHI" : "LBHS");
+        break;
+    default:
+        assert(false);
+        return false;
+    }
+
+    // Low words are compared as unsigned.
+    left.emitLoadD(out, 2, "low word of left long");
+    if (!isEqualityTest || !right.isZeroWord(2))
+        right.emitCompareD(out, 2);
+    out.ins(lowWordBranch, successLabel);
+    out.ins("LBRA", failureLabel);
+    return true;
+}
+
+
 CodeStatus
 BinaryOpExpr::emitBoolJumps(ASMText &out,
-                            Tree *condition,
+                            const Tree *condition,
                             const std::string &successLabel,
                             const std::string &failureLabel)
 {
@@ -3104,7 +3402,7 @@ BinaryOpExpr::emitBoolJumps(ASMText &out,
     // If the condition is the boolean negation of something,
     // then evaluate that thing directly and reverse the target labels.
     //
-    UnaryOpExpr *ue = dynamic_cast<UnaryOpExpr *>(condition);
+    const UnaryOpExpr *ue = dynamic_cast<const UnaryOpExpr *>(condition);
     if (ue && ue->getOperator() == UnaryOpExpr::BOOLEAN_NEG)
         return emitBoolJumps(out, ue->getSubExpr(), failureLabel, successLabel);
 
@@ -3133,7 +3431,23 @@ BinaryOpExpr::emitBoolJumps(ASMText &out,
         }
         else if (be->isRelationalOperator())
         {
-            if ((be->getOperator() == EQUALITY || be->getOperator() == INEQUALITY) && be->subExpr1->isExpressionAlwaysFalse())
+            if ((binop == EQUALITY || binop == INEQUALITY)
+                    && be->subExpr1->isExpressionAlwaysFalse()
+                    && isBooleanExpr(be->subExpr0))
+            {
+                // We have "if ({condition} == 0)" or "if ({condition} != 0)",
+                // where {condition} is already a boolean expression:
+                // branch on {condition} directly instead of materializing it.
+                //
+                if (binop == EQUALITY)
+                    return emitBoolJumps(out, be->subExpr0, failureLabel, successLabel);
+                return emitBoolJumps(out, be->subExpr0, successLabel, failureLabel);
+            }
+
+            if (be->emitInlineDWordComparisonJumps(out, successLabel, failureLabel))
+                return true;
+
+            if ((binop == EQUALITY || binop == INEQUALITY) && be->subExpr1->isExpressionAlwaysFalse())
             {
                 // We have "if ({something} == 0)" or "if ({something} != 0)".
                 // Simplify to "if (!{something})" or "if ({something})" respectively.
@@ -3215,6 +3529,37 @@ BinaryOpExpr::emitBoolJumps(ASMText &out,
 }
 
 
+bool
+BinaryOpExpr::isBooleanExpr(const Tree *tree)
+{
+    if (const BinaryOpExpr *be = dynamic_cast<const BinaryOpExpr *>(tree))
+        return be->isRelationalOperator() || be->oper == LOGICAL_AND || be->oper == LOGICAL_OR;
+    if (const UnaryOpExpr *ue = dynamic_cast<const UnaryOpExpr *>(tree))
+        return ue->getOperator() == UnaryOpExpr::BOOLEAN_NEG;
+    return false;
+}
+
+
+CodeStatus
+BinaryOpExpr::emitBoolValue(ASMText &out, const Tree *condition)
+{
+    TranslationUnit &tu = TranslationUnit::instance();
+    string trueLabel  = tu.generateLabel('L');
+    string falseLabel = tu.generateLabel('L');
+    string endLabel   = tu.generateLabel('L');
+
+    if (!emitBoolJumps(out, condition, trueLabel, falseLabel))
+        return false;
+    out.emitLabel(trueLabel);
+    out.ins("LDB", "#1", "condition at " + condition->getLineNo() + " is true");
+    out.ins("BRA", endLabel);
+    out.emitLabel(falseLabel);
+    out.ins("CLRB", "", "condition is false");
+    out.emitLabel(endLabel);
+    return true;
+}
+
+
 bool
 BinaryOpExpr::isRelationalOperator() const
 {
@@ -3274,3 +3619,114 @@ BinaryOpExpr::replaceChild(Tree *existingChild, Tree *newChild)
     assert(!"child not found");
 }
 
+
+void
+BinaryOpExpr::castOperand(bool rightSide, const TypeDesc *td)
+{
+    Tree *&operand = (rightSide ? subExpr1 : subExpr0);
+    CastExpr *castExpr = new CastExpr(td, operand);
+    castExpr->copyLineNo(*operand);
+    operand = castExpr;
+}
+
+
+void
+BinaryOpExpr::narrowToByte(const TypeDesc *byteTD)
+{
+    assert(byteTD->type == BYTE_TYPE);
+    setTypeDesc(byteTD);
+    narrowedToByte = true;
+}
+
+
+
+/*static*/
+Tree *
+BinaryOpExpr::foldLongOrRealConstants(Op op, const Tree *left, const Tree *right)
+{
+    const RealConstantExpr *leftReal  = dynamic_cast<const RealConstantExpr *>(left);
+    const RealConstantExpr *rightReal = dynamic_cast<const RealConstantExpr *>(right);
+    int64_t leftInt = 0, rightInt = 0;
+    if (!leftReal && !left->evaluateIntegerLiteral(leftInt))
+        return NULL;
+    if (!rightReal && !right->evaluateIntegerLiteral(rightInt))
+        return NULL;
+
+    if (leftReal || rightReal)
+    {
+        // Use the operands and the result that the program would have at run time.
+        double a = (leftReal  ? RealConstantExpr::toTargetPrecision(leftReal->getRealValue(), false)
+                              : RealConstantExpr::toTargetPrecision(double(leftInt), true));
+        double b = (rightReal ? RealConstantExpr::toTargetPrecision(rightReal->getRealValue(), false)
+                              : RealConstantExpr::toTargetPrecision(double(rightInt), true));
+        double result = 0;
+        switch (op)
+        {
+        case ADD: result = a + b; break;
+        case SUB: result = a - b; break;
+        case MUL: result = a * b; break;
+        case DIV:
+            if (b == 0)
+                return NULL;  // leave it to run time
+            result = a / b;
+            break;
+        default:
+            return NULL;
+        }
+        return new RealConstantExpr(RealConstantExpr::toTargetPrecision(result, true), "");
+    }
+
+    if (!left->isLong() && !right->isLong())
+        return NULL;  // 16-bit case: see evaluateConstantExpr()
+
+    // Determine the signedness of the result as in setTypeForRealOrLongOperands()
+    // and in the bitwise operator case of ExpressionTypeSetter::processBinOp().
+    //
+    bool resultIsSigned = false;
+    if (op == BITWISE_AND || op == BITWISE_OR || op == BITWISE_XOR || !right->isLong())
+        resultIsSigned = (left->isLong() ? left : right)->isSigned();
+    else if (!left->isLong())
+        resultIsSigned = right->isSigned();
+    else
+        resultIsSigned = left->isSigned() && right->isSigned();
+
+    uint32_t a = uint32_t(leftInt), b = uint32_t(rightInt);
+    uint32_t result = 0;
+    switch (op)
+    {
+    case ADD: result = a + b; break;
+    case SUB: result = a - b; break;
+    case MUL: result = a * b; break;
+    case DIV:
+    case MOD:
+        if (b == 0)
+            return NULL;  // leave it to run time
+        if (resultIsSigned)
+        {
+            int64_t sa = int32_t(a), sb = int32_t(b);
+            result = uint32_t(op == DIV ? sa / sb : sa % sb);
+        }
+        else
+            result = (op == DIV ? a / b : a % b);
+        break;
+    case BITWISE_AND: result = a & b; break;
+    case BITWISE_OR:  result = a | b; break;
+    case BITWISE_XOR: result = a ^ b; break;
+    case LEFT_SHIFT:
+    case RIGHT_SHIFT:
+        if (!left->isLong() || rightInt < 0 || rightInt >= 32)
+            return NULL;
+        resultIsSigned = left->isSigned();
+        if (op == LEFT_SHIFT)
+            result = a << b;
+        else if (resultIsSigned && (a & 0x80000000UL))
+            result = ~(~a >> b);  // sign extension
+        else
+            result = a >> b;
+        break;
+    default:
+        return NULL;
+    }
+
+    return new DWordConstantExpr(resultIsSigned ? double(int32_t(result)) : double(result), resultIsSigned);
+}
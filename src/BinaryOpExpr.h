@@ -70,16 +70,52 @@ public:
                                 const std::string &condBranchInstr) const;
 
     static CodeStatus emitBoolJumps(ASMText &out,
-                                    Tree *condition,
+                                    const Tree *condition,
                                     const std::string &successLabel,
                                     const std::string &failureLabel);
 
+    // Indicates if 'tree' is an expression whose value is always 0 or 1,
+    // i.e., a relational operator, && or || or a boolean negation.
+    // Such an expression can be evaluated with emitBoolJumps() instead of
+    // being materialized in B and then tested.
+    //
+    static bool isBooleanExpr(const Tree *tree);
+
+    // Emits code that leaves 1 in B if 'condition' is true, 0 otherwise.
+    // The condition is evaluated with emitBoolJumps(), so no intermediate
+    // boolean value is materialized for its sub-expressions.
+    //
+    static CodeStatus emitBoolValue(ASMText &out, const Tree *condition);
+
     static const char *getOperatorToken(Op op);
 
+    // Returns a new constant expression that has the value of 'left' 'op' 'right',
+    // if both operands are literals and at least one of them is a long or a real.
+    // Returns NULL otherwise, including if the operation must be left to run time
+    // (e.g., division by zero). The operands are not modified.
+    // Called by the parser, so that such expressions do not cost a call
+    // to a long or real utility routine at run time.
+    // A real result is rounded to the precision of the target platform
+    // (see RealConstantExpr::toTargetPrecision()), so that a chain of
+    // operations gives the value that it would give at run time.
+    //
+    static Tree *foldLongOrRealConstants(Op op, const Tree *left, const Tree *right);
+
     virtual bool iterate(Functor &f);
 
     virtual void replaceChild(Tree *existingChild, Tree *newChild);
 
+    // Replaces the left (or right) operand with a cast of that operand to 'td'.
+    //
+    void castOperand(bool rightSide, const TypeDesc *td);
+
+    // Gives this integral operation the byte type 'byteTD', so that it is
+    // computed with 8-bit instructions. Called by the ExpressionTypeSetter
+    // when only the low byte of the result is used, in which case the result
+    // is the same as under Standard C, so -Wgives-byte does not apply.
+    //
+    void narrowToByte(const TypeDesc *byteTD);
+
     virtual bool isLValue() const { return oper == ASSIGNMENT || oper == INC_ASSIGN || oper == DEC_ASSIGN
                                         || oper == MUL_ASSIGN || oper == DIV_ASSIGN || oper == MOD_ASSIGN
                                         || oper == XOR_ASSIGN || oper == AND_ASSIGN || oper == OR_ASSIGN
@@ -94,6 +130,9 @@ private:
                                                 bool lValue,
                                                 std::string &assignedValueArg) const;
     CodeStatus emitRealOrLongComparison(ASMText &out) const;
+    bool emitInlineDWordComparisonJumps(ASMText &out,
+                                        const std::string &successLabel,
+                                        const std::string &failureLabel) const;
     CodeStatus emitNullPointerComparison(ASMText &out, const Tree &ptrExpr, bool invertRelationalOperator) const;
     bool isSignedComparison() const;
 
@@ -108,6 +147,7 @@ private:
     Tree *subExpr1;  // owns the Tree object
     int16_t numBytesPerElement;
     class Declaration *resultDeclaration;  // used when result is real number
+    bool narrowedToByte;  // see narrowToByte()
 
 private:
 
@@ -23,6 +23,8 @@
 #include "VariableExpr.h"
 #include "Declaration.h"
 #include "WordConstantExpr.h"
+#include "DWordConstantExpr.h"
+#include "RealConstantExpr.h"
 #include "VariableExpr.h"
 #include "IdentifierExpr.h"
 
@@ -165,6 +167,17 @@ CastExpr::emitCode(ASMText &out, bool lValue) const
         return true;
     }
 
+    // Casting a word constant to a byte: only load the low byte.
+    uint16_t value = 0;
+    if (!lValue && castTD->type == BYTE_TYPE && subTD->type == WORD_TYPE && subExpr->evaluateConstantExpr(value))
+    {
+        if ((value & 0xFF) == 0)
+            out.ins("CLRB", "", "cast to " + castTD->toString());
+        else
+            out.ins("LDB", "#" + wordToString(value & 0xFF, true), "cast to " + castTD->toString());
+        return true;
+    }
+
     if (!subExpr->emitCode(out, lValue))
         return false;
 
@@ -203,3 +216,38 @@ CastExpr::iterate(Functor &f)
         return false;
     return true;
 }
+
+
+/*static*/
+Tree *
+CastExpr::foldLongOrRealConstant(const TypeDesc *td, const Tree *subExpr)
+{
+    const RealConstantExpr *rce = dynamic_cast<const RealConstantExpr *>(subExpr);
+    int64_t intValue = 0;
+    if (!rce && !subExpr->evaluateIntegerLiteral(intValue))
+        return NULL;
+    if (!rce && !subExpr->isLong() && !td->isRealOrLong())
+        return NULL;  // 16-bit case: see evaluateConstantExpr()
+
+    if (td->isReal())
+        return new RealConstantExpr(rce ? rce->getRealValue() : RealConstantExpr::toTargetPrecision(double(intValue), true), "");
+    if (!td->isLong() && td->type != WORD_TYPE && td->type != BYTE_TYPE)
+        return NULL;
+
+    if (rce)
+    {
+        double realValue = RealConstantExpr::toTargetPrecision(rce->getRealValue(), false);
+        if (realValue <= -2147483649.0 || realValue >= 4294967296.0)
+            return NULL;  // out of range: leave it to run time
+        intValue = int64_t(realValue);  // truncates toward zero, as in C
+    }
+
+    uint32_t dw = uint32_t(intValue);
+    if (td->isLong())
+        return new DWordConstantExpr(td->isSigned ? double(int32_t(dw)) : double(dw), td->isSigned);
+
+    bool isWord = (td->type == WORD_TYPE);
+    uint16_t w = uint16_t(isWord ? dw & 0xFFFF : dw & 0xFF);
+    double wordValue = (!td->isSigned ? double(w) : isWord ? double(int16_t(w)) : double(int8_t(w)));
+    return new WordConstantExpr(wordValue, isWord, td->isSigned);
+}
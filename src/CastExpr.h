@@ -54,6 +54,13 @@ public:
 
     static bool isZeroCastToVoidPointer(const Tree &tree);
 
+    // Returns a new constant expression that has the value of 'subExpr' converted
+    // to type 'td', if 'subExpr' is a literal and the conversion is from or to
+    // a long or a real. Returns NULL otherwise. 'subExpr' is not modified.
+    // Called by the parser. See BinaryOpExpr::foldLongOrRealConstants().
+    //
+    static Tree *foldLongOrRealConstant(const TypeDesc *td, const Tree *subExpr);
+
 private:
 
     // Forbidden:
@@ -31,6 +31,7 @@ public:
     CompoundStmt()
     :   TreeSequence()
     {
+        setNodeKind(COMPOUND_STMT_NODE);
     }
 };
 
@@ -20,6 +20,7 @@
 #include "ConditionalExpr.h"
 
 #include "TranslationUnit.h"
+#include "BinaryOpExpr.h"
 
 using namespace std;
 
@@ -67,16 +68,25 @@ ConditionalExpr::emitCode(ASMText &out, bool lValue) const
             << " " << trueExpr->getType()
             << " " << falseExpr->getType()
             << endl;*/
-    if (!condition->emitCode(out, false))  // condition is r-value
-        return false;
+    uint16_t value = 0;
+    if (condition->evaluateConstantExpr(value))  // if condition is constant, only emit selected expression
+    {
+        const Tree *selectedExpr = (value != 0 ? trueExpr : falseExpr);
+        if (!selectedExpr->emitCode(out, lValue))
+            return false;
+        promoteIfNeeded(out, *selectedExpr, *(value != 0 ? falseExpr : trueExpr));
+        return true;
+    }
 
+    // Branch directly on the condition codes set by the condition,
+    // instead of materializing the condition in B and testing it.
+    //
+    string trueLabel  = TranslationUnit::genLabel('L');
     string falseLabel = TranslationUnit::genLabel('L');
-    if (condition->getType() == BYTE_TYPE)
-        out.ins("TSTB");
-    else
-        out.emitCMPDImmediate(0);
-    out.ins("LBEQ", falseLabel, "if conditional expression is false");
-    
+    if (!BinaryOpExpr::emitBoolJumps(out, condition, trueLabel, falseLabel))
+        return false;
+
+    out.emitLabel(trueLabel, "conditional expression is true");
     if (!trueExpr->emitCode(out, lValue))
         return false;
 
@@ -24,6 +24,7 @@
 #include "StringLiteralExpr.h"
 #include "ClassDef.h"
 #include "TreeSequence.h"
+#include "PackedInitializer.h"
 #include "ExpressionTypeSetter.h"
 #include "VariableExpr.h"
 #include "ScopeCreator.h"
@@ -55,6 +56,8 @@ Declaration::Declaration(const string &id, const TypeDesc *td,
     needsFinish(false),
     arraySizeExprList()
 {
+    setNodeKind(DECLARATION_NODE);
+
     if (isExtern)
         setLabelFromVariableId();
 }
@@ -76,6 +79,8 @@ Declaration::Declaration(const string &id, const TypeDesc *varTypeDesc,
     needsFinish(true),
     arraySizeExprList(_arraySizeExprList)
 {
+    setNodeKind(DECLARATION_NODE);
+
     if (isExtern)
         setLabelFromVariableId();
 }
@@ -266,6 +271,9 @@ Declaration::isArrayWithOnlyNumericalLiteralInitValues() const
     if (dynamic_cast<const StringLiteralExpr *>(initializationExpr))
         return true;  // passes for an array of byte integers
 
+    if (dynamic_cast<const PackedInitializer *>(initializationExpr))
+        return true;
+
     const TreeSequence *seq = dynamic_cast<TreeSequence *>(initializationExpr);
     if (seq == NULL)
         return false;  // not supposed to happen
@@ -316,6 +324,9 @@ Declaration::isTreeSequenceWithOnlyNumericalLiterals(const TreeSequence *seq)
             continue;
         }
 
+        if (dynamic_cast<const PackedInitializer *>(tree))
+            continue;  // only contains integer literals
+
         if (!tree->isNumericalLiteral())
             return false;
     }
@@ -324,6 +335,48 @@ Declaration::isTreeSequenceWithOnlyNumericalLiterals(const TreeSequence *seq)
 }
 
 
+bool
+Declaration::isByteOrWordArray(const TypeDesc *typeDesc)
+{
+    if (typeDesc == NULL || typeDesc->type != ARRAY_TYPE)
+        return false;
+    BasicType elementType = typeDesc->getPointedType();
+    return elementType == BYTE_TYPE || elementType == WORD_TYPE;
+}
+
+
+// Replaces each PackedInitializer in 'initializer' with an equivalent TreeSequence,
+// except those that initialize a byte or word array, if keepByteAndWordArrays is true.
+// requiredTypeDesc: Type of what 'initializer' initializes. Allowed to be null.
+//
+void
+Declaration::unpackInitializer(Tree *&initializer, const TypeDesc *requiredTypeDesc, bool keepByteAndWordArrays)
+{
+    if (PackedInitializer *packed = dynamic_cast<PackedInitializer *>(initializer))
+    {
+        if (keepByteAndWordArrays && isByteOrWordArray(requiredTypeDesc))
+            return;
+        initializer = packed->unpack();
+        delete packed;
+        return;
+    }
+
+    TreeSequence *seq = dynamic_cast<TreeSequence *>(initializer);
+    if (seq == NULL)
+        return;
+
+    // Only follow the array types. Struct members are unpacked.
+    //
+    const TypeDesc *elementTypeDesc = NULL;
+    if (requiredTypeDesc != NULL && requiredTypeDesc->type == ARRAY_TYPE)
+        elementTypeDesc = requiredTypeDesc->getPointedTypeDesc();
+
+    for (vector<Tree *>::iterator it = seq->begin(); it != seq->end(); ++it)
+        if (*it != NULL)
+            unpackInitializer(*it, elementTypeDesc, keepByteAndWordArrays && elementTypeDesc != NULL);
+}
+
+
 void
 Declaration::setLabel(const string &_label)
 {
@@ -360,6 +413,13 @@ Declaration::emitStaticArrayInitializer(ASMText &out)
         return true;
     }
 
+    if (const PackedInitializer *packed = dynamic_cast<PackedInitializer *>(initializationExpr))
+    {
+        out.emitLabel(label, getVariableId() + ": " + getTypeDesc()->toString());
+        emitPackedInitializer(out, *packed, getTypeDesc());
+        return true;
+    }
+
     const TreeSequence *seq = dynamic_cast<TreeSequence *>(initializationExpr);
     if (seq == NULL)
         return false;
@@ -377,6 +437,24 @@ Declaration::emitStaticArrayInitializer(ASMText &out)
 }
 
 
+// Emits the values of 'packed' as an array of type 'arrayTypeDesc',
+// 16 bytes per FCB directive, like the initializer images.
+//
+void
+Declaration::emitPackedInitializer(ASMText &out, const PackedInitializer &packed, const TypeDesc *arrayTypeDesc) const
+{
+    vector<uint8_t> image;
+    image.reserve(packed.size() * 2);
+    packed.appendImage(image, *arrayTypeDesc->getPointedTypeDesc(), this);
+
+    for (size_t start = 0; start < image.size(); start += 16)
+    {
+        vector<uint8_t> line(image.begin() + start, image.begin() + min(start + 16, image.size()));
+        DWordConstantExpr::emitDWordConstantDefinition(out, line);
+    }
+}
+
+
 // Emits FCB and FDB directives.
 // The initializer value will be in the representation specified by 'requiredTypeDesc'.
 // Supports longs and reals.
@@ -384,6 +462,13 @@ Declaration::emitStaticArrayInitializer(ASMText &out)
 CodeStatus
 Declaration::emitStaticValues(ASMText &out, Tree *arrayElementInitializer, const TypeDesc *requiredTypeDesc)
 {
+    if (const PackedInitializer *packed = dynamic_cast<const PackedInitializer *>(arrayElementInitializer))
+    {
+        assert(isByteOrWordArray(requiredTypeDesc));  // see unpackInitializer()
+        emitPackedInitializer(out, *packed, requiredTypeDesc);
+        return true;
+    }
+
     // Try to evaluate arrayElementInitializer as a constant (short int) expression.
     //
     uint16_t initValue = 0;
@@ -649,9 +734,12 @@ Declaration::emitArrayAddress(ASMText &out, const IdentifierExpr &ie, const Type
 // numArrayElements: Only used if 'requiredTypeDesc' is of ARRAY_TYPE.
 // writingOffset: In/out counter that gets advanced by the number of data bytes
 //                affected by the emitted code.
+// skipImageLeaves: If true, no code is emitted for the values accepted by
+//                  getInitializerImageLeaf(), because the variable has already
+//                  been initialized from an image built by buildInitializerImage().
 //
 CodeStatus
-Declaration::emitSequenceInitCode(ASMText &out, const Tree *initializer, const TypeDesc *requiredTypeDesc, int16_t numArrayElements, uint16_t& writingOffset) const
+Declaration::emitSequenceInitCode(ASMText &out, const Tree *initializer, const TypeDesc *requiredTypeDesc, int16_t numArrayElements, uint16_t& writingOffset, bool skipImageLeaves) const
 {
     assert(requiredTypeDesc->isValid());
 
@@ -677,7 +765,7 @@ Declaration::emitSequenceInitCode(ASMText &out, const Tree *initializer, const T
                 comment << "Element " << size_t(it - seq->begin()) << " of compound initializer: member '"
                         << member->getName() << "' of type " << member->getTypeDesc()->toString();
                 out.emitComment(comment.str());
-                if (!emitSequenceInitCode(out, *it, member->getTypeDesc(), member->getNumArrayElements(), writingOffset))
+                if (!emitSequenceInitCode(out, *it, member->getTypeDesc(), member->getNumArrayElements(), writingOffset, skipImageLeaves))
                     return false;
             }
             return true;
@@ -691,7 +779,7 @@ Declaration::emitSequenceInitCode(ASMText &out, const Tree *initializer, const T
                 comment << "Element " << size_t(it - seq->begin()) << " of array (element type is " << *arrayElemTypeDesc << ")";
                 out.emitComment(comment.str());
 
-                if (!emitSequenceInitCode(out, *it, arrayElemTypeDesc, int16_t(arrayElemTypeDesc->getNumArrayElements()), writingOffset))
+                if (!emitSequenceInitCode(out, *it, arrayElemTypeDesc, int16_t(arrayElemTypeDesc->getNumArrayElements()), writingOffset, skipImageLeaves))
                     return false;
             }
             return true;
@@ -701,6 +789,36 @@ Declaration::emitSequenceInitCode(ASMText &out, const Tree *initializer, const T
         return false;
     }
 
+    if (const PackedInitializer *packed = dynamic_cast<const PackedInitializer *>(initializer))
+    {
+        assert(isByteOrWordArray(requiredTypeDesc));  // see unpackInitializer()
+        const TypeDesc *arrayElemTypeDesc = requiredTypeDesc->getPointedTypeDesc();
+        if (skipImageLeaves)  // all elements are literals, already copied from the image
+        {
+            writingOffset += uint16_t(packed->size() * TranslationUnit::instance().getTypeSize(*arrayElemTypeDesc));
+            return true;
+        }
+        for (size_t i = 0; i < packed->size(); ++i)
+        {
+            Tree *element = packed->createElement(i);
+            bool success = emitSequenceInitCode(out, element, arrayElemTypeDesc, 0, writingOffset, false);
+            delete element;
+            if (!success)
+                return false;
+        }
+        return true;
+    }
+
+    if (skipImageLeaves)
+    {
+        vector<uint8_t> bytes;
+        if (getInitializerImageLeaf(initializer, requiredTypeDesc, bytes))
+        {
+            writingOffset += uint16_t(bytes.size());  // value already copied from the image
+            return true;
+        }
+    }
+
     // Emit single r-value.
     //
     if (const StringLiteralExpr *sle = dynamic_cast<const StringLiteralExpr *>(initializer))
@@ -834,6 +952,131 @@ Declaration::emitSequenceInitCode(ASMText &out, const Tree *initializer, const T
 }
 
 
+// Determines if 'initializer' is a literal that can be part of the image
+// built by buildInitializerImage(). If it is, stores in 'bytes' the representation
+// of that literal in a field of type 'requiredTypeDesc', i.e., the bytes that
+// emitSequenceInitCode() would otherwise store with instructions.
+//
+bool
+Declaration::getInitializerImageLeaf(const Tree *initializer, const TypeDesc *requiredTypeDesc, vector<uint8_t> &bytes)
+{
+    bytes.clear();
+
+    if (const DWordConstantExpr *dwce = dynamic_cast<const DWordConstantExpr *>(initializer))
+    {
+        vector<uint8_t> rep = dwce->getRepresentation();
+        if (requiredTypeDesc->isLong())
+            bytes = rep;
+        else if (requiredTypeDesc->type == WORD_TYPE)
+            bytes.assign(rep.begin() + 2, rep.end());
+        else if (requiredTypeDesc->type == BYTE_TYPE)
+            bytes.push_back(rep[3]);
+        return !bytes.empty();
+    }
+
+    if (const RealConstantExpr *rce = dynamic_cast<const RealConstantExpr *>(initializer))
+    {
+        if (requiredTypeDesc->isReal() && rce->isSingle() == requiredTypeDesc->isSingle())
+            bytes = rce->getRepresentation();
+        return !bytes.empty();
+    }
+
+    uint16_t value = 0;
+    if (initializer->isRealOrLong() || !initializer->evaluateConstantExpr(value))
+        return false;
+
+    if (initializer->getType() == BYTE_TYPE)  // same extension as SEX or CLRA
+        value = (initializer->isSigned() ? uint16_t(int8_t(value)) : (value & 0xFF));
+
+    if (requiredTypeDesc->type == BYTE_TYPE)
+        bytes.push_back(uint8_t(value));
+    else if (requiredTypeDesc->type == WORD_TYPE || requiredTypeDesc->type == POINTER_TYPE)
+    {
+        bytes.push_back(uint8_t(value >> 8));
+        bytes.push_back(uint8_t(value));
+    }
+    else if (requiredTypeDesc->isLong())
+    {
+        uint8_t highBytes = (initializer->isSigned() && (value & 0x8000) ? 0xFF : 0x00);
+        bytes.push_back(highBytes);
+        bytes.push_back(highBytes);
+        bytes.push_back(uint8_t(value >> 8));
+        bytes.push_back(uint8_t(value));
+    }
+    return !bytes.empty();
+}
+
+
+// Appends to 'image' the bytes that emitSequenceInitCode() would write
+// for 'initializer'. Literals accepted by getInitializerImageLeaf() are
+// represented by their value; any other value is represented by zeroes,
+// to be overwritten by code emitted by emitSequenceInitCode().
+// numStoreBytesReplaced: In/out estimate of the number of bytes of code
+//                        that the image makes unnecessary.
+// Returns false if the initializer is not supported.
+//
+bool
+Declaration::buildInitializerImage(const Tree *initializer, const TypeDesc *requiredTypeDesc, int16_t numArrayElements,
+                                   vector<uint8_t> &image, uint16_t &numStoreBytesReplaced) const
+{
+    TranslationUnit &tu = TranslationUnit::instance();
+
+    if (const TreeSequence *seq = dynamic_cast<const TreeSequence *>(initializer))
+    {
+        if (requiredTypeDesc->type == CLASS_TYPE)
+        {
+            const ClassDef *cl = tu.getClassDef(requiredTypeDesc->className);
+            assert(cl && cl->getType() == CLASS_TYPE);
+
+            size_t memberIndex = 0;
+            for (vector<Tree *>::const_iterator it = seq->begin(); it != seq->end(); ++it, ++memberIndex)
+            {
+                const ClassDef::ClassMember *member = cl->getDataMember(memberIndex);
+                if (member == NULL)
+                    break;
+                if (!buildInitializerImage(*it, member->getTypeDesc(), member->getNumArrayElements(), image, numStoreBytesReplaced))
+                    return false;
+            }
+            return true;
+        }
+        if (requiredTypeDesc->type == ARRAY_TYPE)
+        {
+            const TypeDesc *arrayElemTypeDesc = requiredTypeDesc->getPointedTypeDesc();
+            for (vector<Tree *>::const_iterator it = seq->begin(); it != seq->end(); ++it)
+                if (!buildInitializerImage(*it, arrayElemTypeDesc, int16_t(arrayElemTypeDesc->getNumArrayElements()), image, numStoreBytesReplaced))
+                    return false;
+            return true;
+        }
+        return false;
+    }
+
+    if (const PackedInitializer *packed = dynamic_cast<const PackedInitializer *>(initializer))
+    {
+        if (!isByteOrWordArray(requiredTypeDesc))
+            return false;
+        packed->appendImage(image, *requiredTypeDesc->getPointedTypeDesc(), NULL);
+        numStoreBytesReplaced += uint16_t(4 * packed->size());  // LDD #/STD per element
+        return true;
+    }
+
+    vector<uint8_t> bytes;
+    if (getInitializerImageLeaf(initializer, requiredTypeDesc, bytes))
+    {
+        image.insert(image.end(), bytes.begin(), bytes.end());
+        numStoreBytesReplaced += (bytes.size() <= 2 ? 4 : 10);  // LDD #/STD vs. LEAX/TFR/LEAX/LBSR
+        return true;
+    }
+
+    uint16_t numBytes = 0;
+    if (dynamic_cast<const StringLiteralExpr *>(initializer) && requiredTypeDesc->type == ARRAY_TYPE)
+        numBytes = numArrayElements * tu.getTypeSize(*requiredTypeDesc->pointedTypeDesc);
+    else
+        numBytes = tu.getTypeSize(*requiredTypeDesc);
+    image.insert(image.end(), numBytes, 0);
+    return true;
+}
+
+
 // Returns true iff tree if name[...][...][...]...
 //
 static bool
@@ -952,6 +1195,8 @@ isConstantInitializer(const Tree &initExpr)
                 return false;
         return true;
     }
+    if (dynamic_cast<const PackedInitializer *>(&initExpr))
+        return true;
     if (const BinaryOpExpr *bin = dynamic_cast<const BinaryOpExpr *>(&initExpr))
     {
         size_t numVariables = 0, numConstantExpressions = 0;
@@ -969,6 +1214,12 @@ Declaration::checkSemantics(Functor &f)
     //cout << "# Declaration::checkSemantics: " << getLineNo() << ": " << getVariableId() << ": "
     //     << getTypeDesc() << " '" << getTypeDesc()->toString() << "', extern=" << isExtern << ", const=" << isConst() << endl;
 
+    // Only the byte and word arrays of a global declaration are emitted from
+    // the compact form of their literal initializer lists.
+    //
+    if (initializationExpr != NULL)
+        unpackInitializer(initializationExpr, getTypeDesc(), global);
+
     // If this declaration is global, use a ScopeCreator to register it in the
     // global space and to set the declaration of each variable expression in
     // any initialization expression.
@@ -1156,26 +1407,42 @@ Declaration::checkArrayInitializer(Tree *initializationExpr, const TypeDesc *var
     assert(!variableId.empty());
 
     TreeSequence *seq = dynamic_cast<TreeSequence *>(initializationExpr);
-    if (seq != NULL)
+    const PackedInitializer *packed = dynamic_cast<const PackedInitializer *>(initializationExpr);
+    if (seq != NULL || packed != NULL)
     {
+        size_t numInitializers = (seq != NULL ? seq->size() : packed->size());
+
         // Check that initializationExpr is not too long. Warn if too short.
         //
         assert(dimIndex < arrayDimensions.size());
         uint16_t numArrayElements = arrayDimensions[dimIndex];
-        if (seq->size() > size_t(numArrayElements))
+        if (numInitializers > size_t(numArrayElements))
         {
             initializationExpr->errormsg("too many elements (%u) in initializer for array of %hu element(s)",
-                                        seq->size(), numArrayElements);
+                                        numInitializers, numArrayElements);
             return;
         }
-        if (seq->size() < size_t(numArrayElements))
+        if (numInitializers < size_t(numArrayElements))
         {
             initializationExpr->warnmsg("only %u element(s) in initializer for array of %hu element(s)",
-                                        seq->size(), numArrayElements);
+                                        numInitializers, numArrayElements);
         }
 
-        for (vector<Tree *>::const_iterator it = seq->begin(); it != seq->end(); ++it)
-            checkInitExpr(*it, varTypeDesc->pointedTypeDesc, variableId, arrayDimensions, dimIndex + 1);
+        if (seq != NULL)
+            for (vector<Tree *>::const_iterator it = seq->begin(); it != seq->end(); ++it)
+                checkInitExpr(*it, varTypeDesc->pointedTypeDesc, variableId, arrayDimensions, dimIndex + 1);
+        else
+        {
+            // Check each element of the PackedInitializer as a separate literal,
+            // to get the same warnings, e.g., about a value that does not fit in a byte.
+            //
+            for (size_t i = 0; i < numInitializers; ++i)
+            {
+                Tree *element = packed->createElement(i);
+                checkInitExpr(element, varTypeDesc->pointedTypeDesc, variableId, arrayDimensions, dimIndex + 1);
+                delete element;
+            }
+        }
     }
     else  // initializer is not a sequence:
     {
@@ -1301,9 +1568,30 @@ Declaration::emitCode(ASMText &out, bool /*lValue*/) const
             out.ins("CLR", getFrameDisplacementArg(), "variable " + variableId);
         else if (const TreeSequence *seq = dynamic_cast<const TreeSequence *>(initializationExpr))  // if init from { ... }
         {
-            uint16_t writingOffset = 0;
             uint16_t numArrayElements = (arrayDimensions.size() > 0 ? arrayDimensions.front() : 1);
-            if (!emitSequenceInitCode(out, seq, declTD, numArrayElements, writingOffset))
+
+            // If the literals in the initializer would take more code to store
+            // than to copy from a constant image, copy that image to the variable,
+            // then only emit code for the non-literal values.
+            //
+            vector<uint8_t> image;
+            uint16_t numStoreBytesReplaced = 0;
+            bool useImage = buildInitializerImage(seq, declTD, int16_t(numArrayElements), image, numStoreBytesReplaced)
+                            && image.size() > MAX_INLINE_COPY_SIZE
+                            && numStoreBytesReplaced > image.size() + 16;  // 16: bytes taken by copy sequence below
+            if (useImage)
+            {
+                string imageLabel = TranslationUnit::instance().registerInitializerImage(image);
+                out.ins("LEAX", imageLabel + ",PCR", "initial value of " + variableId);
+                out.ins("PSHS", "X", "source");
+                out.ins("LDD", "#" + wordToString(uint16_t(image.size())), "size of initial value");
+                out.ins("LEAX", getFrameDisplacementArg(), "variable " + variableId);
+                callUtility(out, "copyMem", "initialize " + variableId);
+                out.ins("LEAS", "2,S");
+            }
+
+            uint16_t writingOffset = 0;
+            if (!emitSequenceInitCode(out, seq, declTD, numArrayElements, writingOffset, useImage))
                 return false;
         }
         else if (getType() == ARRAY_TYPE && sle)  // if char[] init by string literal
@@ -1394,12 +1682,21 @@ Declaration::emitCode(ASMText &out, bool /*lValue*/) const
             }
             else if (getType() == CLASS_TYPE)  // init a struct from a struct
             {
-                out.ins("PSHS", "X", "source struct");
                 int16_t structSizeInBytes = TranslationUnit::instance().getTypeSize(*declTD);
-                out.ins("LDD", "#" + wordToString(structSizeInBytes), "size of struct " + declTD->className);
-                out.ins("LEAX", getFrameDisplacementArg(), "destination struct: " + variableId);
-                callUtility(out, "copyMem", "initialize struct");
-                out.ins("LEAS", "2,S");
+                if (structSizeInBytes <= MAX_INLINE_COPY_SIZE && TranslationUnit::instance().getTargetPlatform() != OS9)
+                {
+                    out.ins("TFR", "X,Y", "source struct");
+                    out.ins("LEAX", getFrameDisplacementArg(), "destination struct: " + variableId);
+                    emitInlineCopyFromYToX(out, structSizeInBytes);
+                }
+                else
+                {
+                    out.ins("PSHS", "X", "source struct");
+                    out.ins("LDD", "#" + wordToString(structSizeInBytes), "size of struct " + declTD->className);
+                    out.ins("LEAX", getFrameDisplacementArg(), "destination struct: " + variableId);
+                    callUtility(out, "copyMem", "initialize struct");
+                    out.ins("LEAS", "2,S");
+                }
             }
             else
             {
@@ -163,7 +163,13 @@ private:
     static void checkClassInitializer(Tree *initializationExpr, const TypeDesc *varTypeDesc, const std::string &variableId);
     static bool isRealOrLongInitWithNumber(const TypeDesc *varTypeDesc, const Tree &initializationExpr);
     static bool isTreeSequenceWithOnlyNumericalLiterals(const TreeSequence *seq);
-    CodeStatus emitSequenceInitCode(ASMText &out, const Tree *initializer, const TypeDesc *requiredTypeDesc, int16_t arraySizeInBytes, uint16_t& writingOffset) const;
+    static void unpackInitializer(Tree *&initializer, const TypeDesc *requiredTypeDesc, bool keepByteAndWordArrays);
+    static bool isByteOrWordArray(const TypeDesc *typeDesc);
+    void emitPackedInitializer(ASMText &out, const class PackedInitializer &packed, const TypeDesc *arrayTypeDesc) const;
+    CodeStatus emitSequenceInitCode(ASMText &out, const Tree *initializer, const TypeDesc *requiredTypeDesc, int16_t arraySizeInBytes, uint16_t& writingOffset, bool skipImageLeaves = false) const;
+    static bool getInitializerImageLeaf(const Tree *initializer, const TypeDesc *requiredTypeDesc, std::vector<uint8_t> &bytes);
+    bool buildInitializerImage(const Tree *initializer, const TypeDesc *requiredTypeDesc, int16_t numArrayElements,
+                               std::vector<uint8_t> &image, uint16_t &numStoreBytesReplaced) const;
     static bool emitArrayAddress(ASMText &out, const IdentifierExpr &ie, const TypeDesc &requiredTypeDesc);
 
 };
@@ -28,6 +28,8 @@ DeclarationSequence::DeclarationSequence(const TypeDesc *_typeDesc, std::vector<
 :   TreeSequence(),
     enumeratorList(_enumeratorList)
 {
+    setNodeKind(DECLARATION_SEQUENCE_NODE);
+
     assert(_typeDesc);
     assert(_typeDesc->isValid());
     setTypeDesc(_typeDesc);
@@ -22,6 +22,7 @@
 #include "Declaration.h"
 #include "TreeSequence.h"
 #include "StringLiteralExpr.h"
+#include "PackedInitializer.h"
 #include "ExpressionTypeSetter.h"
 #include "TranslationUnit.h"
 #include "FormalParameter.h"
@@ -208,6 +209,8 @@ Declarator::computeArrayDimensions(vector<uint16_t> &arrayDimensions,
             size_t len = 1;
             if (const TreeSequence *ts = dynamic_cast<const TreeSequence *>(initExpr))
                 len = ts->size();
+            else if (const PackedInitializer *pi = dynamic_cast<const PackedInitializer *>(initExpr))
+                len = pi->size();
             else if (const StringLiteralExpr *sle = dynamic_cast<const StringLiteralExpr *>(initExpr))
                 len = sle->getLiteral().length() + 1;  // include terminating '\0'
             else
@@ -70,7 +70,13 @@ ExpressionTypeSetter::close(Tree *t)
                          bin->getLeft()->getTypeDesc()->toString().c_str(),
                          bin->getRight()->getTypeDesc()->toString().c_str());
         }
-        return processBinOp(bin);
+        if (!processBinOp(bin))
+            return false;
+
+        // Done after processBinOp(), so that its diagnostics are based on the original types.
+        if (isLowByteOfWordUsed(bin))
+            narrowToByte(bin->getRight());
+        return true;
     }
 
     UnaryOpExpr *un = dynamic_cast<UnaryOpExpr *>(t);
@@ -92,6 +98,10 @@ ExpressionTypeSetter::close(Tree *t)
                          ce->getTypeDesc()->toString().c_str());
 
         assert(ce->getType() != ARRAY_TYPE);  // no syntax for this
+
+        // Casting a word expression to a byte: only its low byte is used.
+        if (ce->getType() == BYTE_TYPE && ce->getSubExpr()->getType() == WORD_TYPE && isNarrowableToByte(ce->getSubExpr()))
+            narrowToByte(ce->getSubExpr());
         return true;
     }
 
@@ -667,3 +677,121 @@ ExpressionTypeSetter::processUnaryOp(UnaryOpExpr *un)
             return true;
     }
 }
+
+
+// Indicates if the low byte of the value of 'tree' only depends on the low bytes
+// of its operands, so that it can be computed with 8-bit instructions when only
+// that low byte is used. This is the case of +, -, *, &, |, ^, unary - and ~,
+// but not of / or >> for example.
+//
+bool
+ExpressionTypeSetter::isNarrowableToByte(const Tree *tree)
+{
+    if (!tree->getTypeDesc()->isByteOrWord())
+        return false;
+
+    if (const BinaryOpExpr *bin = dynamic_cast<const BinaryOpExpr *>(tree))
+    {
+        const TypeDesc *leftTD  = bin->getLeft()->getTypeDesc();
+        const TypeDesc *rightTD = bin->getRight()->getTypeDesc();
+        uint16_t numBits = 0;
+        switch (bin->getOperator())
+        {
+        case BinaryOpExpr::ADD:
+        case BinaryOpExpr::SUB:
+        case BinaryOpExpr::MUL:
+        case BinaryOpExpr::BITWISE_AND:
+        case BinaryOpExpr::BITWISE_OR:
+        case BinaryOpExpr::BITWISE_XOR:
+            return leftTD->isByteOrWord() && rightTD->isByteOrWord();  // excludes pointer arithmetic
+        case BinaryOpExpr::LEFT_SHIFT:
+            return leftTD->isByteOrWord() && bin->getRight()->evaluateConstantExpr(numBits) && numBits < 8;
+        default:
+            return false;
+        }
+    }
+
+    if (const UnaryOpExpr *un = dynamic_cast<const UnaryOpExpr *>(tree))
+        return (un->getOperator() == UnaryOpExpr::NEG || un->getOperator() == UnaryOpExpr::BITWISE_NOT)
+               && un->getSubExpr()->getTypeDesc()->isByteOrWord();
+
+    if (const CastExpr *ce = dynamic_cast<const CastExpr *>(tree))
+        return ce->getSubExpr()->getTypeDesc()->isByteOrWord();
+
+    return false;
+}
+
+
+// Indicates if 'bin' stores a word expression into a byte, i.e., if only
+// the low byte of its right side is used.
+//
+bool
+ExpressionTypeSetter::isLowByteOfWordUsed(const BinaryOpExpr *bin)
+{
+    switch (bin->getOperator())
+    {
+    case BinaryOpExpr::ASSIGNMENT:
+    case BinaryOpExpr::INC_ASSIGN:
+    case BinaryOpExpr::DEC_ASSIGN:
+    case BinaryOpExpr::XOR_ASSIGN:
+    case BinaryOpExpr::AND_ASSIGN:
+    case BinaryOpExpr::OR_ASSIGN:
+        return bin->getLeft()->getType() == BYTE_TYPE
+               && bin->getRight()->getType() == WORD_TYPE
+               && isNarrowableToByte(bin->getRight());
+    default:
+        return false;
+    }
+}
+
+
+// Rewrites 'tree', which must satisfy isNarrowableToByte(), so that it computes
+// only the low byte of its value, with 8-bit operations. Operands that cannot
+// be narrowed themselves are cast to a byte, which only loads their low byte.
+//
+void
+ExpressionTypeSetter::narrowToByte(Tree *tree)
+{
+    TypeManager &tm = TranslationUnit::getTypeManager();
+    const TypeDesc *byteTD = tm.getIntType(BYTE_TYPE, tree->isSigned());
+
+    if (BinaryOpExpr *bin = dynamic_cast<BinaryOpExpr *>(tree))
+    {
+        for (int side = 0; side < 2; ++side)
+        {
+            if (side == 1 && bin->getOperator() == BinaryOpExpr::LEFT_SHIFT)
+                break;  // shift count is not narrowed
+            Tree *operand = (side == 0 ? bin->getLeft() : bin->getRight());
+            if (isNarrowableToByte(operand))
+                narrowToByte(operand);
+            else if (operand->getType() != BYTE_TYPE)
+                bin->castOperand(side == 1, tm.getIntType(BYTE_TYPE, operand->isSigned()));
+        }
+        if (bin->getType() != BYTE_TYPE)
+            bin->narrowToByte(byteTD);
+        return;
+    }
+
+    if (UnaryOpExpr *un = dynamic_cast<UnaryOpExpr *>(tree))
+    {
+        Tree *subExpr = un->getSubExpr();
+        if (isNarrowableToByte(subExpr))
+            narrowToByte(subExpr);
+        else if (subExpr->getType() != BYTE_TYPE)
+            un->castSubExpr(tm.getIntType(BYTE_TYPE, subExpr->isSigned()));
+        un->setTypeDesc(byteTD);
+        return;
+    }
+
+    if (CastExpr *ce = dynamic_cast<CastExpr *>(tree))
+    {
+        // Casting to a byte only keeps the low byte of the sub-expression,
+        // so no code is needed to narrow it further.
+        if (isNarrowableToByte(ce->getSubExpr()))
+            narrowToByte(ce->getSubExpr());
+        ce->setTypeDesc(byteTD);
+        return;
+    }
+
+    assert(!"unexpected tree in ExpressionTypeSetter::narrowToByte()");
+}
@@ -37,6 +37,9 @@ private:
     bool processBinOp(BinaryOpExpr *bin);
     bool checkForUnaryOnClass(const Tree &subExpr, UnaryOpExpr::Op op) const;
     bool processUnaryOp(UnaryOpExpr *un);
+    static bool isNarrowableToByte(const Tree *tree);
+    static bool isLowByteOfWordUsed(const BinaryOpExpr *bin);
+    static void narrowToByte(Tree *tree);
 };
 
 
@@ -35,6 +35,7 @@ ForStmt::ForStmt(Tree *initExprList, Tree *cond,
     increments(incrExprList),
     body(bodyStmt)
 {
+    setNodeKind(FOR_STMT_NODE);
 }
 
 
@@ -44,6 +44,8 @@ FunctionCallExpr::FunctionCallExpr(Tree *func, TreeSequence *args)
     arguments(args),
     returnValueDeclaration(NULL)
 {
+    setNodeKind(FUNCTION_CALL_EXPR_NODE);
+
     assert(function != NULL);
     assert(arguments != NULL);
 }
@@ -245,8 +247,7 @@ FunctionCallExpr::checkCallArguments(const string &functionId,
                                      Contraption &contraption,
                                      const TreeSequence &args) const
 {
-    extern int numErrors;
-    int initNumErrors = numErrors;
+    int initNumErrors = TranslationUnit::instance().getNumErrors();
 
     string temp = (functionId.empty() ? "call through function pointer" : "function " + functionId + "()");
 
@@ -355,7 +356,7 @@ FunctionCallExpr::checkCallArguments(const string &functionId,
     }
 
     // Check printf() arguments unless an error has already been reported about this function call.
-    if (numErrors == initNumErrors)
+    if (TranslationUnit::instance().getNumErrors() == initNumErrors)
     {
         if (functionId == "printf" || functionId == "sprintf")
             checkPrintfArguments(args, functionId);
@@ -547,7 +548,7 @@ FunctionCallExpr::checkSemantics(Functor &f)
     // If the return type is struct/union, declare a hidden struct/union in the current scope.
     // This object will receive the return value. Its address will be passed in the call.
     //
-    if (passesHiddenParam())
+    if (getType() == CLASS_TYPE)
         returnValueDeclaration = Declaration::declareHiddenVariableInCurrentScope(*this);
 }
 
@@ -555,14 +556,14 @@ FunctionCallExpr::checkSemantics(Functor &f)
 bool
 FunctionCallExpr::passesHiddenParam() const
 {
-    return getType() == CLASS_TYPE;
+    return getType() == CLASS_TYPE && !FunctionDef::isStructReturnedInRegister(*getTypeDesc());
 }
 
 
 bool
 FunctionCallExpr::isFunctionReceivingFirstParamInReg() const
 {
-    const FunctionDef *fd = TranslationUnit::instance().getFunctionDef(getIdentifier());
+    const FunctionDef *fd = (funcPtrVarDecl ? NULL : TranslationUnit::instance().getFunctionDef(getIdentifier()));
     if (fd)
         return fd->isFunctionReceivingFirstParamInReg();
     assert(function);
@@ -571,15 +572,50 @@ FunctionCallExpr::isFunctionReceivingFirstParamInReg() const
 }
 
 
+// Only true for direct calls to a function on which FunctionDef::receiveParamsInRegisters()
+// has chosen to pass the second argument in X.
+//
+bool
+FunctionCallExpr::isFunctionReceivingSecondParamInReg() const
+{
+    if (funcPtrVarDecl)
+        return false;
+    const FunctionDef *fd = TranslationUnit::instance().getFunctionDef(getIdentifier());
+    return fd && fd->isFunctionReceivingSecondParamInReg();
+}
+
+
+// Indicates if the argument expression can be loaded in D without using X,
+// e.g., a constant or a simple variable.
+//
+bool
+FunctionCallExpr::isArgLoadableWithoutX(const Tree &expr)
+{
+    if (expr.getType() != BYTE_TYPE && expr.getType() != WORD_TYPE && expr.getType() != POINTER_TYPE)
+        return false;
+    if (dynamic_cast<const WordConstantExpr *>(&expr))
+        return true;
+    const VariableExpr *ve = expr.asVariableExpr();
+    return ve && !ve->isFuncAddrExpr();
+}
+
+
 // Emits an instruction and increments numBytesPushed depending on whether the
-// argument must be passed in a register (D) or pushed in the stack.
-// isArgInRegX: Only applies if passInReg is true.
+// argument must be passed in a register (D, or X if passInRegX is true) or pushed in the stack.
+// isArgInRegX: Only applies if passInReg or passInRegX is true.
 // pshsArg: Not used if passInReg is true.
 //
 bool
-FunctionCallExpr::emitPushSingleArg(ASMText &out, bool passInReg, bool isArgInRegX, uint16_t &numBytesPushed,
+FunctionCallExpr::emitPushSingleArg(ASMText &out, bool passInReg, bool passInRegX, bool isArgInRegX, uint16_t &numBytesPushed,
                                     const char *pshsArg, const string &pshsComment) const
 {
+    if (passInRegX)
+    {
+        if (!isArgInRegX)
+            out.ins("TFR", "D,X", "function receives argument 2 in X");
+        return true;
+    }
+
     if (!passInReg)
     {
         out.ins("PSHS", pshsArg, pshsComment);
@@ -613,6 +649,7 @@ FunctionCallExpr::emitArgumentPushCode(ASMText &out,
     const FunctionDef *fd = TranslationUnit::instance().getFunctionDef(getIdentifier());
     const FormalParamList *formalParams = (fd ? fd->getFormalParamList() : NULL);  // may be null
     const bool calledFunctionReceivesFirstVisibleParamInReg = (isFunctionReceivingFirstParamInReg() && !passesHiddenParam());
+    const bool calledFunctionReceivesSecondParamInReg = isFunctionReceivingSecondParamInReg();
     size_t index = arguments->size();
     for (vector<Tree *>::reverse_iterator it = arguments->rbegin();
                                          it != arguments->rend(); it++, index--)
@@ -635,6 +672,15 @@ FunctionCallExpr::emitArgumentPushCode(ASMText &out,
         }
 
         const bool passInReg = (calledFunctionReceivesFirstVisibleParamInReg && fpIndex == 0);
+        const bool passInRegX = (calledFunctionReceivesSecondParamInReg && fpIndex == 1);
+
+        // If the second argument has already been computed in X, preserve it
+        // while the first argument is computed, unless that does not use X.
+        //
+        const bool preserveX = (passInReg && calledFunctionReceivesSecondParamInReg
+                                && arguments->size() >= 2 && !isArgLoadableWithoutX(*expr));
+        if (preserveX)
+            out.ins("PSHS", "X", "preserve argument 2 of " + functionId + "()");
 
         // Emit code depending on the argument type.
 
@@ -644,12 +690,12 @@ FunctionCallExpr::emitArgumentPushCode(ASMText &out,
         if (const StringLiteralExpr *sle = dynamic_cast<const StringLiteralExpr *>(expr))
         {
             out.ins("LEAX", sle->getArg(), sle->getEscapedVersion());
-            emitPushSingleArg(out, passInReg, true, numBytesPushed, "X", comment);
+            emitPushSingleArg(out, passInReg, passInRegX, true, numBytesPushed, "X", comment);
         }
         else if (ve && ve->getType() == ARRAY_TYPE)  // if argument is an array
         {
             out.ins("LEAX", ve->getFrameDisplacementArg(), "address of array " + ve->getId());
-            emitPushSingleArg(out, passInReg, true, numBytesPushed, "X", comment);
+            emitPushSingleArg(out, passInReg, passInRegX, true, numBytesPushed, "X", comment);
         }
         else if (unary && unary->getOperator() == UnaryOpExpr::ADDRESS_OF)
         {
@@ -663,11 +709,12 @@ FunctionCallExpr::emitArgumentPushCode(ASMText &out,
             }
             else if (!subExpr->emitCode(out, true))  // emit l-value, to get address in X and avoid TFR X,D
                 return false;
-            emitPushSingleArg(out, passInReg, true, numBytesPushed, "X", comment);
+            emitPushSingleArg(out, passInReg, passInRegX, true, numBytesPushed, "X", comment);
         }
         else if (expr->getType() == CLASS_TYPE)  // if passing a struct by value
         {
-            assert(!passInReg);
+            assert(!passInReg || (param && param->isIntegral() && !param->isLong()));
+            assert(!passInRegX || (param && param->isIntegral() && !param->isLong()));
 
             // Emit the struct expression as an l-value, i.e., compute its address in X.
             if (!expr->emitCode(out, true))
@@ -701,6 +748,14 @@ FunctionCallExpr::emitArgumentPushCode(ASMText &out,
                     out.ins(param->isSigned() ? "SEX" : "CLRA", "", "promoting byte argument to word");
                     out.ins("STA", ",S", "MSB of argument");
                 }
+
+                if (passInReg || passInRegX)
+                {
+                    out.ins("PULS", passInRegX ? "X" : "B,A", "function receives argument "
+                                                             + wordToString(uint16_t(index))
+                                                             + " in " + (passInRegX ? "X" : "D"));
+                    numBytesPushed -= uint16_t(passedSize);
+                }
             }
             else if ((param && param->isLong() && expr->isReal())  // if passing real to long
                   || (param && param->isReal() && expr->isLong()))  // or passing long to real
@@ -739,7 +794,18 @@ FunctionCallExpr::emitArgumentPushCode(ASMText &out,
                 // which optimizes the case of Color Basic's 5-byte float.
                 //
                 uint16_t structSizeInBytes = uint16_t(expr->getTypeSize());
-                if (structSizeInBytes > 0)
+                if (structSizeInBytes > 0 && structSizeInBytes <= MAX_INLINE_COPY_SIZE)
+                {
+                    emitInlinePushFromX(out, int16_t(structSizeInBytes));
+                    if (structSizeInBytes == 1)
+                    {
+                        out.ins("LEAS", "-1,S", "1-byte argument always pushed as 2 bytes");
+                        ++numBytesPushed;
+                    }
+
+                    numBytesPushed += structSizeInBytes;
+                }
+                else if (structSizeInBytes > 0)
                 {
                     if (structSizeInBytes != 4 && structSizeInBytes != 5)
                         out.ins("LDD", "#" + wordToString(structSizeInBytes), "size of " + expr->getTypeDesc()->toString());
@@ -787,9 +853,12 @@ FunctionCallExpr::emitArgumentPushCode(ASMText &out,
             }
             else
             {
-                emitPushSingleArg(out, passInReg, false, numBytesPushed, "B,A", comment);
+                emitPushSingleArg(out, passInReg, passInRegX, false, numBytesPushed, "B,A", comment);
             }
         }
+
+        if (preserveX)
+            out.ins("PULS", "X", "argument 2 of " + functionId + "()");
     }
 
     return true;
@@ -926,6 +995,9 @@ FunctionCallExpr::emitCode(ASMText &out, bool lValue) const
     if (lValue)
     {
         assert(getType() == CLASS_TYPE);
+        if (!passesHiddenParam())  // if small struct/union returned in B or D
+            out.ins(getTypeSize() == 1 ? "STB" : "STD", returnValueDeclaration->getFrameDisplacementArg(0),
+                                "store struct/union returned by " + functionId + "()");
         out.ins("LEAX", returnValueDeclaration->getFrameDisplacementArg(0),
                                 "address of struct/union returned by " + functionId + "()");
     }
@@ -53,6 +53,10 @@ public:
     */
     std::string getIdentifier() const;
 
+    /** Returns the expression that designates the called function.
+    */
+    const Tree *getFunctionExpr() const { return function; }
+
     /** Call this with a non-null Declaration pointer when the function call
         uses a function pointer variable, or with NULL when the call is
         directly to a global function name.
@@ -90,13 +94,15 @@ private:
                             class Contraption &contraption,
                             const TreeSequence &args) const;
     void checkPrintfArguments(const TreeSequence &args, const std::string &functionId) const;
-    bool emitPushSingleArg(ASMText &out, bool passInReg, bool isArgInRegX, uint16_t &numBytesPushed,
+    bool emitPushSingleArg(ASMText &out, bool passInReg, bool passInRegX, bool isArgInRegX, uint16_t &numBytesPushed,
                            const char *pshsArg, const std::string &pshsComment) const;
     bool emitArgumentPushCode(ASMText &out,
                               const std::string &functionId,
                               uint16_t &numBytesPushed) const;
     bool passesHiddenParam() const;
     bool isFunctionReceivingFirstParamInReg() const;
+    bool isFunctionReceivingSecondParamInReg() const;
+    static bool isArgLoadableWithoutX(const Tree &expr);
 
     // Forbidden:
     FunctionCallExpr(const FunctionCallExpr &);
@@ -47,9 +47,6 @@
 using namespace std;
 
 
-uint16_t FunctionDef::functionStackSpace = 0;
-
-
 class Tracer : public Tree::Functor
 {
 public:
@@ -182,8 +179,11 @@ FunctionDef::FunctionDef(const DeclarationSpecifierList &dsl,
     asmOnly(dsl.isAssemblyOnly()),
     noReturnInstruction(dsl.hasNoReturnInstruction()),
     called(false),
-    firstParamReceivedInReg(dsl.isFunctionReceivingFirstParamInReg())
+    firstParamReceivedInReg(dsl.isFunctionReceivingFirstParamInReg()),
+    secondParamReceivedInReg(false)
 {
+    setNodeKind(FUNCTION_DEF_NODE);
+
     // The "interrupt" and "_CMOC_fpir_" flags only make sense on function types
     // and function pointer types.
     // Set the return type of the function so that this type does not contain those flags,
@@ -223,7 +223,18 @@ FunctionDef::~FunctionDef()
 bool
 FunctionDef::hasHiddenParam() const
 {
-    return getType() == CLASS_TYPE;
+    return getType() == CLASS_TYPE && !isStructReturnedInRegister(*getTypeDesc());
+}
+
+
+/*static*/
+bool
+FunctionDef::isStructReturnedInRegister(const TypeDesc &returnTypeDesc)
+{
+    if (returnTypeDesc.type != CLASS_TYPE || returnTypeDesc.isRealOrLong())
+        return false;
+    int16_t size = TranslationUnit::instance().getTypeSize(returnTypeDesc);
+    return size == 1 || size == 2;
 }
 
 
@@ -303,8 +314,10 @@ FunctionDef::declareFormalParams()
         formalParamDeclarations.push_back(decl);
 
         // This (visible) parameter is passed in a register if it is the first visible parameter,
-        // and the function receives no hidden parameter.
-        const bool formalParamIsLocalVar = (firstParamReceivedInReg && it == formalParamList->begin() && !hasHiddenParam());
+        // and the function receives no hidden parameter, or if it is the second one
+        // and receiveParamsInRegisters() has chosen to pass it in X.
+        const bool formalParamIsLocalVar = (firstParamReceivedInReg && it == formalParamList->begin() && !hasHiddenParam())
+                                        || (secondParamReceivedInReg && argIndex == 2);
         if (!formalParamIsLocalVar)
         {
             if (TranslationUnit::instance().getTypeSize(*fp->getTypeDesc()) == 1)  // if byte or 1-byte struct/union
@@ -604,7 +617,7 @@ FunctionDef::emitCode(ASMText &out, bool lValue) const
     // Generate code that sets up the function's stack frame:
     
     out.emitSeparatorComment();
-    out.emitFunctionStart(functionId, getLineNo());
+    out.emitFunctionStart(functionId, getLineNo(), getProfileKey());
     out.emitLabel(functionLabel);
 
     // A stack frame is only needed if the function:
@@ -622,14 +635,15 @@ FunctionDef::emitCode(ASMText &out, bool lValue) const
         out.ins("PSHS", "U");
 
     // Function-entry stack check, if enabled. This is the point where it is done under OS-9.
-    if (!asmOnly && getFunctionStackSpace() > 0)
+    uint16_t functionStackSpace = TranslationUnit::instance().getFunctionStackSpace();
+    if (!asmOnly && functionStackSpace > 0)
     {
         // Call a utility routine that receives it argument as a word that follows the call.
         // This avoids trashing a register.
         // The routine (see crt.asm) knows about the argument and adjusts the stacked return address accordingly.
         //
         callUtility(out, "_stkcheck");
-        out.ins("FDB", "-" + wordToString(getFunctionStackSpace() - minDisplacement), "argument for _stkcheck");
+        out.ins("FDB", "-" + wordToString(functionStackSpace - minDisplacement), "argument for _stkcheck");
     }
 
     if (needStackFrame)
@@ -665,6 +679,22 @@ FunctionDef::emitCode(ASMText &out, bool lValue) const
         }
     }
 
+    if (secondParamReceivedInReg)
+    {
+        assert(formalParamList && formalParamList->size() >= 2);
+        const FormalParameter *fp = dynamic_cast<FormalParameter *>(*(formalParamList->begin() + 1));
+        assert(fp != NULL);
+        const Declaration *decl = getScope()->getVariableDeclaration(fp->getId(), false);
+        assert(decl);
+        if (fp->getType() == BYTE_TYPE)
+        {
+            out.ins("TFR", "X,D", "byte parameter " + fp->getId() + " received in X");  // D already spilled
+            out.ins("STB", decl->getFrameDisplacementArg(0), "spill parameter " + fp->getId());
+        }
+        else
+            out.ins("STX", decl->getFrameDisplacementArg(0), "spill parameter " + fp->getId());
+    }
+
     // Issue comments indicating where the parameters and locals are allocated.
 
     vector<string> declarationIds;
@@ -686,8 +716,15 @@ FunctionDef::emitCode(ASMText &out, bool lValue) const
         }
     }
 
+    if (TranslationUnit::instance().isExecutionProfileUsed())
+    {
+        out.emitComment("Profile: " + dwordToString(TranslationUnit::instance().getExecutionCount(getProfileKey()))
+                        + " instructions executed" + (isHot() ? " (hot)" : isCold() ? " (cold)" : ""));
+    }
+
     // Generate code for the body:
 
+    TranslationUnit::instance().setCurrentFunction(this);
     TranslationUnit::instance().setCurrentFunctionEndLabel(endLabel);
     TranslationUnit::instance().pushScope(const_cast<Scope *>(getScope()));  // const_cast should be removed...
     bool success = bodyStmts->emitCode(out, false);
@@ -697,6 +734,7 @@ FunctionDef::emitCode(ASMText &out, bool lValue) const
     TranslationUnit::instance().popScope();
 
     TranslationUnit::instance().setCurrentFunctionEndLabel("");
+    TranslationUnit::instance().setCurrentFunction(NULL);
 
     if (needStackFrame)
     {
@@ -716,7 +754,7 @@ FunctionDef::emitCode(ASMText &out, bool lValue) const
             out.ins(isISR ? "RTI" : "RTS");
     }
 
-    out.emitFunctionEnd(functionId, getLineNo());
+    out.emitFunctionEnd(functionId, getLineNo(), getProfileKey());
 
     return success;
 }
@@ -788,6 +826,14 @@ FunctionDef::findAssemblyLabelFromIDLabeledStatement(const std::string &id) cons
 }
 
 
+uint16_t
+FunctionDef::getLocalVariableSpace() const
+{
+    assert(minDisplacement <= 0);  // allocateLocalVariables() must have been called
+    return uint16_t(-minDisplacement);
+}
+
+
 bool
 FunctionDef::isInterruptServiceRoutine() const
 {
@@ -802,6 +848,40 @@ FunctionDef::isFunctionReceivingFirstParamInReg() const
 }
 
 
+bool
+FunctionDef::isFunctionReceivingSecondParamInReg() const
+{
+    return secondParamReceivedInReg;
+}
+
+
+bool
+FunctionDef::isParamPassableInRegister(const Tree &param)
+{
+    const FormalParameter *fp = dynamic_cast<const FormalParameter *>(&param);
+    if (!fp || fp->getId().empty() || !fp->getArrayDimensions().empty())
+        return false;
+    BasicType t = fp->getType();
+    return t == BYTE_TYPE || t == WORD_TYPE || t == POINTER_TYPE;
+}
+
+
+void
+FunctionDef::receiveParamsInRegisters()
+{
+    if (!bodyStmts || !isStatic || isISR || asmOnly || firstParamReceivedInReg || hasHiddenParam())
+        return;
+    if (!formalParamList || formalParamList->endsWithEllipsis() || formalParamList->size() == 0)
+        return;
+    if (!isParamPassableInRegister(**formalParamList->begin()))
+        return;
+
+    firstParamReceivedInReg = true;
+    secondParamReceivedInReg = (formalParamList->size() >= 2
+                                && isParamPassableInRegister(**(formalParamList->begin() + 1)));
+}
+
+
 bool
 FunctionDef::isAssemblyOnly() const
 {
@@ -816,15 +896,36 @@ FunctionDef::hasInternalLinkage() const
 }
 
 
-uint16_t
-FunctionDef::getFunctionStackSpace()
+bool
+FunctionDef::isHot() const
 {
-    return functionStackSpace;
+    const TranslationUnit &tu = TranslationUnit::instance();
+    if (!tu.isExecutionProfileUsed())
+        return false;
+    uint32_t count = tu.getExecutionCount(getProfileKey());
+    return count > 0 && uint64_t(count) * 100 >= tu.getTotalExecutionCount();
 }
 
 
-void
-FunctionDef::setFunctionStackSpace(uint16_t numBytes)
+bool
+FunctionDef::isCold() const
 {
-    functionStackSpace = numBytes;
+    const TranslationUnit &tu = TranslationUnit::instance();
+    if (!tu.isExecutionProfileUsed())
+        return false;
+    string key = getProfileKey();
+    return tu.isInExecutionProfile(key) && tu.getExecutionCount(key) == 0;
+}
+
+
+string
+FunctionDef::getProfileKey() const
+{
+    if (!isStatic)
+        return functionId;
+    string key = TranslationUnit::instance().getModuleName();
+    for (string::iterator it = key.begin(); it != key.end(); ++it)
+        if (!isalnum((unsigned char) *it) && *it != '_')
+            *it = '_';
+    return key + "$" + functionId;
 }
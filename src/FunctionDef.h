@@ -80,6 +80,11 @@ public:
     //
     void allocateLocalVariables();
 
+    // Number of bytes reserved in the stack frame for the local variables.
+    // allocateLocalVariables() must have been called.
+    //
+    uint16_t getLocalVariableSpace() const;
+
     // declareFormalParams() and allocateLocalVariables() must have been called.
     //
     virtual CodeStatus emitCode(ASMText &out, bool lValue) const;
@@ -93,6 +98,20 @@ public:
 
     bool isFunctionReceivingFirstParamInReg() const;
 
+    // Only true if receiveParamsInRegisters() has been called with success.
+    //
+    bool isFunctionReceivingSecondParamInReg() const;
+
+    // Makes this function receive its first parameter in D and its second one
+    // in X, as far as their types allow it. Does nothing if this function is
+    // not a static definition that takes a fixed list of byte, word or pointer
+    // parameters.
+    // Must only be called on a function whose address is never taken,
+    // because a call through a pointer passes all arguments in the stack.
+    // Must be called before the SemanticsChecker pass.
+    //
+    void receiveParamsInRegisters();
+
     bool isAssemblyOnly() const;
 
     bool hasInternalLinkage() const;
@@ -116,12 +135,26 @@ public:
     //
     std::string getAddressOfReturnValue() const;
 
-    // Number of bytes that a function is expected to use in addition to its local variables.
-    // Useful when targeting OS-9.
+    // Indicates if a function whose return type is 'returnTypeDesc' returns
+    // a struct or union of 1 or 2 bytes in B or D, instead of receiving
+    // the address of the return value as a hidden parameter.
     //
-    static uint16_t getFunctionStackSpace();
+    static bool isStructReturnedInRegister(const TypeDesc &returnTypeDesc);
 
-    static void setFunctionStackSpace(uint16_t numBytes);
+    // Hot: at least 1% of the instructions executed by the profiled run
+    // were in this function. Cold: none were. Both false if no profile is used
+    // (see TranslationUnit::setExecutionProfile()) or if the profile does not
+    // cover the function.
+    //
+    bool isHot() const;
+    bool isCold() const;
+
+    // Name under which this function appears in an execution profile:
+    // the function identifier, prefixed with the module name and a '$'
+    // for a static function, so that the static functions of different
+    // modules do not get mixed up.
+    //
+    std::string getProfileKey() const;
 
 private:
     // Forbidden:
@@ -132,6 +165,7 @@ private:
 
     void declareFormalParams();
     bool hasHiddenParam() const;
+    static bool isParamPassableInRegister(const Tree &param);
 
 private:
 
@@ -150,8 +184,7 @@ private:
     bool noReturnInstruction;
     bool called;  // true means at least one call or address-of seen on this function
     bool firstParamReceivedInReg;
-
-    static uint16_t functionStackSpace;  // in bytes; 0 means no stack check
+    bool secondParamReceivedInReg;  // in X; only set by receiveParamsInRegisters()
 
 };
 
@@ -33,6 +33,7 @@ IdentifierExpr::IdentifierExpr(const char *id)
     variableExpr(NULL),
     functionNameStringLiteral(NULL)
 {
+    setNodeKind(IDENTIFIER_EXPR_NODE);
 }
 
 
@@ -215,6 +215,16 @@ JumpStmt::emitCode(ASMText &out, bool lValue) const
 
                         callUtility(out, "copySingle");
                     }
+                    else if (FunctionDef::isStructReturnedInRegister(*currentFunctionDef->getTypeDesc()))
+                    {
+                        writeLineNoComment(out, "return struct/union in register");
+
+                        // Emit the struct/union as an l-value, so we get its address in X.
+                        if (!argument->emitCode(out, true))
+                            return false;
+                        bool isByte = (tu.getTypeSize(*currentFunctionDef->getTypeDesc()) == 1);
+                        out.ins(isByte ? "LDB" : "LDD", ",X", "return " + currentFunctionDef->getTypeDesc()->toString() + " in " + (isByte ? "B" : "D"));
+                    }
                     else if (currentFunctionDef->getType() == CLASS_TYPE)  // if returning struct/union
                     {
                         writeLineNoComment(out, "return struct/union by value");
@@ -222,17 +232,27 @@ JumpStmt::emitCode(ASMText &out, bool lValue) const
                         // Emit the struct/union as an l-value, so we get its address in X.
                         if (!argument->emitCode(out, true))
                             return false;
-                        out.ins("PSHS", "X", "source struct/union");
-
-                        // Get the address where to write the struct/union.
-                        // It has been passed to the current function as a hidden 1st parameter.
-                        out.ins("LDX", currentFunctionDef->getAddressOfReturnValue(), "address of return value");
 
                         uint16_t objectSize = tu.getTypeSize(*currentFunctionDef->getTypeDesc());
-                        out.ins("LDD", "#" + wordToString(objectSize), "size of " + currentFunctionDef->getTypeDesc()->toString());
+                        if (objectSize <= MAX_INLINE_COPY_SIZE && tu.getTargetPlatform() != OS9)
+                        {
+                            out.ins("TFR", "X,Y", "source struct/union");
+                            out.ins("LDX", currentFunctionDef->getAddressOfReturnValue(), "address of return value");
+                            emitInlineCopyFromYToX(out, objectSize);
+                        }
+                        else
+                        {
+                            out.ins("PSHS", "X", "source struct/union");
 
-                        callUtility(out, "copyMem");
-                        out.ins("LEAS", "2,S", "discard copyMem argument");
+                            // Get the address where to write the struct/union.
+                            // It has been passed to the current function as a hidden 1st parameter.
+                            out.ins("LDX", currentFunctionDef->getAddressOfReturnValue(), "address of return value");
+
+                            out.ins("LDD", "#" + wordToString(objectSize), "size of " + currentFunctionDef->getTypeDesc()->toString());
+
+                            callUtility(out, "copyMem");
+                            out.ins("LEAS", "2,S", "discard copyMem argument");
+                        }
                     }
                     else  // returning type that fits in B or D:
                     {
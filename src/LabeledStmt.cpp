@@ -31,6 +31,7 @@ LabeledStmt::LabeledStmt(Tree *_caseExpr, Tree *_statement)
     expression(_caseExpr),
     statement(_statement)
 {
+    setNodeKind(LABELED_STMT_NODE);
 }
 
 
@@ -41,6 +42,7 @@ LabeledStmt::LabeledStmt(Tree *_defaultStatement)
     expression(NULL),
     statement(_defaultStatement)
 {
+    setNodeKind(LABELED_STMT_NODE);
 }
 
 
@@ -51,6 +53,7 @@ LabeledStmt::LabeledStmt(const char *_id, const string &_asmLabel, Tree *_statem
     expression(NULL),
     statement(_statement)
 {
+    setNodeKind(LABELED_STMT_NODE);
 }
 
 
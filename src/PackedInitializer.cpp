@@ -0,0 +1,219 @@
+/*  $Id$
+
+    CMOC - A C-like cross-compiler
+    Copyright (C) 2003-2015 Pierre Sarrazin <http://sarrazip.com/>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PackedInitializer.h"
+
+#include "TreeSequence.h"
+#include "WordConstantExpr.h"
+#include "UnaryOpExpr.h"
+
+#include <algorithm>
+#include <limits.h>
+
+using namespace std;
+
+
+PackedInitializer::PackedInitializer()
+  : Tree(),
+    values(),
+    elementFlags(),
+    lineRuns()
+{
+}
+
+
+/*virtual*/
+PackedInitializer::~PackedInitializer()
+{
+}
+
+
+// Returns the literal that 'tree' is, or the literal that 'tree' negates, if any.
+// The literal must have a valid 16-bit value, so that WordConstantExpr::checkSemantics()
+// has no error to report about it. A negated literal must be a signed word.
+//
+static const WordConstantExpr *
+getPackableLiteral(const Tree *tree, bool &isNegated)
+{
+    isNegated = false;
+    const WordConstantExpr *wce = dynamic_cast<const WordConstantExpr *>(tree);
+    if (wce == NULL)
+    {
+        const UnaryOpExpr *ue = dynamic_cast<const UnaryOpExpr *>(tree);
+        if (ue == NULL || ue->getOperator() != UnaryOpExpr::NEG)
+            return NULL;
+        wce = dynamic_cast<const WordConstantExpr *>(ue->getSubExpr());
+        if (wce == NULL || wce->getType() != WORD_TYPE || !wce->isSigned())
+            return NULL;
+        isNegated = true;
+    }
+    double value = wce->getRealValue();
+    if (value < -32768.0 || value > 65535.0)
+        return NULL;
+    return wce;
+}
+
+
+/*static*/
+Tree *
+PackedInitializer::pack(TreeSequence *seq)
+{
+    if (seq == NULL || seq->size() < MIN_NUM_ELEMENTS)
+        return seq;
+
+    bool isNegated;
+    for (vector<Tree *>::const_iterator it = seq->begin(); it != seq->end(); ++it)
+        if (getPackableLiteral(*it, isNegated) == NULL)
+            return seq;
+
+    PackedInitializer *packed = new PackedInitializer();
+    packed->copyLineNo(*seq);
+    packed->values.reserve(seq->size());
+    packed->elementFlags.reserve(seq->size());
+
+    for (vector<Tree *>::const_iterator it = seq->begin(); it != seq->end(); ++it)
+    {
+        bool appended = packed->appendLiteral(*it);
+        assert(appended);
+        (void) appended;
+    }
+
+    delete seq;
+    return packed;
+}
+
+
+/*static*/
+Tree *
+PackedInitializer::append(Tree *list, Tree *element)
+{
+    PackedInitializer *packed = dynamic_cast<PackedInitializer *>(list);
+    if (packed != NULL)
+    {
+        if (packed->appendLiteral(element))
+        {
+            delete element;
+            return packed;
+        }
+        TreeSequence *seq = packed->unpack();  // the list cannot stay packed
+        delete packed;
+        seq->addTree(element);
+        return seq;
+    }
+
+    TreeSequence *seq = dynamic_cast<TreeSequence *>(list);
+    assert(seq != NULL);
+    seq->addTree(element);
+    if (seq->size() == MIN_NUM_ELEMENTS)
+        return pack(seq);
+    return seq;
+}
+
+
+bool
+PackedInitializer::appendLiteral(const Tree *tree)
+{
+    bool isNegated;
+    const WordConstantExpr *wce = getPackableLiteral(tree, isNegated);
+    if (wce == NULL)
+        return false;
+
+    int lineNo = tree->getIntLineNo();
+    if (lineRuns.empty() || lineRuns.back().second != lineNo)
+        lineRuns.push_back(make_pair(values.size(), lineNo));
+
+    if (isNegated)
+    {
+        values.push_back(uint16_t(0) - wce->getWordValue());
+        elementFlags.push_back(WORD_ELEMENT | SIGNED_ELEMENT);
+    }
+    else
+    {
+        values.push_back(wce->getWordValue());
+        elementFlags.push_back((wce->getType() == WORD_TYPE ? WORD_ELEMENT : 0)
+                               | (wce->isSigned() ? SIGNED_ELEMENT : 0));
+    }
+    return true;
+}
+
+
+size_t
+PackedInitializer::size() const
+{
+    return values.size();
+}
+
+
+Tree *
+PackedInitializer::createElement(size_t index) const
+{
+    assert(index < values.size());
+    uint8_t flags = elementFlags[index];
+    double value = ((flags & SIGNED_ELEMENT) ? double(int16_t(values[index])) : double(values[index]));
+    Tree *element = new WordConstantExpr(value, (flags & WORD_ELEMENT) != 0, (flags & SIGNED_ELEMENT) != 0);
+    element->copyLineNo(*this);
+    vector<pair<size_t, int> >::const_iterator it = upper_bound(lineRuns.begin(), lineRuns.end(),
+                                                                 make_pair(index, INT_MAX));
+    if (it != lineRuns.begin())
+        element->setIntLineNo((it - 1)->second);
+    return element;
+}
+
+
+TreeSequence *
+PackedInitializer::unpack() const
+{
+    TreeSequence *seq = new TreeSequence();
+    seq->copyLineNo(*this);
+    for (size_t i = 0; i < values.size(); ++i)
+        seq->addTree(createElement(i));
+    return seq;
+}
+
+
+void
+PackedInitializer::appendImage(vector<uint8_t> &image, const TypeDesc &elementTypeDesc, const Tree *warningTree) const
+{
+    assert(elementTypeDesc.type == BYTE_TYPE || elementTypeDesc.type == WORD_TYPE);
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        uint16_t value = values[i];
+        uint8_t flags = elementFlags[i];
+
+        if (elementTypeDesc.type == BYTE_TYPE)
+        {
+            if (warningTree != NULL)
+            {
+                if (! elementTypeDesc.isSigned && value > 0xFF)
+                    warningTree->warnmsg("value %u (0x%x) does not fit in an unsigned character (value will be truncated)", value, value);
+                else if (elementTypeDesc.isSigned && (int16_t(value) < -128 || int16_t(value) > 127))
+                    warningTree->warnmsg("value %u (0x%x) does not fit in a signed character (value will be truncated)", value, value);
+            }
+            image.push_back(uint8_t(value));
+        }
+        else
+        {
+            if ((flags & (WORD_ELEMENT | SIGNED_ELEMENT)) == SIGNED_ELEMENT)  // signed byte: sign-extend
+                value = uint16_t(int8_t(value));
+            image.push_back(uint8_t(value >> 8));
+            image.push_back(uint8_t(value));
+        }
+    }
+}
@@ -0,0 +1,101 @@
+/*  $Id$
+
+    CMOC - A C-like cross-compiler
+    Copyright (C) 2003-2015 Pierre Sarrazin <http://sarrazip.com/>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _H_PackedInitializer
+#define _H_PackedInitializer
+
+#include "Tree.h"
+
+class TreeSequence;
+
+
+// Compact form of a { ... } initializer list whose elements are all integer
+// literals, e.g., a bitmap or a table of level data. An element takes 3 bytes
+// instead of a WordConstantExpr.
+//
+// Created by the parser (see append()). Declaration::checkSemantics() only keeps
+// this form for the byte or word arrays of a global declaration. It replaces
+// the other ones with an equivalent TreeSequence (see unpack()).
+//
+class PackedInitializer : public Tree
+{
+public:
+
+    // Shorter lists are left as TreeSequence objects.
+    //
+    enum { MIN_NUM_ELEMENTS = 16 };
+
+    // If 'seq' has at least MIN_NUM_ELEMENTS elements and they are all 16-bit
+    // integer literals (possibly negated), returns an equivalent PackedInitializer
+    // and destroys 'seq'. Returns 'seq' otherwise.
+    //
+    static Tree *pack(TreeSequence *seq);
+
+    // Adds 'element' at the end of 'list', which must be a TreeSequence or a
+    // PackedInitializer returned by this function, and returns the resulting list,
+    // destroying 'list' if it is replaced. Called by the parser for each element of
+    // a { ... } list, so that a list of literals is packed as soon as it is long
+    // enough, and each literal that follows is destroyed as soon as it is packed,
+    // which lets the next one reuse its memory (see TranslationUnit::TreeArena).
+    //
+    static Tree *append(Tree *list, Tree *element);
+
+    virtual ~PackedInitializer();
+
+    size_t size() const;
+
+    // Returns a new TreeSequence of WordConstantExpr objects equivalent to this list.
+    //
+    TreeSequence *unpack() const;
+
+    // Returns a new WordConstantExpr equivalent to the element at 'index',
+    // with the line number of the original element.
+    //
+    Tree *createElement(size_t index) const;
+
+    // Appends to 'image' the bytes of each element, converted to 'elementTypeDesc',
+    // which must be a byte or word type.
+    // warningTree: If not null, receives the same warnings as Declaration::emitStaticValues()
+    //              would issue for values that do not fit in a byte.
+    //
+    void appendImage(std::vector<uint8_t> &image, const TypeDesc &elementTypeDesc, const Tree *warningTree) const;
+
+    virtual bool isLValue() const { return false; }
+
+private:
+
+    PackedInitializer();
+
+    // Returns false, without modifying this list, if 'tree' is not a literal that can be packed.
+    bool appendLiteral(const Tree *tree);
+
+    enum { WORD_ELEMENT = 1, SIGNED_ELEMENT = 2 };
+
+    std::vector<uint16_t> values;  // as returned by WordConstantExpr::getWordValue()
+    std::vector<uint8_t> elementFlags;  // WORD_ELEMENT and/or SIGNED_ELEMENT, for each element of 'values'
+    std::vector<std::pair<size_t, int> > lineRuns;  // index of the first element of each source line, and that line number
+
+    // Forbidden:
+    PackedInitializer(const PackedInitializer &);
+    PackedInitializer &operator = (const PackedInitializer &);
+
+};
+
+
+#endif  /* _H_PackedInitializer */
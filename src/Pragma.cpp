@@ -22,6 +22,7 @@
 #include <stdlib.h>
 #include <stdlib.h>
 #include <errno.h>
+#include <unistd.h>
 
 using namespace std;
 
@@ -126,6 +127,73 @@ Pragma::isStackSpace(uint16_t &numBytes) const
 }
 
 
+// #pragma embed "filename" as symbol
+//
+bool
+Pragma::isEmbed(string &filename, string &symbol) const
+{
+    return parseEmbed(directive, filename, symbol);
+}
+
+
+/*static*/
+bool
+Pragma::parseEmbed(const string &directive, string &filename, string &symbol)
+{
+    if (strncmp(directive.c_str(), "embed", 5) != 0)
+        return false;
+
+    size_t i = 5, len = directive.length();
+    if (i == len || !isspace(directive[i]))
+        return false;
+    passSpaces(directive, i);
+    if (i == len || directive[i] != '"')
+        return false;
+    size_t closingQuote = directive.find('"', i + 1);
+    if (closingQuote == string::npos || closingQuote == i + 1)
+        return false;
+    string fn(directive, i + 1, closingQuote - i - 1);
+
+    i = closingQuote + 1;
+    passSpaces(directive, i);
+    if (directive.compare(i, 2, "as") != 0 || i + 2 == len || !isspace(directive[i + 2]))
+        return false;
+    i += 2;
+    passSpaces(directive, i);
+
+    size_t symbolStart = i;
+    if (i == len || !(isalpha(directive[i]) || directive[i] == '_'))
+        return false;
+    for ( ; i < len && (isalnum(directive[i]) || directive[i] == '_'); ++i)
+        ;
+    string sym(directive, symbolStart, i - symbolStart);
+    passSpaces(directive, i);
+    if (i != len)
+        return false;
+
+    filename = fn;
+    symbol = sym;
+    return true;
+}
+
+
+/*static*/
+string
+Pragma::getEmbeddedFilePath(const string &filename, const string &sourceFilename)
+{
+    if (filename[0] == '/')
+        return filename;
+    string::size_type slash = sourceFilename.rfind('/');
+    if (slash == string::npos)
+        return filename;
+    string path(sourceFilename, 0, slash + 1);
+    path += filename;
+    if (access(path.c_str(), F_OK) != 0)
+        return filename;
+    return path;
+}
+
+
 string
 Pragma::getDirective() const
 {
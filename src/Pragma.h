@@ -53,6 +53,21 @@ public:
     //
     bool isStackSpace(uint16_t &numBytes) const;
 
+    // If this pragma is 'embed "filename" as symbol', then stores the filename
+    // and the symbol, and returns true. Returns false otherwise.
+    //
+    bool isEmbed(std::string &filename, std::string &symbol) const;
+
+    // Same as isEmbed(), but on the text that follows "#pragma".
+    //
+    static bool parseEmbed(const std::string &directive, std::string &filename, std::string &symbol);
+
+    // Returns the path of the file named by an embed pragma that appears in
+    // 'sourceFilename'. A relative path is taken as relative to the directory
+    // of 'sourceFilename', unless no such file exists there.
+    //
+    static std::string getEmbeddedFilePath(const std::string &filename, const std::string &sourceFilename);
+
     std::string getDirective() const;
 
     // Vectrex directives:
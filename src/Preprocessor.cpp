@@ -0,0 +1,2269 @@
+/*  $Id$
+
+    CMOC - A C-like cross-compiler
+    Copyright (C) 2003-2015 Pierre Sarrazin <http://sarrazip.com/>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Preprocessor.h"
+
+#include "util.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+
+// Maximum number of nested #include directives, as with GNU cpp.
+//
+static const size_t MAX_INCLUDE_DEPTH = 200;
+
+
+Preprocessor::Token::Token(Kind _kind, const string &_text, int _line, int _column)
+  : kind(_kind),
+    text(_text),
+    line(_line),
+    column(_column),
+    atLineStart(false),
+    precededBySpace(false),
+    fromMacro(false),
+    hasPaddingSource(false),
+    hideSet(NULL)
+{
+}
+
+
+bool
+Preprocessor::Macro::isSameDefinition(const Macro &m) const
+{
+    if (isFunctionLike != m.isFunctionLike || isVariadic != m.isVariadic
+            || params != m.params || body.size() != m.body.size())
+        return false;
+    for (size_t i = 0; i < body.size(); ++i)
+        if (body[i].text != m.body[i].text
+                || (i > 0 && body[i].precededBySpace != m.body[i].precededBySpace))
+            return false;
+    return true;
+}
+
+
+// Returns the index in 'params' of the parameter named by 'tok', or -1.
+//
+int
+Preprocessor::Macro::getParamIndex(const Token &tok) const
+{
+    if (!isFunctionLike || tok.kind != Token::IDENTIFIER)
+        return -1;
+    for (size_t i = 0; i < params.size(); ++i)
+        if (params[i] == tok.text)
+            return int(i);
+    return -1;
+}
+
+
+const Preprocessor::Token *
+Preprocessor::TokenStream::peek() const
+{
+    for (deque<Token>::const_iterator it = pending.begin(); it != pending.end(); ++it)
+        if (it->kind != Token::PADDING)
+            return &*it;
+    if (tokens != NULL && index < tokens->size())
+        return &(*tokens)[index];
+    return NULL;
+}
+
+
+bool
+Preprocessor::TokenStream::get(Token &tok)
+{
+    if (!pending.empty())
+    {
+        tok = pending.front();
+        pending.pop_front();
+        return true;
+    }
+    if (tokens != NULL && index < tokens->size())
+    {
+        tok = (*tokens)[index++];
+        return true;
+    }
+    return false;
+}
+
+
+void
+Preprocessor::TokenStream::pushFront(const TokenList &list)
+{
+    pending.insert(pending.begin(), list.begin(), list.end());
+}
+
+
+Preprocessor::FileContext::FileContext(const SourceFile *_file, const string &_name)
+  : file(_file),
+    name(_name),
+    dir(),
+    lineDelta(0),
+    stream(&_file->tokens)
+{
+    size_t slash = name.rfind('/');
+    if (slash != string::npos)
+        dir.assign(name, 0, slash);
+}
+
+
+Preprocessor::Preprocessor(const list<string> &_includeDirs, FileCache &_fileCache)
+  : fileCache(_fileCache),
+    includeDirs(),
+    commandLineDefinitions(),
+    macros(),
+    onceOnlyFiles(),
+    includedFiles(),
+    precompiledText(),
+    headerReplacingPrecompiledHeader(),
+    contextStack(),
+    hideSetPool(),
+    baseFilename(),
+    counter(0),
+    errorReported(false),
+    fatalError(false),
+    dateString(),
+    timeString(),
+    out(NULL),
+    outLine(1),
+    outLinePrinted(false),
+    avoidPaste(false),
+    paddingSpacing(-1),
+    havePrevToken(false),
+    prevToken()
+{
+    for (list<string>::const_iterator it = _includeDirs.begin(); it != _includeDirs.end(); ++it)
+    {
+        string dir = *it;
+        while (dir.length() > 1 && dir[dir.length() - 1] == '/')
+            dir.erase(dir.length() - 1);
+        includeDirs.push_back(dir);
+    }
+
+    // Same predefined macros as cpp -xc++ -U__cplusplus -undef.
+    defineMacro("__STDC__");
+    defineMacro("__STDC_HOSTED__");
+    defineMacro("__STDC_UTF_16__");
+    defineMacro("__STDC_UTF_32__");
+    defineMacro("_GNU_SOURCE");
+
+    time_t now = time(NULL);
+    char buffer[64];
+    if (strftime(buffer, sizeof(buffer), "\"%b %e %Y\"", localtime(&now)) > 0)
+        dateString = buffer;
+    if (strftime(buffer, sizeof(buffer), "\"%H:%M:%S\"", localtime(&now)) > 0)
+        timeString = buffer;
+}
+
+
+Preprocessor::~Preprocessor()
+{
+    for (vector<FileContext *>::iterator it = contextStack.begin(); it != contextStack.end(); ++it)
+        delete *it;
+}
+
+
+void
+Preprocessor::defineMacro(const string &definition)
+{
+    commandLineDefinitions.push_back(definition);
+
+    // Like cpp, turn "NAME=BODY" into "NAME BODY" and "NAME" into "NAME 1".
+    string text = definition;
+    size_t equalSign = text.find('=');
+    if (equalSign != string::npos)
+        text[equalSign] = ' ';
+    else
+        text += " 1";
+
+    TokenList tokens;
+    tokenize(text, tokens);
+    (void) readMacroDefinition(tokens, 0, "<command-line>", 0);
+}
+
+
+bool
+Preprocessor::preprocessFile(const string &filename, string &output)
+{
+    SourceFile mainFile;
+    if (!readSourceFile(filename, mainFile))
+    {
+        errormsgEx(filename, 0, "cannot open source file: %s", strerror(errno));
+        return false;
+    }
+
+    baseFilename = filename;
+    out = &output;
+    output.reserve(65536);
+    emitLineMarker(1, filename, NULL);
+    if (!precompiledText.empty())
+    {
+        output += precompiledText;
+        emitLineMarker(1, filename, "2");
+    }
+    else if (!headerReplacingPrecompiledHeader.empty())
+    {
+        const string &header = headerReplacingPrecompiledHeader;
+        SourceFile headerFile;
+        if (!readSourceFile(header, headerFile))
+        {
+            errormsgEx(header, 0, "cannot open header file: %s", strerror(errno));
+            return false;
+        }
+        includedFiles.insert(header);
+        emitLineMarker(1, header, "1");
+        processFile(headerFile, header);
+        onceOnlyFiles.insert(header);  // as with a precompiled header
+        emitLineMarker(1, filename, "2");
+    }
+
+    processFile(mainFile, filename);
+
+    if (outLinePrinted)
+        output += '\n';
+    out = NULL;
+    hideSetPool.clear();
+    return !errorReported;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Precompiled headers.
+
+
+// First line of a precompiled header. The number changes with the format.
+//
+static const char pchSignature[] = "CMOC precompiled header 2";
+
+
+// Returns the FNV-1a hash of the contents of the named file, in hexadecimal,
+// or an empty string if the file cannot be read.
+//
+static string
+getFileChecksum(const string &path)
+{
+    ifstream file(path.c_str(), ios::in | ios::binary);
+    if (!file)
+        return string();
+    uint32_t hash = 2166136261u;
+    char buffer[8192];
+    while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+        for (streamsize i = 0; i < file.gcount(); ++i)
+            hash = (hash ^ uint8_t(buffer[i])) * 16777619u;
+    if (file.bad())
+        return string();
+    stringstream ss;
+    ss << hex << hash;
+    return ss.str();
+}
+
+
+// Compares the modification times to the nanosecond where the file system allows it.
+// Equal times count as "no earlier", because a file saved in the same clock tick
+// as the precompiled header may have changed after it.
+//
+static bool
+isModifiedNoEarlierThan(const struct stat &a, const struct stat &b)
+{
+#ifdef __APPLE__
+    const struct timespec &ta = a.st_mtimespec, &tb = b.st_mtimespec;
+#else
+    const struct timespec &ta = a.st_mtim, &tb = b.st_mtim;
+#endif
+    if (ta.tv_sec != tb.tv_sec)
+        return ta.tv_sec > tb.tv_sec;
+    return ta.tv_nsec >= tb.tv_nsec;
+}
+
+
+bool
+Preprocessor::writePrecompiledHeader(const string &filename, const string &pchFilename)
+{
+    SourceFile header;
+    if (!readSourceFile(filename, header))
+    {
+        errormsgEx(filename, 0, "cannot open header file: %s", strerror(errno));
+        return false;
+    }
+
+    string text;
+    baseFilename = filename;
+    out = &text;
+    emitLineMarker(1, filename, "1");
+
+    processFile(header, filename);
+
+    if (outLinePrinted)
+        text += '\n';
+    out = NULL;
+    hideSetPool.clear();
+    if (errorReported)
+        return false;
+
+    // Including the header after loading the precompiled header must do nothing,
+    // even if the header has no include guard.
+    onceOnlyFiles.insert(filename);
+
+    // The precompiled header is out of date if one of the "file" entries is newer
+    // and its contents no longer have the recorded checksum.
+    // The "define" and "include-dir" entries must match those of the compilation.
+    //
+    ofstream pchFile(pchFilename.c_str(), ios::out | ios::binary);
+    pchFile << pchSignature << "\n";
+    for (vector<string>::const_iterator it = commandLineDefinitions.begin(); it != commandLineDefinitions.end(); ++it)
+        pchFile << "define " << *it << "\n";
+    for (vector<string>::const_iterator it = includeDirs.begin(); it != includeDirs.end(); ++it)
+        pchFile << "include-dir " << *it << "\n";
+    pchFile << "file " << getFileChecksum(filename) << " " << filename << "\n";
+    for (set<string>::const_iterator it = includedFiles.begin(); it != includedFiles.end(); ++it)
+        pchFile << "file " << getFileChecksum(*it) << " " << *it << "\n";
+    for (set<string>::const_iterator it = onceOnlyFiles.begin(); it != onceOnlyFiles.end(); ++it)
+        pchFile << "once " << *it << "\n";
+    pchFile << "counter " << counter << "\n";
+    for (MacroTable::const_iterator it = macros.begin(); it != macros.end(); ++it)
+        pchFile << "macro " << it->second.line << " " << it->second.filename << "\n"
+                << getDefinitionText(it->first, it->second) << "\n";
+    pchFile << "text " << text.length() << "\n" << text;
+    pchFile.close();
+    if (!pchFile)
+    {
+        errormsgEx(pchFilename, "cannot write precompiled header: %s", strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+
+bool
+Preprocessor::loadPrecompiledHeader(const string &pchFilename)
+{
+    ifstream pchFile(pchFilename.c_str(), ios::in | ios::binary);
+    struct stat pchStat;
+    if (!pchFile || stat(pchFilename.c_str(), &pchStat) != 0)
+    {
+        errormsgEx(pchFilename, "cannot open precompiled header: %s", strerror(errno));
+        return false;
+    }
+
+    vector<string> definitions, dirs;
+    string headerFilename;  // first "file" entry
+    MacroTable savedMacros;  // restored if the precompiled header is out of date
+    savedMacros.swap(macros);  // replaced by those of the precompiled header
+
+    string line;
+    bool valid = getline(pchFile, line) && line == pchSignature;
+    while (valid && precompiledText.empty() && getline(pchFile, line))
+    {
+        size_t space = line.find(' ');
+        string keyword(line, 0, space);
+        string value = (space == string::npos ? string() : string(line, space + 1));
+
+        if (keyword == "define")
+            definitions.push_back(value);
+        else if (keyword == "include-dir")
+            dirs.push_back(value);
+        else if (keyword == "file")
+        {
+            space = value.find(' ');
+            if (space == string::npos)
+            {
+                valid = false;
+                break;
+            }
+            string checksum(value, 0, space), path(value, space + 1);
+            if (headerFilename.empty())
+                headerFilename = path;
+
+            // Only read the file if its time does not tell that it is older.
+            struct stat fileStat;
+            if (stat(path.c_str(), &fileStat) != 0
+                    || (isModifiedNoEarlierThan(fileStat, pchStat) && getFileChecksum(path) != checksum))
+            {
+                warnmsgEx(pchFilename, "precompiled header is out of date because of %s: preprocessing %s instead",
+                          path.c_str(), headerFilename.c_str());
+                macros.swap(savedMacros);
+                headerReplacingPrecompiledHeader = headerFilename;
+                return true;
+            }
+        }
+        else if (keyword == "once")
+            onceOnlyFiles.insert(value);
+        else if (keyword == "counter")
+            counter = unsigned(strtoul(value.c_str(), NULL, 10));
+        else if (keyword == "macro")
+        {
+            space = value.find(' ');
+            string definition;
+            if (space == string::npos || !getline(pchFile, definition))
+                valid = false;
+            else
+            {
+                TokenList tokens;
+                tokenize(definition, tokens);
+                valid = readMacroDefinition(tokens, 0, string(value, space + 1), atoi(value.c_str()));
+            }
+        }
+        else if (keyword == "text")
+        {
+            size_t length = strtoul(value.c_str(), NULL, 10);
+            if (length == 0)
+                valid = false;
+            else
+            {
+                precompiledText.resize(length);
+                valid = pchFile.read(&precompiledText[0], length) && size_t(pchFile.gcount()) == length;
+            }
+        }
+        else
+            valid = false;
+    }
+
+    if (!valid || precompiledText.empty())
+    {
+        precompiledText.clear();
+        errormsgEx(pchFilename, "invalid precompiled header");
+        return false;
+    }
+    if (definitions != commandLineDefinitions || dirs != includeDirs)
+    {
+        precompiledText.clear();
+        errormsgEx(pchFilename, "precompiled header was created with different -D, -I or target options");
+        return false;
+    }
+    return true;
+}
+
+
+// Returns the text of a definition of macro 'name' that readMacroDefinition()
+// accepts, e.g., "F(a,b) ((a) + (b))".
+//
+/*static*/
+string
+Preprocessor::getDefinitionText(const string &name, const Macro &macro)
+{
+    string text = name;
+    if (macro.isFunctionLike)
+    {
+        text += '(';
+        for (size_t i = 0; i < macro.params.size(); ++i)
+        {
+            if (i > 0)
+                text += ',';
+            if (macro.isVariadic && i + 1 == macro.params.size())
+                text += (macro.params[i] == "__VA_ARGS__" ? string("...") : macro.params[i] + "...");
+            else
+                text += macro.params[i];
+        }
+        text += ')';
+    }
+    for (TokenList::const_iterator it = macro.body.begin(); it != macro.body.end(); ++it)
+    {
+        if (it == macro.body.begin() || it->precededBySpace)
+            text += ' ';
+        text += it->text;
+    }
+    return text;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Tokenization.
+
+
+static bool
+isIdentifierStart(char c)
+{
+    return isalpha((unsigned char) c) || c == '_' || c == '$';
+}
+
+
+static bool
+isIdentifierChar(char c)
+{
+    return isalnum((unsigned char) c) || c == '_' || c == '$';
+}
+
+
+// Returns the length of the backslash-newline sequence at text[i], or 0.
+//
+static size_t
+getLineSpliceLength(const string &text, size_t i)
+{
+    if (text[i] != '\\')
+        return 0;
+    if (i + 1 < text.length() && text[i + 1] == '\n')
+        return 2;
+    if (i + 2 < text.length() && text[i + 1] == '\r' && text[i + 2] == '\n')
+        return 3;
+    return 0;
+}
+
+
+// Returns the length of the punctuator at text[i], or 0.
+//
+static size_t
+getPunctuatorLength(const string &text, size_t i)
+{
+    static const char *multiCharPunctuators[] =
+    {
+        "...", "<<=", ">>=", "->*",
+        "->", "++", "--", "<<", ">>", "<=", ">=", "==", "!=", "&&", "||",
+        "*=", "/=", "%=", "+=", "-=", "&=", "^=", "|=", "##", "::", ".*",
+        NULL
+    };
+    for (const char **p = multiCharPunctuators; *p != NULL; ++p)
+        if (text.compare(i, strlen(*p), *p) == 0)
+            return strlen(*p);
+    if (text[i] != '\0' && strchr("[](){}.&*+-~!/%<>^|?:;=,#", text[i]) != NULL)
+        return 1;
+    return 0;
+}
+
+
+// Returns the length of the character or string literal that starts at text[i]
+// with the given quote character, or 0 if it is not terminated on the same line.
+//
+static size_t
+getQuotedLength(const string &text, size_t i, char quote)
+{
+    size_t j = i + 1;
+    while (j < text.length() && text[j] != quote && text[j] != '\n')
+    {
+        if (text[j] == '\\' && j + 1 < text.length() && text[j + 1] != '\n')
+            ++j;
+        ++j;
+    }
+    if (j >= text.length() || text[j] != quote)
+        return 0;
+    return j + 1 - i;
+}
+
+
+// Returns a number that is at least the number of tokens that tokenize() finds
+// in 'text': the number of characters outside comments that start a word
+// or that are neither alphanumeric nor white space.
+//
+static size_t
+getMaxNumTokens(const string &text)
+{
+    size_t len = text.length(), num = 0;
+    bool inWord = false;
+    for (size_t i = 0; i < len; ++i)
+    {
+        char c = text[i];
+        if (c == '/' && i + 1 < len && (text[i + 1] == '*' || text[i + 1] == '/'))
+        {
+            size_t end = (text[i + 1] == '*' ? text.find("*/", i + 2) : text.find('\n', i + 2));
+            if (end == string::npos)
+                break;
+            i = end + (text[i + 1] == '*' ? 1 : 0);
+            inWord = false;
+            continue;
+        }
+        bool isWordChar = isalnum((unsigned char) c) || c == '_';
+        if ((isWordChar && !inWord) || (!isWordChar && !isspace((unsigned char) c)))
+            ++num;
+        inWord = isWordChar;
+    }
+    return num;
+}
+
+
+/*static*/
+void
+Preprocessor::tokenize(const string &text, TokenList &tokens)
+{
+    size_t len = text.length();
+    size_t i = 0;
+    int line = 1;
+    size_t lineStart = 0;  // index in 'text' of the start of the current physical line
+    bool atLineStart = true, precededBySpace = false;
+
+    while (i < len)
+    {
+        char c = text[i];
+
+        if (c == '\n')
+        {
+            ++i;
+            ++line;
+            lineStart = i;
+            atLineStart = true;
+            precededBySpace = false;
+            continue;
+        }
+        if (size_t n = getLineSpliceLength(text, i))
+        {
+            i += n;
+            ++line;
+            lineStart = i;
+            continue;
+        }
+        if (c == ' ' || c == '\t' || c == '\f' || c == '\v' || c == '\r')
+        {
+            ++i;
+            precededBySpace = true;
+            continue;
+        }
+        if (c == '/' && i + 1 < len && text[i + 1] == '*')
+        {
+            for (i += 2; i < len && text.compare(i, 2, "*/") != 0; ++i)
+                if (text[i] == '\n')
+                {
+                    ++line;
+                    lineStart = i + 1;
+                }
+            i = (i < len ? i + 2 : len);
+            precededBySpace = true;
+            continue;
+        }
+        if (c == '/' && i + 1 < len && text[i + 1] == '/')
+        {
+            while (i < len && text[i] != '\n')
+            {
+                if (size_t n = getLineSpliceLength(text, i))  // comment continues on next line
+                {
+                    i += n;
+                    ++line;
+                    lineStart = i;
+                }
+                else
+                    ++i;
+            }
+            precededBySpace = true;
+            continue;
+        }
+
+        Token tok(Token::OTHER, "", line, int(i - lineStart + 1));
+        tok.atLineStart = atLineStart;
+        tok.precededBySpace = precededBySpace;
+        size_t start = i;
+
+        if (isIdentifierStart(c))
+        {
+            while (i < len && isIdentifierChar(text[i]))
+                ++i;
+            tok.kind = Token::IDENTIFIER;
+
+            // Wide or Unicode character or string literal, e.g., L'x'.
+            string prefix(text, start, i - start);
+            if (i < len && (text[i] == '\'' || text[i] == '"')
+                    && (prefix == "L" || prefix == "u" || prefix == "U" || prefix == "u8"))
+                if (size_t n = getQuotedLength(text, i, text[i]))
+                {
+                    tok.kind = (text[i] == '\'' ? Token::CHAR_LITERAL : Token::STRING_LITERAL);
+                    i += n;
+                }
+        }
+        else if (isdigit((unsigned char) c) || (c == '.' && i + 1 < len && isdigit((unsigned char) text[i + 1])))
+        {
+            for (++i; i < len; ++i)
+            {
+                char d = text[i];
+                if ((d == '+' || d == '-') && strchr("eEpP", text[i - 1]) != NULL)
+                    continue;
+                if (!isIdentifierChar(d) && d != '.')
+                    break;
+            }
+            tok.kind = Token::NUMBER;
+        }
+        else if (c == '\'' || c == '"')
+        {
+            size_t n = getQuotedLength(text, i, c);
+            if (n > 0)
+            {
+                tok.kind = (c == '\'' ? Token::CHAR_LITERAL : Token::STRING_LITERAL);
+                i += n;
+            }
+            else  // unterminated: the quote is a token by itself, as with cpp
+                ++i;
+        }
+        else if (size_t n = getPunctuatorLength(text, i))
+        {
+            tok.kind = Token::PUNCTUATOR;
+            i += n;
+        }
+        else
+            ++i;
+
+        tok.text.assign(text, start, i - start);
+        tokens.push_back(tok);
+        atLineStart = false;
+        precededBySpace = false;
+    }
+}
+
+
+/*static*/
+bool
+Preprocessor::readSourceFile(const string &path, SourceFile &sourceFile)
+{
+    ifstream file(path.c_str(), ios::in | ios::binary);
+    if (!file)
+        return false;
+    stringstream contents;
+    contents << file.rdbuf();
+    if (file.bad())
+        return false;
+
+    // Reserving an upper bound avoids the reallocations of a growing vector,
+    // which hold two copies of the tokens at once, e.g., of a large data table.
+    // The pages of the excess are not touched.
+    //
+    const string text = contents.str();
+    sourceFile.tokens.reserve(getMaxNumTokens(text));
+    tokenize(text, sourceFile.tokens);
+    findGuardMacro(sourceFile);
+    return true;
+}
+
+
+// Sets sourceFile.guardMacro to X if the file has the form #ifndef X ... #endif,
+// where the #endif matches the #ifndef and is followed by nothing.
+// Then, including the file again while X is defined is known to produce nothing.
+//
+/*static*/
+void
+Preprocessor::findGuardMacro(SourceFile &sourceFile)
+{
+    const TokenList &tokens = sourceFile.tokens;
+    if (tokens.size() < 3 || !tokens[0].is("#")
+            || tokens[1].atLineStart || tokens[1].text != "ifndef"
+            || tokens[2].atLineStart || tokens[2].kind != Token::IDENTIFIER)
+        return;
+
+    size_t depth = 0;
+    for (size_t i = 0; i < tokens.size(); ++i)
+    {
+        if (!tokens[i].atLineStart || !tokens[i].is("#") || i + 1 >= tokens.size() || tokens[i + 1].atLineStart)
+            continue;
+        const string &name = tokens[i + 1].text;
+        if (name == "if" || name == "ifdef" || name == "ifndef")
+            ++depth;
+        else if ((name == "elif" || name == "else") && depth == 1)
+            return;
+        else if (name == "endif" && --depth == 0)
+        {
+            for (i += 2; i < tokens.size(); ++i)
+                if (tokens[i].atLineStart)
+                    return;  // tokens after the #endif line
+            sourceFile.guardMacro = tokens[2].text;
+            return;
+        }
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Output.
+
+
+/*static*/
+Preprocessor::Token
+Preprocessor::makePadding(const Token *source)
+{
+    Token padding(Token::PADDING);
+    if (source != NULL)
+    {
+        padding.hasPaddingSource = true;
+        padding.precededBySpace = source->precededBySpace;
+    }
+    return padding;
+}
+
+
+// Determines if 'prev' and 'tok' would be read as a different sequence of
+// tokens if 'tok' were written immediately after 'prev'.
+// Same rules as cpp_avoid_paste() in GNU cpp.
+//
+/*static*/
+bool
+Preprocessor::avoidsPaste(const Token &prev, const Token &tok)
+{
+    char c = (tok.kind == Token::PUNCTUATOR ? tok.text[0] : '\0');
+    const string &a = prev.text;
+
+    switch (prev.kind)
+    {
+    case Token::PUNCTUATOR:
+        if (c == '=' && (a == "=" || a == "!" || a == ">" || a == "<" || a == "+" || a == "-"
+                         || a == "*" || a == "/" || a == "%" || a == "&" || a == "|" || a == "^"
+                         || a == ">>" || a == "<<"))
+            return true;
+        if (a == ">")
+            return c == '>';
+        if (a == "<")
+            return c == '<' || c == '%' || c == ':';
+        if (a == "+")
+            return c == '+';
+        if (a == "-")
+            return c == '-' || c == '>';
+        if (a == "/")
+            return c == '/' || c == '*';
+        if (a == "%")
+            return c == ':' || c == '%';
+        if (a == "&")
+            return c == '&';
+        if (a == "|")
+            return c == '|';
+        if (a == ":")
+            return c == ':' || c == '>';
+        if (a == "->")
+            return c == '*';
+        if (a == ".")
+            return c == '.' || c == '%' || tok.kind == Token::NUMBER;
+        if (a == "#")
+            return c == '#' || c == '%';
+        return false;
+    case Token::IDENTIFIER:
+        return tok.kind == Token::IDENTIFIER || tok.kind == Token::CHAR_LITERAL || tok.kind == Token::STRING_LITERAL;
+    case Token::NUMBER:
+        return tok.kind == Token::NUMBER || tok.kind == Token::IDENTIFIER || tok.kind == Token::CHAR_LITERAL
+               || c == '.' || c == '+' || c == '-';
+    case Token::OTHER:
+        return a == "\\" && tok.kind == Token::IDENTIFIER;
+    default:
+        return false;
+    }
+}
+
+
+// Writes 'tok' to the output, preceded by a line change and indentation
+// if it does not belong on the current output line, or by a space where
+// cpp would write one.
+//
+void
+Preprocessor::emitToken(const Token &tok)
+{
+    if (tok.kind == Token::PADDING)
+    {
+        avoidPaste = true;
+        if (paddingSpacing == -1 || (paddingSpacing == 0 && !tok.hasPaddingSource))
+            paddingSpacing = (!tok.hasPaddingSource ? -1 : tok.precededBySpace ? 1 : 0);
+        return;
+    }
+
+    int line = getPresumedLine(tok.line);
+    if (!outLinePrinted || line != outLine)
+    {
+        emitLineChange(line, tok.column);
+        if (avoidPaste && tok.column == 1 && tok.is("#"))
+            *out += ' ';  // do not produce a line that looks like a directive
+    }
+    else if (avoidPaste)
+    {
+        bool space = (paddingSpacing == -1 ? tok.precededBySpace : paddingSpacing == 1);
+        if (space || (havePrevToken && avoidsPaste(prevToken, tok)))
+            *out += ' ';
+    }
+    else if (tok.precededBySpace)
+        *out += ' ';
+
+    *out += tok.text;
+    avoidPaste = false;
+    paddingSpacing = -1;
+    prevToken = tok;
+    havePrevToken = true;
+}
+
+
+// Moves the output to line 'line' of the current file.
+// Uses newlines to reach a nearby line, and a line marker otherwise.
+//
+void
+Preprocessor::emitLineSync(int line)
+{
+    if (outLinePrinted)
+    {
+        *out += '\n';
+        ++outLine;
+        outLinePrinted = false;
+    }
+    if (line >= outLine && line < outLine + 8)
+    {
+        out->append(size_t(line - outLine), '\n');
+        outLine = line;
+    }
+    else
+        emitLineMarker(line, contextStack.back()->name, NULL);
+    havePrevToken = false;
+}
+
+
+// Starts output line 'line' of the current file and indents it so that
+// a token at 'column' appears at that column.
+//
+void
+Preprocessor::emitLineChange(int line, int column)
+{
+    emitLineSync(line);
+    if (column > 1)
+        out->append(size_t(column - 1), ' ');
+    outLinePrinted = true;
+}
+
+
+// flag: NULL, or "1" when entering an #included file, or "2" when returning from one.
+//
+void
+Preprocessor::emitLineMarker(int line, const string &filename, const char *flag)
+{
+    if (outLinePrinted)
+        *out += '\n';
+    stringstream marker;
+    marker << "# " << line << " " << quote(filename);
+    if (flag != NULL)
+        marker << " " << flag;
+    marker << "\n";
+    *out += marker.str();
+    outLine = line;
+    outLinePrinted = false;
+    havePrevToken = false;
+}
+
+
+// Writes the #pragma directive whose tokens start at line[start], on its own line.
+// The tokens are not macro-expanded.
+//
+void
+Preprocessor::outputPragma(const TokenList &line, size_t start, int directiveLine)
+{
+    emitLineSync(getPresumedLine(directiveLine));
+    *out += "#pragma ";
+    for (size_t i = start; i < line.size(); ++i)
+    {
+        if (i > start && line[i].precededBySpace)
+            *out += ' ';
+        *out += line[i].text;
+    }
+    *out += '\n';
+    ++outLine;
+}
+
+
+// Returns 's' as a C string literal.
+//
+/*static*/
+string
+Preprocessor::quote(const string &s)
+{
+    string result = "\"";
+    for (string::const_iterator it = s.begin(); it != s.end(); ++it)
+    {
+        if (*it == '\\' || *it == '"')
+            result += '\\';
+        result += *it;
+    }
+    result += '"';
+    return result;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Files and directives.
+
+
+void
+Preprocessor::processFile(const SourceFile &file, const string &name)
+{
+    FileContext *ctx = new FileContext(&file, name);
+    contextStack.push_back(ctx);
+    TokenStream &stream = ctx->stream;
+    vector<Conditional> conditionals;
+
+    while (!fatalError)
+    {
+        if (!stream.hasPending())
+        {
+            const Token *next = stream.peek();
+            if (next == NULL)
+                break;
+            if (next->atLineStart && next->is("#"))
+            {
+                Token hash;
+                stream.get(hash);
+                processDirective(*ctx, conditionals, hash);
+                continue;
+            }
+        }
+
+        Token tok;
+        if (!stream.get(tok))
+            break;
+        if (tok.kind == Token::IDENTIFIER && expandMacro(stream, tok))
+            continue;
+        emitToken(tok);
+    }
+
+    if (!conditionals.empty() && !fatalError)
+        error(conditionals.back().line, "unterminated conditional directive");
+
+    contextStack.pop_back();
+    delete ctx;
+}
+
+
+// Reads the tokens that follow the current position up to the end of the directive line.
+//
+void
+Preprocessor::readDirectiveLine(FileContext &ctx, TokenList &line)
+{
+    const TokenList &tokens = ctx.file->tokens;
+    size_t &index = ctx.stream.index;
+    while (index < tokens.size() && !tokens[index].atLineStart)
+        line.push_back(tokens[index++]);
+}
+
+
+void
+Preprocessor::processDirective(FileContext &ctx, vector<Conditional> &conditionals, const Token &hash)
+{
+    TokenList line;
+    readDirectiveLine(ctx, line);
+    if (line.empty())
+        return;  // null directive
+
+    const Token &directive = line[0];
+    int lastLine = line.back().line;
+
+    if (directive.kind == Token::NUMBER)  // GNU line marker, e.g., # 42 "foo.c"
+    {
+        processLineDirective(ctx, line, 0, lastLine);
+        return;
+    }
+    if (directive.kind != Token::IDENTIFIER)
+    {
+        error(hash.line, "invalid preprocessing directive");
+        return;
+    }
+
+    const string &name = directive.text;
+
+    if (name == "define")
+    {
+        readMacroDefinition(line, 1, ctx.name, getPresumedLine(hash.line));
+        return;
+    }
+    if (name == "undef")
+    {
+        if (line.size() < 2 || line[1].kind != Token::IDENTIFIER)
+            error(hash.line, "macro names must be identifiers");
+        else
+            macros.erase(line[1].text);
+        return;
+    }
+    if (name == "include")
+    {
+        processInclude(ctx, line, hash.line, lastLine);
+        return;
+    }
+    if (name == "if" || name == "ifdef" || name == "ifndef")
+    {
+        bool value = false;
+        if (name == "if")
+            value = evaluateCondition(line, 1, hash.line);
+        else if (line.size() < 2 || line[1].kind != Token::IDENTIFIER)
+            error(hash.line, "macro names must be identifiers");
+        else
+            value = (isDefined(line[1].text) == (name == "ifdef"));
+
+        Conditional cond = { value, false, hash.line };
+        conditionals.push_back(cond);
+        if (!value)
+            skipGroups(ctx, conditionals);
+        return;
+    }
+    if (name == "elif" || name == "else" || name == "endif")
+    {
+        if (conditionals.empty())
+        {
+            error(hash.line, "#%s without #if", name.c_str());
+            return;
+        }
+        if (name == "endif")
+        {
+            conditionals.pop_back();
+            return;
+        }
+        Conditional &cond = conditionals.back();
+        if (cond.elseSeen)
+            error(hash.line, "#%s after #else", name.c_str());
+        if (name == "else")
+            cond.elseSeen = true;
+        skipGroups(ctx, conditionals);  // the current group was the one taken
+        return;
+    }
+    if (name == "error" || name == "warning")
+    {
+        string message;
+        for (size_t i = 1; i < line.size(); ++i)
+        {
+            if (i > 1 && line[i].precededBySpace)
+                message += ' ';
+            message += line[i].text;
+        }
+        if (name == "error")
+            error(hash.line, "#error %s", message.c_str());
+        else
+            warning(hash.line, "#warning %s", message.c_str());
+        return;
+    }
+    if (name == "line")
+    {
+        processLineDirective(ctx, line, 1, lastLine);
+        return;
+    }
+    if (name == "pragma")
+    {
+        if (line.size() == 2 && line[1].text == "once")
+            onceOnlyFiles.insert(ctx.name);
+        else
+            outputPragma(line, 1, hash.line);
+        return;
+    }
+    if (name == "ident" || name == "sccs")
+        return;
+
+    error(hash.line, "invalid preprocessing directive #%s", name.c_str());
+}
+
+
+// Called at the start of a group of the innermost conditional that must not be included.
+// Skips groups until one is taken (by #elif or #else), or until the #endif.
+//
+void
+Preprocessor::skipGroups(FileContext &ctx, vector<Conditional> &conditionals)
+{
+    const TokenList &tokens = ctx.file->tokens;
+    size_t &index = ctx.stream.index;
+    size_t depth = 0;
+
+    while (index < tokens.size())
+    {
+        const Token &tok = tokens[index++];
+        if (!tok.atLineStart || !tok.is("#") || index >= tokens.size() || tokens[index].atLineStart)
+            continue;
+        int hashLine = tok.line;
+        const string &name = tokens[index++].text;
+
+        if (name == "if" || name == "ifdef" || name == "ifndef")
+        {
+            ++depth;
+            continue;
+        }
+        if (depth > 0)
+        {
+            if (name == "endif")
+                --depth;
+            continue;
+        }
+
+        Conditional &cond = conditionals.back();
+        if (name == "endif")
+        {
+            TokenList line;
+            readDirectiveLine(ctx, line);
+            conditionals.pop_back();
+            return;
+        }
+        if (name == "else")
+        {
+            if (cond.elseSeen)
+                error(hashLine, "#else after #else");
+            cond.elseSeen = true;
+            if (!cond.groupTaken)
+            {
+                cond.groupTaken = true;
+                return;
+            }
+        }
+        else if (name == "elif")
+        {
+            if (cond.elseSeen)
+                error(hashLine, "#elif after #else");
+            if (!cond.groupTaken)
+            {
+                TokenList line;
+                readDirectiveLine(ctx, line);
+                if (evaluateCondition(line, 0, hashLine))
+                {
+                    cond.groupTaken = true;
+                    return;
+                }
+            }
+        }
+    }
+}
+
+
+const Preprocessor::SourceFile *
+Preprocessor::findIncludedFile(const string &name, bool isAngled, string &path)
+{
+    vector<string> candidates;
+    if (name[0] == '/')
+        candidates.push_back(name);
+    else
+    {
+        if (!isAngled)
+        {
+            const string &dir = contextStack.back()->dir;
+            candidates.push_back(dir.empty() ? name : dir + "/" + name);
+        }
+        for (vector<string>::const_iterator it = includeDirs.begin(); it != includeDirs.end(); ++it)
+            candidates.push_back(*it + "/" + name);
+    }
+
+    for (vector<string>::const_iterator it = candidates.begin(); it != candidates.end(); ++it)
+    {
+        map<string, SourceFile>::const_iterator cached = fileCache.files.find(*it);
+        if (cached != fileCache.files.end())
+        {
+            path = *it;
+            return &cached->second;
+        }
+        SourceFile sourceFile;
+        if (readSourceFile(*it, sourceFile))
+        {
+            path = *it;
+            SourceFile &entry = fileCache.files[path];
+            entry.tokens.swap(sourceFile.tokens);
+            entry.guardMacro = sourceFile.guardMacro;
+            return &entry;
+        }
+    }
+    return NULL;
+}
+
+
+void
+Preprocessor::processInclude(FileContext &ctx, const TokenList &line, int directiveLine, int lastLine)
+{
+    TokenList operand(line.begin() + 1, line.end());
+    if (!operand.empty() && operand[0].kind != Token::STRING_LITERAL && !operand[0].is("<"))
+    {
+        TokenList expanded;
+        expandTokenList(operand, expanded);
+        operand.clear();
+        for (TokenList::const_iterator it = expanded.begin(); it != expanded.end(); ++it)
+            if (it->kind != Token::PADDING)
+                operand.push_back(*it);
+    }
+
+    string name;
+    bool isAngled = false;
+    if (!operand.empty() && operand[0].kind == Token::STRING_LITERAL && operand[0].text[0] == '"')
+        name.assign(operand[0].text, 1, operand[0].text.length() - 2);
+    else if (!operand.empty() && operand[0].is("<"))
+    {
+        size_t i;
+        for (i = 1; i < operand.size() && !operand[i].is(">"); ++i)
+        {
+            if (i > 1 && operand[i].precededBySpace)
+                name += ' ';
+            name += operand[i].text;
+        }
+        if (i == operand.size())
+            name.clear();
+        isAngled = true;
+    }
+    if (name.empty())
+    {
+        error(directiveLine, "#include expects \"FILENAME\" or <FILENAME>");
+        return;
+    }
+
+    string path;
+    const SourceFile *file = findIncludedFile(name, isAngled, path);
+    if (file == NULL)
+    {
+        error(directiveLine, "%s: No such file or directory", name.c_str());
+        fatalError = true;
+        return;
+    }
+    if (onceOnlyFiles.find(path) != onceOnlyFiles.end()
+            || (!file->guardMacro.empty() && isDefined(file->guardMacro)))
+        return;
+    if (contextStack.size() >= MAX_INCLUDE_DEPTH)
+    {
+        error(directiveLine, "#include nested depth %u exceeds maximum of %u",
+              unsigned(contextStack.size()), unsigned(MAX_INCLUDE_DEPTH));
+        fatalError = true;
+        return;
+    }
+
+    includedFiles.insert(path);
+    emitLineSync(getPresumedLine(directiveLine));
+    emitLineMarker(1, path, "1");
+    processFile(*file, path);
+    emitLineMarker(getPresumedLine(lastLine) + 1, ctx.name, "2");
+}
+
+
+// Processes #line N "FILENAME" or # N "FILENAME", where the arguments start at line[start].
+//
+void
+Preprocessor::processLineDirective(FileContext &ctx, const TokenList &line, size_t start, int lastLine)
+{
+    TokenList args;
+    if (start < line.size() && line[start].kind == Token::NUMBER)
+        args.assign(line.begin() + start, line.end());
+    else
+    {
+        TokenList expanded;
+        expandTokenList(TokenList(line.begin() + start, line.end()), expanded);
+        for (TokenList::const_iterator it = expanded.begin(); it != expanded.end(); ++it)
+            if (it->kind != Token::PADDING)
+                args.push_back(*it);
+    }
+
+    char *end = NULL;
+    unsigned long newLine = (args.empty() ? 0 : strtoul(args[0].text.c_str(), &end, 10));
+    if (args.empty() || args[0].kind != Token::NUMBER || *end != '\0')
+    {
+        error(lastLine, "#line directive requires a simple digit sequence");
+        return;
+    }
+    if (args.size() >= 2)
+    {
+        if (args[1].kind != Token::STRING_LITERAL || args[1].text[0] != '"')
+        {
+            error(lastLine, "invalid filename in #line directive");
+            return;
+        }
+        ctx.name.assign(args[1].text, 1, args[1].text.length() - 2);
+    }
+    ctx.lineDelta = int(newLine) - (lastLine + 1);
+    emitLineMarker(int(newLine), ctx.name, NULL);
+}
+
+
+// Defines the macro whose name is at line[start].
+// Returns false if the definition is invalid.
+//
+bool
+Preprocessor::readMacroDefinition(const TokenList &line, size_t start, const string &filename, int lineNo)
+{
+    int errorLine = (line.empty() ? 0 : line[0].line);
+    if (start >= line.size() || line[start].kind != Token::IDENTIFIER)
+    {
+        error(errorLine, "macro names must be identifiers");
+        return false;
+    }
+    const string &name = line[start].text;
+    if (name == "defined")
+    {
+        error(errorLine, "\"defined\" cannot be used as a macro name");
+        return false;
+    }
+
+    Macro macro;
+    macro.filename = filename;
+    macro.line = lineNo;
+    size_t i = start + 1;
+
+    if (i < line.size() && line[i].is("(") && !line[i].precededBySpace)
+    {
+        macro.isFunctionLike = true;
+        for (++i; ; ++i)
+        {
+            if (i >= line.size())
+            {
+                error(errorLine, "missing ')' in macro parameter list");
+                return false;
+            }
+            if (line[i].is(")") && macro.params.empty())
+                break;
+            if (line[i].is("..."))
+            {
+                macro.params.push_back("__VA_ARGS__");
+                macro.isVariadic = true;
+                ++i;
+            }
+            else if (line[i].kind == Token::IDENTIFIER)
+            {
+                if (find(macro.params.begin(), macro.params.end(), line[i].text) != macro.params.end())
+                {
+                    error(errorLine, "duplicate macro parameter \"%s\"", line[i].text.c_str());
+                    return false;
+                }
+                macro.params.push_back(line[i].text);
+                if (++i < line.size() && line[i].is("..."))  // GNU named variadic parameter
+                {
+                    macro.isVariadic = true;
+                    ++i;
+                }
+            }
+            else
+            {
+                error(errorLine, "expected parameter name, found \"%s\"", line[i].text.c_str());
+                return false;
+            }
+
+            if (i < line.size() && line[i].is(")"))
+                break;
+            if (i >= line.size() || !line[i].is(",") || macro.isVariadic)
+            {
+                error(errorLine, "expected ',' or ')' in macro parameter list");
+                return false;
+            }
+        }
+        ++i;  // pass ')'
+    }
+
+    macro.body.assign(line.begin() + i, line.end());
+    for (TokenList::iterator it = macro.body.begin(); it != macro.body.end(); ++it)
+        it->atLineStart = false;
+    if (!macro.body.empty())
+    {
+        macro.body[0].precededBySpace = false;
+        if (macro.body[0].is("##") || macro.body.back().is("##"))
+        {
+            error(errorLine, "'##' cannot appear at either end of a macro expansion");
+            return false;
+        }
+    }
+    if (macro.isFunctionLike)
+        for (size_t j = 0; j < macro.body.size(); ++j)
+            if (macro.body[j].is("#") && (j + 1 == macro.body.size() || macro.getParamIndex(macro.body[j + 1]) < 0))
+            {
+                error(errorLine, "'#' is not followed by a macro parameter");
+                return false;
+            }
+
+    MacroTable::iterator it = macros.find(name);
+    if (it != macros.end())
+    {
+        if (!it->second.isSameDefinition(macro))
+            warning(errorLine, "\"%s\" redefined", name.c_str());
+        it->second = macro;
+    }
+    else
+        macros[name] = macro;
+    return true;
+}
+
+
+bool
+Preprocessor::isDefined(const string &name) const
+{
+    return macros.find(name) != macros.end()
+           || name == "__LINE__" || name == "__FILE__" || name == "__BASE_FILE__"
+           || name == "__DATE__" || name == "__TIME__" || name == "__COUNTER__"
+           || name == "__INCLUDE_LEVEL__";
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Macro expansion.
+
+
+/*static*/
+bool
+Preprocessor::hideSetContains(const HideSet *hs, const string &name)
+{
+    for ( ; hs != NULL; hs = hs->next)
+        if (hs->name == name)
+            return true;
+    return false;
+}
+
+
+const Preprocessor::HideSet *
+Preprocessor::addToHideSet(const HideSet *hs, const string &name)
+{
+    if (hideSetContains(hs, name))
+        return hs;
+    HideSet node = { name, hs };
+    hideSetPool.push_back(node);
+    return &hideSetPool.back();
+}
+
+
+const Preprocessor::HideSet *
+Preprocessor::unionHideSets(const HideSet *a, const HideSet *b)
+{
+    const HideSet *result = b;
+    for ( ; a != NULL; a = a->next)
+        result = addToHideSet(result, a->name);
+    return result;
+}
+
+
+const Preprocessor::HideSet *
+Preprocessor::intersectHideSets(const HideSet *a, const HideSet *b)
+{
+    const HideSet *result = NULL;
+    for ( ; a != NULL; a = a->next)
+        if (hideSetContains(b, a->name))
+            result = addToHideSet(result, a->name);
+    return result;
+}
+
+
+// If 'nameTok' is a macro invocation, replaces it and its arguments, if any,
+// with the expansion, which is pushed at the front of 'stream', and returns true.
+//
+bool
+Preprocessor::expandMacro(TokenStream &stream, const Token &nameTok)
+{
+    if (hideSetContains(nameTok.hideSet, nameTok.text))
+        return false;
+
+    MacroTable::const_iterator it = macros.find(nameTok.text);
+    if (it == macros.end())
+        return expandBuiltinMacro(stream, nameTok);
+    const Macro &macro = it->second;
+
+    TokenList result;
+    const HideSet *hs = NULL;
+    if (!macro.isFunctionLike)
+    {
+        hs = addToHideSet(nameTok.hideSet, nameTok.text);
+        substitute(macro, vector<TokenList>(), result);
+    }
+    else
+    {
+        const Token *next = stream.peek();
+        if (next == NULL || !next->is("("))
+            return false;
+        vector<TokenList> args;
+        const HideSet *rparenHideSet = NULL;
+        if (!collectArguments(stream, nameTok, macro, args, rparenHideSet))
+            return true;
+        hs = addToHideSet(intersectHideSets(nameTok.hideSet, rparenHideSet), nameTok.text);
+        substitute(macro, args, result);
+    }
+
+    TokenList expansion;
+    expansion.reserve(result.size() + 2);
+    expansion.push_back(makePadding(&nameTok));
+    for (TokenList::iterator r = result.begin(); r != result.end(); ++r)
+    {
+        if (r->kind != Token::PADDING)
+        {
+            r->hideSet = unionHideSets(r->hideSet, hs);
+            r->line = nameTok.line;
+            r->column = nameTok.column;
+            r->fromMacro = true;
+        }
+        expansion.push_back(*r);
+    }
+    expansion.push_back(makePadding(NULL));
+    stream.pushFront(expansion);
+    return true;
+}
+
+
+bool
+Preprocessor::expandBuiltinMacro(TokenStream &stream, const Token &nameTok)
+{
+    const string &name = nameTok.text;
+    Token tok(Token::NUMBER, "", nameTok.line, nameTok.column);
+    stringstream value;
+
+    if (name == "__LINE__")
+        value << getPresumedLine(nameTok.line);
+    else if (name == "__COUNTER__")
+        value << counter++;
+    else if (name == "__INCLUDE_LEVEL__")
+        value << contextStack.size() - 1;
+    else
+    {
+        tok.kind = Token::STRING_LITERAL;
+        if (name == "__FILE__")
+            value << quote(contextStack.back()->name);
+        else if (name == "__BASE_FILE__")
+            value << quote(baseFilename);
+        else if (name == "__DATE__")
+            value << dateString;
+        else if (name == "__TIME__")
+            value << timeString;
+        else
+            return false;
+    }
+
+    tok.text = value.str();
+    tok.precededBySpace = nameTok.precededBySpace;
+    tok.fromMacro = true;
+    tok.hideSet = nameTok.hideSet;
+
+    TokenList expansion;
+    expansion.push_back(makePadding(&nameTok));
+    expansion.push_back(tok);
+    expansion.push_back(makePadding(NULL));
+    stream.pushFront(expansion);
+    return true;
+}
+
+
+// Reads the parenthesized arguments of an invocation of 'macro', which starts with 'nameTok'.
+// Stores the hide set of the closing parenthesis in 'rparenHideSet'.
+// Returns false if an error was reported.
+//
+bool
+Preprocessor::collectArguments(TokenStream &stream, const Token &nameTok, const Macro &macro,
+                               vector<TokenList> &args, const HideSet *&rparenHideSet)
+{
+    Token tok;
+    do
+        stream.get(tok);
+    while (tok.kind == Token::PADDING);
+    assert(tok.is("("));
+
+    args.push_back(TokenList());
+    size_t depth = 0;
+    for (;;)
+    {
+        if (!stream.get(tok))
+        {
+            error(nameTok.line, "unterminated argument list invoking macro \"%s\"", nameTok.text.c_str());
+            return false;
+        }
+        if (tok.kind == Token::PADDING)
+        {
+            if (!args.back().empty())  // drop leading padding
+                args.back().push_back(tok);
+            continue;
+        }
+        if (tok.is("("))
+            ++depth;
+        else if (tok.is(")"))
+        {
+            if (depth == 0)
+            {
+                rparenHideSet = tok.hideSet;
+                break;
+            }
+            --depth;
+        }
+        else if (tok.is(",") && depth == 0 && !(macro.isVariadic && args.size() == macro.params.size()))
+        {
+            args.push_back(TokenList());
+            continue;
+        }
+
+        if (tok.atLineStart)  // a newline in the arguments counts as a space
+            tok.precededBySpace = true;
+        tok.atLineStart = false;
+        args.back().push_back(tok);
+    }
+
+    for (vector<TokenList>::iterator it = args.begin(); it != args.end(); ++it)  // drop trailing padding
+        while (!it->empty() && it->back().kind == Token::PADDING)
+            it->pop_back();
+
+    size_t numParams = macro.params.size();
+    if (numParams == 0 && args.size() == 1 && args[0].empty())
+        args.clear();
+    else if (macro.isVariadic && args.size() + 1 == numParams)
+        args.push_back(TokenList());  // no variable arguments
+
+    if (args.size() < numParams)
+    {
+        error(nameTok.line, "macro \"%s\" requires %u arguments, but only %u given",
+              nameTok.text.c_str(), unsigned(numParams), unsigned(args.size()));
+        return false;
+    }
+    if (args.size() > numParams)
+    {
+        error(nameTok.line, "macro \"%s\" passed %u arguments, but takes just %u",
+              nameTok.text.c_str(), unsigned(args.size()), unsigned(numParams));
+        return false;
+    }
+    return true;
+}
+
+
+// Replaces the parameters of 'macro' with 'args' in its body, and applies # and ##.
+// The hide sets and positions of the resulting tokens are left to the caller.
+//
+void
+Preprocessor::substitute(const Macro &macro, const vector<TokenList> &args, TokenList &result)
+{
+    const TokenList &body = macro.body;
+    bool emptyLeftOperand = false;  // true if the left operand of the next ## is an empty argument
+
+    for (size_t i = 0; i < body.size(); ++i)
+    {
+        const Token &tok = body[i];
+
+        if (macro.isFunctionLike && tok.is("#"))  // stringification
+        {
+            result.push_back(stringize(args[macro.getParamIndex(body[i + 1])], tok));
+            ++i;
+            continue;
+        }
+
+        // GNU extension: ", ## __VA_ARGS__" drops the comma if there are no variable arguments.
+        if (tok.is(",") && i + 2 < body.size() && body[i + 1].is("##")
+                && macro.isVariadic && macro.getParamIndex(body[i + 2]) == int(macro.params.size()) - 1)
+        {
+            const TokenList &va = args.back();
+            if (!va.empty())
+            {
+                result.push_back(tok);
+                result.insert(result.end(), va.begin(), va.end());
+            }
+            i += 2;
+            continue;
+        }
+
+        if (tok.is("##"))  // the left operand is at the end of 'result', unless it is empty
+        {
+            const Token &rhs = body[++i];
+            int paramIndex = macro.getParamIndex(rhs);
+            TokenList right;
+            if (paramIndex < 0)
+                right.push_back(rhs);
+            else
+                right = args[paramIndex];  // not expanded
+
+            if (emptyLeftOperand)  // an empty left operand gives the right operand
+            {
+                result.insert(result.end(), right.begin(), right.end());
+                emptyLeftOperand = right.empty();
+                continue;
+            }
+            if (right.empty())
+                continue;
+            TokenList::iterator r = right.begin();
+            if (!pasteTokens(result.back(), *r))
+                result.push_back(*r);
+            result.insert(result.end(), ++r, right.end());
+            continue;
+        }
+
+        emptyLeftOperand = false;
+
+        int paramIndex = macro.getParamIndex(tok);
+        if (paramIndex < 0)
+        {
+            result.push_back(tok);
+            continue;
+        }
+
+        const TokenList &arg = args[paramIndex];
+
+        if (i + 1 < body.size() && body[i + 1].is("##"))  // left operand of ##: not expanded
+        {
+            if (arg.empty())
+                emptyLeftOperand = true;
+            else
+            {
+                size_t first = result.size();
+                result.insert(result.end(), arg.begin(), arg.end());
+                result[first].precededBySpace = tok.precededBySpace;
+            }
+            continue;
+        }
+
+        TokenList expanded;
+        expandTokenList(arg, expanded);
+        if (i > 0)
+            result.push_back(makePadding(&tok));
+        result.insert(result.end(), expanded.begin(), expanded.end());
+        result.push_back(makePadding(NULL));
+    }
+}
+
+
+// Macro-expands 'input' on its own, as is done for a macro argument.
+//
+void
+Preprocessor::expandTokenList(const TokenList &input, TokenList &output)
+{
+    TokenStream stream(NULL);
+    stream.pending.assign(input.begin(), input.end());
+    Token tok;
+    while (stream.get(tok))
+        if (tok.kind != Token::IDENTIFIER || !expandMacro(stream, tok))
+            output.push_back(tok);
+}
+
+
+// Replaces 'left' with the concatenation of 'left' and 'right'.
+// Returns false if that does not give a single token, in which case 'left' is unchanged.
+//
+bool
+Preprocessor::pasteTokens(Token &left, const Token &right)
+{
+    string text = left.text + right.text;
+    TokenList tokens;
+    tokenize(text, tokens);
+    if (tokens.size() != 1 || tokens[0].text != text)
+    {
+        error(left.line, "pasting \"%s\" and \"%s\" does not give a valid preprocessing token",
+              left.text.c_str(), right.text.c_str());
+        return false;
+    }
+    left.kind = tokens[0].kind;
+    left.text = text;
+    return true;
+}
+
+
+Preprocessor::Token
+Preprocessor::stringize(const TokenList &arg, const Token &hashTok) const
+{
+    // Spaces are placed as in the output (see emitToken()).
+    string text = "\"";
+    bool first = true;
+    int spacing = -1;
+    for (TokenList::const_iterator it = arg.begin(); it != arg.end(); ++it)
+    {
+        if (it->kind == Token::PADDING)
+        {
+            if (spacing == -1 || (spacing == 0 && !it->hasPaddingSource))
+                spacing = (!it->hasPaddingSource ? -1 : it->precededBySpace ? 1 : 0);
+            continue;
+        }
+        if (!first && (spacing == -1 ? it->precededBySpace : spacing == 1))
+            text += ' ';
+        first = false;
+        spacing = -1;
+        if (it->kind == Token::STRING_LITERAL || it->kind == Token::CHAR_LITERAL)
+        {
+            string quoted = quote(it->text);
+            text.append(quoted, 1, quoted.length() - 2);
+        }
+        else
+            text += it->text;
+    }
+    text += '"';
+
+    Token tok(Token::STRING_LITERAL, text, hashTok.line, hashTok.column);
+    tok.precededBySpace = hashTok.precededBySpace;
+    return tok;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// #if expressions.
+
+
+// Evaluates an #if expression whose macros have been expanded.
+// Integers are computed as intmax_t or uintmax_t, as cpp does.
+// The operands that && || and ?: do not evaluate are still parsed,
+// but division errors and overflows in them are not diagnosed.
+//
+class Preprocessor::ExpressionEvaluator
+{
+public:
+
+    ExpressionEvaluator(const TokenList &_tokens)
+    :   tokens(_tokens), index(0), unevaluatedDepth(0), errorMessage(), overflowed(false) {}
+
+    // Returns false and sets 'message' if the expression is invalid.
+    //
+    bool evaluate(bool &result, string &message)
+    {
+        if (tokens.empty())
+        {
+            message = "#if with no expression";
+            return false;
+        }
+        Value v = parseConditional();
+        if (errorMessage.empty() && index < tokens.size())
+            errorMessage = "missing binary operator before token \"" + tokens[index].text + "\"";
+        if (!errorMessage.empty())
+        {
+            message = errorMessage;
+            return false;
+        }
+        result = (v.n != 0);
+        return true;
+    }
+
+    // Indicates if a signed division overflowed in an evaluated operand.
+    //
+    bool hasOverflowed() const { return overflowed; }
+
+private:
+
+    struct Value
+    {
+        long long n;
+        bool isUnsigned;
+
+        Value(long long _n = 0, bool _isUnsigned = false) : n(_n), isUnsigned(_isUnsigned) {}
+    };
+
+    const TokenList &tokens;
+    size_t index;
+    size_t unevaluatedDepth;  // > 0 while parsing an operand whose value is not used
+    string errorMessage;
+    bool overflowed;
+
+    bool accept(const char *op)
+    {
+        if (index < tokens.size() && tokens[index].is(op))
+        {
+            ++index;
+            return true;
+        }
+        return false;
+    }
+
+    void fail(const string &message)
+    {
+        if (errorMessage.empty())
+            errorMessage = message;
+        index = tokens.size();
+    }
+
+    Value parseConditional()
+    {
+        Value cond = parseBinary(0);
+        if (!accept("?"))
+            return cond;
+        Value a = parseOperand(cond.n == 0);
+        if (!accept(":"))
+        {
+            fail("expected ':' in #if expression");
+            return Value();
+        }
+        Value b = parseOperand(cond.n != 0);
+        bool isUnsigned = a.isUnsigned || b.isUnsigned;
+        return Value(cond.n != 0 ? a.n : b.n, isUnsigned);
+    }
+
+    // Returns the precedence of binary operator 'op', from 1 (||) to 10 (*), or 0.
+    //
+    static int getPrecedence(const Token &tok)
+    {
+        if (tok.kind != Token::PUNCTUATOR)
+            return 0;
+        static const char *levels[] = { "||", "&&", "|", "^", "&", "== !=", "< > <= >=", "<< >>", "+ -", "* / %", NULL };
+        for (int level = 0; levels[level] != NULL; ++level)
+        {
+            istringstream ops(levels[level]);
+            string op;
+            while (ops >> op)
+                if (tok.text == op)
+                    return level + 1;
+        }
+        return 0;
+    }
+
+    Value parseBinary(int minPrecedence)
+    {
+        Value left = parseUnary();
+        for (;;)
+        {
+            if (index >= tokens.size())
+                return left;
+            const Token &opTok = tokens[index];
+            int prec = getPrecedence(opTok);
+            if (prec == 0 || prec <= minPrecedence)
+                return left;
+            ++index;
+            bool shortCircuited = (opTok.text == "&&" && left.n == 0) || (opTok.text == "||" && left.n != 0);
+            if (shortCircuited)
+                ++unevaluatedDepth;
+            Value right = parseBinary(prec);
+            if (shortCircuited)
+                --unevaluatedDepth;
+            left = apply(opTok.text, left, right);
+        }
+    }
+
+    // Parses an operand of ?:, which is not evaluated if 'skipped' is true.
+    //
+    Value parseOperand(bool skipped)
+    {
+        if (skipped)
+            ++unevaluatedDepth;
+        Value v = parseConditional();
+        if (skipped)
+            --unevaluatedDepth;
+        return v;
+    }
+
+    Value apply(const string &op, Value a, Value b)
+    {
+        if (op == "||")
+            return Value(a.n != 0 || b.n != 0);
+        if (op == "&&")
+            return Value(a.n != 0 && b.n != 0);
+        if (op == "<<" || op == ">>")
+        {
+            bool left = (op == "<<") == (b.n >= 0 || b.isUnsigned);
+            unsigned long long count = (b.isUnsigned || b.n >= 0) ? (unsigned long long) b.n : (unsigned long long) -b.n;
+            if (count >= 64)
+                return Value(left || a.isUnsigned || a.n >= 0 ? 0 : -1, a.isUnsigned);
+            if (left)
+                return Value((long long) ((unsigned long long) a.n << count), a.isUnsigned);
+            if (a.isUnsigned)
+                return Value((long long) ((unsigned long long) a.n >> count), true);
+            return Value(a.n >> count);
+        }
+
+        bool isUnsigned = a.isUnsigned || b.isUnsigned;
+        unsigned long long ua = (unsigned long long) a.n, ub = (unsigned long long) b.n;
+        if (op == "==")
+            return Value(a.n == b.n);
+        if (op == "!=")
+            return Value(a.n != b.n);
+        if (op == "<")
+            return Value(isUnsigned ? ua < ub : a.n < b.n);
+        if (op == ">")
+            return Value(isUnsigned ? ua > ub : a.n > b.n);
+        if (op == "<=")
+            return Value(isUnsigned ? ua <= ub : a.n <= b.n);
+        if (op == ">=")
+            return Value(isUnsigned ? ua >= ub : a.n >= b.n);
+        if (op == "|")
+            return Value(a.n | b.n, isUnsigned);
+        if (op == "^")
+            return Value(a.n ^ b.n, isUnsigned);
+        if (op == "&")
+            return Value(a.n & b.n, isUnsigned);
+        if (op == "+")
+            return Value((long long) (ua + ub), isUnsigned);
+        if (op == "-")
+            return Value((long long) (ua - ub), isUnsigned);
+        if (op == "*")
+            return Value((long long) (ua * ub), isUnsigned);
+        if (b.n == 0)
+        {
+            if (unevaluatedDepth == 0)
+                fail("division by zero in #if");
+            return Value(0, isUnsigned);
+        }
+        if (op == "/")
+        {
+            if (isUnsigned)
+                return Value((long long) (ua / ub), true);
+            if (b.n == -1)  // avoid the undefined LLONG_MIN / -1
+            {
+                if (a.n == LLONG_MIN && unevaluatedDepth == 0)
+                    overflowed = true;
+                return Value((long long) (0ULL - ua));
+            }
+            return Value(a.n / b.n);
+        }
+        if (isUnsigned)
+            return Value((long long) (ua % ub), true);
+        return Value(b.n == -1 ? 0 : a.n % b.n);
+    }
+
+    Value parseUnary()
+    {
+        if (accept("+"))
+            return parseUnary();
+        if (accept("-"))
+        {
+            Value v = parseUnary();
+            return Value((long long) (0ULL - (unsigned long long) v.n), v.isUnsigned);
+        }
+        if (accept("~"))
+        {
+            Value v = parseUnary();
+            return Value(~v.n, v.isUnsigned);
+        }
+        if (accept("!"))
+            return Value(parseUnary().n == 0);
+        if (accept("("))
+        {
+            Value v = parseConditional();
+            if (!accept(")"))
+                fail("missing ')' in expression");
+            return v;
+        }
+        return parsePrimary();
+    }
+
+    Value parsePrimary()
+    {
+        if (index >= tokens.size())
+        {
+            fail("#if with no expression");
+            return Value();
+        }
+        const Token &tok = tokens[index++];
+        switch (tok.kind)
+        {
+        case Token::NUMBER:
+            return parseNumber(tok.text);
+        case Token::CHAR_LITERAL:
+            return parseCharLiteral(tok.text);
+        case Token::IDENTIFIER:
+            return Value(tok.text == "true" ? 1 : 0);  // undefined identifiers are 0
+        default:
+            fail("token \"" + tok.text + "\" is not valid in preprocessor expressions");
+            return Value();
+        }
+    }
+
+    Value parseNumber(const string &text)
+    {
+        char *end = NULL;
+        unsigned long long n = strtoull(text.c_str(), &end, 0);
+        bool isUnsigned = false;
+        for ( ; *end != '\0'; ++end)
+            if (*end == 'u' || *end == 'U')
+                isUnsigned = true;
+            else if (*end != 'l' && *end != 'L')
+            {
+                fail("invalid integer constant \"" + text + "\" in #if expression");
+                return Value();
+            }
+        return Value((long long) n, isUnsigned);
+    }
+
+    Value parseCharLiteral(const string &text)
+    {
+        size_t i = text.find('\'') + 1;
+        long long n = 0;
+        size_t numChars = 0;
+        while (i < text.length() && text[i] != '\'')
+        {
+            int c = (unsigned char) text[i++];
+            if (c == '\\' && i < text.length())
+            {
+                c = (unsigned char) text[i++];
+                switch (c)
+                {
+                case 'n': c = '\n'; break;
+                case 't': c = '\t'; break;
+                case 'r': c = '\r'; break;
+                case 'a': c = '\a'; break;
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'v': c = '\v'; break;
+                case 'x':
+                    for (c = 0; i < text.length() && isxdigit((unsigned char) text[i]); ++i)
+                        c = c * 16 + (isdigit((unsigned char) text[i]) ? text[i] - '0' : tolower(text[i]) - 'a' + 10);
+                    break;
+                default:
+                    if (c >= '0' && c <= '7')
+                    {
+                        c -= '0';
+                        for (int k = 0; k < 2 && i < text.length() && text[i] >= '0' && text[i] <= '7'; ++k)
+                            c = c * 8 + (text[i++] - '0');
+                    }
+                }
+            }
+            n = (n << 8) | (c & 0xFF);
+            ++numChars;
+        }
+        return Value(numChars == 1 ? (long long) (signed char) n : n);
+    }
+
+    // Forbidden:
+    ExpressionEvaluator(const ExpressionEvaluator &);
+    ExpressionEvaluator &operator = (const ExpressionEvaluator &);
+
+};
+
+
+// Evaluates the expression of an #if or #elif directive, which starts at line[start].
+//
+bool
+Preprocessor::evaluateCondition(const TokenList &line, size_t start, int directiveLine)
+{
+    // Replace the defined operators before expanding the macros.
+    TokenList expr;
+    for (size_t i = start; i < line.size(); ++i)
+    {
+        const Token &tok = line[i];
+        if (tok.kind != Token::IDENTIFIER || tok.text != "defined")
+        {
+            expr.push_back(tok);
+            continue;
+        }
+        bool inParens = (i + 1 < line.size() && line[i + 1].is("("));
+        size_t nameIndex = i + (inParens ? 2 : 1);
+        if (nameIndex >= line.size() || line[nameIndex].kind != Token::IDENTIFIER
+                || (inParens && (nameIndex + 1 >= line.size() || !line[nameIndex + 1].is(")"))))
+        {
+            error(directiveLine, "operator \"defined\" requires an identifier");
+            return false;
+        }
+        Token value(Token::NUMBER, isDefined(line[nameIndex].text) ? "1" : "0", tok.line, tok.column);
+        expr.push_back(value);
+        i = nameIndex + (inParens ? 1 : 0);
+    }
+
+    TokenList expanded, tokens;
+    expandTokenList(expr, expanded);
+    for (TokenList::const_iterator it = expanded.begin(); it != expanded.end(); ++it)
+        if (it->kind != Token::PADDING)
+            tokens.push_back(*it);
+
+    ExpressionEvaluator evaluator(tokens);
+    bool result = false;
+    string message;
+    if (!evaluator.evaluate(result, message))
+    {
+        error(directiveLine, "%s", message.c_str());
+        return false;
+    }
+    if (evaluator.hasOverflowed())
+        warning(directiveLine, "integer overflow in #if");
+    return result;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Diagnostics.
+
+
+int
+Preprocessor::getPresumedLine(int physicalLine) const
+{
+    return physicalLine + (contextStack.empty() ? 0 : contextStack.back()->lineDelta);
+}
+
+
+void
+Preprocessor::error(int line, const char *fmt, ...)
+{
+    errorReported = true;
+    stringstream location;
+    location << (contextStack.empty() ? string("<command-line>") : contextStack.back()->name)
+             << ":" << getPresumedLine(line);
+    va_list ap;
+    va_start(ap, fmt);
+    diagnoseVa("error", location.str(), fmt, ap);
+    va_end(ap);
+}
+
+
+void
+Preprocessor::warning(int line, const char *fmt, ...)
+{
+    stringstream location;
+    location << (contextStack.empty() ? string("<command-line>") : contextStack.back()->name)
+             << ":" << getPresumedLine(line);
+    va_list ap;
+    va_start(ap, fmt);
+    diagnoseVa("warning", location.str(), fmt, ap);
+    va_end(ap);
+}
@@ -0,0 +1,287 @@
+/*  $Id$
+
+    CMOC - A C-like cross-compiler
+    Copyright (C) 2003-2015 Pierre Sarrazin <http://sarrazip.com/>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _H_Preprocessor
+#define _H_Preprocessor
+
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <set>
+#include <deque>
+
+
+// C preprocessor that runs inside the compiler, instead of an external cpp
+// process. Its output has the same form as that of GNU cpp, i.e., the source
+// text with the macros expanded, #include markers of the form # NUM "FILENAME",
+// and the #pragma directives left in place. The lexer reads that output.
+//
+// The tokens of each header file are kept in a FileCache, together with the
+// name of the macro that guards the file against multiple inclusion, if any.
+// When the Preprocessor objects of several .c files share a cache, a header
+// like cmoc.h is only read and tokenized once.
+//
+// A header can also be saved as a precompiled header (see --pch), i.e., the
+// text that it produces once preprocessed, and the macros that are defined
+// at its end. Loading that file is faster than preprocessing the header,
+// and its included headers, in each compilation. The declarations of the
+// header are still parsed by each compilation.
+//
+// Errors and warnings are reported like those of the compiler, with the name
+// of the file and the line number.
+//
+class Preprocessor
+{
+public:
+
+    class FileCache;
+
+    // includeDirs: Directories searched by #include, in order.
+    // fileCache: Receives the tokens of the files read by this object.
+    //
+    Preprocessor(const std::list<std::string> &includeDirs, FileCache &fileCache);
+
+    ~Preprocessor();
+
+    // Defines a macro from a command-line argument of the form NAME, NAME=BODY
+    // or NAME(PARAMS)=BODY. NAME alone defines NAME as 1, like cpp -D.
+    //
+    void defineMacro(const std::string &definition);
+
+    // Preprocesses the file named 'filename' and stores the result in 'output'.
+    // Returns false if an error was reported.
+    // Must not be called more than once per Preprocessor object.
+    //
+    bool preprocessFile(const std::string &filename, std::string &output);
+
+    // Preprocesses the header file named 'filename' and writes the result,
+    // with the macros defined at the end of the header, to a precompiled header
+    // named 'pchFilename'. Returns false if an error was reported.
+    // Must not be called more than once per Preprocessor object.
+    //
+    bool writePrecompiledHeader(const std::string &filename, const std::string &pchFilename);
+
+    // Loads a precompiled header written by writePrecompiledHeader().
+    // preprocessFile() then behaves as if the header were #included before
+    // the first line of the file, and a later #include of it does nothing.
+    // Must be called after defineMacro(), with the same macro definitions and
+    // include directories as when the precompiled header was written.
+    // If one of the files that the precompiled header was made from has changed
+    // since, a warning is issued and preprocessFile() preprocesses the header
+    // itself instead.
+    // Returns false if an error was reported.
+    //
+    bool loadPrecompiledHeader(const std::string &pchFilename);
+
+private:
+
+    struct HideSet;
+    class ExpressionEvaluator;
+
+    struct Token
+    {
+        // A PADDING token is not output. It marks the start or the end of a macro
+        // expansion, where a space may be needed to keep two tokens apart.
+        //
+        enum Kind { IDENTIFIER, NUMBER, CHAR_LITERAL, STRING_LITERAL, PUNCTUATOR, OTHER, PADDING };
+
+        Kind kind;
+        std::string text;
+        int line;      // physical line in the source file; for a token produced
+                       // by a macro, line of the outermost macro invocation
+        int column;    // 1-based
+        bool atLineStart;
+        bool precededBySpace;
+        bool fromMacro;
+        bool hasPaddingSource;  // PADDING only: if true, precededBySpace is the spacing
+                                // of the macro name or parameter that the padding replaces
+        const HideSet *hideSet;  // macros that must not be expanded again on this token
+
+        Token(Kind _kind = OTHER, const std::string &_text = std::string(), int _line = 0, int _column = 0);
+
+        bool is(const char *s) const { return (kind == PUNCTUATOR || kind == OTHER) && text == s; }
+    };
+
+    typedef std::vector<Token> TokenList;
+
+    struct HideSet
+    {
+        std::string name;
+        const HideSet *next;
+    };
+
+    // Tokenized contents of a source file.
+    //
+    struct SourceFile
+    {
+        TokenList tokens;  // a directive ends before the next token that is at the start of a line
+        std::string guardMacro;  // non-empty if the whole file is in #ifndef guardMacro ... #endif
+
+        SourceFile() : tokens(), guardMacro() {}
+    };
+
+    struct Macro
+    {
+        bool isFunctionLike;
+        bool isVariadic;  // true if last parameter is __VA_ARGS__
+        std::vector<std::string> params;
+        TokenList body;
+        std::string filename;  // where this macro was defined
+        int line;
+
+        Macro() : isFunctionLike(false), isVariadic(false), params(), body(), filename(), line(0) {}
+
+        bool isSameDefinition(const Macro &m) const;
+        int getParamIndex(const Token &tok) const;
+    };
+
+    // A sequence of tokens being read, i.e., a source file with tokens pushed in front
+    // of it by macro expansions, or a token list that is being macro-expanded on its own.
+    //
+    struct TokenStream
+    {
+        std::deque<Token> pending;
+        const TokenList *tokens;  // may be null
+        size_t index;  // in 'tokens'
+
+        TokenStream(const TokenList *_tokens) : pending(), tokens(_tokens), index(0) {}
+
+        bool hasPending() const { return !pending.empty(); }
+        const Token *peek() const;  // skips PADDING tokens
+        bool get(Token &tok);
+        void pushFront(const TokenList &list);
+    };
+
+    // File being preprocessed, i.e., the main source file or an #included file.
+    //
+    struct FileContext
+    {
+        const SourceFile *file;
+        std::string name;  // as used in #include markers and __FILE__
+        std::string dir;   // directory searched first by #include "..."
+        int lineDelta;     // set by #line
+        TokenStream stream;
+
+        FileContext(const SourceFile *_file, const std::string &_name);
+    };
+
+    struct Conditional
+    {
+        bool groupTaken;  // true if one of the groups of this #if has been included
+        bool elseSeen;
+        int line;  // of the #if, #ifdef or #ifndef
+    };
+
+    typedef std::map<std::string, Macro> MacroTable;
+
+    FileCache &fileCache;  // not owned by this object
+    std::vector<std::string> includeDirs;
+    std::vector<std::string> commandLineDefinitions;  // arguments of the defineMacro() calls
+    MacroTable macros;
+    std::set<std::string> onceOnlyFiles;  // paths of files that contained #pragma once
+    std::set<std::string> includedFiles;  // paths of the files processed by #include
+    std::string precompiledText;  // output of the precompiled header loaded, if any
+    std::string headerReplacingPrecompiledHeader;  // header preprocessed instead of an out of date precompiled header
+    std::vector<FileContext *> contextStack;
+    std::list<HideSet> hideSetPool;
+    std::string baseFilename;
+    unsigned counter;  // value of next __COUNTER__
+    bool errorReported;
+    bool fatalError;  // true means stop preprocessing
+    std::string dateString, timeString;
+
+    // Output state.
+    std::string *out;
+    int outLine;
+    bool outLinePrinted;  // true if something has been written on the current output line
+    bool avoidPaste;
+    int paddingSpacing;  // -1 if no padding source, otherwise 1 if it has a space before it, 0 if not
+    bool havePrevToken;
+    Token prevToken;
+
+    static bool readSourceFile(const std::string &path, SourceFile &sourceFile);
+    static void tokenize(const std::string &text, TokenList &tokens);
+    static void findGuardMacro(SourceFile &sourceFile);
+    static Token makePadding(const Token *source);
+    static bool avoidsPaste(const Token &prev, const Token &tok);
+    static std::string quote(const std::string &s);
+    static std::string getDefinitionText(const std::string &name, const Macro &macro);
+
+    void emitToken(const Token &tok);
+    void emitLineSync(int line);
+    void emitLineChange(int line, int column);
+    void emitLineMarker(int line, const std::string &filename, const char *flag);
+    void outputPragma(const TokenList &line, size_t start, int directiveLine);
+
+    void processFile(const SourceFile &file, const std::string &name);
+    void readDirectiveLine(FileContext &ctx, TokenList &line);
+    void processDirective(FileContext &ctx, std::vector<Conditional> &conditionals, const Token &hash);
+    void skipGroups(FileContext &ctx, std::vector<Conditional> &conditionals);
+    const SourceFile *findIncludedFile(const std::string &name, bool isAngled, std::string &path);
+    void processInclude(FileContext &ctx, const TokenList &line, int directiveLine, int lastLine);
+    void processLineDirective(FileContext &ctx, const TokenList &line, size_t start, int lastLine);
+    bool readMacroDefinition(const TokenList &line, size_t start, const std::string &filename, int lineNo);
+    bool isDefined(const std::string &name) const;
+
+    static bool hideSetContains(const HideSet *hs, const std::string &name);
+    const HideSet *addToHideSet(const HideSet *hs, const std::string &name);
+    const HideSet *unionHideSets(const HideSet *a, const HideSet *b);
+    const HideSet *intersectHideSets(const HideSet *a, const HideSet *b);
+
+    bool expandMacro(TokenStream &stream, const Token &nameTok);
+    bool expandBuiltinMacro(TokenStream &stream, const Token &nameTok);
+    bool collectArguments(TokenStream &stream, const Token &nameTok, const Macro &macro,
+                          std::vector<TokenList> &args, const HideSet *&rparenHideSet);
+    void substitute(const Macro &macro, const std::vector<TokenList> &args, TokenList &result);
+    void expandTokenList(const TokenList &input, TokenList &output);
+    bool pasteTokens(Token &left, const Token &right);
+    Token stringize(const TokenList &arg, const Token &hashTok) const;
+    bool evaluateCondition(const TokenList &line, size_t start, int directiveLine);
+
+    int getPresumedLine(int physicalLine) const;
+    void error(int line, const char *fmt, ...);
+    void warning(int line, const char *fmt, ...);
+
+    // Forbidden:
+    Preprocessor(const Preprocessor &);
+    Preprocessor &operator = (const Preprocessor &);
+
+};
+
+
+// Tokenized header files, shared by the Preprocessor objects that are given
+// the same cache. Not to be used by two threads at the same time.
+//
+class Preprocessor::FileCache
+{
+public:
+
+    FileCache() : files() {}
+
+private:
+
+    friend class Preprocessor;
+
+    std::map<std::string, SourceFile> files;  // key: file path
+
+};
+
+
+#endif  /* _H_Preprocessor */
@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <iterator>
 #include <iomanip>
+#include <math.h>
 
 using namespace std;
 
@@ -162,6 +163,29 @@ RealConstantExpr::getRepresentation() const
 }
 
 
+/*static*/
+double
+RealConstantExpr::toTargetPrecision(double value, bool round)
+{
+    int numMantissaBits = 0;
+    switch (TranslationUnit::instance().getTargetPlatform())
+    {
+    case COCO_BASIC: numMantissaBits = 32; break;
+    case OS9:        numMantissaBits = 24; break;
+    default:         return double(float(value));
+    }
+
+    if (value == 0.0 || value - value != 0.0)  // if zero, infinite or NaN
+        return value;
+
+    int exponent = 0;
+    double mantissa = ldexp(frexp(fabs(value), &exponent), numMantissaBits);  // frexp() gives [0.5, 1)
+    mantissa = (round ? floor(mantissa + 0.5) : floor(mantissa));
+    double result = ldexp(mantissa, exponent - numMantissaBits);
+    return value < 0.0 ? - result : result;
+}
+
+
 uint32_t
 RealConstantExpr::getDWordValue() const
 {
@@ -41,6 +41,15 @@ public:
 
     uint32_t getDWordValue() const;
 
+    // Returns 'value' with the precision of the mantissa of the target platform's
+    // floating-point format: 32 bits for Color Basic, 24 bits for OS-9,
+    // or that of the host's float type for the other platforms.
+    // The extra bits are dropped if 'round' is false, as getRepresentation() does
+    // for a literal. Otherwise, the value is rounded to the nearest, with ties
+    // away from zero, as the target's arithmetic routines do with their results.
+    //
+    static double toTargetPrecision(double value, bool round);
+
     void negateValue() { realValue = - realValue; }
 
     // Returns an IEEE-754-ish representation of the real value,
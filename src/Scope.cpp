@@ -34,6 +34,7 @@ Scope::Scope(Scope *_parent, const string &_startLineNo)
   : parent(_parent),
     subScopes(),
     declTable(),
+    declMap(),
     classTable(),
     startLineNo(_startLineNo)
 {
@@ -170,6 +171,7 @@ Scope::declareVariable(Declaration *d)
             //
             declTable.erase(findInVectorOfPairsByKey(declTable, id));
             declTable.push_back(make_pair(id, d));
+            declMap[id] = d;
             return true;
         }
 
@@ -188,6 +190,7 @@ Scope::declareVariable(Declaration *d)
     }
 
     declTable.push_back(make_pair(id, d));
+    declMap[id] = d;
     return true;
 }
 
@@ -195,9 +198,9 @@ Scope::declareVariable(Declaration *d)
 Declaration *
 Scope::getVariableDeclaration(const string &id, bool lookInAncestors) const
 {
-    for (DeclarationTable::const_iterator it = declTable.begin(); it != declTable.end(); ++it)
-        if (it->first == id)
-            return it->second;
+    map<string, Declaration *>::const_iterator it = declMap.find(id);
+    if (it != declMap.end())
+        return it->second;
 
     if (lookInAncestors && parent != NULL)
         return parent->getVariableDeclaration(id, lookInAncestors);
@@ -213,6 +216,7 @@ Scope::destroyDeclarations()
         delete it->second;
 
     declTable.clear();
+    declMap.clear();
 }
 
 
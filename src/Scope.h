@@ -112,6 +112,9 @@ private:
     DeclarationTable declTable;
                                 // does not own the pointed objects
                                 // no two entries may have same string value
+    std::map<std::string, Declaration *> declMap;
+                                // same declarations as declTable, indexed by ID
+                                // for getVariableDeclaration(); declTable gives the order
     std::map<std::string, ClassDef *> classTable;
                                 // owns the pointed objects
     std::string startLineNo;
@@ -78,9 +78,10 @@ ScopeCreator::privateOpen(Tree *t)
     // Compound statements (other than a function's top braces) create a scope.
     // So do the for() and while() statement bodies.
     //
-    if (   (dynamic_cast<CompoundStmt *>(t) && ancestors.size() > 0)
-        || dynamic_cast<ForStmt *>(t)
-        || dynamic_cast<WhileStmt *>(t))
+    Tree::NodeKind kind = t->getNodeKind();
+    if (   (kind == Tree::COMPOUND_STMT_NODE && ancestors.size() > 0)
+        || kind == Tree::FOR_STMT_NODE
+        || kind == Tree::WHILE_STMT_NODE)
     {
         Scope *s = new Scope(cs, t->getLineNo());
         assert(s->getParent() == cs);
@@ -93,13 +94,14 @@ ScopeCreator::privateOpen(Tree *t)
         return true;
     }
 
-    DeclarationSequence *declSeq = dynamic_cast<DeclarationSequence *>(t);
-    if (declSeq != NULL)
+    if (kind == Tree::DECLARATION_SEQUENCE_NODE)
     {
+        DeclarationSequence *declSeq = static_cast<DeclarationSequence *>(t);
         for (std::vector<Tree *>::iterator it = declSeq->begin(); it != declSeq->end(); ++it)
         {
-            if (Declaration *decl = dynamic_cast<Declaration *>(*it))
+            if ((*it)->getNodeKind() == Tree::DECLARATION_NODE)
             {
+                Declaration *decl = static_cast<Declaration *>(*it);
                 /*cout << "# ScopeCreator::privateOpen(" << t << "): Declaration: " << decl->getVariableId()
                         << " at line " << decl->getLineNo()
                         << ", cs=" << cs << "\n";*/
@@ -117,15 +119,15 @@ ScopeCreator::privateOpen(Tree *t)
         return true;
     }
 
-    IdentifierExpr *ie = dynamic_cast<IdentifierExpr *>(t);
-    if (ie)
+    if (kind == Tree::IDENTIFIER_EXPR_NODE)
     {
-        processIdentifierExpr(*ie);
+        processIdentifierExpr(*static_cast<IdentifierExpr *>(t));
         return true;
     }
 
-    if (const AssemblerStmt *ae = dynamic_cast<AssemblerStmt *>(t))
+    if (kind == Tree::ASSEMBLER_STMT_NODE)
     {
+        const AssemblerStmt *ae = static_cast<AssemblerStmt *>(t);
         set<string> varNames;
         ae->getAllVariableNames(varNames);
         for (set<string>::const_iterator it = varNames.begin(); it != varNames.end(); ++it)
@@ -137,9 +139,9 @@ ScopeCreator::privateOpen(Tree *t)
         }
     }
 
-    FunctionCallExpr *fce = dynamic_cast<FunctionCallExpr *>(t);
-    if (fce)
+    if (kind == Tree::FUNCTION_CALL_EXPR_NODE)
     {
+        FunctionCallExpr *fce = static_cast<FunctionCallExpr *>(t);
         // Process a call through a pointer. Note that we can't call isCallThroughPointer()
         // on 'fce' yet because that method relies on FunctionCallExpr::funcPtrVarDecl,
         // which is the member we are going to initialize here.
@@ -54,7 +54,7 @@ SemanticsChecker::open(Tree *t)
     //        To avoid this patch, the use of ScopeCreator should be taken out of FunctionDef::checkSemantics()
     //        and the ScopeCreator should be invoked before using the SemanticsChecker.
     //
-    if (dynamic_cast<FunctionDef *>(t))
+    if (t->getNodeKind() == Tree::FUNCTION_DEF_NODE)
         TranslationUnit::instance().pushScope(t->getScope());
 
     return true;
@@ -68,9 +68,9 @@ SemanticsChecker::close(Tree *t)
 
     t->popScopeIfExists();
 
-    if (const FunctionDef *fd = dynamic_cast<FunctionDef *>(t))
+    if (t->getNodeKind() == Tree::FUNCTION_DEF_NODE)
     {
-        if (fd->getBody())  // if end of function body
+        if (static_cast<FunctionDef *>(t)->getBody())  // if end of function body
             setCurrentFunctionDef(NULL);  // no more current function
     }
     return true;
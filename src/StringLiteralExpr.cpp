@@ -31,6 +31,8 @@ StringLiteralExpr::StringLiteralExpr(const string &literal)
     asmLabel(),
     emitted(false)
 {
+    setNodeKind(STRING_LITERAL_EXPR_NODE);
+
     bool hexEscapeOutOfRange = false, octalEscapeOutOfRange = false;
 
     stringValue = decodeEscapedLiteral(hexEscapeOutOfRange, octalEscapeOutOfRange);
@@ -23,29 +23,18 @@
 #include "BinaryOpExpr.h"
 #include "CompoundStmt.h"
 #include "LabeledStmt.h"
+#include "FunctionDef.h"
 
 using namespace std;
 
 
-bool SwitchStmt::isJumpModeForced = false;
-SwitchStmt::JumpMode SwitchStmt::forcedJumpMode = IF_ELSE;
-
-
-// static
-void
-SwitchStmt::forceJumpMode(JumpMode _forcedJumpMode)
-{
-    isJumpModeForced = true;
-    forcedJumpMode = _forcedJumpMode;
-}
-
-
 SwitchStmt::SwitchStmt(Tree *_expression, Tree *_statement)
   : Tree(),
     expression(_expression),
     statement(_statement),
     cases()
 {
+    setNodeKind(SWITCH_STMT_NODE);
 }
 
 
@@ -284,8 +273,22 @@ SwitchStmt::emitCode(ASMText &out, bool lValue) const
     size_t ifElseCost = computeJumpModeCost(IF_ELSE, caseValues);
     size_t jumpTableCost = computeJumpModeCost(JUMP_TABLE, caseValues);
 
+    JumpMode forcedJumpMode = IF_ELSE;
+    bool isJumpModeForced = tu.getForcedSwitchJumpMode(forcedJumpMode);
     JumpMode jumpMode = (isJumpModeForced ? forcedJumpMode : (ifElseCost <= jumpTableCost ? IF_ELSE : JUMP_TABLE));
 
+    // In a function that the execution profile (see --profile-use) shows to be hot,
+    // choose the faster mode instead of the smaller one.
+    const FunctionDef *currentFunction = tu.getCurrentFunction();
+    if (!isJumpModeForced && currentFunction != NULL && currentFunction->isHot())
+    {
+        size_t ifElseCycles = computeJumpModeCycles(IF_ELSE, caseValues);
+        size_t jumpTableCycles = computeJumpModeCycles(JUMP_TABLE, caseValues);
+        jumpMode = (ifElseCycles <= jumpTableCycles ? IF_ELSE : JUMP_TABLE);
+        out.emitComment("Hot function: IF_ELSE takes " + dwordToString(uint32_t(ifElseCycles))
+                        + " cycles on average, JUMP_TABLE takes " + dwordToString(uint32_t(jumpTableCycles)));
+    }
+
     // Override isJumpModeForced if jump table cost is way higher.
     if (jumpTableCost > ifElseCost && jumpTableCost - ifElseCost >= 256)
         jumpMode = IF_ELSE;
@@ -467,6 +470,35 @@ SwitchStmt::computeJumpModeCost(JumpMode jumpMode,
 }
 
 
+// Estimates the average number of cycles taken to reach the code of a case,
+// assuming that each case, and the default case, is equally likely.
+// caseValues: Must be sorted by case value.
+//
+size_t
+SwitchStmt::computeJumpModeCycles(JumpMode jumpMode,
+                                  const vector<CaseValueAndIndexPair> &caseValues) const
+{
+    bool exprIsByte = (expression->getType() == BYTE_TYPE);
+    switch (jumpMode)
+    {
+    case IF_ELSE:
+        {
+            // CMPB/CMPD with immediate argument, then LBEQ, which takes 5 cycles,
+            // or 6 when the branch is taken. The k-th case value is reached after
+            // k comparisons. The default case is reached after all comparisons and an LBRA.
+            size_t n = caseValues.size();
+            size_t compareCycles = (exprIsByte ? 2 : 5) + 5;
+            return ((n * (n + 1) / 2 + n) * compareCycles + n + 5) / (n + 1);
+        }
+    case JUMP_TABLE:
+        // CLRA/SEX if needed, LEAX, LBRA, then the 43 cycles of the longest path
+        // through signedJumpTableSwitch/unsignedJumpTableSwitch.
+        return (exprIsByte ? 2 : 0) + 9 + 5 + 43;
+    }
+    return 0;
+}
+
+
 bool
 SwitchStmt::iterate(Functor &f)
 {
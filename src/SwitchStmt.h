@@ -28,10 +28,9 @@ class SwitchStmt : public Tree
 {
 public:
 
+    // See also TranslationUnit::forceSwitchJumpMode().
     enum JumpMode { IF_ELSE, JUMP_TABLE };
 
-    static void forceJumpMode(JumpMode _forcedJumpMode);
-
     // Represents a case statement or the default statement.
     //
     struct SwitchCase
@@ -83,6 +82,7 @@ private:
     static bool signedCaseValueComparator(const CaseValueAndIndexPair &a, const CaseValueAndIndexPair &b);
     static bool unsignedCaseValueComparator(const CaseValueAndIndexPair &a, const CaseValueAndIndexPair &b);
     size_t computeJumpModeCost(JumpMode jumpMode, const std::vector<CaseValueAndIndexPair> &caseValues) const;
+    size_t computeJumpModeCycles(JumpMode jumpMode, const std::vector<CaseValueAndIndexPair> &caseValues) const;
 
     // Forbidden:
     SwitchStmt(const SwitchStmt &);
@@ -94,9 +94,6 @@ public:
     Tree *statement;   // owns the pointed object
     SwitchCaseList cases;  // includes the 'default' clause, if any
 
-    static bool isJumpModeForced;
-    static JumpMode forcedJumpMode;
-
 };
 
 
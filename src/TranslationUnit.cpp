@@ -35,15 +35,18 @@
 #include "SwitchStmt.h"
 #include "LabeledStmt.h"
 #include "ExpressionTypeSetter.h"
+#include "AssemblerStmt.h"
 
 #include <assert.h>
 #include <errno.h>
 #include <fstream>
+#include <iomanip>
+#include <algorithm>
 
 using namespace std;
 
 
-/*static*/ TranslationUnit *TranslationUnit::theInstance = NULL;
+/*static*/ thread_local TranslationUnit *TranslationUnit::theInstance = NULL;
 
 
 void
@@ -86,7 +89,8 @@ TranslationUnit::TranslationUnit(TargetPlatform _targetPlatform,
                                  bool _isBinaryOpGivingByteWarningEnabled,
                                  bool _isLocalVariableHidingAnotherWarningEnabled,
                                  bool _relocatabilitySupported)
-  : typeManager(),
+  : treeArena(),
+    typeManager(),
     globalScope(NULL),
     definitionList(NULL),
     functionDefs(),
@@ -95,6 +99,7 @@ TranslationUnit::TranslationUnit(TargetPlatform _targetPlatform,
     scopeStack(),
     breakableStack(),
     functionEndLabel(),
+    currentFunction(NULL),
     labelGeneratorIndex(0),
     stringLiteralLabelToValue(),
     stringLiteralValueToLabel(),
@@ -102,6 +107,8 @@ TranslationUnit::TranslationUnit(TargetPlatform _targetPlatform,
     realConstantValueToLabel(),
     dwordConstantLabelToValue(),
     dwordConstantValueToLabel(),
+    initializerImageLabelToValue(),
+    initializerImageValueToLabel(),
     builtInFunctionDescs(),
     relocatabilitySupported(_relocatabilitySupported),
     isProgramExecutableOnlyOnce(false),
@@ -115,6 +122,8 @@ TranslationUnit::TranslationUnit(TargetPlatform _targetPlatform,
     isBinaryOpGivingByteWarningEnabled(_isBinaryOpGivingByteWarningEnabled),
     isLocalVariableHidingAnotherWarningEnabled(_isLocalVariableHidingAnotherWarningEnabled),
     warnedAboutVolatile(false),
+    warnedAboutDoubleType(false),
+    warnedAboutDoublePrecisionLiteral(false),
     neededUtilitySubRoutines(),
     targetPlatform(_targetPlatform),
     vxTitle("CMOC"),
@@ -124,9 +133,23 @@ TranslationUnit::TranslationUnit(TargetPlatform _targetPlatform,
     vxTitlePosX(-0x56),
     vxTitlePosY(0x20),
     vxCopyright("2015"),
-    sourceFilenamesSeen()
+    sourceFilenamesSeen(),
+    sourceFilenames(),
+    sourceFilenameIds(),
+    currentSourceFilenameId(0),
+    currentLineNo(1),
+    numErrors(0),
+    numWarnings(0),
+    functionStackSpace(0),
+    executionCounts(),
+    totalExecutionCount(0),
+    blockExecutionCounts(),
+    moduleName(),
+    isSwitchJumpModeForced(false),
+    forcedSwitchJumpMode(SwitchStmt::IF_ELSE)
 {
     theInstance = this;  // instance() needed by Scope constructor
+    currentSourceFilenameId = internSourceFilename(string());  // until the lexer sees an #include marker
     typeManager.createBasicTypes();
     globalScope = new Scope(NULL, string());  // requires 'void', i.e., must come after createBasicTypes()
     typeManager.createInternalStructs(*globalScope, targetPlatform);  // global scope must be created; receives internal structs
@@ -251,6 +274,39 @@ TranslationUnit::registerFunctionCall(const string &callerId, const string &call
 }
 
 
+// Passes each node to several Functors, so that they can do their work
+// in a single traversal of the tree. Each node is given to the functors in
+// the order in which they were added. Each functor thus sees the nodes
+// in the same order as if it were used alone, but a functor must not depend
+// on work that another functor does on nodes that come later in the tree.
+//
+class FunctorList : public Tree::Functor
+{
+public:
+    FunctorList() : functors() {}
+    void add(Tree::Functor &f)
+    {
+        functors.push_back(&f);
+    }
+    virtual bool open(Tree *t)
+    {
+        for (vector<Tree::Functor *>::iterator it = functors.begin(); it != functors.end(); ++it)
+            if (!(*it)->open(t))
+                return false;
+        return true;
+    }
+    virtual bool close(Tree *t)
+    {
+        for (vector<Tree::Functor *>::iterator it = functors.begin(); it != functors.end(); ++it)
+            if (!(*it)->close(t))
+                return false;
+        return true;
+    }
+private:
+    vector<Tree::Functor *> functors;  // does not own the pointed objects
+};
+
+
 // Checks function prototypes, definitions and calls.
 //
 class FunctionChecker : public Tree::Functor
@@ -264,12 +320,13 @@ public:
     }
     virtual bool open(Tree *t)
     {
-        if (FunctionDef *fd = dynamic_cast<FunctionDef *>(t))
+        if (t->getNodeKind() == Tree::FUNCTION_DEF_NODE)
         {
-            processFunctionDef(fd);
+            processFunctionDef(static_cast<FunctionDef *>(t));
         }
-        else if (FunctionCallExpr *fc = dynamic_cast<FunctionCallExpr *>(t))
+        else if (t->getNodeKind() == Tree::FUNCTION_CALL_EXPR_NODE)
         {
+            FunctionCallExpr *fc = static_cast<FunctionCallExpr *>(t);
             if (!fc->isCallThroughPointer())
             {
                 string funcId = fc->getIdentifier();
@@ -326,6 +383,57 @@ private:
 };
 
 
+// Finds the names that are used other than as the callee of a direct call,
+// e.g., f in &f, pf = f or (*f)(). A function whose name is so used
+// may be called through a pointer, so it must keep the standard calling convention.
+// Must be run before the SemanticsChecker, while names are still IdentifierExpr objects.
+// The result is used by TranslationUnit::passStaticFunctionParamsInRegisters().
+// Names used in inline assembly are also treated as having their address taken.
+//
+class FunctionAddressFinder : public Tree::Functor
+{
+public:
+    FunctionAddressFinder() : directCallees(), addressedNames(), asmStmts() {}
+    virtual bool open(Tree *t)
+    {
+        switch (t->getNodeKind())
+        {
+        case Tree::FUNCTION_CALL_EXPR_NODE:
+            if (const Tree *callee = static_cast<FunctionCallExpr *>(t)->getFunctionExpr())
+                directCallees.insert(callee);
+            break;
+        case Tree::IDENTIFIER_EXPR_NODE:
+            if (directCallees.find(t) == directCallees.end())
+                addressedNames.insert(static_cast<IdentifierExpr *>(t)->getId());
+            break;
+        case Tree::ASSEMBLER_STMT_NODE:
+            asmStmts.push_back(static_cast<AssemblerStmt *>(t));
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+    virtual bool close(Tree * /*t*/)
+    {
+        return true;
+    }
+    bool isAddressTaken(const string &funcId) const
+    {
+        if (addressedNames.find(funcId) != addressedNames.end())
+            return true;
+        for (vector<const AssemblerStmt *>::const_iterator it = asmStmts.begin(); it != asmStmts.end(); ++it)
+            if ((*it)->mentionsName(funcId))
+                return true;
+        return false;
+    }
+private:
+    set<const Tree *> directCallees;
+    set<string> addressedNames;
+    vector<const AssemblerStmt *> asmStmts;
+};
+
+
 // Checks for labeled statements used outside of a switch() statement.
 //
 class LabeledStmtChecker : public Tree::Functor
@@ -338,16 +446,19 @@ public:
     }
     virtual bool open(Tree *t)
     {
-        if (dynamic_cast<SwitchStmt *>(t))
+        if (t->getNodeKind() == Tree::SWITCH_STMT_NODE)
             ++switchLevel;
-        const LabeledStmt *ls = NULL;
-        if (switchLevel == 0 && (ls = dynamic_cast<LabeledStmt *>(t)) && ls->isCaseOrDefault())
-            t->errormsg("%s label not within a switch statement", ls->isCase() ? "case" : "default");
+        else if (switchLevel == 0 && t->getNodeKind() == Tree::LABELED_STMT_NODE)
+        {
+            const LabeledStmt *ls = static_cast<LabeledStmt *>(t);
+            if (ls->isCaseOrDefault())
+                t->errormsg("%s label not within a switch statement", ls->isCase() ? "case" : "default");
+        }
         return true;
     }
     virtual bool close(Tree *t)
     {
-        if (dynamic_cast<SwitchStmt *>(t))
+        if (t->getNodeKind() == Tree::SWITCH_STMT_NODE)
             --switchLevel;
         return true;
     }
@@ -390,20 +501,22 @@ public:
 
     virtual bool open(Tree *t)
     {
-        if (const Declaration *decl = dynamic_cast<Declaration *>(t))
+        if (t->getNodeKind() == Tree::DECLARATION_NODE)
         {
+            const Declaration *decl = static_cast<Declaration *>(t);
             if (decl->isGlobal())
             {
                 assert(!decl->getVariableId().empty());
                 globalsEncountered.insert(decl->getVariableId());
             }
         }
-        else if (const IdentifierExpr *ie = dynamic_cast<IdentifierExpr *>(t))
+        else if (t->getNodeKind() == Tree::IDENTIFIER_EXPR_NODE)
         {
+            const IdentifierExpr *ie = static_cast<IdentifierExpr *>(t);
             const VariableExpr *ve = ie->getVariableExpr();
             if (ve && !ve->isFuncAddrExpr())
             {
-                decl = ve->getDeclaration();
+                const Declaration *decl = ve->getDeclaration();
                 assert(decl);
                 if (decl->isGlobal())
                 {
@@ -432,18 +545,20 @@ public:
     StringLiteralRegistererererer() : currentFunctionDef(NULL) {}
     virtual bool open(Tree *t)
     {
-        if (StringLiteralExpr *sle = dynamic_cast<StringLiteralExpr *>(t))
+        if (t->getNodeKind() == Tree::STRING_LITERAL_EXPR_NODE)
         {
+            StringLiteralExpr *sle = static_cast<StringLiteralExpr *>(t);
             sle->setLabel(TranslationUnit::instance().registerStringLiteral(*sle));
             return true;
         }
-        if (FunctionDef *fd = dynamic_cast<FunctionDef *>(t))
+        if (t->getNodeKind() == Tree::FUNCTION_DEF_NODE)
         {
-            currentFunctionDef = fd;
+            currentFunctionDef = static_cast<FunctionDef *>(t);
             return true;
         }
-        if (IdentifierExpr *ie = dynamic_cast<IdentifierExpr *>(t))
+        if (t->getNodeKind() == Tree::IDENTIFIER_EXPR_NODE)
         {
+            IdentifierExpr *ie = static_cast<IdentifierExpr *>(t);
             string id = ie->getId();
             if (id == "__FUNCTION__" || id == "__func__")
             {
@@ -477,9 +592,10 @@ public:
     DeclarationFinisher() {}
     virtual bool open(Tree *t)
     {
-        DeclarationSequence *declSeq = dynamic_cast<DeclarationSequence *>(t);
-        if (declSeq)
+        if (t->getNodeKind() == Tree::DECLARATION_SEQUENCE_NODE)
         {
+            DeclarationSequence *declSeq = static_cast<DeclarationSequence *>(t);
+
             // Set the type of the expression used by enumerators, if any, e.g., enum { A = sizeof(v) }.
             //
             std::vector<Enumerator *> *enumeratorList = declSeq->getEnumeratorList();
@@ -507,9 +623,9 @@ public:
             return true;
         }
 
-        Declaration *decl = dynamic_cast<Declaration *>(t);
-        if (!decl)
+        if (t->getNodeKind() != Tree::DECLARATION_NODE)
             return true;
+        Declaration *decl = static_cast<Declaration *>(t);
         /*cout << "# DeclarationFinisher: decl " << decl << ": '" << decl->getVariableId()
              << "', isGlobal=" << decl->isGlobal() << ", needsFinish=" << decl->needsFinish << ", line " << decl->getLineNo() << endl;*/
         if (!decl->needsFinish)
@@ -687,6 +803,28 @@ TranslationUnit::setGlobalDeclarationLabels()
 }
 
 
+// Makes static functions whose address is never taken receive their first
+// two parameters in D and X, instead of in the stack. Their callers are
+// all in this translation unit, and they all make direct calls.
+//
+// 'finder' must have been run over definitionList.
+//
+void
+TranslationUnit::passStaticFunctionParamsInRegisters(const FunctionAddressFinder &finder)
+{
+    for (vector<Tree *>::iterator it = definitionList->begin();
+                                 it != definitionList->end(); it++)
+    {
+        FunctionDef *fd = dynamic_cast<FunctionDef *>(*it);
+        if (fd == NULL || fd->getBody() == NULL || !fd->hasInternalLinkage())
+            continue;
+        if (getFunctionDef(fd->getId()) != fd || finder.isAddressTaken(fd->getId()))
+            continue;
+        fd->receiveParamsInRegisters();
+    }
+}
+
+
 void
 TranslationUnit::declareFunctions()
 {
@@ -737,18 +875,25 @@ TranslationUnit::checkSemantics()
     // but that could not be initialized completely because that method is called
     // during parsing.
     // Also set the type of the expression used by enumerators, if any, e.g., enum { A = sizeof(v) }.
+    // The same traversal finds the functions whose address is taken
+    // and registers the string literals.
+    //
+    FunctionAddressFinder finder;
     {
         DeclarationFinisher df;
-        definitionList->iterate(df);
+        StringLiteralRegistererererer r;
+        FunctorList functors;
+        functors.add(df);
+        functors.add(finder);
+        functors.add(r);
+        definitionList->iterate(functors);
     }
 
-    vector<const Declaration *> constDataDeclarationsToCheck;
-    constDataDeclarationsToCheck.reserve(32);
-
     setGlobalDeclarationLabels();
 
     declareFunctions();
 
+    passStaticFunctionParamsInRegisters(finder);
 
     // Check that all members of structs and unions are of a defined type,
     // e.g., detect struct A { struct B b; } where 'B' is not defined.
@@ -756,9 +901,6 @@ TranslationUnit::checkSemantics()
     ClassChecker cc;
     globalScope->forEachClassDef(cc);
 
-    StringLiteralRegistererererer r;
-    definitionList->iterate(r);
-
     // Among other things, the ExpressionTypeSetter is run over the function bodies
     // during the following step.
     //
@@ -768,12 +910,6 @@ TranslationUnit::checkSemantics()
     }  // destroy ScopeCreator here so that it pops all scopes it pushed onto the TranslationUnit's stack
 
 
-    {
-        UndeclaredGlobalVariableChecker checker;
-        definitionList->iterate(checker);
-    }
-
-
     // Call setReadOnly() on global declarations that are suitable for the rodata section,
     // which may be in ROM.
     //
@@ -803,18 +939,23 @@ TranslationUnit::checkSemantics()
     }
 
 
-    // Check function prototypes, definitions and calls.
-    // The following step assumes that the ExpressionTypeSetter has been run
+    // Check the uses of global variables, the function prototypes, definitions
+    // and calls, and the case and default labels, in a single traversal.
+    // The FunctionChecker assumes that the ExpressionTypeSetter has been run
     // over the function bodies, so that function calls that use a function pointer
     // can be differentiated from standard calls.
     //
+    UndeclaredGlobalVariableChecker ugvc;
     FunctionChecker ufc(*this, callToUndefinedFunctionAllowed);
-    definitionList->iterate(ufc);
-    ufc.reportErrors();
-
-
     LabeledStmtChecker lsc;
-    definitionList->iterate(lsc);
+    {
+        FunctorList functors;
+        functors.add(ugvc);
+        functors.add(ufc);
+        functors.add(lsc);
+        definitionList->iterate(functors);
+    }
+    ufc.reportErrors();
 }
 
 
@@ -1066,7 +1207,8 @@ TranslationUnit::emitAssembler(ASMText &out, uint16_t dataAddress, uint16_t stac
                         if (decl->isExtern)
                         {
                             assert(!decl->getLabel().empty());
-                            out.emitImport(decl->getLabel().c_str());
+                            if (!isEmbeddedFileLabel(decl->getLabel()))  // if not defined by #pragma embed
+                                out.emitImport(decl->getLabel().c_str());
                         }
                         else if (!decl->isStatic)
                         {
@@ -1098,7 +1240,10 @@ TranslationUnit::emitAssembler(ASMText &out, uint16_t dataAddress, uint16_t stac
         if (emit)
         {
             if (!fd->hasInternalLinkage())
+            {
                 out.emitExport(fd->getLabel());
+                out.emitExport("funcend_" + fd->getId());  // lets --profile-use find the function's end in the linker map
+            }
             if (!fd->emitCode(out, false))
                 errormsg("failed to emit code for function %s()", fd->getId().c_str());
             emittedFunctions.insert(fd->getId());  // remember that this func has been emitted
@@ -1114,7 +1259,10 @@ TranslationUnit::emitAssembler(ASMText &out, uint16_t dataAddress, uint16_t stac
         if (fd->isCalled() && emittedFunctions.find(fd->getId()) == emittedFunctions.end())
         {
             if (!fd->hasInternalLinkage())
+            {
                 out.emitExport(fd->getLabel());
+                out.emitExport("funcend_" + fd->getId());
+            }
             if (!fd->emitCode(out, false))
                 errormsg("failed to emit code for function %s() in 2nd pass", fd->getId().c_str());
             emittedFunctions.insert(fd->getId());  // remember that this func has been emitted
@@ -1226,6 +1374,27 @@ TranslationUnit::emitAssembler(ASMText &out, uint16_t dataAddress, uint16_t stac
         out.emitLabel("dword_constants_end");
     }
 
+    // Generate the initial values of local arrays and structs:
+
+    if (initializerImageLabelToValue.size() > 0)
+    {
+        out.emitSeparatorComment();
+        out.emitComment("INITIALIZER IMAGES");
+        for (map< std::string, std::vector<uint8_t> >::const_iterator it = initializerImageLabelToValue.begin();
+                                                                     it != initializerImageLabelToValue.end(); it++)
+        {
+            out.emitLabel(it->first);
+            const vector<uint8_t> &image = it->second;
+            for (size_t start = 0; start < image.size(); start += 16)  // 16 bytes per FCB directive
+            {
+                vector<uint8_t> line(image.begin() + start, image.begin() + min(start + 16, image.size()));
+                DWordConstantExpr::emitDWordConstantDefinition(out, line);
+            }
+        }
+    }
+
+    emitEmbeddedFiles(out);
+
     // Generate global variables.
     //
     out.emitSeparatorComment();
@@ -1413,6 +1582,66 @@ TranslationUnit::~TranslationUnit()
 }
 
 
+TranslationUnit::TreeArena::TreeArena()
+  : blocks(),
+    numBytesUsedInLastBlock(0),
+    freeLists(MAX_SMALL_NODE_SIZE / ALIGNMENT + 1, NULL)
+{
+}
+
+
+TranslationUnit::TreeArena::~TreeArena()
+{
+    for (vector<char *>::iterator it = blocks.begin(); it != blocks.end(); ++it)
+        delete [] *it;
+}
+
+
+void *
+TranslationUnit::TreeArena::allocate(size_t numBytes)
+{
+    numBytes = (numBytes + ALIGNMENT - 1) & ~size_t(ALIGNMENT - 1);
+
+    if (numBytes > MAX_SMALL_NODE_SIZE)  // large node: give it its own block, and keep filling the last one
+    {
+        char *block = new char[numBytes];
+        blocks.insert(blocks.end() - (blocks.empty() ? 0 : 1), block);
+        return block;
+    }
+
+    void *&freeList = freeLists[numBytes / ALIGNMENT];
+    if (freeList != NULL)
+    {
+        void *p = freeList;
+        freeList = *static_cast<void **>(p);
+        return p;
+    }
+
+    if (blocks.empty() || numBytesUsedInLastBlock + numBytes > BLOCK_SIZE)
+    {
+        blocks.push_back(new char[BLOCK_SIZE]);
+        numBytesUsedInLastBlock = 0;
+    }
+
+    void *p = blocks.back() + numBytesUsedInLastBlock;
+    numBytesUsedInLastBlock += numBytes;
+    return p;
+}
+
+
+void
+TranslationUnit::TreeArena::release(void *p, size_t numBytes)
+{
+    numBytes = (numBytes + ALIGNMENT - 1) & ~size_t(ALIGNMENT - 1);
+    if (p == NULL || numBytes > MAX_SMALL_NODE_SIZE)
+        return;  // a large node's block is only freed with the others
+
+    void *&freeList = freeLists[numBytes / ALIGNMENT];
+    *static_cast<void **>(p) = freeList;
+    freeList = p;
+}
+
+
 void
 TranslationUnit::pushScope(Scope *scope)
 {
@@ -1486,6 +1715,20 @@ TranslationUnit::getCurrentFunctionEndLabel()
 }
 
 
+void
+TranslationUnit::setCurrentFunction(const FunctionDef *fd)
+{
+    currentFunction = fd;
+}
+
+
+const FunctionDef *
+TranslationUnit::getCurrentFunction() const
+{
+    return currentFunction;
+}
+
+
 /*static*/
 string
 TranslationUnit::genLabel(char letter)
@@ -1590,6 +1833,20 @@ TranslationUnit::registerDWordConstant(const DWordConstantExpr &dwce)
 }
 
 
+string
+TranslationUnit::registerInitializerImage(const vector<uint8_t> &image)
+{
+    std::map< std::vector<uint8_t>, std::string >::iterator it = initializerImageValueToLabel.find(image);
+    if (it != initializerImageValueToLabel.end())
+        return it->second;
+
+    string asmLabel = generateLabel('I');
+    initializerImageLabelToValue[asmLabel] = image;
+    initializerImageValueToLabel[image] = asmLabel;
+    return asmLabel;
+}
+
+
 // In bytes. Returns 0 for an undefined struct or union.
 //
 int16_t
@@ -1681,6 +1938,7 @@ TranslationUnit::processPragmas(uint16_t &codeAddress, bool codeAddressSetBySwit
 {
     if (! definitionList)
         return;
+    string embeddedFilename, embeddedSymbol;
     for (vector<Tree *>::iterator it = definitionList->begin();
                                  it != definitionList->end(); ++it)
         if (Pragma *pragma = dynamic_cast<Pragma *>(*it))
@@ -1734,12 +1992,104 @@ TranslationUnit::processPragmas(uint16_t &codeAddress, bool codeAddressSetBySwit
                 if (targetPlatform == VECTREX)
                     pragma->errormsg("#pragma stack_space is not permitted for Vectrex");
             }
+            else if (pragma->isEmbed(embeddedFilename, embeddedSymbol))
+            {
+                addEmbeddedFile(*pragma, embeddedFilename, embeddedSymbol);
+            }
             else
                 pragma->errormsg("invalid pragma directive: %s", pragma->getDirective().c_str());
         }
 }
 
 
+// Registers the file named by a #pragma embed directive, so that
+// emitEmbeddedFiles() copies it into the rodata section.
+// The file is only read at that point, but it is opened here to
+// report a missing or oversized file early.
+//
+void
+TranslationUnit::addEmbeddedFile(const Pragma &pragma, const string &filename, const string &symbol)
+{
+    string path = Pragma::getEmbeddedFilePath(filename, pragma.getSourceFilename());
+    addPrerequisiteFilename(path.c_str());
+
+    string label = "_" + symbol;
+    if (isEmbeddedFileLabel(label) || isEmbeddedFileLabel(label + "_size"))
+    {
+        pragma.errormsg("#pragma embed: symbol `%s' already used by a previous #pragma embed", symbol.c_str());
+        return;
+    }
+
+    ifstream file(path.c_str(), ios::in | ios::binary);
+    if (!file)
+    {
+        int e = errno;
+        pragma.errormsg("#pragma embed: cannot open `%s': %s", path.c_str(), strerror(e));
+        return;
+    }
+    file.seekg(0, ios::end);
+    streamoff size = file.tellg();
+    if (size < 0 || size > 0xFFFF)
+    {
+        pragma.errormsg("#pragma embed: `%s' is too large (the maximum is 65535 bytes)", path.c_str());
+        return;
+    }
+
+    embeddedFiles.push_back(EmbeddedFile(label, path, uint16_t(size), &pragma));
+}
+
+
+// Indicates if 'label' is defined by emitEmbeddedFiles().
+//
+bool
+TranslationUnit::isEmbeddedFileLabel(const string &label) const
+{
+    for (vector<EmbeddedFile>::const_iterator it = embeddedFiles.begin(); it != embeddedFiles.end(); ++it)
+        if (it->label == label || it->label + "_size" == label)
+            return true;
+    return false;
+}
+
+
+// Defines the symbol of each #pragma embed directive as the start of
+// a copy of the named file, and the symbol followed by "_size" as
+// a word that contains the size of that file.
+// The file is copied 16 bytes per FCB directive, without being loaded
+// into memory as a whole.
+//
+void
+TranslationUnit::emitEmbeddedFiles(ASMText &out) const
+{
+    if (embeddedFiles.size() == 0)
+        return;
+
+    out.emitSeparatorComment();
+    out.emitComment("EMBEDDED FILES");
+    for (vector<EmbeddedFile>::const_iterator it = embeddedFiles.begin(); it != embeddedFiles.end(); ++it)
+    {
+        out.emitExport(it->label + "_size");
+        out.emitLabel(it->label + "_size");
+        out.ins("FDB", wordToString(it->size, true), "size of " + it->path);
+
+        out.emitExport(it->label);
+        out.emitLabel(it->label);
+
+        ifstream file(it->path.c_str(), ios::in | ios::binary);
+        char buffer[16];
+        size_t numBytesLeft = it->size;
+        while (numBytesLeft > 0 && file.read(buffer, min(numBytesLeft, sizeof(buffer))))
+        {
+            size_t n = size_t(file.gcount());
+            vector<uint8_t> line(buffer, buffer + n);
+            DWordConstantExpr::emitDWordConstantDefinition(out, line);
+            numBytesLeft -= n;
+        }
+        if (numBytesLeft > 0)
+            it->pragma->errormsg("#pragma embed: failed to read `%s'", it->path.c_str());
+    }
+}
+
+
 void
 TranslationUnit::enableNullPointerChecking(bool enable)
 {
@@ -1883,6 +2233,46 @@ TranslationUnit::isWarningOnPassingConstForFuncPtr() const
 }
 
 
+uint32_t
+TranslationUnit::internSourceFilename(const string &filename)
+{
+    map<string, uint32_t>::const_iterator it = sourceFilenameIds.find(filename);
+    if (it != sourceFilenameIds.end())
+        return it->second;
+
+    uint32_t id = uint32_t(sourceFilenames.size());
+    sourceFilenames.push_back(filename);
+    sourceFilenameIds[filename] = id;
+    return id;
+}
+
+
+const string &
+TranslationUnit::getSourceFilename(uint32_t id) const
+{
+    assert(id < sourceFilenames.size());
+    return sourceFilenames[id];
+}
+
+
+void
+TranslationUnit::setCurrentSourcePosition(const string &filename, int lineNo)
+{
+    currentSourceFilenameId = internSourceFilename(filename);
+    currentLineNo = lineNo;
+}
+
+
+void
+TranslationUnit::countDiagnostic(bool isError)
+{
+    if (isError)
+        ++numErrors;
+    else
+        ++numWarnings;
+}
+
+
 void
 TranslationUnit::addPrerequisiteFilename(const char *filename)
 {
@@ -1921,6 +2311,83 @@ TranslationUnit::writePrerequisites(ostream &out,
 }
 
 
+// Removes the underscore that begins the label of a C function.
+//
+static string
+stackReportName(const string &label)
+{
+    return label[0] == '_' ? label.substr(1) : label;
+}
+
+
+void
+TranslationUnit::writeStackReport(ostream &out, const string &sourceFilename, const ASMText::StackReport &report) const
+{
+    // List main() first, then the interrupt service routines, then the other functions.
+    //
+    vector<const FunctionDef *> entryPoints, others;
+    for (FunctionDefTable::const_iterator it = functionDefs.begin(); it != functionDefs.end(); ++it)
+    {
+        const FunctionDef *fd = it->second;
+        if (report.find(fd->getLabel()) == report.end())
+            continue;  // no code emitted
+        if (fd->getId() == "main")
+            entryPoints.insert(entryPoints.begin(), fd);
+        else if (fd->isInterruptServiceRoutine())
+            entryPoints.push_back(fd);
+        else
+            others.push_back(fd);
+    }
+    entryPoints.insert(entryPoints.end(), others.begin(), others.end());
+
+    out << "Stack usage of " << sourceFilename << ", in bytes, including the return address:\n";
+    out << "  Locals     Own   Worst  Function\n";
+    for (vector<const FunctionDef *>::const_iterator it = entryPoints.begin(); it != entryPoints.end(); ++it)
+    {
+        const FunctionDef *fd = *it;
+        const ASMText::StackReportEntry &entry = report.find(fd->getLabel())->second;
+
+        // An IRQ, NMI or SWI makes the CPU stack all the registers (12 bytes).
+        // A FIRQ only stacks CC and PC, but the vector that a function
+        // is hooked to is not known here, so the worst case is assumed.
+        //
+        int entryBytes = fd->isInterruptServiceRoutine() ? 12 : 2;
+
+        out << setw(8) << fd->getLocalVariableSpace()
+            << setw(8) << entry.ownDepth + entryBytes;
+        if (entry.worstDepth < 0)
+            out << setw(8) << "-";
+        else
+            out << setw(8) << entry.worstDepth + entryBytes;
+        out << "  " << fd->getId();
+
+        if (fd->getId() == "main")
+            out << "; entry point";
+        else if (fd->isInterruptServiceRoutine())
+            out << "; interrupt entry point";
+        if (!entry.recursion.empty())
+        {
+            out << "; recursion:";
+            istringstream labels(entry.recursion);
+            string word;
+            while (labels >> word)
+                out << ' ' << stackReportName(word);
+        }
+        if (entry.callsThroughPointer)
+            out << "; calls through a pointer not counted";
+        if (entry.incomplete)
+            out << "; inline assembly not counted";
+        if (!entry.externalCallees.empty())
+        {
+            out << "; other modules not counted:";
+            for (set<string>::const_iterator jt = entry.externalCallees.begin(); jt != entry.externalCallees.end(); ++jt)
+                out << (jt == entry.externalCallees.begin() ? " " : ", ") << stackReportName(*jt);
+        }
+        out << '\n';
+    }
+}
+
+
 bool
 TranslationUnit::warnOnConstIncorrect() const
 {
@@ -1950,3 +2417,127 @@ TranslationUnit::warnAboutVolatile()
     warnmsg("the `volatile' keyword is not supported by this compiler");
     warnedAboutVolatile = true;
 }
+
+
+void
+TranslationUnit::warnAboutDoubleType()
+{
+    if (warnedAboutDoubleType)
+        return;
+    warnmsg("`double' is an alias for `float' for this compiler");
+    warnedAboutDoubleType = true;
+}
+
+
+void
+TranslationUnit::warnAboutDoublePrecisionLiteral()
+{
+    if (warnedAboutDoublePrecisionLiteral)
+        return;
+    warnmsg("double-precision numeric literals have same precision as `float' for this compiler");
+    warnedAboutDoublePrecisionLiteral = true;
+}
+
+
+void
+TranslationUnit::setFunctionStackSpace(uint16_t numBytes)
+{
+    functionStackSpace = numBytes;
+}
+
+
+uint16_t
+TranslationUnit::getFunctionStackSpace() const
+{
+    return functionStackSpace;
+}
+
+
+void
+TranslationUnit::setExecutionProfile(const ExecutionCountTable &counts, const ExecutionCountTable &blockCounts)
+{
+    executionCounts = counts;
+    blockExecutionCounts = blockCounts;
+    totalExecutionCount = 0;
+    for (ExecutionCountTable::const_iterator it = counts.begin(); it != counts.end(); ++it)
+        totalExecutionCount += it->second;
+}
+
+
+bool
+TranslationUnit::isExecutionProfileUsed() const
+{
+    return totalExecutionCount > 0;
+}
+
+
+uint32_t
+TranslationUnit::getExecutionCount(const string &functionId) const
+{
+    ExecutionCountTable::const_iterator it = executionCounts.find(functionId);
+    return it == executionCounts.end() ? 0 : it->second;
+}
+
+
+bool
+TranslationUnit::isInExecutionProfile(const string &functionId) const
+{
+    return executionCounts.find(functionId) != executionCounts.end();
+}
+
+
+uint32_t
+TranslationUnit::getTotalExecutionCount() const
+{
+    return totalExecutionCount;
+}
+
+
+bool
+TranslationUnit::getBlockExecutionCount(const string &blockKey, uint32_t &count) const
+{
+    ExecutionCountTable::const_iterator it = blockExecutionCounts.find(blockKey);
+    if (it == blockExecutionCounts.end())
+        return false;
+    count = it->second;
+    return true;
+}
+
+
+void
+TranslationUnit::setModuleName(const string &name)
+{
+    moduleName = name;
+}
+
+
+const string &
+TranslationUnit::getModuleName() const
+{
+    return moduleName;
+}
+
+
+bool
+TranslationUnit::areProfilingLabelsEmitted() const
+{
+    return targetPlatform == USIM;
+}
+
+
+void
+TranslationUnit::forceSwitchJumpMode(SwitchStmt::JumpMode jumpMode)
+{
+    isSwitchJumpModeForced = true;
+    forcedSwitchJumpMode = jumpMode;
+}
+
+
+bool
+TranslationUnit::getForcedSwitchJumpMode(SwitchStmt::JumpMode &jumpMode) const
+{
+    if (!isSwitchJumpModeForced)
+        return false;
+    jumpMode = forcedSwitchJumpMode;
+    return true;
+}
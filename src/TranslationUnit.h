@@ -22,6 +22,7 @@
 
 #include "TypeManager.h"
 #include "Scope.h"
+#include "SwitchStmt.h"
 
 class Tree;
 class TreeSequence;
@@ -31,12 +32,22 @@ class ClassDef;
 class DeclarationSequence;
 class DeclarationSpecifierList;
 class Declarator;
+class Pragma;
 
 
+// State of the compilation of a C file: the trees, the types, the options
+// that apply to code generation, the position of the lexer in the source,
+// and the diagnostic counters.
+//
+// The instance is per thread, so that each thread can compile a C file
+// with its own instance, e.g., when the compiler is used as a library.
+//
 class TranslationUnit
 {
 public:
 
+    // Returns the instance created by createInstance() in the calling thread.
+    //
     static TranslationUnit &instance()
     {
         assert(theInstance);
@@ -45,6 +56,45 @@ public:
 
     static TypeManager &getTypeManager() { return instance().typeManager; }
 
+    // Allocates memory for a Tree node. See Tree::operator new().
+    static void *allocateTreeNode(size_t numBytes) { return instance().treeArena.allocate(numBytes); }
+
+    // Makes the memory of a destroyed Tree node available to allocateTreeNode().
+    // Does nothing if called after the TranslationUnit has started to be destroyed.
+    //
+    static void releaseTreeNode(void *p, size_t numBytes)
+    {
+        if (theInstance != NULL)
+            theInstance->treeArena.release(p, numBytes);
+    }
+
+    // Returns a number that identifies 'filename' in this translation unit.
+    // Trees keep this number instead of a copy of their source filename.
+    //
+    uint32_t internSourceFilename(const std::string &filename);
+
+    // id: Value returned by internSourceFilename().
+    const std::string &getSourceFilename(uint32_t id) const;
+
+    // Position of the lexer in the source, which new Tree nodes take, and which
+    // errormsg() and warnmsg() report. Updated by the lexer.
+    //
+    void setCurrentSourcePosition(const std::string &filename, int lineNo);
+    void incrementCurrentLineNo() { ++currentLineNo; }
+    uint32_t getCurrentSourceFilenameId() const { return currentSourceFilenameId; }
+    const std::string &getCurrentSourceFilename() const { return getSourceFilename(currentSourceFilenameId); }
+    int getCurrentLineNo() const { return currentLineNo; }
+
+    // Called by diagnoseVa() for each error or warning issued.
+    //
+    void countDiagnostic(bool isError);
+
+    int getNumErrors() const { return numErrors; }
+    int getNumWarnings() const { return numWarnings; }
+
+    // Creates the instance of the calling thread.
+    // Fails an assertion if that thread already has one.
+    //
     static void createInstance(TargetPlatform targetPlatform,
                                bool callToUndefinedFunctionAllowed,
                                bool warnSignCompare,
@@ -118,6 +168,10 @@ public:
     void setCurrentFunctionEndLabel(const std::string &label);
     std::string getCurrentFunctionEndLabel();
 
+    // Function whose code is currently being emitted, or null.
+    void setCurrentFunction(const FunctionDef *fd);
+    const FunctionDef *getCurrentFunction() const;
+
     static std::string genLabel(char letter);
     std::string generateLabel(char letter);
 
@@ -136,6 +190,12 @@ public:
     //
     std::string registerDWordConstant(const class DWordConstantExpr &rce);
 
+    // Registers the initial value of a local array or struct, to be emitted
+    // in the rodata section. Returns the assembly label of that image.
+    // A given image is not registered twice, so as to save memory.
+    //
+    std::string registerInitializerImage(const std::vector<uint8_t> &image);
+
     int16_t getTypeSize(const TypeDesc &typeDesc) const;
 
     const ClassDef *getClassDef(const std::string &className) const;
@@ -192,6 +252,68 @@ public:
 
     void warnAboutVolatile();
 
+    // Warns once per translation unit that `double' is the same as `float'.
+    void warnAboutDoubleType();
+
+    // Warns once per translation unit that a literal without an f suffix
+    // has the precision of a `float'.
+    void warnAboutDoublePrecisionLiteral();
+
+    // Number of bytes that a function is expected to use in addition to its local variables.
+    // Useful when targeting OS-9. 0 means no stack check upon function entry.
+    //
+    void setFunctionStackSpace(uint16_t numBytes);
+    uint16_t getFunctionStackSpace() const;
+
+    // Number of instructions executed in each function, indexed by the key
+    // returned by FunctionDef::getProfileKey().
+    // See --profile-use and FunctionDef::isHot().
+    //
+    typedef std::map<std::string, uint32_t> ExecutionCountTable;
+
+    // blockCounts: number of times that the first instruction of each function
+    // and of each block labelled by ASMText::layOutBlocks() was executed,
+    // indexed by the function's profile key or by the block's key.
+    //
+    void setExecutionProfile(const ExecutionCountTable &counts, const ExecutionCountTable &blockCounts);
+
+    bool isExecutionProfileUsed() const;
+
+    // Returns 0 if functionId is not in the profile.
+    uint32_t getExecutionCount(const std::string &functionId) const;
+
+    // False for a function that the linker map does not show, e.g., one that
+    // was not in the profiled program.
+    bool isInExecutionProfile(const std::string &functionId) const;
+
+    // Sum of the counts in the profile.
+    uint32_t getTotalExecutionCount() const;
+
+    // Returns false if blockKey is not in the profile.
+    bool getBlockExecutionCount(const std::string &blockKey, uint32_t &count) const;
+
+    // Name of the module being compiled, without directory nor extension.
+    // Distinguishes the static functions of different modules in a profile.
+    //
+    void setModuleName(const std::string &name);
+    const std::string &getModuleName() const;
+
+    // True if the functions and the blocks of the generated code get the exported
+    // labels that allow a later compilation to find them in an execution profile.
+    // Only done for the usim target, which is the one that produces profiles.
+    //
+    bool areProfilingLabelsEmitted() const;
+
+    // Makes every switch statement use the given mode instead of the one
+    // that SwitchStmt finds to be the most compact.
+    //
+    void forceSwitchJumpMode(SwitchStmt::JumpMode jumpMode);
+
+    // Returns false if forceSwitchJumpMode() has not been called.
+    // Otherwise, stores the forced mode in 'jumpMode' and returns true.
+    //
+    bool getForcedSwitchJumpMode(SwitchStmt::JumpMode &jumpMode) const;
+
     // Adds the given filename to the list of filenames that the current
     // translation unit depends on.
     //
@@ -205,6 +327,13 @@ public:
                             const std::string &objectFilename,
                             const std::string &pkgdatadir) const;
 
+    // Writes the worst-case stack usage of each function that is in 'report'
+    // (see ASMText::computeStackReport()), starting with the entry points,
+    // i.e., main() and the interrupt service routines.
+    // See --stack-report.
+    //
+    void writeStackReport(std::ostream &out, const std::string &sourceFilename, const ASMText::StackReport &report) const;
+
     // Adds decl to globalVariables if not extern.
     // Declares decl in globalScope.
     //
@@ -227,10 +356,14 @@ private:
     CodeStatus emitWritableGlobals(ASMText &out) const;
     CodeStatus emitGlobalVariables(ASMText &out, bool readOnlySection, bool withStaticInitializer) const;
     void checkConstDataDeclarationInitializer(const Declaration &decl) const;
+    void addEmbeddedFile(const Pragma &pragma, const std::string &filename, const std::string &symbol);
+    bool isEmbeddedFileLabel(const std::string &label) const;
+    void emitEmbeddedFiles(ASMText &out) const;
     void markGlobalDeclarations();
     void setTypeDescOfGlobalDeclarationClasses();
     void setGlobalDeclarationLabels();
     void declareFunctions();
+    void passStaticFunctionParamsInRegisters(const class FunctionAddressFinder &finder);
 
     struct StandardFunctionDeclaration
     {
@@ -244,8 +377,32 @@ private:
 
     typedef std::map<std::string, FunctionDef *> FunctionDefTable;
 
-    static TranslationUnit *theInstance;
+    static thread_local TranslationUnit *theInstance;
 
+    // Memory from which all Tree nodes are allocated. Freed in one shot when
+    // the TranslationUnit is destroyed, after the trees owned by the other members.
+    // The memory of a node that is deleted before then is reused for the next
+    // node of the same rounded size, e.g., when the parser replaces the elements
+    // of a long initializer list with a PackedInitializer.
+    //
+    class TreeArena
+    {
+    public:
+        TreeArena();
+        ~TreeArena();
+        void *allocate(size_t numBytes);
+        void release(void *p, size_t numBytes);
+    private:
+        enum { BLOCK_SIZE = 65536, ALIGNMENT = 16, MAX_SMALL_NODE_SIZE = BLOCK_SIZE / 4 };
+        std::vector<char *> blocks;  // owns the blocks, which come from new[]
+        size_t numBytesUsedInLastBlock;
+        std::vector<void *> freeLists;  // index: size / ALIGNMENT; each free node starts with a pointer to the next one
+        // Forbidden:
+        TreeArena(const TreeArena &);
+        TreeArena &operator = (const TreeArena &);
+    };
+
+    TreeArena treeArena;  // must be the first member to be constructed and the last to be destroyed
     TypeManager typeManager;
     Scope *globalScope;  // Scope tree must be destroyed after the TreeSequences in definitionList
     TreeSequence *definitionList;  // owns the object, which must have been allocated with 'new'
@@ -255,6 +412,7 @@ private:
     std::vector<Scope *> scopeStack;  // does not own the pointed objects
     std::vector<BreakableLabels> breakableStack;
     std::string functionEndLabel;  // assembly label of the function currently being emitted
+    const FunctionDef *currentFunction;  // function currently being emitted; null if none
     size_t labelGeneratorIndex;
 
     typedef std::map<std::string, const StringLiteralExpr *> StringLiteralToExprMap;  // key = asm label
@@ -272,6 +430,11 @@ private:
     std::map< std::vector<uint8_t>, std::string > dwordConstantValueToLabel;
                         // key = dword representation, value = asm label
 
+    std::map< std::string, std::vector<uint8_t> > initializerImageLabelToValue;
+                        // key = asm label, value = initial value of array or struct
+    std::map< std::vector<uint8_t>, std::string > initializerImageValueToLabel;
+                        // key = initial value of array or struct, value = asm label
+
     std::map<std::string, std::string> builtInFunctionDescs;
     bool relocatabilitySupported;
     bool isProgramExecutableOnlyOnce;
@@ -285,6 +448,8 @@ private:
     bool isBinaryOpGivingByteWarningEnabled;
     bool isLocalVariableHidingAnotherWarningEnabled;
     bool warnedAboutVolatile;
+    bool warnedAboutDoubleType;
+    bool warnedAboutDoublePrecisionLiteral;
     std::set<std::string> neededUtilitySubRoutines;
     TargetPlatform targetPlatform;
 
@@ -299,6 +464,34 @@ private:
 
     std::vector<std::string> sourceFilenamesSeen;  // as listed by cpp output
 
+    // File to be copied into the rodata section by #pragma embed.
+    //
+    struct EmbeddedFile
+    {
+        std::string label;  // assembly label of the C symbol named by the pragma
+        std::string path;
+        uint16_t size;  // in bytes
+        const Pragma *pragma;  // for error messages
+
+        EmbeddedFile(const std::string &_label, const std::string &_path, uint16_t _size, const Pragma *_pragma)
+        :   label(_label), path(_path), size(_size), pragma(_pragma) {}
+    };
+
+    std::vector<EmbeddedFile> embeddedFiles;  // in order of appearance of the pragmas
+    std::vector<std::string> sourceFilenames;  // index: ID returned by internSourceFilename()
+    std::map<std::string, uint32_t> sourceFilenameIds;  // key: filename; value: index in sourceFilenames
+    uint32_t currentSourceFilenameId;  // see setCurrentSourcePosition()
+    int currentLineNo;  // first line is numbered 1
+    int numErrors;
+    int numWarnings;
+    uint16_t functionStackSpace;  // in bytes; 0 means no stack check
+    ExecutionCountTable executionCounts;  // empty if no profile used
+    uint32_t totalExecutionCount;  // sum of the values in executionCounts
+    ExecutionCountTable blockExecutionCounts;  // empty if no profile used
+    std::string moduleName;
+    bool isSwitchJumpModeForced;
+    SwitchStmt::JumpMode forcedSwitchJumpMode;  // meaningful if isSwitchJumpModeForced is true
+
     // Forbidden operations:
     TranslationUnit(const TranslationUnit &);
     TranslationUnit & operator = (const TranslationUnit &);
@@ -37,15 +37,12 @@
 using namespace std;
 
 
-extern int lineno;
-extern string sourceFilename;
-
-
 Tree::Tree()
   : scope(NULL),
-    sourceFilename(::sourceFilename),
-    lineno(::lineno),
-    typeDesc(TranslationUnit::getTypeManager().getVoidType())
+    sourceFilenameId(TranslationUnit::instance().getCurrentSourceFilenameId()),
+    lineno(TranslationUnit::instance().getCurrentLineNo()),
+    typeDesc(TranslationUnit::getTypeManager().getVoidType()),
+    nodeKind(OTHER_NODE)
 {
     assert(typeDesc);
 }
@@ -53,9 +50,10 @@ Tree::Tree()
 
 Tree::Tree(const TypeDesc *td)
   : scope(NULL),
-    sourceFilename(::sourceFilename),
-    lineno(::lineno),
-    typeDesc(td)
+    sourceFilenameId(TranslationUnit::instance().getCurrentSourceFilenameId()),
+    lineno(TranslationUnit::instance().getCurrentLineNo()),
+    typeDesc(td),
+    nodeKind(OTHER_NODE)
 {
     assert(typeDesc);
     assert(typeDesc->type != SIZELESS_TYPE);
@@ -68,6 +66,20 @@ Tree::~Tree()
 }
 
 
+void *
+Tree::operator new(size_t numBytes)
+{
+    return TranslationUnit::allocateTreeNode(numBytes);
+}
+
+
+void
+Tree::operator delete(void *p, size_t numBytes)
+{
+    TranslationUnit::releaseTreeNode(p, numBytes);  // the block is freed by TranslationUnit::TreeArena
+}
+
+
 void Tree::setScope(Scope *s)
 {
     scope = s;
@@ -118,7 +130,7 @@ Tree::emitCode(ASMText & /*out*/, bool /*lValue*/) const
 void
 Tree::setLineNo(const string &srcFilename, int no)
 {
-    sourceFilename = srcFilename;
+    sourceFilenameId = TranslationUnit::instance().internSourceFilename(srcFilename);
     lineno = no;
 }
 
@@ -127,15 +139,22 @@ string
 Tree::getLineNo() const
 {
     char temp[1024];
-    snprintf(temp, sizeof(temp), "%s:%d", sourceFilename.c_str(), lineno);
+    snprintf(temp, sizeof(temp), "%s:%d", TranslationUnit::instance().getSourceFilename(sourceFilenameId).c_str(), lineno);
     return temp;
 }
 
 
+const string &
+Tree::getSourceFilename() const
+{
+    return TranslationUnit::instance().getSourceFilename(sourceFilenameId);
+}
+
+
 void
 Tree::copyLineNo(const Tree &tree)
 {
-    sourceFilename = tree.sourceFilename;
+    sourceFilenameId = tree.sourceFilenameId;
     lineno = tree.lineno;
 }
 
@@ -147,7 +166,7 @@ Tree::writeLineNoComment(ASMText &out, const string &text) const
 {
     stringstream comment;
     if (lineno >= 1)
-        comment << "Line " << sourceFilename << ":" << lineno;
+        comment << "Line " << TranslationUnit::instance().getSourceFilename(sourceFilenameId) << ":" << lineno;
     if (lineno >= 1 && !text.empty())
         comment << ": ";
     if (!text.empty())
@@ -354,6 +373,48 @@ Tree::callUtility(ASMText &out, const string &utilitySubRoutine, const string &c
 }
 
 
+/*static*/
+void
+Tree::emitInlineCopyFromYToX(ASMText &out, int16_t numBytes)
+{
+    for (int16_t offset = 0; offset < numBytes; offset += 2)
+    {
+        string arg = (offset == 0 ? string() : wordToString(offset));
+        if (numBytes - offset == 1)
+        {
+            out.ins("LDB", arg + ",Y");
+            out.ins("STB", arg + ",X");
+        }
+        else
+        {
+            out.ins("LDD", arg + ",Y");
+            out.ins("STD", arg + ",X");
+        }
+    }
+}
+
+
+/*static*/
+void
+Tree::emitInlinePushFromX(ASMText &out, int16_t numBytes)
+{
+    // Push from the end, so that the first byte ends up at the lowest address.
+    int16_t offset = numBytes;
+    if (offset % 2 != 0)
+    {
+        --offset;
+        out.ins("LDB", (offset == 0 ? string() : wordToString(offset)) + ",X");
+        out.ins("PSHS", "B");
+    }
+    while (offset > 0)
+    {
+        offset -= 2;
+        out.ins("LDD", (offset == 0 ? string() : wordToString(offset)) + ",X");
+        out.ins("PSHS", "B,A");
+    }
+}
+
+
 void
 Tree::errormsg(const char *fmt, ...) const
 {
@@ -542,6 +603,34 @@ Tree::evaluateConstantExpr() const
 }
 
 
+bool
+Tree::evaluateIntegerLiteral(int64_t &value) const
+{
+    if (const DWordConstantExpr *dwce = dynamic_cast<const DWordConstantExpr *>(this))
+    {
+        double realValue = dwce->getRealValue();
+        if (realValue < -2147483648.0 || realValue >= 4294967296.0)
+            return false;  // invalid: will be reported by DWordConstantExpr::checkSemantics()
+        uint32_t dw = dwce->getDWordValue();
+        value = (isSigned() ? int64_t(int32_t(dw)) : int64_t(dw));
+        return true;
+    }
+    if (const WordConstantExpr *wce = dynamic_cast<const WordConstantExpr *>(this))
+    {
+        double realValue = wce->getRealValue();
+        if (realValue < -32768.0 || realValue > 65535.0)
+            return false;  // invalid: will be reported by WordConstantExpr::checkSemantics()
+        uint16_t w = wce->getWordValue();
+        if (getType() == BYTE_TYPE)
+            value = (isSigned() ? int64_t(int8_t(w)) : int64_t(uint8_t(w)));
+        else
+            value = (isSigned() ? int64_t(int16_t(w)) : int64_t(w));
+        return true;
+    }
+    return false;
+}
+
+
 bool
 Tree::isNumericalLiteral() const
 {
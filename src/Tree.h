@@ -34,6 +34,36 @@ public:
 
     virtual ~Tree();
 
+    // Trees are allocated from the current TranslationUnit's arena, which frees
+    // them all at once when the TranslationUnit is destroyed. Deleting a Tree
+    // runs its destructor and lets the arena reuse its memory for another Tree.
+    //
+    static void *operator new(size_t numBytes);
+    static void operator delete(void *p, size_t numBytes);
+
+    // Identifies the classes that the semantic passes of the TranslationUnit
+    // look for, so that they can recognize a node without a dynamic_cast.
+    // These classes have no subclasses. All other nodes are OTHER_NODE.
+    //
+    enum NodeKind
+    {
+        OTHER_NODE,
+        DECLARATION_NODE,
+        DECLARATION_SEQUENCE_NODE,
+        FUNCTION_DEF_NODE,
+        FUNCTION_CALL_EXPR_NODE,
+        IDENTIFIER_EXPR_NODE,
+        STRING_LITERAL_EXPR_NODE,
+        ASSEMBLER_STMT_NODE,
+        COMPOUND_STMT_NODE,
+        FOR_STMT_NODE,
+        WHILE_STMT_NODE,
+        SWITCH_STMT_NODE,
+        LABELED_STMT_NODE
+    };
+
+    NodeKind getNodeKind() const { return nodeKind; }
+
     void setScope(Scope *s);
     const Scope *getScope() const;
     Scope *getScope();
@@ -62,6 +92,7 @@ public:
 
     void setLineNo(const std::string &srcFilename, int no);
     std::string getLineNo() const;
+    const std::string &getSourceFilename() const;
     void setIntLineNo(int no) { lineno = no; }
     int getIntLineNo() const { return lineno; }
     void copyLineNo(const Tree &tree);
@@ -108,6 +139,13 @@ public:
     //
     bool evaluateConstantExpr(uint16_t &result) const;
 
+    // If this tree is a word or long literal, stores its value in 'value',
+    // sign-extended if the literal's type is signed, and returns true.
+    // Unlike evaluateConstantExpr(), does not need the ExpressionTypeSetter
+    // to have run, so the parser can use it.
+    //
+    bool evaluateIntegerLiteral(int64_t &value) const;
+
     // True if this tree is a long literal, a real literal, or if evaluateConstantExpr() succeeds.
     //
     bool isNumericalLiteral() const;
@@ -127,16 +165,33 @@ public:
     //
     static void callUtility(ASMText &out, const std::string &utilitySubRoutine, const std::string &comment = "");
 
+    // Largest struct/union, in bytes, that is copied or pushed with inline
+    // LDD/STD or LDD/PSHS instructions instead of a call to a utility routine.
+    //
+    enum { MAX_INLINE_COPY_SIZE = 8 };
+
+    // Emits LDD/STD instructions (LDB/STB for an odd last byte) that copy
+    // numBytes bytes from the address in Y to the address in X.
+    // Preserves X and Y. Trashes D.
+    //
+    static void emitInlineCopyFromYToX(ASMText &out, int16_t numBytes);
+
+    // Emits LDD/PSHS instructions (LDB/PSHS for an odd last byte) that push
+    // a copy of the numBytes bytes at the address in X.
+    // Preserves X. Trashes D.
+    //
+    static void emitInlinePushFromX(ASMText &out, int16_t numBytes);
+
     void errormsg(const char *fmt, ...) const;
     void warnmsg(const char *fmt, ...) const;
 
     // Issues the error message on optionalTree if not null, otherwise uses
-    // globals sourceFilename and lineno.
+    // the current source position of the TranslationUnit.
     //
     static void errormsg(const Tree *optionalTree, const char *fmt, ...);
 
     // Issues the warning message on optionalTree if not null, otherwise uses
-    // globals sourceFilename and lineno.
+    // the current source position of the TranslationUnit.
     //
     static void warnmsg(const Tree *optionalTree, const char *fmt, ...);
 
@@ -155,6 +210,10 @@ protected:
     Tree();  // void type
     Tree(const TypeDesc *td);
 
+    // Called by the constructor of each class listed in NodeKind.
+    //
+    void setNodeKind(NodeKind kind) { nodeKind = kind; }
+
     static bool deleteAndAssign(Tree *&member, Tree *oldAddr, Tree *newAddr);
 
 private:
@@ -169,9 +228,10 @@ private:
 private:
 
     Scope *scope;  // may be null; does not own the object
-    std::string sourceFilename;  // valid only when lineno >= 1
+    uint32_t sourceFilenameId;  // see TranslationUnit::internSourceFilename(); valid only when lineno >= 1
     int lineno;  // valid only when >= 1
     const TypeDesc *typeDesc;
+    NodeKind nodeKind;
 
 };
 
@@ -36,9 +36,15 @@ using namespace std;
 
 TypeManager::TypeManager()
 :   types(),
+    pointerTypes(),
+    arrayTypes(),
+    classTypes(),
+    typesByStructure(),
+    functionPointerTypes(),
     typeDefs(),
     enumTypeNames(),
-    enumerators()
+    enumerators(),
+    enumeratorsByName()
 {
 }
 
@@ -47,13 +53,13 @@ void
 TypeManager::createBasicTypes()
 {
     // The order is significant. See the other methods.
-    types.push_back(new TypeDesc(VOID_TYPE, NULL, string(), false, false));
-    types.push_back(new TypeDesc(BYTE_TYPE, NULL, string(), false, false));
-    types.push_back(new TypeDesc(BYTE_TYPE, NULL, string(), true, false));
-    types.push_back(new TypeDesc(WORD_TYPE, NULL, string(), false, false));
-    types.push_back(new TypeDesc(WORD_TYPE, NULL, string(), true, false));
-    types.push_back(new TypeDesc(SIZELESS_TYPE, NULL, string(), false, false));
-    types.push_back(new TypeDesc(SIZELESS_TYPE, NULL, string(), true, false));
+    addType(new TypeDesc(VOID_TYPE, NULL, string(), false, false));
+    addType(new TypeDesc(BYTE_TYPE, NULL, string(), false, false));
+    addType(new TypeDesc(BYTE_TYPE, NULL, string(), true, false));
+    addType(new TypeDesc(WORD_TYPE, NULL, string(), false, false));
+    addType(new TypeDesc(WORD_TYPE, NULL, string(), true, false));
+    addType(new TypeDesc(SIZELESS_TYPE, NULL, string(), false, false));
+    addType(new TypeDesc(SIZELESS_TYPE, NULL, string(), true, false));
 }
 
 
@@ -77,7 +83,7 @@ TypeManager::createInternalStructs(Scope &globalScope, TargetPlatform targetPlat
 void
 TypeManager::createStructWithArrayOfBytes(Scope &globalScope, const char *structName, size_t numBytesInArray)
 {
-    types.push_back(new TypeDesc(CLASS_TYPE, NULL, structName, false, false));
+    addType(new TypeDesc(CLASS_TYPE, NULL, structName, false, false));
     ClassDef *theStruct = new ClassDef();
     theStruct->setName(structName);  // use same name as TypeDesc
     const TypeDesc *memberTypeDesc = getIntType(BYTE_TYPE, false);
@@ -93,7 +99,7 @@ TypeManager::createStructWithArrayOfBytes(Scope &globalScope, const char *struct
 void
 TypeManager::createStructWithPairOfWords(Scope &globalScope, const char *structName, bool isHighWordSigned)
 {
-    types.push_back(new TypeDesc(CLASS_TYPE, NULL, structName, isHighWordSigned, false));
+    addType(new TypeDesc(CLASS_TYPE, NULL, structName, isHighWordSigned, false));
     ClassDef *theStruct = new ClassDef();
     theStruct->setName(structName);  // use same name as TypeDesc
 
@@ -125,6 +131,99 @@ TypeManager::~TypeManager()
 }
 
 
+// Appends 'td' to types[] and registers it in the indexes that the get*() methods use
+// instead of scanning types[]. 'td' must be complete: its contents determine its keys.
+// An existing entry for a key is kept, so that lookups find the first matching type,
+// as a scan of types[] would.
+//
+TypeDesc *
+TypeManager::addType(TypeDesc *td) const
+{
+    assert(td && td->isValid());
+    types.push_back(td);
+
+    switch (td->type)
+    {
+    case POINTER_TYPE:
+        pointerTypes.insert(make_pair(td->pointedTypeDesc, td));
+        if (td->pointedTypeDesc->type == FUNCTION_TYPE)
+        {
+            const TypeDesc *funcTD = td->pointedTypeDesc;
+            functionPointerTypes[getFunctionSignatureHash(*funcTD->returnTypeDesc, funcTD->ellipsis, funcTD->formalParamTypeDescList)].push_back(td);
+        }
+        break;
+    case ARRAY_TYPE:
+        arrayTypes.insert(make_pair(ArrayKey(td->pointedTypeDesc, td->numArrayElements), td));
+        break;
+    case CLASS_TYPE:
+        classTypes.insert(make_pair(ClassKey(td->className, td->isUnion), td));
+        break;
+    default:
+        break;
+    }
+
+    typesByStructure[getStructuralHash(*td)].push_back(td);
+    return td;
+}
+
+
+uint32_t
+TypeManager::combineHash(uint32_t hash, uint32_t value)
+{
+    return (hash ^ value) * 16777619u;  // FNV-1a step
+}
+
+
+// Hashes the parts of a function type that findFunctionPointerType() compares
+// with operator ==. Calling convention flags and constness are not included.
+//
+uint32_t
+TypeManager::getFunctionSignatureHash(const TypeDesc &returnTypeDesc,
+                                      bool ellipsis,
+                                      const std::vector<const TypeDesc *> &formalParamTypeDescs)
+{
+    uint32_t hash = combineHash(2166136261u, FUNCTION_TYPE);
+    hash = combineHash(hash, ellipsis);
+    hash = combineHash(hash, getStructuralHash(returnTypeDesc));
+    hash = combineHash(hash, uint32_t(formalParamTypeDescs.size()));
+    for (vector<const TypeDesc *>::const_iterator it = formalParamTypeDescs.begin(); it != formalParamTypeDescs.end(); ++it)
+        hash = combineHash(hash, getStructuralHash(**it));
+    return hash;
+}
+
+
+// Two types for which TypeDesc::compare() returns 0 or only calling convention flag bits
+// have the same hash. That is why this hash ignores array sizes, isUnion, etc.
+//
+uint32_t
+TypeManager::getStructuralHash(const TypeDesc &td)
+{
+    if (td.type == FUNCTION_TYPE)
+        return combineHash(getFunctionSignatureHash(*td.returnTypeDesc, td.ellipsis, td.formalParamTypeDescList), td.isConst);
+
+    uint32_t hash = combineHash(2166136261u, td.type);
+    hash = combineHash(hash, td.isConst);
+    switch (td.type)
+    {
+    case BYTE_TYPE:
+    case WORD_TYPE:
+        hash = combineHash(hash, td.isSigned);
+        break;
+    case CLASS_TYPE:
+        for (string::const_iterator it = td.className.begin(); it != td.className.end(); ++it)
+            hash = combineHash(hash, uint8_t(*it));
+        break;
+    case POINTER_TYPE:
+    case ARRAY_TYPE:
+        hash = combineHash(hash, getStructuralHash(*td.pointedTypeDesc));
+        break;
+    default:
+        break;
+    }
+    return hash;
+}
+
+
 const TypeDesc *
 TypeManager::getVoidType() const
 {
@@ -180,16 +279,11 @@ TypeManager::getPointerTo(const TypeDesc *pointedTypeDesc) const
     if (pointedTypeDesc == NULL)
         return NULL;
 
-    for (vector<TypeDesc *>::const_iterator it = types.begin(); it != types.end(); ++it)
-    {
-        const TypeDesc *td = *it;
-        assert(td && td->isValid());
-        if (td->type == POINTER_TYPE && td->pointedTypeDesc == pointedTypeDesc)
-            return td;
-    }
+    map<const TypeDesc *, const TypeDesc *>::const_iterator it = pointerTypes.find(pointedTypeDesc);
+    if (it != pointerTypes.end())
+        return it->second;
 
-    types.push_back(new TypeDesc(POINTER_TYPE, pointedTypeDesc, string(), false, false));
-    return types.back();
+    return addType(new TypeDesc(POINTER_TYPE, pointedTypeDesc, string(), false, false));
 }
 
 
@@ -227,16 +321,13 @@ TypeManager::getConst(const TypeDesc *typeDesc) const
 
     TypeDesc targetTypeDesc(*typeDesc);
     targetTypeDesc.isConst = true;
-    for (vector<TypeDesc *>::const_iterator it = types.begin(); it != types.end(); ++it)
-    {
-        const TypeDesc *td = *it;
-        assert(td && td->isValid());
-        if (*td == targetTypeDesc)
-            return td;  // found existing const version of 'typeDesc'
-    }
+    TypeBucketMap::const_iterator bucket = typesByStructure.find(getStructuralHash(targetTypeDesc));
+    if (bucket != typesByStructure.end())
+        for (vector<const TypeDesc *>::const_iterator it = bucket->second.begin(); it != bucket->second.end(); ++it)
+            if (**it == targetTypeDesc)
+                return *it;  // found existing const version of 'typeDesc'
 
-    types.push_back(new TypeDesc(targetTypeDesc));
-    return types.back();
+    return addType(new TypeDesc(targetTypeDesc));
 }
 
 
@@ -282,16 +373,11 @@ TypeManager::getArrayOf(const TypeDesc *pointedTypeDesc, size_t numArrayDimensio
 
     if (numArrayDimensions == 1)
     {
-        for (vector<TypeDesc *>::const_iterator it = types.begin(); it != types.end(); ++it)
-        {
-            const TypeDesc *td = *it;
-            assert(td && td->isValid());
-            if (td->type == ARRAY_TYPE && td->pointedTypeDesc == pointedTypeDesc && td->numArrayElements == uint16_t(-1))
-                return td;
-        }
+        map<ArrayKey, const TypeDesc *>::const_iterator it = arrayTypes.find(ArrayKey(pointedTypeDesc, uint16_t(-1)));
+        if (it != arrayTypes.end())
+            return it->second;
 
-        types.push_back(new TypeDesc(ARRAY_TYPE, pointedTypeDesc, string(), false, false));
-        return types.back();
+        return addType(new TypeDesc(ARRAY_TYPE, pointedTypeDesc, string(), false, false));
     }
 
     return getArrayOf(getArrayOf(pointedTypeDesc, numArrayDimensions - 1), 1);
@@ -324,28 +410,22 @@ TypeManager::getSizedArrayOf(const TypeDesc *pointedTypeDesc, const std::vector<
 const TypeDesc *
 TypeManager::getSizedOneDimArrayOf(const TypeDesc *pointedTypeDesc, size_t numArrayElements) const
 {
-    for (vector<TypeDesc *>::const_iterator it = types.begin(); it != types.end(); ++it)
+    if (numArrayElements == uint16_t(numArrayElements))
     {
-        const TypeDesc *td = *it;
-        assert(td && td->isValid());
-        if (td->type == ARRAY_TYPE && td->pointedTypeDesc == pointedTypeDesc && td->numArrayElements == numArrayElements)
-            return td;
+        map<ArrayKey, const TypeDesc *>::const_iterator it = arrayTypes.find(ArrayKey(pointedTypeDesc, uint16_t(numArrayElements)));
+        if (it != arrayTypes.end())
+            return it->second;
     }
 
-    types.push_back(new TypeDesc(ARRAY_TYPE, pointedTypeDesc, string(), false, false, numArrayElements));
-    return types.back();
+    return addType(new TypeDesc(ARRAY_TYPE, pointedTypeDesc, string(), false, false, numArrayElements));
 }
 
 const TypeDesc *
 TypeManager::getClassType(const std::string &className, bool isUnion, bool createIfAbsent) const
 {
-    for (vector<TypeDesc *>::const_iterator it = types.begin(); it != types.end(); ++it)
-    {
-        const TypeDesc *td = *it;
-        assert(td && td->isValid());
-        if (td->type == CLASS_TYPE && td->isUnion == isUnion && td->className == className)
-            return td;
-    }
+    map<ClassKey, const TypeDesc *>::const_iterator it = classTypes.find(ClassKey(className, isUnion));
+    if (it != classTypes.end())
+        return it->second;
 
     if (createIfAbsent)
     {
@@ -353,8 +433,7 @@ TypeManager::getClassType(const std::string &className, bool isUnion, bool creat
             errormsg("referring to %s as a %s, but it is a %s",
                         className.c_str(), isUnion ? "union" : "struct", !isUnion ? "union" : "struct");
 
-        types.push_back(new TypeDesc(CLASS_TYPE, NULL, className, false, isUnion));
-        return types.back();
+        return addType(new TypeDesc(CLASS_TYPE, NULL, className, false, isUnion));
     }
 
     return NULL;
@@ -378,15 +457,22 @@ TypeManager::findFunctionPointerType(const TypeDesc *returnTypeDesc,
                                      bool isISR,
                                      bool receivesFirstParamInReg) const
 {
-    for (vector<TypeDesc *>::const_iterator it = types.begin(); it != types.end(); ++it)
+    vector<const TypeDesc *> paramTypeDescs;
+    if (!params.hasSingleVoidParam())
+        for (vector<Tree *>::const_iterator it = params.begin(); it != params.end(); ++it)
+            paramTypeDescs.push_back((*it)->getTypeDesc());
+
+    TypeBucketMap::const_iterator bucket = functionPointerTypes.find(
+                        getFunctionSignatureHash(*returnTypeDesc, params.endsWithEllipsis(), paramTypeDescs));
+    if (bucket == functionPointerTypes.end())
+        return NULL;
+
+    for (vector<const TypeDesc *>::const_iterator it = bucket->second.begin(); it != bucket->second.end(); ++it)
     {
         const TypeDesc *td = *it;
         assert(td && td->isValid());
-        if (td->type != POINTER_TYPE)
-            continue;
         const TypeDesc *funcTD = td->pointedTypeDesc;
-        if (funcTD->type != FUNCTION_TYPE)
-            continue;
+        assert(td->type == POINTER_TYPE && funcTD->type == FUNCTION_TYPE);
         if (funcTD->isISR != isISR || funcTD->receivesFirstParamInReg != receivesFirstParamInReg || funcTD->ellipsis != params.endsWithEllipsis())
             continue;
         if (*funcTD->returnTypeDesc != *returnTypeDesc)
@@ -426,13 +512,14 @@ TypeManager::getFunctionPointerType(const TypeDesc *returnTypeDesc, const Formal
 
     TypeDesc *funcTD = new TypeDesc(fixedReturnTypeDesc, isISR, params.endsWithEllipsis(), receivesFirstParamInReg);
     assert(funcTD->type == FUNCTION_TYPE);
-    types.push_back(funcTD);
 
     // Add the argument types to funcTD, unless the list of args is just (void).
+    // This must be done before addType(), which indexes funcTD by its contents.
     //
     if (!params.hasSingleVoidParam())
         for (vector<Tree *>::const_iterator it = params.begin(); it != params.end(); ++it)
              funcTD->addFormalParamTypeDesc((*it)->getTypeDesc());
+    addType(funcTD);
 
     //cout << "# TypeManager::getFunctionPointerType:   funcTD={" << funcTD->toString() << "}\n";
     return getPointerTo(funcTD);
@@ -445,17 +532,18 @@ TypeManager::getInterruptType(const TypeDesc *existingType) const
     if (existingType->isISR)
         return existingType;
 
-    for (vector<TypeDesc *>::const_iterator it = types.begin(); it != types.end(); ++it)
-    {
-        const TypeDesc *td = *it;
-        if (((- TypeDesc::compare(*existingType, *td)) & 2) && td->isISR)
-            return td;
-    }
+    TypeBucketMap::const_iterator bucket = typesByStructure.find(getStructuralHash(*existingType));
+    if (bucket != typesByStructure.end())
+        for (vector<const TypeDesc *>::const_iterator it = bucket->second.begin(); it != bucket->second.end(); ++it)
+        {
+            const TypeDesc *td = *it;
+            if (((- TypeDesc::compare(*existingType, *td)) & 2) && td->isISR)
+                return td;
+        }
 
     TypeDesc *newTD = new TypeDesc(*existingType);
     newTD->isISR = true;
-    types.push_back(newTD);
-    return newTD;
+    return addType(newTD);
 }
 
 
@@ -465,17 +553,18 @@ TypeManager::getFPIRType(const TypeDesc *existingType) const
     if (existingType->receivesFirstParamInReg)
         return existingType;
 
-    for (vector<TypeDesc *>::const_iterator it = types.begin(); it != types.end(); ++it)
-    {
-        const TypeDesc *td = *it;
-        if (((- TypeDesc::compare(*existingType, *td)) & 4) && td->receivesFirstParamInReg)
-            return td;
-    }
+    TypeBucketMap::const_iterator bucket = typesByStructure.find(getStructuralHash(*existingType));
+    if (bucket != typesByStructure.end())
+        for (vector<const TypeDesc *>::const_iterator it = bucket->second.begin(); it != bucket->second.end(); ++it)
+        {
+            const TypeDesc *td = *it;
+            if (((- TypeDesc::compare(*existingType, *td)) & 4) && td->receivesFirstParamInReg)
+                return td;
+        }
 
     TypeDesc *newTD = new TypeDesc(*existingType);
     newTD->receivesFirstParamInReg = true;
-    types.push_back(newTD);
-    return newTD;
+    return addType(newTD);
 }
 
 
@@ -485,19 +574,20 @@ TypeManager::getTypeWithoutCallingConventionFlags(const TypeDesc *existingType)
     if (! existingType->isISR && ! existingType->receivesFirstParamInReg)
         return existingType;
 
-    for (vector<TypeDesc *>::const_iterator it = types.begin(); it != types.end(); ++it)
-    {
-        const TypeDesc *td = *it;
-        // If td has no calling convention flags and differs from existingType only by such flags, then td is it.
-        if (!td->isISR && !td->receivesFirstParamInReg && ((- TypeDesc::compare(*existingType, *td)) & (2 | 4)))
-            return td;
-    }
+    TypeBucketMap::const_iterator bucket = typesByStructure.find(getStructuralHash(*existingType));
+    if (bucket != typesByStructure.end())
+        for (vector<const TypeDesc *>::const_iterator it = bucket->second.begin(); it != bucket->second.end(); ++it)
+        {
+            const TypeDesc *td = *it;
+            // If td has no calling convention flags and differs from existingType only by such flags, then td is it.
+            if (!td->isISR && !td->receivesFirstParamInReg && ((- TypeDesc::compare(*existingType, *td)) & (2 | 4)))
+                return td;
+        }
 
     TypeDesc *newTD = new TypeDesc(*existingType);
     newTD->isISR = false;
     newTD->receivesFirstParamInReg = false;
-    types.push_back(newTD);
-    return newTD;
+    return addType(newTD);
 }
 
 
@@ -627,10 +717,8 @@ TypeManager::declareEnumerationList(const std::string &enumTypeName,
 Enumerator *
 TypeManager::findEnumerator(const string &enumeratorName) const
 {
-    for (size_t i = 0; i < enumerators.size(); ++i)
-        if (enumerators[i].first == enumeratorName)
-            return enumerators[i].second;
-    return NULL;
+    map<string, Enumerator *>::const_iterator it = enumeratorsByName.find(enumeratorName);
+    return it != enumeratorsByName.end() ? it->second : NULL;
 }
 
 
@@ -653,6 +741,7 @@ TypeManager::declareEnumerator(Enumerator *enumerator)
     }
 
     enumerators.push_back(make_pair(enumerator->name, enumerator));
+    enumeratorsByName[enumerator->name] = enumerator;
     return true;
 }
 
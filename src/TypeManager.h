@@ -154,6 +154,12 @@ private:
                                             bool isISR,
                                             bool receivesFirstParamInReg) const;
     const TypeDesc *getSizedOneDimArrayOf(const TypeDesc *pointedTypeDesc, size_t numArrayElements) const;
+    TypeDesc *addType(TypeDesc *td) const;
+    static uint32_t combineHash(uint32_t hash, uint32_t value);
+    static uint32_t getFunctionSignatureHash(const TypeDesc &returnTypeDesc,
+                                             bool ellipsis,
+                                             const std::vector<const TypeDesc *> &formalParamTypeDescs);
+    static uint32_t getStructuralHash(const TypeDesc &td);
 
 private:
 
@@ -164,10 +170,25 @@ private:
     typedef std::vector<EnumeratorNamePair> EnumeratorList;  // key: enum name
         // NOTE: Enumerators listed in declaration order so that they get processed in that order by the DeclarationFinisher.
 
+    // Indexes over types[], maintained by addType(), so that the get*() methods
+    // do not have to scan all known types. Each index keeps the first type
+    // registered under a given key, i.e., the one that a scan of types[] would find.
+    // The buckets of a TypeBucketMap list their types in types[] order.
+    //
+    typedef std::pair<const TypeDesc *, uint16_t> ArrayKey;  // pointed type, number of elements
+    typedef std::pair<std::string, bool> ClassKey;  // class name, isUnion
+    typedef std::map<uint32_t, std::vector<const TypeDesc *> > TypeBucketMap;
+
     mutable std::vector<TypeDesc *> types;  // see the constructor for predefined types
+    mutable std::map<const TypeDesc *, const TypeDesc *> pointerTypes;  // key: pointed type
+    mutable std::map<ArrayKey, const TypeDesc *> arrayTypes;
+    mutable std::map<ClassKey, const TypeDesc *> classTypes;
+    mutable TypeBucketMap typesByStructure;  // key: getStructuralHash()
+    mutable TypeBucketMap functionPointerTypes;  // key: getFunctionSignatureHash() of the pointed function
     TypeDefMap typeDefs;
     EnumTypeNameMap enumTypeNames;
     EnumeratorList enumerators;  // owns the Enumerators, must delete them
+    std::map<std::string, Enumerator *> enumeratorsByName;  // index over 'enumerators'
 
 };
 
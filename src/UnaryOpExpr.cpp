@@ -525,7 +525,15 @@ UnaryOpExpr::emitCode(ASMText &out, bool lValue) const
             if (getTypeDesc()->isRealOrLong())
             {
                 //string variant = subExpr->isLong() ? "DWord" : (subExpr->isSingle() ? "Single" : "Double");
-                if (!isPre)
+                if (!isPre && getTypeDesc()->isLong())
+                {
+                    assert(resultDeclaration);
+                    out.ins("LDD", ",X", "copy long to temporary that receives init value of inc/dec");
+                    out.ins("STD", resultDeclaration->getFrameDisplacementArg(0));
+                    out.ins("LDD", "2,X");
+                    out.ins("STD", resultDeclaration->getFrameDisplacementArg(2));
+                }
+                else if (!isPre)
                 {
                     assert(resultDeclaration);
                     out.ins("PSHS", "X", "preserve address of number to inc/dec");
@@ -534,7 +542,31 @@ UnaryOpExpr::emitCode(ASMText &out, bool lValue) const
                     callUtility(out, "copy" + string(variant));  // preserves X
                     out.ins("PULS", "X", "point to number to inc/dec");
                 }
-                callUtility(out, string(isInc ? "increment" : "decrement") + variant, "inc/dec number at X");  // preserves X
+                if (getTypeDesc()->isLong() && isInc)
+                {
+                    // Increment the long at X from its low byte, stopping at the first byte that does not wrap to zero.
+                    string endLabel = TranslationUnit::instance().generateLabel('L');
+                    out.ins("INC", "3,X", "increment long at X");
+                    out.ins("LBNE", endLabel);
+                    out.ins("INC", "2,X");
+                    out.ins("LBNE", endLabel);
+                    out.ins("INC", "1,X");
+                    out.ins("LBNE", endLabel);
+                    out.ins("INC", ",X");
+                    out.emitLabel(endLabel);
+                }
+                else if (getTypeDesc()->isLong())
+                {
+                    out.ins("LDD", "2,X", "decrement long at X");
+                    out.ins("SUBD", "#1");
+                    out.ins("STD", "2,X");
+                    out.ins("LDD", ",X");
+                    out.ins("SBCB", "#0");
+                    out.ins("SBCA", "#0");
+                    out.ins("STD", ",X");
+                }
+                else
+                    callUtility(out, string(isInc ? "increment" : "decrement") + variant, "inc/dec number at X");  // preserves X
                 if (!isPre)
                 {
                     out.ins("LEAX", resultDeclaration->getFrameDisplacementArg(0),
@@ -667,6 +699,8 @@ UnaryOpExpr::emitCode(ASMText &out, bool lValue) const
             assert(getType() == BYTE_TYPE);
             if (lValue)
                 return false;
+            if (BinaryOpExpr::isBooleanExpr(subExpr))  // e.g., !(a < b): branch on CC directly
+                return BinaryOpExpr::emitBoolValue(out, this);
             if (subExpr->getTypeDesc()->isRealOrLong())
             {
                 if (!subExpr->emitCode(out, true))  // point to real/long with X
@@ -765,3 +799,13 @@ UnaryOpExpr::replaceChild(Tree *existingChild, Tree *newChild)
         return;
     assert(!"child not found");
 }
+
+
+void
+UnaryOpExpr::castSubExpr(const TypeDesc *td)
+{
+    assert(subExpr != NULL);
+    CastExpr *castExpr = new CastExpr(td, subExpr);
+    castExpr->copyLineNo(*subExpr);
+    subExpr = castExpr;
+}
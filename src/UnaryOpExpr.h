@@ -78,6 +78,10 @@ public:
 
     virtual void replaceChild(Tree *existingChild, Tree *newChild);
 
+    // Replaces the operand with a cast of that operand to 'td'.
+    //
+    void castSubExpr(const TypeDesc *td);
+
     void allowDereferencingVoid() { dereferencingVoidAllowed = true; }
 
     virtual bool isLValue() const { return oper == INDIRECTION || oper == PREINC || oper == POSTINC || oper == POSTINC || oper == POSTDEC; }
@@ -31,6 +31,7 @@ WhileStmt::WhileStmt(Tree *cond, Tree *bodyStmt, bool isDoWhile)
     body(bodyStmt),
     isDo(isDoWhile)
 {
+    setNodeKind(WHILE_STMT_NODE);
 }
 
 
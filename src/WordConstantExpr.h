@@ -40,6 +40,8 @@ public:
 
     uint16_t getWordValue() const;
 
+    double getRealValue() const { return wordValue; }
+
     virtual void checkSemantics(Functor &f);
 
     virtual CodeStatus emitCode(ASMText &out, bool lValue) const;
@@ -24,27 +24,26 @@
 
 using namespace std;
 
-string sourceFilename;
-int lineno = 1;  // line number in the input text; first line is numbered 1
-
-
-static bool doublePrecisionLiteralWarningIssued = false;
+/*  The scanner is reentrant: its state is in the yyscan_t object created
+    by yylex_init_extra(). The actions refer to the TranslationUnit being
+    compiled as 'yyextra', which keeps the current source position.
+*/
 
-static void warnIfDoublePrecisionLiteral(const char *realLiteralText)
+static void warnIfDoublePrecisionLiteral(TranslationUnit &tu, const char *realLiteralText)
 {
-    if (!doublePrecisionLiteralWarningIssued && tolower(realLiteralText[strlen(realLiteralText) - 1]) != 'f')
-    {
-        warnmsg("double-precision numeric literals have same precision as `float' for this compiler");
-        doublePrecisionLiteralWarningIssued = true;
-    }
+    if (tolower(realLiteralText[strlen(realLiteralText) - 1]) != 'f')
+        tu.warnAboutDoublePrecisionLiteral();
 }
 
 
-extern "C" int yywrap(void) { return 1; }  // yylex() returns 0 when EOF reached
+extern "C" int yywrap(yyscan_t) { return 1; }  // yylex() returns 0 when EOF reached
 
 bool isOctal(uint64_t &value, const char *str);
 %}
 
+%option reentrant bison-bridge
+%option extra-type="TranslationUnit *"
+
 letter          [A-Za-z_]
 digit           [0-9]
 ws              ([ \t\f\v\r\xA0]|\xC2\xA0)
@@ -65,13 +64,13 @@ ws              ([ \t\f\v\r\xA0]|\xC2\xA0)
             The 1st integer is the line number in FILENAME.
             One or more integers can appear after the filename. They are all ignored.
         */
-^\#\ [0-9]+\ \".*\"[ 0-9]*$     { sscanf(yytext + 2, "%d", &lineno);
-                                  lineno--;
+^\#\ [0-9]+\ \".*\"[ 0-9]*$     { int markerLineNo = 1;
+                                  sscanf(yytext + 2, "%d", &markerLineNo);
                                   char *fn = strchr(yytext, '\"') + 1;
                                   char *end = strchr(fn, '\"');
                                   *end = '\0';
-                                  sourceFilename = fn;
-                                  TranslationUnit::instance().addPrerequisiteFilename(fn);
+                                  yyextra->setCurrentSourcePosition(fn, markerLineNo - 1);
+                                  yyextra->addPrerequisiteFilename(fn);
                                 }
 
     /* Pragma directive. */
@@ -81,7 +80,7 @@ ws              ([ \t\f\v\r\xA0]|\xC2\xA0)
                                     const char *src = strstr(yytext, "pragma") + 6;
                                     for (++src; isspace(*src); ++src)
                                         ;
-                                    yylval.str = strdup(src);
+                                    yylval->str = strdup(src);
                                     return PRAGMA; 
                                 }
 
@@ -89,12 +88,12 @@ ws              ([ \t\f\v\r\xA0]|\xC2\xA0)
 asm({ws}|\n)*\{([^\{\}]|(\{[^\{\}]*\}))*\}         {
                                     // Verbatim assembler text.
                                     // Copy contents of braces into yytext, and count newlines.
-                                    // Update 'lineno' according to number of source lines taken.
+                                    // Update the line number according to number of source lines taken.
                                     // 
                                     char *p;
                                     for (p = yytext + 3; *p != '{'; ++p)
                                         if (*p == '\n')
-                                            ++lineno;
+                                            yyextra->incrementCurrentLineNo();
 
                                     char *begin = p + 1;
                                     char *end = strrchr(begin, '}');
@@ -106,7 +105,7 @@ asm({ws}|\n)*\{([^\{\}]|(\{[^\{\}]*\}))*\}         {
                                             char c = *reader++;
                                             *writer++ = c;
                                             if (c == '\n')
-                                                ++lineno;
+                                                yyextra->incrementCurrentLineNo();
                                         }
                                         *writer = '\0';
 
@@ -118,7 +117,7 @@ asm({ws}|\n)*\{([^\{\}]|(\{[^\{\}]*\}))*\}         {
 {ws}+                           ;
 
     /* Newline increments the line counter. */
-\n                              { lineno++; }
+\n                              { yyextra->incrementCurrentLineNo(); }
 
 --                              { return MINUS_MINUS; }
 \+\+                            { return PLUS_PLUS; }
@@ -146,14 +145,14 @@ asm({ws}|\n)*\{([^\{\}]|(\{[^\{\}]*\}))*\}         {
     /* Hexadecimal constant. */
 0[xX]([0-9A-Fa-f]+)([lLuU]+)?    { unsigned long n;
                                    sscanf(yytext + 2, "%lx", &n);
-                                   yylval.real = n;
+                                   yylval->real = n;
                                    return REAL; }
 
     /* Binary constant. */
 0[bB]([01]+)([lLuU]+)?    { unsigned long n = 0;
                             for (const char *p = yytext + 2; isdigit(*p); ++p)
                                 n = (n << 1) | unsigned(*p != '0'); 
-                            yylval.real = n;
+                            yylval->real = n;
                             return REAL; }
 
     /* Decimal float constant.
@@ -163,32 +162,32 @@ asm({ws}|\n)*\{([^\{\}]|(\{[^\{\}]*\}))*\}         {
        these 3 tokens as a subtraction. 
     */
 (([0-9]*\.[0-9]+))([eE][-+]?[0-9]+)?[fF]?       {
-                yylval.real = atof(yytext);
-                warnIfDoublePrecisionLiteral(yytext);
+                yylval->real = atof(yytext);
+                warnIfDoublePrecisionLiteral(*yyextra, yytext);
                 return REAL; }
 
     /* If there are no digits after the decimal point, there must be
        at least one digit before the point, e.g., "1.", "1.e6", "1.f", "1.e6f".
     */
 ([0-9]+\.)([eE][-+]?[0-9]+)?[fF]?       {
-                yylval.real = atof(yytext);
-                warnIfDoublePrecisionLiteral(yytext);
+                yylval->real = atof(yytext);
+                warnIfDoublePrecisionLiteral(*yyextra, yytext);
                 return REAL; }
 
     /* Same as previous rule, but no decimal point, and required 'e'.
     */
 ([0-9]+)([eE][-+]?[0-9]+)[fF]?       {
-                yylval.real = atof(yytext);
-                warnIfDoublePrecisionLiteral(yytext);
+                yylval->real = atof(yytext);
+                warnIfDoublePrecisionLiteral(*yyextra, yytext);
                 return REAL; }
 
     /* Decimal or octal integer, with optional "unsigned" or "long" suffix character. */ 
 ([0-9]+)([uUlL]*)       {
                 uint64_t octalConversion = 0;
                 if (yytext[0] == '0' && isOctal(octalConversion, yytext + 1))
-                    yylval.real = double(octalConversion);
+                    yylval->real = double(octalConversion);
                 else
-                    yylval.real = atof(yytext);
+                    yylval->real = atof(yytext);
                 return REAL; }
 
     /* Keyword, typedef name or identifier. */
@@ -234,46 +233,46 @@ asm({ws}|\n)*\{([^\{\}]|(\{[^\{\}]*\}))*\}         {
                 const TypeDesc *td = TranslationUnit::getTypeManager().getTypeDef(yytext);
                 if (td)  // if yytext is the name of a typedef: 
                 {
-                    yylval.typeDesc = td;
+                    yylval->typeDesc = td;
                     return TYPE_NAME;
                 }
 
-                yylval.str = strdup(yytext); return ID;
+                yylval->str = strdup(yytext); return ID;
                 }
 
     /* Double-quoted string constant. No double-quote or newline allowed inside. */
-\"([^\"\n]|\\\")*\"     { yylval.str = strdup(yytext + 1);
-                        yylval.str[strlen(yylval.str) - 1] = '\0';
+\"([^\"\n]|\\\")*\"     { yylval->str = strdup(yytext + 1);
+                        yylval->str[strlen(yylval->str) - 1] = '\0';
                         return STRLIT; }
 
     /* Control code character constants. */
-''              { yylval.character = '\0'; return CHARLIT; }
-'\\0'           { yylval.character = '\0'; return CHARLIT; }
-'\\a'           { yylval.character = '\a'; return CHARLIT; }
-'\\b'           { yylval.character = '\b'; return CHARLIT; }
-'\\t'           { yylval.character = '\t'; return CHARLIT; }
-'\\n'           { yylval.character = '\n'; return CHARLIT; }
-'\\v'           { yylval.character = '\v'; return CHARLIT; }
-'\\f'           { yylval.character = '\f'; return CHARLIT; }
-'\\r'           { yylval.character = '\r'; return CHARLIT; }
-'\\''           { yylval.character = '\''; return CHARLIT; }
-'\\\"'          { yylval.character = '\"'; return CHARLIT; }
-'\\\\'          { yylval.character = '\\'; return CHARLIT; }
+''              { yylval->character = '\0'; return CHARLIT; }
+'\\0'           { yylval->character = '\0'; return CHARLIT; }
+'\\a'           { yylval->character = '\a'; return CHARLIT; }
+'\\b'           { yylval->character = '\b'; return CHARLIT; }
+'\\t'           { yylval->character = '\t'; return CHARLIT; }
+'\\n'           { yylval->character = '\n'; return CHARLIT; }
+'\\v'           { yylval->character = '\v'; return CHARLIT; }
+'\\f'           { yylval->character = '\f'; return CHARLIT; }
+'\\r'           { yylval->character = '\r'; return CHARLIT; }
+'\\''           { yylval->character = '\''; return CHARLIT; }
+'\\\"'          { yylval->character = '\"'; return CHARLIT; }
+'\\\\'          { yylval->character = '\\'; return CHARLIT; }
 
     /* Character constant expressed as a hexadecimal character code (e.g., '\xFF'). */
 '\\x[0-9A-Fa-f][0-9A-Fa-f]?'    { unsigned int n;
                                 sscanf(yytext + 3, "%x", &n);
-                                yylval.character = (signed char) n;
+                                yylval->character = (signed char) n;
                                 return CHARLIT; }
 
     /* Character constant expressed as an octal character code (e.g., '\0377'). */
 '\\0?[0-7][0-7]?[0-7]?'    { unsigned int n;
                             sscanf(yytext + 2, "%o", &n);
-                            yylval.character = (signed char) n;
+                            yylval->character = (signed char) n;
                             return CHARLIT;}
 
     /* Other character constant. */
-'.'             { yylval.character = yytext[1]; return CHARLIT; }
+'.'             { yylval->character = yytext[1]; return CHARLIT; }
 
     /* Any non-blank single-character token. */
 .                               { return yytext[0]; }
@@ -283,7 +282,7 @@ asm({ws}|\n)*\{([^\{\}]|(\{[^\{\}]*\}))*\}         {
 
 /*  Avoids warning about `yyunput' being defined but not used.
 */
-void BlackHole(void) { yyunput('\0', NULL); }
+void BlackHole(yyscan_t yyscanner) { yyunput('\0', NULL, yyscanner); }
 
 
 /*  Returns true if 'str' contains only octal digits and puts the value in 'value'.
@@ -20,7 +20,8 @@
 #include "TranslationUnit.h"
 
 #include "SwitchStmt.h"
-#include "FunctionDef.h"
+#include "Pragma.h"
+#include "Preprocessor.h"
 
 #include <string>
 #include <iostream>
@@ -37,16 +38,23 @@
 #if defined(__MINGW32__)
 #define WIFEXITED(x)   ((unsigned) (x) < 259)
 #define WEXITSTATUS(x) ((x) & 0xff)
+#else
+#include <sys/wait.h>
+#include <unistd.h>
 #endif
 
 using namespace std;
 
 
-int yyparse(void);
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void *yyscan_t;  // scanner generated from lexer.ll
+#endif
 
-extern FILE *yyin;
-extern int numErrors;
-extern int numWarnings;
+int yylex_init_extra(TranslationUnit *tu, yyscan_t *scanner);
+void yyset_in(FILE *file, yyscan_t scanner);
+int yylex_destroy(yyscan_t scanner);
+int yyparse(yyscan_t scanner);
 
 
 #ifndef PROGRAM  // Allow the compilation to define the program name as a macro.
@@ -69,7 +77,8 @@ public:
 
     uint16_t stackSpace;  // applies to --check-stack and sbrk()
 
-    uint32_t functionStackSpace;  // uint32_t(-1) means not set by command-line argument
+    uint32_t functionStackSpace;  // uint32_t(-1) means not set by command-line argument;
+                                  // main() replaces it with the value to use before compiling
 
     string pkgdatadir;  // directory where CMOC support files (.h, etc.) get installed
 
@@ -91,6 +100,8 @@ public:
     bool treatWarningsAsErrors;
     bool nullPointerCheckingEnabled;
     bool stackOverflowCheckingEnabled;
+    bool stackReportEnabled;  // write the stack usage of each function to standard output
+    bool cycleReportEnabled;  // write the cycles taken by each function to standard output
     TargetPlatform targetPlatform;
     bool assumeTrack34;  // true = CoCo DECB Track 34 (relevant only with COCO_BASIC)
     bool generateSREC;   // generate a Motorola SREC executable
@@ -117,9 +128,18 @@ public:
     bool searchDefaultIncludeDirs;
 
     list<string> defines;
+    bool externalPreprocessorUsed;  // --external-cpp: call cpp instead of using the Preprocessor class
+    bool precompiledHeadersGenerated;  // --pch: write a precompiled header for each .h file
+    string precompiledHeaderFilename;  // --include-pch=FILE; empty if not used
+    size_t numJobs;  // -j: maximum number of C files compiled at the same time
+    TranslationUnit::ExecutionCountTable executionCounts;  // --profile-use; empty if not used
+    TranslationUnit::ExecutionCountTable blockExecutionCounts;  // --profile-use; empty if not used
+    Preprocessor::FileCache preprocessorFileCache;  // shared by the C files compiled by this process
 
 private:
     static uint32_t getVersionInteger();
+    void defineMacros(Preprocessor &preprocessor, const char *targetPreprocId) const;
+    void createTranslationUnit() const;
 
 public:
     Parameters()
@@ -144,6 +164,8 @@ public:
         treatWarningsAsErrors(false),
         nullPointerCheckingEnabled(false),
         stackOverflowCheckingEnabled(false),
+        stackReportEnabled(false),
+        cycleReportEnabled(false),
         targetPlatform(COCO_BASIC),
         assumeTrack34(false),
         generateSREC(false),
@@ -166,10 +188,21 @@ public:
         relocatabilitySupported(true),
         includeDirList(),
         searchDefaultIncludeDirs(true),
-        defines()
+        defines(),
+        externalPreprocessorUsed(false),
+        precompiledHeadersGenerated(false),
+        precompiledHeaderFilename(),
+        numJobs(1),
+        executionCounts(),
+        blockExecutionCounts(),
+        preprocessorFileCache()
     {
     }
 
+    int precompileHeader(const string &headerFilename,
+                         const string &pchFilename,
+                         const char *targetPreprocId);
+
     int compileCFile(const string &inputFilename,
                      const string &moduleName,
                      const string &asmFilename,
@@ -238,6 +271,12 @@ displayHelp()
         "-Idir               Add directory <dir> to the compiler's include directories\n"
         "                    (also applies to assembler).\n"
         "-Dxxx=yyy           Equivalent to #define xxx yyy\n"
+        "--external-cpp      Preprocess with the system's cpp command instead of the\n"
+        "                    built-in preprocessor.\n"
+        "--pch               Write a precompiled header (FILE.h.pch), i.e., the\n"
+        "                    preprocessed text and macros of each FILE.h given,\n"
+        "                    instead of compiling. See the manual.\n"
+        "--include-pch=FILE  Start each C file with the precompiled header FILE.\n"
         "-L dir              Add a directory to the library search path.\n"
         "-l name             Add a library to the linking phase. -lfoo expects `libfoo.a'.\n"
         "                    This option must be specified after the source/object files.\n"
@@ -251,6 +290,10 @@ displayHelp()
         "                    Affects --check-stack and sbrk().\n"
         "                    Not usable under OS-9, where stack checking is automatic.\n"
         "                    Ignored when targeting Vectrex.\n"
+        "--stack-report      Display the worst-case stack usage of each function,\n"
+        "                    starting with main() and the interrupt service routines.\n"
+        "--cycle-report      Display the cycles taken by the fastest and slowest paths\n"
+        "                    through each function, and by one iteration of each loop.\n"
         "--function-stack=N  (OS-9 only.) Emit code at the start of each function to check that there\n"
         "                    is at least N bytes of free stack space in addition to local variables.\n"
         "                    0 means no stack checking. Default is 64.\n"
@@ -261,12 +304,16 @@ displayHelp()
         "-Wlocal-var-hiding  Warn when a local variable hides another one.\n"
         "--switch=MODE       Force all switch() statements to use MODE, where MODE is 'ifelse'\n"
         "                    for an if-else sequence or 'jump' for a jump table.\n"
+        "--profile-use=FILE  Optimize for speed the functions and blocks that FILE, written by\n"
+        "                    usim --profile, shows to be hot. Needs the linker map with the same\n"
+        "                    name but the .map extension (see -i).\n"
         "-O0|-O1|-O2         Optimization level (default is 2). Compilation is faster with -O0.\n"
         //"--no-peephole       Deprecated: equivalent to -O0.\n"
         "-Werror             Treat warnings as errors.\n"
         "-o FILE             Place the output in FILE (default: change C file extension to .bin).\n"
         "--intermediate|-i   Keep intermediate compilation and linking files.\n"
         "--intdir=D          Put intermediate files in directory D.\n"
+        "-j N                Compile as many as N C files at the same time.\n"
         "\n";
 
     cout << "Compiler data directory: " << params.pkgdatadir << "\n\n";
@@ -608,6 +655,111 @@ checkLinkingMap(uint16_t limitAddress,
 }
 
 
+// Reads the per-address execution counts written by usim's --profile option
+// in profileFilename, and the linker map that has the same name but with the
+// .map extension. Uses the funcend_* labels that the compiler emits after each
+// function to attribute each executed address to a function. A static function
+// is found by its funcstart_* and funcend_* labels, which are only emitted
+// for the usim target (see TranslationUnit::areProfilingLabelsEmitted()).
+// Fills 'counts' with the number of instructions executed in each function,
+// and 'blockCounts' with the number of times that the first instruction of
+// each function and of each funcblock_* label was executed.
+//
+static int
+loadExecutionProfile(const string &profileFilename,
+                     TranslationUnit::ExecutionCountTable &counts,
+                     TranslationUnit::ExecutionCountTable &blockCounts)
+{
+    string mapFilename = replaceExtension(profileFilename, ".map");
+    ifstream mapFile(mapFilename.c_str());
+    if (!mapFile)
+    {
+        cout << PACKAGE << fatalErrorPrefix << "failed to open linker map file " << mapFilename << endl;
+        return EXIT_FAILURE;
+    }
+
+    // Key: object filename and function identifier. Value: start and end addresses.
+    typedef map<pair<string, string>, pair<uint16_t, uint16_t> > FunctionBoundaries;
+    FunctionBoundaries boundaries;
+    map<string, uint16_t> blockAddresses;  // key: block key (see ASMText::layOutBlocks())
+
+    string line, symbolName, objectFilename;
+    while (getline(mapFile, line))
+    {
+        uint16_t symbolValue = 0;
+        if (!parseLinkerMapSymbolLine(line, &symbolName, &objectFilename, symbolValue))
+            continue;
+        if (startsWith(symbolName, "funcend_"))
+            boundaries[make_pair(objectFilename, string(symbolName, 8))].second = symbolValue;
+        else if (startsWith(symbolName, "funcstart_"))
+            boundaries[make_pair(objectFilename, string(symbolName, 10))].first = symbolValue;
+        else if (startsWith(symbolName, "funcblock_"))
+            blockAddresses[string(symbolName, 10)] = symbolValue;
+        else if (symbolName[0] == '_')
+            boundaries[make_pair(objectFilename, string(symbolName, 1))].first = symbolValue;
+    }
+
+    // Key: start address. Value: end address and function identifier.
+    typedef map<uint16_t, pair<uint16_t, string> > FunctionRanges;
+    FunctionRanges ranges;
+    for (FunctionBoundaries::const_iterator it = boundaries.begin(); it != boundaries.end(); ++it)
+        if (it->second.first < it->second.second)  // if function (a variable has no end)
+            ranges[it->second.first] = make_pair(it->second.second, it->first.second);
+
+    ifstream profileFile(profileFilename.c_str());
+    if (!profileFile)
+    {
+        cout << PACKAGE << fatalErrorPrefix << "failed to open execution profile " << profileFilename << endl;
+        return EXIT_FAILURE;
+    }
+
+    uint64_t numAttributedInstructions = 0;
+    map<uint16_t, uint32_t> addressCounts;
+    while (getline(profileFile, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+        unsigned address = 0;
+        unsigned long count = 0;
+        if (sscanf(line.c_str(), "%x %lu", &address, &count) != 2 || address > 0xFFFF)
+        {
+            cout << PACKAGE << fatalErrorPrefix << "invalid line in execution profile " << profileFilename
+                            << ": " << line << endl;
+            return EXIT_FAILURE;
+        }
+
+        addressCounts[uint16_t(address)] += uint32_t(count);
+
+        FunctionRanges::const_iterator it = ranges.upper_bound(uint16_t(address));
+        if (it == ranges.begin())
+            continue;  // address precedes all functions
+        --it;
+        if (address < it->second.first)
+        {
+            counts[it->second.second] += uint32_t(count);
+            numAttributedInstructions += count;
+        }
+    }
+
+    if (numAttributedInstructions == 0)
+    {
+        cout << PACKAGE << ": warning: execution profile " << profileFilename
+                        << " matches no function in linker map " << mapFilename << endl;
+        return EXIT_SUCCESS;
+    }
+
+    for (FunctionRanges::const_iterator it = ranges.begin(); it != ranges.end(); ++it)
+    {
+        counts.insert(make_pair(it->second.second, 0));  // list functions never executed
+        blockCounts[it->second.second] = addressCounts[it->first];
+    }
+    for (map<string, uint16_t>::const_iterator it = blockAddresses.begin(); it != blockAddresses.end(); ++it)
+        blockCounts[it->first] = addressCounts[it->second];
+
+    return EXIT_SUCCESS;
+}
+
+
 static bool
 removeFile(const string &path)
 {
@@ -767,8 +919,6 @@ invokeLinker(const vector<string> &objectFilenames,
     status = WEXITSTATUS(status);
     if (status != 0)
         return status;
-    if (numErrors > 0)
-        return EXIT_FAILURE;
 
     return checkLinkingMap(limitAddress, mapFilename);
 }
@@ -995,6 +1145,113 @@ parseIncludeMarker(const char *line, string &filename)
 }
 
 
+// Determines if 'line' is a #pragma embed directive (see Pragma::isEmbed()).
+// If it is, the quoted file path is stored in 'filename' and true is returned.
+// Otherwise, false is returned.
+//
+static bool
+parseEmbedPragma(const char *line, string &filename)
+{
+    string directive(line);
+    size_t i = 0;
+    passSpaces(directive, i);
+    if (directive.compare(i, 1, "#") != 0)
+        return false;
+    passSpaces(directive, ++i);
+    if (directive.compare(i, 6, "pragma") != 0)
+        return false;
+    i += 6;
+    passSpaces(directive, i);
+    size_t end = directive.find_last_not_of(" \t\r\n");
+    if (end == string::npos || end < i)
+        return false;
+    string symbol;
+    return Pragma::parseEmbed(string(directive, i, end + 1 - i), filename, symbol);
+}
+
+
+// Returns a file from which the contents of 'text' can be read, or NULL.
+// 'text' must not change until the file is closed.
+//
+static FILE *
+openTextAsFile(const string &text)
+{
+#if defined(__MINGW32__)
+    FILE *file = tmpfile();
+    if (file != NULL && (fwrite(text.data(), 1, text.length(), file) != text.length()
+                         || fseek(file, 0, SEEK_SET) != 0))
+    {
+        fclose(file);
+        file = NULL;
+    }
+    return file;
+#else
+    return fmemopen((void *) text.data(), text.length(), "r");
+#endif
+}
+
+
+// Defines the macros that the command line and the target platform imply.
+//
+void
+Parameters::defineMacros(Preprocessor &preprocessor, const char *targetPreprocId) const
+{
+    stringstream versionDefinition;
+    versionDefinition << "_CMOC_VERSION_=" << getVersionInteger();
+    preprocessor.defineMacro(versionDefinition.str());
+    preprocessor.defineMacro(string(targetPreprocId) + "=1");
+    for (list<string>::const_iterator it = defines.begin(); it != defines.end(); ++it)
+        preprocessor.defineMacro(*it);
+}
+
+
+// Creates the TranslationUnit of the calling thread, which receives the options
+// that apply to the compilation of a C file. See TranslationUnitDestroyer.
+//
+void
+Parameters::createTranslationUnit() const
+{
+    TranslationUnit::createInstance(targetPlatform,
+                                    callToUndefinedFunctionAllowed,
+                                    warnSignCompare,
+                                    warnPassingConstForFuncPtr,
+                                    isConstIncorrectWarningEnabled,
+                                    isBinaryOpGivingByteWarningEnabled,
+                                    isLocalVariableHidingAnotherWarningEnabled,
+                                    relocatabilitySupported);
+    TranslationUnit &tu = TranslationUnit::instance();
+    tu.setFunctionStackSpace(uint16_t(functionStackSpace));
+    tu.setExecutionProfile(executionCounts, blockExecutionCounts);
+    if (forceJumpMode)
+        tu.forceSwitchJumpMode(forcedJumpMode);
+}
+
+
+// Writes a precompiled header for the given header file, which can then
+// be passed to --include-pch when compiling with the same -D and -I options
+// and for the same target platform.
+//
+// Returns EXIT_SUCCESS or EXIT_FAILURE.
+//
+int
+Parameters::precompileHeader(const string &headerFilename,
+                             const string &pchFilename,
+                             const char *targetPreprocId)
+{
+    if (verbose)
+        cout << "Precompiling: " << headerFilename << " into " << pchFilename << endl;
+
+    createTranslationUnit();  // counts the errors reported by the Preprocessor
+    TranslationUnitDestroyer tud(true);
+
+    Preprocessor preprocessor(includeDirList, preprocessorFileCache);
+    defineMacros(preprocessor, targetPreprocId);
+    if (!preprocessor.writePrecompiledHeader(headerFilename, pchFilename))
+        return EXIT_FAILURE;  // errors already reported
+    return EXIT_SUCCESS;
+}
+
+
 // Generates the assembly file and invokes the assembler on that file.
 //
 // Returns EXIT_SUCCESS or EXIT_FAILURE.
@@ -1015,48 +1272,71 @@ Parameters::compileCFile(const string &inputFilename,
         cout << "Preprocessing: " << inputFilename << endl;
     }
 
-    // Call the C preprocessor on the source file and prepare to read its output:
+    createTranslationUnit();
+    TranslationUnitDestroyer tud(true);  // destroy TU at end of this function
+    TranslationUnit &tu = TranslationUnit::instance();
+    tu.setModuleName(moduleName);
+
+    // Preprocess the source file and prepare the lexer to read the result:
     //
-    stringstream cppCommand;
-    cppCommand << "cpp -xc++ -U__cplusplus";  // -xc++ makes sure cpp accepts C++-style comments
-    for (list<string>::const_iterator it = includeDirList.begin(); it != includeDirList.end(); ++it)
-        cppCommand << " -I'" << *it << "'";
-    cppCommand << " -D_CMOC_VERSION_=" << getVersionInteger();
-    cppCommand << " -D" << targetPreprocId << "=1";
-    cppCommand << " -U__GNUC__ -nostdinc -undef";
+    string preprocessedText;  // output of the built-in preprocessor
+    FILE *preprocFile = NULL;  // read by the lexer
+    if (externalPreprocessorUsed)
+    {
+        stringstream cppCommand;
+        cppCommand << "cpp -xc++ -U__cplusplus";  // -xc++ makes sure cpp accepts C++-style comments
+        for (list<string>::const_iterator it = includeDirList.begin(); it != includeDirList.end(); ++it)
+            cppCommand << " -I'" << *it << "'";
+        cppCommand << " -D_CMOC_VERSION_=" << getVersionInteger();
+        cppCommand << " -D" << targetPreprocId << "=1";
+        cppCommand << " -U__GNUC__ -nostdinc -undef";
 
-    for (list<string>::const_iterator it = defines.begin(); it != defines.end(); ++it)
-        cppCommand << " -D'" << *it << "'";
+        for (list<string>::const_iterator it = defines.begin(); it != defines.end(); ++it)
+            cppCommand << " -D'" << *it << "'";
 
-    cppCommand << " " << inputFilename;  // must be last argument, for portability
+        cppCommand << " " << inputFilename;  // must be last argument, for portability
 
-    if (verbose)
-        cout << "Preprocessor command: " << cppCommand.str() << endl;
+        if (verbose)
+            cout << "Preprocessor command: " << cppCommand.str() << endl;
 
-    yyin = popen(cppCommand.str().c_str(), "r");
-    if (yyin == NULL)
+        preprocFile = popen(cppCommand.str().c_str(), "r");
+        if (preprocFile == NULL)
+        {
+            int e = errno;
+            cout << PACKAGE << fatalErrorPrefix << "could not start C preprocessor (through pipe):"
+                                                << " " << strerror(e) << endl;
+            return EXIT_FAILURE;
+        }
+    }
+    else
     {
-        int e = errno;
-        cout << PACKAGE << fatalErrorPrefix << "could not start C preprocessor (through pipe):"
-                                            << " " << strerror(e) << endl;
-        return EXIT_FAILURE;
+        Preprocessor preprocessor(includeDirList, preprocessorFileCache);
+        defineMacros(preprocessor, targetPreprocId);
+        if (!precompiledHeaderFilename.empty() && !preprocessor.loadPrecompiledHeader(precompiledHeaderFilename))
+            return EXIT_FAILURE;  // errors already reported
+
+        if (!preprocessor.preprocessFile(inputFilename, preprocessedText))
+            return EXIT_FAILURE;  // errors already reported
+
+        preprocFile = openTextAsFile(preprocessedText);
+        if (preprocFile == NULL)
+        {
+            int e = errno;
+            cout << PACKAGE << fatalErrorPrefix << "could not read preprocessor output:"
+                                                << " " << strerror(e) << endl;
+            return EXIT_FAILURE;
+        }
     }
 
-    PipeCloser preprocFileCloser(yyin);
+    PipeCloser preprocFileCloser(externalPreprocessorUsed ? preprocFile : NULL);
+    FileCloser preprocTextCloser(externalPreprocessorUsed ? NULL : preprocFile);
 
 
     if (preprocOnly || params.generatePrerequisitesFileOnly)
     {
-        TranslationUnit::createInstance(targetPlatform,
-                                        callToUndefinedFunctionAllowed,
-                                        warnSignCompare,
-                                        warnPassingConstForFuncPtr,
-                                        isConstIncorrectWarningEnabled,
-                                        isBinaryOpGivingByteWarningEnabled,
-                                        isLocalVariableHidingAnotherWarningEnabled,
-                                        relocatabilitySupported);
         char buffer[8192];
-        while (fgets(buffer, sizeof(buffer), yyin) != NULL)  // while a line can be read
+        string currentSourceFilename = inputFilename;
+        while (fgets(buffer, sizeof(buffer), preprocFile) != NULL)  // while a line can be read
         {
             if (preprocOnly)
             {
@@ -1067,44 +1347,42 @@ Parameters::compileCFile(const string &inputFilename,
                     cout << PACKAGE << fatalErrorPrefix
                          << "failed to copy C preprocessor output to standard output:"
                          << " " << strerror(e) << endl;
-                    TranslationUnit::destroyInstance();
                     return EXIT_FAILURE;
                 }
             }
-            else  // extract an #included file path, if applicable:
+            else  // extract an #included file path or a #pragma embed file path, if applicable:
             {
                 string filename;
                 if (parseIncludeMarker(buffer, filename))
-                    TranslationUnit::instance().addPrerequisiteFilename(filename.c_str());
+                {
+                    tu.addPrerequisiteFilename(filename.c_str());
+                    currentSourceFilename = filename;
+                }
+                else if (parseEmbedPragma(buffer, filename))
+                    tu.addPrerequisiteFilename(
+                            Pragma::getEmbeddedFilePath(filename, currentSourceFilename).c_str());
             }
         }
         if (preprocOnly)
-        {
-            TranslationUnit::destroyInstance();
             return EXIT_SUCCESS;
-        }
     }
 
 
-    TranslationUnitDestroyer tud(true);  // destroy TU at end of this function
-
-
-    if (numErrors == 0 && !params.generatePrerequisitesFileOnly)
+    if (tu.getNumErrors() == 0 && !params.generatePrerequisitesFileOnly)
     {
-        TranslationUnit::createInstance(targetPlatform,
-                                            callToUndefinedFunctionAllowed,
-                                            warnSignCompare,
-                                            warnPassingConstForFuncPtr,
-                                            isConstIncorrectWarningEnabled,
-                                            isBinaryOpGivingByteWarningEnabled,
-                                            isLocalVariableHidingAnotherWarningEnabled,
-                                            relocatabilitySupported);
-        TranslationUnit &tu = TranslationUnit::instance();
-
         if (verbose)
             cout << "Compiling..." << endl;
-        assert(yyin != NULL);
-        yyparse();  // invoke parser.yy
+        assert(preprocFile != NULL);
+        yyscan_t scanner;
+        if (yylex_init_extra(&tu, &scanner) != 0)
+        {
+            int e = errno;
+            cout << PACKAGE << fatalErrorPrefix << "could not create lexer: " << strerror(e) << endl;
+            return EXIT_FAILURE;
+        }
+        yyset_in(preprocFile, scanner);
+        yyparse(scanner);  // invoke parser.yy
+        yylex_destroy(scanner);
 
 
         uint16_t pragmaStackSpace = 0;
@@ -1153,7 +1431,7 @@ Parameters::compileCFile(const string &inputFilename,
             return EXIT_FAILURE;
         }
 
-        if (numErrors == 0)
+        if (tu.getNumErrors() == 0)
         {
             tu.checkSemantics();  // this is when Scope objects get created in FunctionDefs
 
@@ -1171,27 +1449,33 @@ Parameters::compileCFile(const string &inputFilename,
 
         ASMText asmText;
 
-        if (numErrors == 0)
+        if (tu.getNumErrors() == 0)
         {
             tu.emitAssembler(asmText, params.dataAddress, params.stackSpace, assumeTrack34);
 
+            if (params.nullPointerCheckingEnabled)
+                asmText.removeRedundantNullPointerChecks();
             if (optimizationLevel > 0)
                 asmText.peepholeOptimize(optimizationLevel == 2);
             if (wholeFunctionOptimization)
                 asmText.optimizeWholeFunctions();
+            // The report must not count the margins that hoistStackOverflowChecks()
+            // makes some checks subtract from S, since no data is stored there.
+            ASMText::StackReport stackReport;
+            if (params.stackReportEnabled)
+                asmText.computeStackReport(stackReport);
+            if (params.stackOverflowCheckingEnabled)
+                asmText.hoistStackOverflowChecks();
+            if (params.stackReportEnabled)
+                tu.writeStackReport(cout, inputFilename, stackReport);
+            if (params.cycleReportEnabled)
+                asmText.writeCycleReport(cout, inputFilename);
         }
 
 
-        /*  Now that yyparse() and emitAssembler() have been called, free the memory,
-            to keep valgrind from reporting a leak.
-        */
-        extern string sourceFilename;
-        sourceFilename.clear();
-
-
         /*  Create an asm file that will receive the assembly language code:
         */
-        if (numErrors == 0)
+        if (tu.getNumErrors() == 0)
         {
             if (verbose)
             {
@@ -1220,13 +1504,13 @@ Parameters::compileCFile(const string &inputFilename,
         }
 
         if (verbose)
-            cout << numErrors << " error(s)"
-                    << ", " << numWarnings << " warning(s)." << endl;
+            cout << tu.getNumErrors() << " error(s)"
+                    << ", " << tu.getNumWarnings() << " warning(s)." << endl;
 
-        if (numErrors > 0)
+        if (tu.getNumErrors() > 0)
             return EXIT_FAILURE;
 
-        if (numWarnings > 0 && treatWarningsAsErrors)
+        if (tu.getNumWarnings() > 0 && treatWarningsAsErrors)
             return EXIT_FAILURE;
     }
 
@@ -1235,7 +1519,7 @@ Parameters::compileCFile(const string &inputFilename,
         string dependenciesFilename = replaceExtension(compilationOutputFilename, ".d");
         ofstream dependenciesFile(dependenciesFilename.c_str(), ios::out);
         if (dependenciesFile.good())
-            TranslationUnit::instance().writePrerequisites(dependenciesFile, dependenciesFilename, compilationOutputFilename, params.pkgdatadir);
+            tu.writePrerequisites(dependenciesFile, dependenciesFilename, compilationOutputFilename, params.pkgdatadir);
         else
         {
             int e = errno;
@@ -1258,6 +1542,157 @@ Parameters::compileCFile(const string &inputFilename,
 }
 
 
+// C file whose compilation is deferred to compileCFiles() (see -j).
+//
+struct CFileCompilation
+{
+    string inputFilename;
+    string moduleName;
+    string asmFilename;
+    string outputFilename;
+    FILE *outputFile;  // receives the output of the worker process; null until started
+    pid_t pid;
+    bool finished;
+    int exitStatus;  // valid once finished
+
+    CFileCompilation(const string &_inputFilename, const string &_moduleName,
+                     const string &_asmFilename, const string &_outputFilename)
+    :   inputFilename(_inputFilename), moduleName(_moduleName),
+        asmFilename(_asmFilename), outputFilename(_outputFilename),
+        outputFile(NULL), pid(0), finished(false), exitStatus(EXIT_SUCCESS) {}
+};
+
+
+// Copies the contents of 'file' to standard output and closes 'file'.
+//
+static void
+copyToStandardOutput(FILE *file)
+{
+    char buffer[8192];
+    size_t n;
+    rewind(file);
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        cout.write(buffer, n);
+    cout << flush;
+    fclose(file);
+}
+
+
+// Compiles the given C files, running as many as params.numJobs worker
+// processes at a time. The output of a worker, e.g., its diagnostics, is
+// kept in a temporary file, and copied to standard output once the files
+// that precede it have been copied. The output is thus the same as when
+// the files are compiled one after the other: it stops with the output
+// of the first file that fails to compile.
+// No file is started after a compilation has failed.
+//
+// Returns EXIT_SUCCESS or the status of the first failed compilation
+// in the order of 'compilations'.
+//
+static int
+compileCFiles(vector<CFileCompilation> &compilations,
+              const char *targetPlatformName,
+              const char *targetPreprocId)
+{
+#if defined(__MINGW32__)
+    // No fork(): compile the files one after the other.
+    for (vector<CFileCompilation>::const_iterator it = compilations.begin(); it != compilations.end(); ++it)
+    {
+        int s = params.compileCFile(it->inputFilename, it->moduleName, it->asmFilename, it->outputFilename,
+                                    targetPlatformName, targetPreprocId);
+        if (s != EXIT_SUCCESS)
+            return s;
+    }
+    return EXIT_SUCCESS;
+#else
+    int status = EXIT_SUCCESS;  // status of the last compilation whose output was copied
+    int startStatus = EXIT_SUCCESS;  // EXIT_FAILURE if a worker could not be started
+    bool failed = false;  // true once a compilation has failed, in any order
+    size_t numStarted = 0, numRunning = 0, numCopied = 0;
+
+    for (;;)
+    {
+        while (!failed && startStatus == EXIT_SUCCESS && numStarted < compilations.size() && numRunning < params.numJobs)
+        {
+            CFileCompilation &c = compilations[numStarted];
+            c.outputFile = tmpfile();
+            if (c.outputFile == NULL)
+            {
+                int e = errno;
+                cout << PACKAGE << fatalErrorPrefix << "could not create temporary file: " << strerror(e) << endl;
+                startStatus = EXIT_FAILURE;
+                break;
+            }
+
+            cout << flush;
+            fflush(stdout);  // the worker must not write what has already been written
+            c.pid = fork();
+            if (c.pid == -1)
+            {
+                int e = errno;
+                cout << PACKAGE << fatalErrorPrefix << "could not start worker process: " << strerror(e) << endl;
+                fclose(c.outputFile);
+                c.outputFile = NULL;
+                startStatus = EXIT_FAILURE;
+                break;
+            }
+            if (c.pid == 0)  // in the worker:
+            {
+                dup2(fileno(c.outputFile), STDOUT_FILENO);  // also applies to the assembler
+                dup2(fileno(c.outputFile), STDERR_FILENO);
+                int s = params.compileCFile(c.inputFilename, c.moduleName, c.asmFilename, c.outputFilename,
+                                            targetPlatformName, targetPreprocId);
+                cout << flush;
+                fflush(stdout);
+                _exit(s);
+            }
+            ++numStarted;
+            ++numRunning;
+        }
+
+        if (numRunning == 0)
+            break;
+
+        int waitStatus = 0;
+        pid_t pid = waitpid(-1, &waitStatus, 0);
+        if (pid == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            int e = errno;
+            cout << PACKAGE << fatalErrorPrefix << "could not wait for worker process: " << strerror(e) << endl;
+            return EXIT_FAILURE;
+        }
+        for (size_t i = numCopied; i < numStarted; ++i)
+        {
+            CFileCompilation &c = compilations[i];
+            if (c.pid != pid || c.finished)
+                continue;
+            c.finished = true;
+            --numRunning;
+            c.exitStatus = (WIFEXITED(waitStatus) ? WEXITSTATUS(waitStatus) : EXIT_FAILURE);
+            if (c.exitStatus != EXIT_SUCCESS)
+                failed = true;
+            break;
+        }
+
+        // The output of a file that follows a failed one is not copied,
+        // because that file would not have been compiled without -j.
+        //
+        for ( ; status == EXIT_SUCCESS && numCopied < numStarted && compilations[numCopied].finished; ++numCopied)
+        {
+            copyToStandardOutput(compilations[numCopied].outputFile);
+            status = compilations[numCopied].exitStatus;
+        }
+    }
+
+    for ( ; numCopied < numStarted; ++numCopied)  // files after a failed one, or if the wait loop was left early
+        fclose(compilations[numCopied].outputFile);
+    return (status != EXIT_SUCCESS ? status : startStatus);
+#endif
+}
+
+
 static int
 declareInvalidOption(const string &opt)
 {
@@ -1456,6 +1891,26 @@ interpretCommandLineOptions(int argc, char *argv[], int &argi)
 
             continue;
         }
+        if (curopt == "--external-cpp")
+        {
+            params.externalPreprocessorUsed = true;
+            continue;
+        }
+        if (curopt == "--pch")
+        {
+            params.precompiledHeadersGenerated = true;
+            continue;
+        }
+        if (startsWith(curopt, "--include-pch="))
+        {
+            params.precompiledHeaderFilename = string(curopt, 14);
+            if (params.precompiledHeaderFilename.empty())
+            {
+                cout << PACKAGE << ": Option --include-pch= not followed by filename.\n";
+                return 1;
+            }
+            continue;
+        }
         if (strncmp(curopt.c_str(), "-D", 2) == 0)
         {
             string arg(curopt, 2, string::npos);
@@ -1474,6 +1929,21 @@ interpretCommandLineOptions(int argc, char *argv[], int &argi)
 
             continue;
         }
+        if (startsWith(curopt, "-j"))
+        {
+            string arg(curopt, 2, string::npos);
+            if (arg.empty() && argi + 1 < argc)  // if argument follows -j:
+                arg = argv[++argi];
+            char *endptr = NULL;
+            unsigned long n = strtoul(arg.c_str(), &endptr, 10);
+            if (arg.empty() || *endptr != '\0' || n == 0)
+            {
+                cout << PACKAGE << ": Option -j not followed by a positive number of jobs.\n";
+                return 1;
+            }
+            params.numJobs = size_t(n);
+            continue;
+        }
         if (curopt == "-nostdinc")
         {
             params.searchDefaultIncludeDirs = false;
@@ -1522,6 +1992,16 @@ interpretCommandLineOptions(int argc, char *argv[], int &argi)
             params.stackOverflowCheckingEnabled = true;
             continue;
         }
+        if (curopt == "--stack-report")
+        {
+            params.stackReportEnabled = true;
+            continue;
+        }
+        if (curopt == "--cycle-report")
+        {
+            params.cycleReportEnabled = true;
+            continue;
+        }
         if (strncmp(curopt.c_str(), "--stack-space=", 14) == 0)
         {
             string arg(curopt, 14, string::npos);
@@ -1596,6 +2076,14 @@ interpretCommandLineOptions(int argc, char *argv[], int &argi)
             params.optimizationLevel = 0;
             continue;
         }
+        if (startsWith(curopt, "--profile-use="))
+        {
+            params.executionCounts.clear();
+            params.blockExecutionCounts.clear();
+            if (loadExecutionProfile(string(curopt, 14), params.executionCounts, params.blockExecutionCounts) != EXIT_SUCCESS)
+                return 1;
+            continue;
+        }
         if (curopt == "--wfo")
         {
             params.wholeFunctionOptimization = true;
@@ -1718,6 +2206,16 @@ main(int argc, char *argv[])
     if (params.genAsmOnly)
         params.compileOnly = true;
 
+    if (params.precompiledHeadersGenerated)
+        params.compileOnly = true;
+
+    if (params.externalPreprocessorUsed
+        && (params.precompiledHeadersGenerated || !params.precompiledHeaderFilename.empty()))
+    {
+        cout << PACKAGE << ": --pch and --include-pch are not permitted with --external-cpp\n";
+        return EXIT_FAILURE;
+    }
+
 
     // Forbid --org and --data when targetting some platforms.
     if ((params.targetPlatform == OS9 || params.targetPlatform == VECTREX)
@@ -1769,9 +2267,6 @@ main(int argc, char *argv[])
         }
     }
 
-    if (params.forceJumpMode)
-        SwitchStmt::forceJumpMode(params.forcedJumpMode);
-
     {
         uint16_t fss = 0;  // by default, no stack checking upon function entry
         if (params.functionStackSpace != uint32_t(-1))  // if specified by --function-space
@@ -1785,10 +2280,11 @@ main(int argc, char *argv[])
         }
         else if (params.targetPlatform == OS9)
             fss = 64;
-        FunctionDef::setFunctionStackSpace(fss);
+        params.functionStackSpace = fss;
     }
 
     vector<string> objectFilenames, libraryFilenames, intermediateCompilationFiles, intermediateObjectFiles;
+    vector<CFileCompilation> deferredCompilations;  // with -j
     string programName;
     string asmFilename;
 
@@ -1870,6 +2366,21 @@ main(int argc, char *argv[])
         }
 
 
+        // An assembly file or a header to precompile waits for the C files
+        // deferred before it (see -j), so that the files are processed and their
+        // messages displayed in the order of the command line, and so that
+        // nothing is processed after a C file that fails to compile.
+        //
+        if (!deferredCompilations.empty()
+                && (extension == ".s" || extension == ".asm" || (extension == ".h" && params.precompiledHeadersGenerated)))
+        {
+            status = compileCFiles(deferredCompilations, targetPlatformName, targetPreprocId);
+            deferredCompilations.clear();
+            if (status != EXIT_SUCCESS)
+                break;
+        }
+
+
         // Process the input filename depending on its extension.
         // C files are compiled.
         // Object files are passed to the linker.
@@ -1878,7 +2389,14 @@ main(int argc, char *argv[])
         {
             asmFilename = useIntDir(moduleName + ".s");
 
-            int s = params.compileCFile(inputFilename,
+            int s = EXIT_SUCCESS;
+            if (params.numJobs > 1)
+                deferredCompilations.push_back(CFileCompilation(inputFilename,
+                                                                moduleName,
+                                                                asmFilename,
+                                                                compilationOutputFilename));
+            else
+                s = params.compileCFile(inputFilename,
                                         moduleName,
                                         asmFilename,
                                         compilationOutputFilename,
@@ -1916,6 +2434,16 @@ main(int argc, char *argv[])
             if (!params.compileOnly)
                 intermediateObjectFiles.push_back(compilationOutputFilename);
         }
+        else if (extension == ".h" && params.precompiledHeadersGenerated)
+        {
+            string pchFilename = (params.outputFilename.empty() ? inputFilename + ".pch" : params.outputFilename);
+            int s = params.precompileHeader(inputFilename, pchFilename, targetPreprocId);
+            if (s != EXIT_SUCCESS)
+            {
+                status = s;
+                break;
+            }
+        }
         else if (extension == ".o")
         {
             string objFilename = inputFilename;
@@ -1962,6 +2490,9 @@ main(int argc, char *argv[])
 
     }   // while
 
+    if (status == EXIT_SUCCESS && !deferredCompilations.empty())
+        status = compileCFiles(deferredCompilations, targetPlatformName, targetPreprocId);
+
     removeIntermediateCompilationFiles(intermediateCompilationFiles);
 
     if (status != EXIT_SUCCESS)
@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,17 +45,17 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.4"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -61,8 +66,8 @@
 
 
 
-/* Copy the first part of user declarations.  */
-#line 1 "parser.yy" /* yacc.c:339  */
+/* First part of user prologue.  */
+#line 1 "parser.yy"
 
 /*  $Id: parser.yy,v 1.83 2020/02/10 01:58:22 sarrazip Exp $
 
@@ -87,6 +92,7 @@
 #include "WordConstantExpr.h"
 #include "RealConstantExpr.h"
 #include "DWordConstantExpr.h"
+#include "PackedInitializer.h"
 #include "IdentifierExpr.h"
 #include "VariableExpr.h"
 #include "FunctionCallExpr.h"
@@ -119,273 +125,357 @@
 
 using namespace std;
 
-int yyparse(void);
-int yylex(void);
-void yyerror(const char *msg);
-extern char *yytext;
-
-extern string sourceFilename;  // defined in lexer.ll
-extern int lineno;  // defined in lexer.ll
-int numErrors = 0;  // error counter for yyerror()
-int numWarnings = 0;
-static bool doubleTypeWarningIssued = false;
-
 void _PARSERTRACE(int parserLineNo, const char *fmt, ...);
 #define PARSERTRACE(...) _PARSERTRACE(__LINE__, __VA_ARGS__)
 
+// Creates a BinaryOpExpr, unless the operation can be done at compile time
+// (see BinaryOpExpr::foldLongOrRealConstants()), in which case the operands
+// are destroyed and the resulting constant is returned.
+//
+static Tree *
+newBinaryOpExpr(BinaryOpExpr::Op op, Tree *left, Tree *right)
+{
+    if (Tree *folded = BinaryOpExpr::foldLongOrRealConstants(op, left, right))
+    {
+        delete left;
+        delete right;
+        return folded;
+    }
+    return new BinaryOpExpr(op, left, right);
+}
+
+
+// Like newBinaryOpExpr(), but for a cast.
+//
+static Tree *
+newCastExpr(const TypeDesc *td, Tree *subExpr)
+{
+    if (Tree *folded = CastExpr::foldLongOrRealConstant(td, subExpr))
+    {
+        delete subExpr;
+        return folded;
+    }
+    return new CastExpr(td, subExpr);
+}
+
+
+// Creates a Declarator at the current source position.
+//
+static Declarator *
+newDeclarator(const string &id)
+{
+    const TranslationUnit &tu = TranslationUnit::instance();
+    return new Declarator(id, tu.getCurrentSourceFilename(), tu.getCurrentLineNo());
+}
+
 
-#line 138 "parser.cc" /* yacc.c:339  */
+#line 173 "parser.cc"
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "y.tab.h".  */
-#ifndef YY_YY_Y_TAB_H_INCLUDED
-# define YY_YY_Y_TAB_H_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    ID = 258,
-    STRLIT = 259,
-    PRAGMA = 260,
-    CHARLIT = 261,
-    REAL = 262,
-    TYPE_NAME = 263,
-    INT = 264,
-    CHAR = 265,
-    SHORT = 266,
-    LONG = 267,
-    FLOAT = 268,
-    DOUBLE = 269,
-    SIGNED = 270,
-    UNSIGNED = 271,
-    VOID = 272,
-    PLUS_PLUS = 273,
-    MINUS_MINUS = 274,
-    IF = 275,
-    ELSE = 276,
-    WHILE = 277,
-    DO = 278,
-    FOR = 279,
-    EQUALS_EQUALS = 280,
-    BANG_EQUALS = 281,
-    LOWER_EQUALS = 282,
-    GREATER_EQUALS = 283,
-    AMP_AMP = 284,
-    PIPE_PIPE = 285,
-    LT_LT = 286,
-    GT_GT = 287,
-    BREAK = 288,
-    CONTINUE = 289,
-    RETURN = 290,
-    ASM = 291,
-    NORTS = 292,
-    VERBATIM_ASM = 293,
-    STRUCT = 294,
-    UNION = 295,
-    THIS = 296,
-    PLUS_EQUALS = 297,
-    MINUS_EQUALS = 298,
-    ASTERISK_EQUALS = 299,
-    SLASH_EQUALS = 300,
-    PERCENT_EQUALS = 301,
-    LT_LT_EQUALS = 302,
-    GT_GT_EQUALS = 303,
-    CARET_EQUALS = 304,
-    AMP_EQUALS = 305,
-    PIPE_EQUALS = 306,
-    RIGHT_ARROW = 307,
-    INTERRUPT = 308,
-    SIZEOF = 309,
-    ELLIPSIS = 310,
-    TYPEDEF = 311,
-    ENUM = 312,
-    SWITCH = 313,
-    CASE = 314,
-    DEFAULT = 315,
-    REGISTER = 316,
-    GOTO = 317,
-    EXTERN = 318,
-    STATIC = 319,
-    CONST = 320,
-    VOLATILE = 321,
-    AUTO = 322,
-    FUNC_RECEIVES_FIRST_PARAM_IN_REG = 323
-  };
-#endif
-/* Tokens.  */
-#define ID 258
-#define STRLIT 259
-#define PRAGMA 260
-#define CHARLIT 261
-#define REAL 262
-#define TYPE_NAME 263
-#define INT 264
-#define CHAR 265
-#define SHORT 266
-#define LONG 267
-#define FLOAT 268
-#define DOUBLE 269
-#define SIGNED 270
-#define UNSIGNED 271
-#define VOID 272
-#define PLUS_PLUS 273
-#define MINUS_MINUS 274
-#define IF 275
-#define ELSE 276
-#define WHILE 277
-#define DO 278
-#define FOR 279
-#define EQUALS_EQUALS 280
-#define BANG_EQUALS 281
-#define LOWER_EQUALS 282
-#define GREATER_EQUALS 283
-#define AMP_AMP 284
-#define PIPE_PIPE 285
-#define LT_LT 286
-#define GT_GT 287
-#define BREAK 288
-#define CONTINUE 289
-#define RETURN 290
-#define ASM 291
-#define NORTS 292
-#define VERBATIM_ASM 293
-#define STRUCT 294
-#define UNION 295
-#define THIS 296
-#define PLUS_EQUALS 297
-#define MINUS_EQUALS 298
-#define ASTERISK_EQUALS 299
-#define SLASH_EQUALS 300
-#define PERCENT_EQUALS 301
-#define LT_LT_EQUALS 302
-#define GT_GT_EQUALS 303
-#define CARET_EQUALS 304
-#define AMP_EQUALS 305
-#define PIPE_EQUALS 306
-#define RIGHT_ARROW 307
-#define INTERRUPT 308
-#define SIZEOF 309
-#define ELLIPSIS 310
-#define TYPEDEF 311
-#define ENUM 312
-#define SWITCH 313
-#define CASE 314
-#define DEFAULT 315
-#define REGISTER 316
-#define GOTO 317
-#define EXTERN 318
-#define STATIC 319
-#define CONST 320
-#define VOLATILE 321
-#define AUTO 322
-#define FUNC_RECEIVES_FIRST_PARAM_IN_REG 323
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
-union YYSTYPE
+#include "parser.hh"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-#line 75 "parser.yy" /* yacc.c:355  */
-
-    char *str;
-    signed char character;
-    double real;
-    int integer;
-    BasicType basicType;
-    const TypeDesc *typeDesc;
-    TypeSpecifier *typeSpecifier;
-    DeclarationSpecifierList *declarationSpecifierList;
-    Tree *tree;
-    CompoundStmt *compoundStmt;
-    TreeSequence *treeSequence;
-    FormalParamList *formalParamList;
-    FormalParameter *formalParameter;
-    DeclarationSequence *declarationSequence;
-    Declarator *declarator;
-    std::vector<Declarator *> *declaratorVector;
-    BinaryOpExpr::Op binop;
-    UnaryOpExpr::Op unop;
-    Scope *scope;
-    FunctionDef *functionDef;
-    std::vector<std::string> *strList;
-    ClassDef *classDef;
-    ClassDef::ClassMember *classMember;
-    FilenameAndLineNo *filenameAndLineNo;
-    std::vector<ClassDef::ClassMember *> *classMemberList;
-    Enumerator *enumerator;
-    std::vector<Enumerator *> *enumeratorList;
-    TypeQualifierBitFieldVector *typeQualifierBitFieldVector;
-
-#line 345 "parser.cc" /* yacc.c:355  */
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_ID = 3,                         /* ID  */
+  YYSYMBOL_STRLIT = 4,                     /* STRLIT  */
+  YYSYMBOL_PRAGMA = 5,                     /* PRAGMA  */
+  YYSYMBOL_CHARLIT = 6,                    /* CHARLIT  */
+  YYSYMBOL_REAL = 7,                       /* REAL  */
+  YYSYMBOL_TYPE_NAME = 8,                  /* TYPE_NAME  */
+  YYSYMBOL_INT = 9,                        /* INT  */
+  YYSYMBOL_CHAR = 10,                      /* CHAR  */
+  YYSYMBOL_SHORT = 11,                     /* SHORT  */
+  YYSYMBOL_LONG = 12,                      /* LONG  */
+  YYSYMBOL_FLOAT = 13,                     /* FLOAT  */
+  YYSYMBOL_DOUBLE = 14,                    /* DOUBLE  */
+  YYSYMBOL_SIGNED = 15,                    /* SIGNED  */
+  YYSYMBOL_UNSIGNED = 16,                  /* UNSIGNED  */
+  YYSYMBOL_VOID = 17,                      /* VOID  */
+  YYSYMBOL_PLUS_PLUS = 18,                 /* PLUS_PLUS  */
+  YYSYMBOL_MINUS_MINUS = 19,               /* MINUS_MINUS  */
+  YYSYMBOL_IF = 20,                        /* IF  */
+  YYSYMBOL_ELSE = 21,                      /* ELSE  */
+  YYSYMBOL_WHILE = 22,                     /* WHILE  */
+  YYSYMBOL_DO = 23,                        /* DO  */
+  YYSYMBOL_FOR = 24,                       /* FOR  */
+  YYSYMBOL_EQUALS_EQUALS = 25,             /* EQUALS_EQUALS  */
+  YYSYMBOL_BANG_EQUALS = 26,               /* BANG_EQUALS  */
+  YYSYMBOL_LOWER_EQUALS = 27,              /* LOWER_EQUALS  */
+  YYSYMBOL_GREATER_EQUALS = 28,            /* GREATER_EQUALS  */
+  YYSYMBOL_AMP_AMP = 29,                   /* AMP_AMP  */
+  YYSYMBOL_PIPE_PIPE = 30,                 /* PIPE_PIPE  */
+  YYSYMBOL_LT_LT = 31,                     /* LT_LT  */
+  YYSYMBOL_GT_GT = 32,                     /* GT_GT  */
+  YYSYMBOL_BREAK = 33,                     /* BREAK  */
+  YYSYMBOL_CONTINUE = 34,                  /* CONTINUE  */
+  YYSYMBOL_RETURN = 35,                    /* RETURN  */
+  YYSYMBOL_ASM = 36,                       /* ASM  */
+  YYSYMBOL_NORTS = 37,                     /* NORTS  */
+  YYSYMBOL_VERBATIM_ASM = 38,              /* VERBATIM_ASM  */
+  YYSYMBOL_STRUCT = 39,                    /* STRUCT  */
+  YYSYMBOL_UNION = 40,                     /* UNION  */
+  YYSYMBOL_THIS = 41,                      /* THIS  */
+  YYSYMBOL_PLUS_EQUALS = 42,               /* PLUS_EQUALS  */
+  YYSYMBOL_MINUS_EQUALS = 43,              /* MINUS_EQUALS  */
+  YYSYMBOL_ASTERISK_EQUALS = 44,           /* ASTERISK_EQUALS  */
+  YYSYMBOL_SLASH_EQUALS = 45,              /* SLASH_EQUALS  */
+  YYSYMBOL_PERCENT_EQUALS = 46,            /* PERCENT_EQUALS  */
+  YYSYMBOL_LT_LT_EQUALS = 47,              /* LT_LT_EQUALS  */
+  YYSYMBOL_GT_GT_EQUALS = 48,              /* GT_GT_EQUALS  */
+  YYSYMBOL_CARET_EQUALS = 49,              /* CARET_EQUALS  */
+  YYSYMBOL_AMP_EQUALS = 50,                /* AMP_EQUALS  */
+  YYSYMBOL_PIPE_EQUALS = 51,               /* PIPE_EQUALS  */
+  YYSYMBOL_RIGHT_ARROW = 52,               /* RIGHT_ARROW  */
+  YYSYMBOL_INTERRUPT = 53,                 /* INTERRUPT  */
+  YYSYMBOL_SIZEOF = 54,                    /* SIZEOF  */
+  YYSYMBOL_ELLIPSIS = 55,                  /* ELLIPSIS  */
+  YYSYMBOL_TYPEDEF = 56,                   /* TYPEDEF  */
+  YYSYMBOL_ENUM = 57,                      /* ENUM  */
+  YYSYMBOL_SWITCH = 58,                    /* SWITCH  */
+  YYSYMBOL_CASE = 59,                      /* CASE  */
+  YYSYMBOL_DEFAULT = 60,                   /* DEFAULT  */
+  YYSYMBOL_REGISTER = 61,                  /* REGISTER  */
+  YYSYMBOL_GOTO = 62,                      /* GOTO  */
+  YYSYMBOL_EXTERN = 63,                    /* EXTERN  */
+  YYSYMBOL_STATIC = 64,                    /* STATIC  */
+  YYSYMBOL_CONST = 65,                     /* CONST  */
+  YYSYMBOL_VOLATILE = 66,                  /* VOLATILE  */
+  YYSYMBOL_AUTO = 67,                      /* AUTO  */
+  YYSYMBOL_FUNC_RECEIVES_FIRST_PARAM_IN_REG = 68, /* FUNC_RECEIVES_FIRST_PARAM_IN_REG  */
+  YYSYMBOL_69_ = 69,                       /* ';'  */
+  YYSYMBOL_70_ = 70,                       /* ','  */
+  YYSYMBOL_71_ = 71,                       /* '('  */
+  YYSYMBOL_72_ = 72,                       /* '*'  */
+  YYSYMBOL_73_ = 73,                       /* ')'  */
+  YYSYMBOL_74_ = 74,                       /* '{'  */
+  YYSYMBOL_75_ = 75,                       /* '}'  */
+  YYSYMBOL_76_ = 76,                       /* '='  */
+  YYSYMBOL_77_ = 77,                       /* '['  */
+  YYSYMBOL_78_ = 78,                       /* ']'  */
+  YYSYMBOL_79_ = 79,                       /* ':'  */
+  YYSYMBOL_80_ = 80,                       /* '?'  */
+  YYSYMBOL_81_ = 81,                       /* '|'  */
+  YYSYMBOL_82_ = 82,                       /* '^'  */
+  YYSYMBOL_83_ = 83,                       /* '&'  */
+  YYSYMBOL_84_ = 84,                       /* '<'  */
+  YYSYMBOL_85_ = 85,                       /* '>'  */
+  YYSYMBOL_86_ = 86,                       /* '+'  */
+  YYSYMBOL_87_ = 87,                       /* '-'  */
+  YYSYMBOL_88_ = 88,                       /* '/'  */
+  YYSYMBOL_89_ = 89,                       /* '%'  */
+  YYSYMBOL_90_ = 90,                       /* '!'  */
+  YYSYMBOL_91_ = 91,                       /* '~'  */
+  YYSYMBOL_92_ = 92,                       /* '.'  */
+  YYSYMBOL_YYACCEPT = 93,                  /* $accept  */
+  YYSYMBOL_goal = 94,                      /* goal  */
+  YYSYMBOL_translation_unit = 95,          /* translation_unit  */
+  YYSYMBOL_external_declaration = 96,      /* external_declaration  */
+  YYSYMBOL_function_definition = 97,       /* function_definition  */
+  YYSYMBOL_parameter_type_list = 98,       /* parameter_type_list  */
+  YYSYMBOL_parameter_list = 99,            /* parameter_list  */
+  YYSYMBOL_parameter_declaration = 100,    /* parameter_declaration  */
+  YYSYMBOL_type_name = 101,                /* type_name  */
+  YYSYMBOL_abstract_declarator = 102,      /* abstract_declarator  */
+  YYSYMBOL_function_pointer_cast_opt = 103, /* function_pointer_cast_opt  */
+  YYSYMBOL_function_pointer_cast = 104,    /* function_pointer_cast  */
+  YYSYMBOL_pointer = 105,                  /* pointer  */
+  YYSYMBOL_specifier_qualifier_list = 106, /* specifier_qualifier_list  */
+  YYSYMBOL_compound_stmt = 107,            /* compound_stmt  */
+  YYSYMBOL_stmt_list_opt = 108,            /* stmt_list_opt  */
+  YYSYMBOL_declaration = 109,              /* declaration  */
+  YYSYMBOL_declaration_specifiers = 110,   /* declaration_specifiers  */
+  YYSYMBOL_storage_class_specifier = 111,  /* storage_class_specifier  */
+  YYSYMBOL_type_specifier = 112,           /* type_specifier  */
+  YYSYMBOL_type_qualifier = 113,           /* type_qualifier  */
+  YYSYMBOL_type_qualifier_list = 114,      /* type_qualifier_list  */
+  YYSYMBOL_struct_or_union_specifier = 115, /* struct_or_union_specifier  */
+  YYSYMBOL_struct_or_union = 116,          /* struct_or_union  */
+  YYSYMBOL_enum_specifier = 117,           /* enum_specifier  */
+  YYSYMBOL_enumerator_list = 118,          /* enumerator_list  */
+  YYSYMBOL_enumerator = 119,               /* enumerator  */
+  YYSYMBOL_comma_opt = 120,                /* comma_opt  */
+  YYSYMBOL_non_void_basic_type = 121,      /* non_void_basic_type  */
+  YYSYMBOL_basic_type = 122,               /* basic_type  */
+  YYSYMBOL_save_src_fn = 123,              /* save_src_fn  */
+  YYSYMBOL_save_line_no = 124,             /* save_line_no  */
+  YYSYMBOL_init_declarator_list = 125,     /* init_declarator_list  */
+  YYSYMBOL_init_declarator = 126,          /* init_declarator  */
+  YYSYMBOL_declarator = 127,               /* declarator  */
+  YYSYMBOL_direct_declarator = 128,        /* direct_declarator  */
+  YYSYMBOL_subscript_list = 129,           /* subscript_list  */
+  YYSYMBOL_subscript = 130,                /* subscript  */
+  YYSYMBOL_parameter_type_list_opt = 131,  /* parameter_type_list_opt  */
+  YYSYMBOL_initializer = 132,              /* initializer  */
+  YYSYMBOL_initializer_list = 133,         /* initializer_list  */
+  YYSYMBOL_struct_declaration_list_opt = 134, /* struct_declaration_list_opt  */
+  YYSYMBOL_struct_declaration_list = 135,  /* struct_declaration_list  */
+  YYSYMBOL_struct_declaration = 136,       /* struct_declaration  */
+  YYSYMBOL_struct_declarator_list = 137,   /* struct_declarator_list  */
+  YYSYMBOL_struct_declarator = 138,        /* struct_declarator  */
+  YYSYMBOL_stmt_list = 139,                /* stmt_list  */
+  YYSYMBOL_stmt = 140,                     /* stmt  */
+  YYSYMBOL_labeled_stmt = 141,             /* labeled_stmt  */
+  YYSYMBOL_constant_expr = 142,            /* constant_expr  */
+  YYSYMBOL_expr_stmt = 143,                /* expr_stmt  */
+  YYSYMBOL_expr_opt = 144,                 /* expr_opt  */
+  YYSYMBOL_expr = 145,                     /* expr  */
+  YYSYMBOL_arg_expr_list = 146,            /* arg_expr_list  */
+  YYSYMBOL_assignment_expr = 147,          /* assignment_expr  */
+  YYSYMBOL_assignment_op = 148,            /* assignment_op  */
+  YYSYMBOL_conditional_expr = 149,         /* conditional_expr  */
+  YYSYMBOL_logical_or_expr = 150,          /* logical_or_expr  */
+  YYSYMBOL_logical_and_expr = 151,         /* logical_and_expr  */
+  YYSYMBOL_inclusive_or_expr = 152,        /* inclusive_or_expr  */
+  YYSYMBOL_exclusive_or_expr = 153,        /* exclusive_or_expr  */
+  YYSYMBOL_and_expr = 154,                 /* and_expr  */
+  YYSYMBOL_equality_expr = 155,            /* equality_expr  */
+  YYSYMBOL_equality_op = 156,              /* equality_op  */
+  YYSYMBOL_rel_expr = 157,                 /* rel_expr  */
+  YYSYMBOL_shift_expr = 158,               /* shift_expr  */
+  YYSYMBOL_rel_op = 159,                   /* rel_op  */
+  YYSYMBOL_add_expr = 160,                 /* add_expr  */
+  YYSYMBOL_add_op = 161,                   /* add_op  */
+  YYSYMBOL_mul_expr = 162,                 /* mul_expr  */
+  YYSYMBOL_mul_op = 163,                   /* mul_op  */
+  YYSYMBOL_unary_expr = 164,               /* unary_expr  */
+  YYSYMBOL_unary_op = 165,                 /* unary_op  */
+  YYSYMBOL_cast_expr = 166,                /* cast_expr  */
+  YYSYMBOL_postfix_expr = 167,             /* postfix_expr  */
+  YYSYMBOL_primary_expr = 168,             /* primary_expr  */
+  YYSYMBOL_strlit_seq = 169,               /* strlit_seq  */
+  YYSYMBOL_expr_list_opt = 170,            /* expr_list_opt  */
+  YYSYMBOL_expr_list = 171,                /* expr_list  */
+  YYSYMBOL_selection_stmt = 172,           /* selection_stmt  */
+  YYSYMBOL_if_cond = 173,                  /* if_cond  */
+  YYSYMBOL_else_part_opt = 174,            /* else_part_opt  */
+  YYSYMBOL_while_stmt = 175,               /* while_stmt  */
+  YYSYMBOL_while_cond = 176,               /* while_cond  */
+  YYSYMBOL_do_while_stmt = 177,            /* do_while_stmt  */
+  YYSYMBOL_for_init = 178,                 /* for_init  */
+  YYSYMBOL_for_stmt = 179                  /* for_stmt  */
 };
-
-typedef union YYSTYPE YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
 
-extern YYSTYPE yylval;
 
-int yyparse (void);
+/* Unqualified %code blocks.  */
+#line 111 "parser.yy"
 
-#endif /* !YY_YY_Y_TAB_H_INCLUDED  */
+int yylex(YYSTYPE *lvalp, yyscan_t scanner);  // defined in lexer.ll
+char *yyget_text(yyscan_t scanner);  // defined in lexer.ll
+void yyerror(yyscan_t scanner, const char *msg);  // defined in util.cpp
 
-/* Copy the second part of user declarations.  */
-
-#line 362 "parser.cc" /* yacc.c:358  */
+#line 393 "parser.cc"
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
 #else
 typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -393,15 +483,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -415,47 +518,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -468,8 +567,22 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -534,8 +647,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -544,17 +656,17 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -567,11 +679,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -583,12 +695,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -611,17 +723,20 @@ union yyalloc
 /* YYNSTATES -- Number of states.  */
 #define YYNSTATES  398
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   323
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -659,113 +774,108 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,   149,   149,   150,   154,   160,   169,   170,   171,   172,
-     176,   205,   206,   207,   213,   214,   219,   229,   242,   260,
-     264,   265,   269,   270,   274,   275,   276,   277,   281,   282,
-     283,   284,   288,   293,   294,   300,   304,   313,   315,   317,
-     319,   321,   323,   328,   329,   330,   331,   332,   333,   334,
-     335,   336,   340,   341,   342,   345,   346,   347,   351,   352,
-     356,   357,   361,   374,   391,   392,   396,   402,   407,   416,
-     417,   421,   422,   426,   427,   431,   432,   433,   434,   435,
-     436,   437,   441,   453,   454,   458,   462,   466,   467,   473,
-     474,   478,   482,   486,   492,   495,   501,   506,   511,   516,
-     523,   529,   540,   541,   545,   549,   550,   554,   555,   556,
-     557,   558,   562,   563,   567,   568,   572,   582,   595,   599,
-     600,   605,   606,   607,   616,   617,   621,   622,   623,   624,
-     625,   626,   627,   628,   629,   630,   631,   632,   633,   634,
-     637,   640,   643,   647,   653,   654,   658,   662,   663,   667,
-     668,   672,   673,   687,   688,   692,   693,   702,   703,   704,
-     705,   706,   707,   708,   709,   710,   711,   712,   716,   717,
-     722,   723,   728,   729,   734,   735,   739,   740,   744,   745,
-     749,   750,   755,   756,   760,   761,   765,   766,   768,   773,
-     774,   775,   776,   780,   781,   785,   786,   790,   791,   795,
-     796,   797,   801,   802,   822,   823,   824,   825,   829,   830,
-     831,   832,   833,   834,   838,   839,   843,   844,   847,   850,
-     852,   854,   856,   858,   863,   864,   882,   883,   884,   888,
-     889,   898,   899,   903,   904,   908,   909,   913,   917,   918,
-     922,   926,   930,   934,   935,   939
+       0,   197,   197,   198,   202,   208,   217,   218,   219,   220,
+     224,   253,   254,   255,   261,   262,   267,   277,   290,   308,
+     312,   313,   317,   318,   322,   323,   324,   325,   329,   330,
+     331,   332,   336,   341,   342,   348,   352,   361,   363,   365,
+     367,   369,   371,   376,   377,   378,   379,   380,   381,   382,
+     383,   384,   388,   389,   390,   393,   394,   395,   399,   400,
+     404,   405,   409,   422,   439,   440,   444,   450,   455,   464,
+     465,   469,   470,   474,   475,   479,   480,   481,   482,   483,
+     484,   485,   489,   497,   498,   502,   506,   510,   511,   517,
+     518,   522,   526,   530,   536,   539,   545,   550,   555,   560,
+     567,   573,   584,   585,   589,   593,   594,   598,   599,   600,
+     601,   602,   606,   607,   611,   612,   616,   626,   639,   643,
+     644,   649,   650,   651,   660,   661,   665,   666,   667,   668,
+     669,   670,   671,   672,   673,   674,   675,   676,   677,   678,
+     681,   684,   687,   691,   697,   698,   702,   706,   707,   711,
+     712,   716,   717,   731,   732,   736,   737,   746,   747,   748,
+     749,   750,   751,   752,   753,   754,   755,   756,   760,   761,
+     766,   767,   772,   773,   778,   779,   783,   784,   788,   789,
+     793,   794,   799,   800,   804,   805,   809,   810,   812,   817,
+     818,   819,   820,   824,   825,   829,   830,   834,   835,   839,
+     840,   841,   845,   846,   871,   872,   873,   874,   878,   879,
+     880,   881,   882,   883,   887,   888,   892,   893,   896,   899,
+     901,   903,   905,   907,   912,   913,   932,   933,   934,   938,
+     939,   948,   949,   953,   954,   958,   959,   963,   967,   968,
+     972,   976,   980,   984,   985,   989
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "ID", "STRLIT", "PRAGMA", "CHARLIT",
-  "REAL", "TYPE_NAME", "INT", "CHAR", "SHORT", "LONG", "FLOAT", "DOUBLE",
-  "SIGNED", "UNSIGNED", "VOID", "PLUS_PLUS", "MINUS_MINUS", "IF", "ELSE",
-  "WHILE", "DO", "FOR", "EQUALS_EQUALS", "BANG_EQUALS", "LOWER_EQUALS",
-  "GREATER_EQUALS", "AMP_AMP", "PIPE_PIPE", "LT_LT", "GT_GT", "BREAK",
-  "CONTINUE", "RETURN", "ASM", "NORTS", "VERBATIM_ASM", "STRUCT", "UNION",
-  "THIS", "PLUS_EQUALS", "MINUS_EQUALS", "ASTERISK_EQUALS", "SLASH_EQUALS",
-  "PERCENT_EQUALS", "LT_LT_EQUALS", "GT_GT_EQUALS", "CARET_EQUALS",
-  "AMP_EQUALS", "PIPE_EQUALS", "RIGHT_ARROW", "INTERRUPT", "SIZEOF",
-  "ELLIPSIS", "TYPEDEF", "ENUM", "SWITCH", "CASE", "DEFAULT", "REGISTER",
-  "GOTO", "EXTERN", "STATIC", "CONST", "VOLATILE", "AUTO",
-  "FUNC_RECEIVES_FIRST_PARAM_IN_REG", "';'", "','", "'('", "'*'", "')'",
-  "'{'", "'}'", "'='", "'['", "']'", "':'", "'?'", "'|'", "'^'", "'&'",
-  "'<'", "'>'", "'+'", "'-'", "'/'", "'%'", "'!'", "'~'", "'.'", "$accept",
-  "goal", "translation_unit", "external_declaration",
-  "function_definition", "parameter_type_list", "parameter_list",
-  "parameter_declaration", "type_name", "abstract_declarator",
-  "function_pointer_cast_opt", "function_pointer_cast", "pointer",
-  "specifier_qualifier_list", "compound_stmt", "stmt_list_opt",
-  "declaration", "declaration_specifiers", "storage_class_specifier",
-  "type_specifier", "type_qualifier", "type_qualifier_list",
-  "struct_or_union_specifier", "struct_or_union", "enum_specifier",
-  "enumerator_list", "enumerator", "comma_opt", "non_void_basic_type",
-  "basic_type", "save_src_fn", "save_line_no", "init_declarator_list",
-  "init_declarator", "declarator", "direct_declarator", "subscript_list",
-  "subscript", "parameter_type_list_opt", "initializer",
-  "initializer_list", "struct_declaration_list_opt",
-  "struct_declaration_list", "struct_declaration",
-  "struct_declarator_list", "struct_declarator", "stmt_list", "stmt",
-  "labeled_stmt", "constant_expr", "expr_stmt", "expr_opt", "expr",
-  "arg_expr_list", "assignment_expr", "assignment_op", "conditional_expr",
-  "logical_or_expr", "logical_and_expr", "inclusive_or_expr",
-  "exclusive_or_expr", "and_expr", "equality_expr", "equality_op",
-  "rel_expr", "shift_expr", "rel_op", "add_expr", "add_op", "mul_expr",
-  "mul_op", "unary_expr", "unary_op", "cast_expr", "postfix_expr",
-  "primary_expr", "strlit_seq", "expr_list_opt", "expr_list",
-  "selection_stmt", "if_cond", "else_part_opt", "while_stmt", "while_cond",
-  "do_while_stmt", "for_init", "for_stmt", YY_NULLPTR
+  "\"end of file\"", "error", "\"invalid token\"", "ID", "STRLIT",
+  "PRAGMA", "CHARLIT", "REAL", "TYPE_NAME", "INT", "CHAR", "SHORT", "LONG",
+  "FLOAT", "DOUBLE", "SIGNED", "UNSIGNED", "VOID", "PLUS_PLUS",
+  "MINUS_MINUS", "IF", "ELSE", "WHILE", "DO", "FOR", "EQUALS_EQUALS",
+  "BANG_EQUALS", "LOWER_EQUALS", "GREATER_EQUALS", "AMP_AMP", "PIPE_PIPE",
+  "LT_LT", "GT_GT", "BREAK", "CONTINUE", "RETURN", "ASM", "NORTS",
+  "VERBATIM_ASM", "STRUCT", "UNION", "THIS", "PLUS_EQUALS", "MINUS_EQUALS",
+  "ASTERISK_EQUALS", "SLASH_EQUALS", "PERCENT_EQUALS", "LT_LT_EQUALS",
+  "GT_GT_EQUALS", "CARET_EQUALS", "AMP_EQUALS", "PIPE_EQUALS",
+  "RIGHT_ARROW", "INTERRUPT", "SIZEOF", "ELLIPSIS", "TYPEDEF", "ENUM",
+  "SWITCH", "CASE", "DEFAULT", "REGISTER", "GOTO", "EXTERN", "STATIC",
+  "CONST", "VOLATILE", "AUTO", "FUNC_RECEIVES_FIRST_PARAM_IN_REG", "';'",
+  "','", "'('", "'*'", "')'", "'{'", "'}'", "'='", "'['", "']'", "':'",
+  "'?'", "'|'", "'^'", "'&'", "'<'", "'>'", "'+'", "'-'", "'/'", "'%'",
+  "'!'", "'~'", "'.'", "$accept", "goal", "translation_unit",
+  "external_declaration", "function_definition", "parameter_type_list",
+  "parameter_list", "parameter_declaration", "type_name",
+  "abstract_declarator", "function_pointer_cast_opt",
+  "function_pointer_cast", "pointer", "specifier_qualifier_list",
+  "compound_stmt", "stmt_list_opt", "declaration",
+  "declaration_specifiers", "storage_class_specifier", "type_specifier",
+  "type_qualifier", "type_qualifier_list", "struct_or_union_specifier",
+  "struct_or_union", "enum_specifier", "enumerator_list", "enumerator",
+  "comma_opt", "non_void_basic_type", "basic_type", "save_src_fn",
+  "save_line_no", "init_declarator_list", "init_declarator", "declarator",
+  "direct_declarator", "subscript_list", "subscript",
+  "parameter_type_list_opt", "initializer", "initializer_list",
+  "struct_declaration_list_opt", "struct_declaration_list",
+  "struct_declaration", "struct_declarator_list", "struct_declarator",
+  "stmt_list", "stmt", "labeled_stmt", "constant_expr", "expr_stmt",
+  "expr_opt", "expr", "arg_expr_list", "assignment_expr", "assignment_op",
+  "conditional_expr", "logical_or_expr", "logical_and_expr",
+  "inclusive_or_expr", "exclusive_or_expr", "and_expr", "equality_expr",
+  "equality_op", "rel_expr", "shift_expr", "rel_op", "add_expr", "add_op",
+  "mul_expr", "mul_op", "unary_expr", "unary_op", "cast_expr",
+  "postfix_expr", "primary_expr", "strlit_seq", "expr_list_opt",
+  "expr_list", "selection_stmt", "if_cond", "else_part_opt", "while_stmt",
+  "while_cond", "do_while_stmt", "for_init", "for_stmt", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,   307,   308,   309,   310,   311,   312,   313,   314,
-     315,   316,   317,   318,   319,   320,   321,   322,   323,    59,
-      44,    40,    42,    41,   123,   125,    61,    91,    93,    58,
-      63,   124,    94,    38,    60,    62,    43,    45,    47,    37,
-      33,   126,    46
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -201
+#define YYPACT_NINF (-201)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-201)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -86
+#define YYTABLE_NINF (-86)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
      811,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,  -201,
@@ -810,9 +920,9 @@ static const yytype_int16 yypact[] =
     -201,  -201,   556,   215,  -201,  -201,   323,  -201
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_uint8 yydefact[] =
 {
        3,     8,    57,    75,    76,    77,    80,    81,    82,    78,
@@ -857,7 +967,7 @@ static const yytype_uint8 yydefact[] =
       85,    86,   231,     0,    85,    86,     0,   245
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
     -201,  -201,  -201,   261,  -201,   -72,  -201,    86,   139,  -201,
@@ -871,10 +981,10 @@ static const yytype_int16 yypgoto[] =
     -201,  -201,  -201,   -25,  -201,  -201,  -201
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int16 yydefgoto[] =
 {
-      -1,    27,    28,    29,    30,   219,   132,   133,   164,   252,
+       0,    27,    28,    29,    30,   219,   132,   133,   164,   252,
      253,   254,    49,    77,   236,   237,   238,   239,    33,    34,
       35,    67,    36,    37,    38,    62,    63,    86,    39,    40,
       93,   158,    50,    51,    92,    53,   155,   156,   220,   109,
@@ -885,9 +995,9 @@ static const yytype_int16 yydefgoto[] =
      328,   375,   246,   330,   247,   366,   248
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
       32,    31,   131,   195,   201,   136,   110,   216,   149,    57,
@@ -1092,8 +1202,8 @@ static const yytype_int16 yycheck[] =
       -1,    -1,    61,    -1,    63,    64,    65,    66,    67,    68
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
 static const yytype_uint8 yystos[] =
 {
        0,     5,     8,     9,    10,    11,    12,    13,    14,    15,
@@ -1138,7 +1248,7 @@ static const yytype_uint8 yystos[] =
       69,   123,   124,   170,    73,   123,   124,   140
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_uint8 yyr1[] =
 {
        0,    93,    94,    94,    95,    95,    96,    96,    96,    96,
@@ -1168,8 +1278,8 @@ static const yytype_uint8 yyr1[] =
      175,   176,   177,   178,   178,   179
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
        0,     2,     1,     0,     1,     2,     1,     1,     1,     1,
        3,     1,     3,     1,     1,     3,     2,     2,     3,     1,
@@ -1199,39 +1309,39 @@ static const yytype_uint8 yyr2[] =
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (scanner, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 
 /* Enable debugging if requested.  */
@@ -1248,55 +1358,53 @@ do {                                            \
     YYFPRINTF Args;                             \
 } while (0)
 
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value); \
+                  Kind, Value, scanner); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, yyscan_t scanner)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (scanner);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, yyscan_t scanner)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, scanner);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1305,7 +1413,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -1328,21 +1436,21 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, yyscan_t scanner)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                                              );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], scanner);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -1350,15 +1458,15 @@ yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, Rule, scanner); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -1381,255 +1489,32 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-static YYSIZE_T
-yystrlen (const char *yystr)
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
 
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-        switch (*++yyp)
-          {
-          case '\'':
-          case ',':
-            goto do_not_strip_quotes;
-
-          case '\\':
-            if (*++yyp != '\\')
-              goto do_not_strip_quotes;
-            /* Fall through.  */
-          default:
-            if (yyres)
-              yyres[yyn] = *yyp;
-            yyn++;
-            break;
-
-          case '"':
-            if (yyres)
-              yyres[yyn] = '\0';
-            return yyn;
-          }
-    do_not_strip_quotes: ;
-    }
-
-  if (! yyres)
-    return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
-
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
-    }
-
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
-
-  {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
-  }
-
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
-
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, yyscan_t scanner)
 {
-  YYUSE (yyvaluep);
+  YY_USE (yyvaluep);
+  YY_USE (scanner);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
-/* The lookahead symbol.  */
-int yychar;
-
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-/* Number of syntax errors so far.  */
-int yynerrs;
 
 
 /*----------.
@@ -1637,45 +1522,51 @@ int yynerrs;
 `----------*/
 
 int
-yyparse (void)
+yyparse (yyscan_t scanner)
 {
-    int yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1683,71 +1574,75 @@ yyparse (void)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
 
         /* Each stack pointer address is followed by the size of the
            data in use in that stack, in bytes.  This used to be a
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
                     &yystacksize);
-
         yyss = yyss1;
         yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
@@ -1755,30 +1650,31 @@ yyparse (void)
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1789,18 +1685,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = yylex ();
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, scanner);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1828,15 +1735,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1851,7 +1756,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1871,65 +1776,65 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 149 "parser.yy" /* yacc.c:1646  */
-    { TranslationUnit::instance().setDefinitionList((yyvsp[0].treeSequence)); }
-#line 1878 "parser.cc" /* yacc.c:1646  */
+  case 2: /* goal: translation_unit  */
+#line 197 "parser.yy"
+                                { TranslationUnit::instance().setDefinitionList((yyvsp[0].treeSequence)); }
+#line 1783 "parser.cc"
     break;
 
-  case 3:
-#line 150 "parser.yy" /* yacc.c:1646  */
-    { TranslationUnit::instance().setDefinitionList(NULL); }
-#line 1884 "parser.cc" /* yacc.c:1646  */
+  case 3: /* goal: %empty  */
+#line 198 "parser.yy"
+                                { TranslationUnit::instance().setDefinitionList(NULL); }
+#line 1789 "parser.cc"
     break;
 
-  case 4:
-#line 155 "parser.yy" /* yacc.c:1646  */
-    {
+  case 4: /* translation_unit: external_declaration  */
+#line 203 "parser.yy"
+            {
                 (yyval.treeSequence) = new TreeSequence();
                 if ((yyvsp[0].tree))
                     (yyval.treeSequence)->addTree((yyvsp[0].tree)); 
             }
-#line 1894 "parser.cc" /* yacc.c:1646  */
+#line 1799 "parser.cc"
     break;
 
-  case 5:
-#line 161 "parser.yy" /* yacc.c:1646  */
-    {
+  case 5: /* translation_unit: translation_unit external_declaration  */
+#line 209 "parser.yy"
+            {
                 (yyval.treeSequence) = (yyvsp[-1].treeSequence);
                 if ((yyvsp[0].tree))
                     (yyval.treeSequence)->addTree((yyvsp[0].tree));
             }
-#line 1904 "parser.cc" /* yacc.c:1646  */
+#line 1809 "parser.cc"
     break;
 
-  case 6:
-#line 169 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].functionDef); }
-#line 1910 "parser.cc" /* yacc.c:1646  */
+  case 6: /* external_declaration: function_definition  */
+#line 217 "parser.yy"
+                                { (yyval.tree) = (yyvsp[0].functionDef); }
+#line 1815 "parser.cc"
     break;
 
-  case 7:
-#line 170 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].declarationSequence); }
-#line 1916 "parser.cc" /* yacc.c:1646  */
+  case 7: /* external_declaration: declaration  */
+#line 218 "parser.yy"
+                                { (yyval.tree) = (yyvsp[0].declarationSequence); }
+#line 1821 "parser.cc"
     break;
 
-  case 8:
-#line 171 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new Pragma((yyvsp[0].str)); free((yyvsp[0].str)); }
-#line 1922 "parser.cc" /* yacc.c:1646  */
+  case 8: /* external_declaration: PRAGMA  */
+#line 219 "parser.yy"
+                                { (yyval.tree) = new Pragma((yyvsp[0].str)); free((yyvsp[0].str)); }
+#line 1827 "parser.cc"
     break;
 
-  case 9:
-#line 172 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = NULL; }
-#line 1928 "parser.cc" /* yacc.c:1646  */
+  case 9: /* external_declaration: ';'  */
+#line 220 "parser.yy"
+                                { (yyval.tree) = NULL; }
+#line 1833 "parser.cc"
     break;
 
-  case 10:
-#line 177 "parser.yy" /* yacc.c:1646  */
-    {
+  case 10: /* function_definition: declaration_specifiers declarator compound_stmt  */
+#line 225 "parser.yy"
+            {
                 DeclarationSpecifierList *dsl = (yyvsp[-2].declarationSpecifierList);
                 Declarator *di = (yyvsp[-1].declarator);
 
@@ -1954,53 +1859,53 @@ yyreduce:
                 delete di;
                 delete dsl;
             }
-#line 1958 "parser.cc" /* yacc.c:1646  */
+#line 1863 "parser.cc"
     break;
 
-  case 11:
-#line 205 "parser.yy" /* yacc.c:1646  */
-    { (yyval.formalParamList) = (yyvsp[0].formalParamList); }
-#line 1964 "parser.cc" /* yacc.c:1646  */
+  case 11: /* parameter_type_list: parameter_list  */
+#line 253 "parser.yy"
+                                     { (yyval.formalParamList) = (yyvsp[0].formalParamList); }
+#line 1869 "parser.cc"
     break;
 
-  case 12:
-#line 206 "parser.yy" /* yacc.c:1646  */
-    { (yyval.formalParamList) = (yyvsp[-2].formalParamList); (yyval.formalParamList)->endWithEllipsis(); }
-#line 1970 "parser.cc" /* yacc.c:1646  */
+  case 12: /* parameter_type_list: parameter_list ',' ELLIPSIS  */
+#line 254 "parser.yy"
+                                     { (yyval.formalParamList) = (yyvsp[-2].formalParamList); (yyval.formalParamList)->endWithEllipsis(); }
+#line 1875 "parser.cc"
     break;
 
-  case 13:
-#line 207 "parser.yy" /* yacc.c:1646  */
-    { (yyval.formalParamList) = new FormalParamList(); (yyval.formalParamList)->endWithEllipsis(); }
-#line 1976 "parser.cc" /* yacc.c:1646  */
+  case 13: /* parameter_type_list: ELLIPSIS  */
+#line 255 "parser.yy"
+                                     { (yyval.formalParamList) = new FormalParamList(); (yyval.formalParamList)->endWithEllipsis(); }
+#line 1881 "parser.cc"
     break;
 
-  case 14:
-#line 213 "parser.yy" /* yacc.c:1646  */
-    { (yyval.formalParamList) = new FormalParamList(); if ((yyvsp[0].formalParameter)) (yyval.formalParamList)->addTree((yyvsp[0].formalParameter)); }
-#line 1982 "parser.cc" /* yacc.c:1646  */
+  case 14: /* parameter_list: parameter_declaration  */
+#line 261 "parser.yy"
+                                     { (yyval.formalParamList) = new FormalParamList(); if ((yyvsp[0].formalParameter)) (yyval.formalParamList)->addTree((yyvsp[0].formalParameter)); }
+#line 1887 "parser.cc"
     break;
 
-  case 15:
-#line 215 "parser.yy" /* yacc.c:1646  */
-    { (yyval.formalParamList) = (yyvsp[-2].formalParamList); if ((yyvsp[0].formalParameter)) (yyval.formalParamList)->addTree((yyvsp[0].formalParameter)); }
-#line 1988 "parser.cc" /* yacc.c:1646  */
+  case 15: /* parameter_list: parameter_list ',' parameter_declaration  */
+#line 263 "parser.yy"
+                                     { (yyval.formalParamList) = (yyvsp[-2].formalParamList); if ((yyvsp[0].formalParameter)) (yyval.formalParamList)->addTree((yyvsp[0].formalParameter)); }
+#line 1893 "parser.cc"
     break;
 
-  case 16:
-#line 220 "parser.yy" /* yacc.c:1646  */
-    {
+  case 16: /* parameter_declaration: declaration_specifiers declarator  */
+#line 268 "parser.yy"
+                {
                     DeclarationSpecifierList *dsl = (yyvsp[-1].declarationSpecifierList);
                     (yyval.formalParameter) = (yyvsp[0].declarator)->createFormalParameter(*dsl);
                     delete dsl;
                     delete (yyvsp[0].declarator);
                 }
-#line 1999 "parser.cc" /* yacc.c:1646  */
+#line 1904 "parser.cc"
     break;
 
-  case 17:
-#line 230 "parser.yy" /* yacc.c:1646  */
-    {
+  case 17: /* type_name: specifier_qualifier_list function_pointer_cast_opt  */
+#line 278 "parser.yy"
+                {
                     if ((yyvsp[0].formalParamList))
                     {
                         (yyval.typeDesc) = TranslationUnit::getTypeManager().getFunctionPointerType(
@@ -2012,12 +1917,12 @@ yyreduce:
                         (yyval.typeDesc) = (yyvsp[-1].declarationSpecifierList)->getTypeDesc();
                     delete (yyvsp[-1].declarationSpecifierList);
                 }
-#line 2016 "parser.cc" /* yacc.c:1646  */
+#line 1921 "parser.cc"
     break;
 
-  case 18:
-#line 243 "parser.yy" /* yacc.c:1646  */
-    {
+  case 18: /* type_name: specifier_qualifier_list abstract_declarator function_pointer_cast_opt  */
+#line 291 "parser.yy"
+                {
                     const TypeDesc *td = TranslationUnit::getTypeManager().getPointerTo((yyvsp[-2].declarationSpecifierList)->getTypeDesc(), *(yyvsp[-1].typeQualifierBitFieldVector));
                     if ((yyvsp[0].formalParamList))
                     {
@@ -2031,276 +1936,276 @@ yyreduce:
                     delete (yyvsp[-1].typeQualifierBitFieldVector);  /* originally created by 'pointer' rule */
                     delete (yyvsp[-2].declarationSpecifierList);
                 }
-#line 2035 "parser.cc" /* yacc.c:1646  */
+#line 1940 "parser.cc"
     break;
 
-  case 19:
-#line 260 "parser.yy" /* yacc.c:1646  */
-    { (yyval.typeQualifierBitFieldVector) = (yyvsp[0].typeQualifierBitFieldVector); }
-#line 2041 "parser.cc" /* yacc.c:1646  */
+  case 19: /* abstract_declarator: pointer  */
+#line 308 "parser.yy"
+                        { (yyval.typeQualifierBitFieldVector) = (yyvsp[0].typeQualifierBitFieldVector); }
+#line 1946 "parser.cc"
     break;
 
-  case 20:
-#line 264 "parser.yy" /* yacc.c:1646  */
-    { (yyval.formalParamList) = NULL; }
-#line 2047 "parser.cc" /* yacc.c:1646  */
+  case 20: /* function_pointer_cast_opt: %empty  */
+#line 312 "parser.yy"
+                                                { (yyval.formalParamList) = NULL; }
+#line 1952 "parser.cc"
     break;
 
-  case 21:
-#line 265 "parser.yy" /* yacc.c:1646  */
-    { (yyval.formalParamList) = (yyvsp[0].formalParamList); }
-#line 2053 "parser.cc" /* yacc.c:1646  */
+  case 21: /* function_pointer_cast_opt: function_pointer_cast  */
+#line 313 "parser.yy"
+                                                { (yyval.formalParamList) = (yyvsp[0].formalParamList); }
+#line 1958 "parser.cc"
     break;
 
-  case 22:
-#line 269 "parser.yy" /* yacc.c:1646  */
-    { (yyval.formalParamList) = (yyvsp[-1].formalParamList); }
-#line 2059 "parser.cc" /* yacc.c:1646  */
+  case 22: /* function_pointer_cast: '(' '*' ')' '(' parameter_type_list ')'  */
+#line 317 "parser.yy"
+                                                { (yyval.formalParamList) = (yyvsp[-1].formalParamList); }
+#line 1964 "parser.cc"
     break;
 
-  case 23:
-#line 270 "parser.yy" /* yacc.c:1646  */
-    { (yyval.formalParamList) = new FormalParamList(); }
-#line 2065 "parser.cc" /* yacc.c:1646  */
+  case 23: /* function_pointer_cast: '(' '*' ')' '(' ')'  */
+#line 318 "parser.yy"
+                                                { (yyval.formalParamList) = new FormalParamList(); }
+#line 1970 "parser.cc"
     break;
 
-  case 24:
-#line 274 "parser.yy" /* yacc.c:1646  */
-    { (yyval.typeQualifierBitFieldVector) = new TypeQualifierBitFieldVector(); (yyval.typeQualifierBitFieldVector)->push_back(0); }
-#line 2071 "parser.cc" /* yacc.c:1646  */
+  case 24: /* pointer: '*'  */
+#line 322 "parser.yy"
+                                        { (yyval.typeQualifierBitFieldVector) = new TypeQualifierBitFieldVector(); (yyval.typeQualifierBitFieldVector)->push_back(0); }
+#line 1976 "parser.cc"
     break;
 
-  case 25:
-#line 275 "parser.yy" /* yacc.c:1646  */
-    { (yyval.typeQualifierBitFieldVector) = new TypeQualifierBitFieldVector(); (yyval.typeQualifierBitFieldVector)->push_back(TypeQualifierBitField((yyvsp[0].integer))); }
-#line 2077 "parser.cc" /* yacc.c:1646  */
+  case 25: /* pointer: '*' type_qualifier_list  */
+#line 323 "parser.yy"
+                                        { (yyval.typeQualifierBitFieldVector) = new TypeQualifierBitFieldVector(); (yyval.typeQualifierBitFieldVector)->push_back(TypeQualifierBitField((yyvsp[0].integer))); }
+#line 1982 "parser.cc"
     break;
 
-  case 26:
-#line 276 "parser.yy" /* yacc.c:1646  */
-    { (yyval.typeQualifierBitFieldVector) = (yyvsp[0].typeQualifierBitFieldVector); (yyval.typeQualifierBitFieldVector)->push_back(0); }
-#line 2083 "parser.cc" /* yacc.c:1646  */
+  case 26: /* pointer: '*' pointer  */
+#line 324 "parser.yy"
+                                        { (yyval.typeQualifierBitFieldVector) = (yyvsp[0].typeQualifierBitFieldVector); (yyval.typeQualifierBitFieldVector)->push_back(0); }
+#line 1988 "parser.cc"
     break;
 
-  case 27:
-#line 277 "parser.yy" /* yacc.c:1646  */
-    { (yyval.typeQualifierBitFieldVector) = (yyvsp[0].typeQualifierBitFieldVector); (yyval.typeQualifierBitFieldVector)->push_back((yyvsp[-1].integer)); }
-#line 2089 "parser.cc" /* yacc.c:1646  */
+  case 27: /* pointer: '*' type_qualifier_list pointer  */
+#line 325 "parser.yy"
+                                        { (yyval.typeQualifierBitFieldVector) = (yyvsp[0].typeQualifierBitFieldVector); (yyval.typeQualifierBitFieldVector)->push_back((yyvsp[-1].integer)); }
+#line 1994 "parser.cc"
     break;
 
-  case 28:
-#line 281 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declarationSpecifierList) = (yyvsp[0].declarationSpecifierList); (yyval.declarationSpecifierList)->add(*(yyvsp[-1].typeSpecifier)); delete (yyvsp[-1].typeSpecifier); }
-#line 2095 "parser.cc" /* yacc.c:1646  */
+  case 28: /* specifier_qualifier_list: type_specifier specifier_qualifier_list  */
+#line 329 "parser.yy"
+                                                { (yyval.declarationSpecifierList) = (yyvsp[0].declarationSpecifierList); (yyval.declarationSpecifierList)->add(*(yyvsp[-1].typeSpecifier)); delete (yyvsp[-1].typeSpecifier); }
+#line 2000 "parser.cc"
     break;
 
-  case 29:
-#line 282 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declarationSpecifierList) = new DeclarationSpecifierList(); (yyval.declarationSpecifierList)->add(*(yyvsp[0].typeSpecifier)); delete (yyvsp[0].typeSpecifier); }
-#line 2101 "parser.cc" /* yacc.c:1646  */
+  case 29: /* specifier_qualifier_list: type_specifier  */
+#line 330 "parser.yy"
+                                                { (yyval.declarationSpecifierList) = new DeclarationSpecifierList(); (yyval.declarationSpecifierList)->add(*(yyvsp[0].typeSpecifier)); delete (yyvsp[0].typeSpecifier); }
+#line 2006 "parser.cc"
     break;
 
-  case 30:
-#line 283 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declarationSpecifierList) = (yyvsp[0].declarationSpecifierList); if ((yyvsp[-1].integer) != -1) (yyval.declarationSpecifierList)->add(DeclarationSpecifierList::Specifier((yyvsp[-1].integer))); }
-#line 2107 "parser.cc" /* yacc.c:1646  */
+  case 30: /* specifier_qualifier_list: type_qualifier specifier_qualifier_list  */
+#line 331 "parser.yy"
+                                                { (yyval.declarationSpecifierList) = (yyvsp[0].declarationSpecifierList); if ((yyvsp[-1].integer) != -1) (yyval.declarationSpecifierList)->add(DeclarationSpecifierList::Specifier((yyvsp[-1].integer))); }
+#line 2012 "parser.cc"
     break;
 
-  case 31:
-#line 284 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declarationSpecifierList) = new DeclarationSpecifierList(); if ((yyvsp[0].integer) != -1) (yyval.declarationSpecifierList)->add(DeclarationSpecifierList::Specifier((yyvsp[0].integer))); }
-#line 2113 "parser.cc" /* yacc.c:1646  */
+  case 31: /* specifier_qualifier_list: type_qualifier  */
+#line 332 "parser.yy"
+                                                { (yyval.declarationSpecifierList) = new DeclarationSpecifierList(); if ((yyvsp[0].integer) != -1) (yyval.declarationSpecifierList)->add(DeclarationSpecifierList::Specifier((yyvsp[0].integer))); }
+#line 2018 "parser.cc"
     break;
 
-  case 32:
-#line 289 "parser.yy" /* yacc.c:1646  */
-    { (yyval.compoundStmt) = (yyvsp[-1].compoundStmt); (yyval.compoundStmt)->setLineNo((yyvsp[-3].str), (yyvsp[-2].integer)); free((yyvsp[-3].str)); }
-#line 2119 "parser.cc" /* yacc.c:1646  */
+  case 32: /* compound_stmt: '{' save_src_fn save_line_no stmt_list_opt '}'  */
+#line 337 "parser.yy"
+                        { (yyval.compoundStmt) = (yyvsp[-1].compoundStmt); (yyval.compoundStmt)->setLineNo((yyvsp[-3].str), (yyvsp[-2].integer)); free((yyvsp[-3].str)); }
+#line 2024 "parser.cc"
     break;
 
-  case 33:
-#line 293 "parser.yy" /* yacc.c:1646  */
-    { (yyval.compoundStmt) = new CompoundStmt(); }
-#line 2125 "parser.cc" /* yacc.c:1646  */
+  case 33: /* stmt_list_opt: %empty  */
+#line 341 "parser.yy"
+                        { (yyval.compoundStmt) = new CompoundStmt(); }
+#line 2030 "parser.cc"
     break;
 
-  case 34:
-#line 294 "parser.yy" /* yacc.c:1646  */
-    { (yyval.compoundStmt) = (yyvsp[0].compoundStmt); }
-#line 2131 "parser.cc" /* yacc.c:1646  */
+  case 34: /* stmt_list_opt: stmt_list  */
+#line 342 "parser.yy"
+                        { (yyval.compoundStmt) = (yyvsp[0].compoundStmt); }
+#line 2036 "parser.cc"
     break;
 
-  case 35:
-#line 301 "parser.yy" /* yacc.c:1646  */
-    {
+  case 35: /* declaration: declaration_specifiers ';'  */
+#line 349 "parser.yy"
+                        {
                             (yyval.declarationSequence) = TranslationUnit::instance().createDeclarationSequence((yyvsp[-1].declarationSpecifierList), NULL);  // deletes $1
                         }
-#line 2139 "parser.cc" /* yacc.c:1646  */
+#line 2044 "parser.cc"
     break;
 
-  case 36:
-#line 305 "parser.yy" /* yacc.c:1646  */
-    {
+  case 36: /* declaration: declaration_specifiers init_declarator_list ';'  */
+#line 353 "parser.yy"
+                        {
                             (yyval.declarationSequence) = TranslationUnit::instance().createDeclarationSequence((yyvsp[-2].declarationSpecifierList), (yyvsp[-1].declaratorVector));  // deletes $1 and $2
                         }
-#line 2147 "parser.cc" /* yacc.c:1646  */
+#line 2052 "parser.cc"
     break;
 
-  case 37:
-#line 314 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declarationSpecifierList) = new DeclarationSpecifierList(); if ((yyvsp[0].integer) != -1) (yyval.declarationSpecifierList)->add(DeclarationSpecifierList::Specifier((yyvsp[0].integer))); }
-#line 2153 "parser.cc" /* yacc.c:1646  */
+  case 37: /* declaration_specifiers: storage_class_specifier  */
+#line 362 "parser.yy"
+            { (yyval.declarationSpecifierList) = new DeclarationSpecifierList(); if ((yyvsp[0].integer) != -1) (yyval.declarationSpecifierList)->add(DeclarationSpecifierList::Specifier((yyvsp[0].integer))); }
+#line 2058 "parser.cc"
     break;
 
-  case 38:
-#line 316 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declarationSpecifierList) = (yyvsp[0].declarationSpecifierList); if ((yyvsp[-1].integer) != -1) (yyval.declarationSpecifierList)->add(DeclarationSpecifierList::Specifier((yyvsp[-1].integer))); }
-#line 2159 "parser.cc" /* yacc.c:1646  */
+  case 38: /* declaration_specifiers: storage_class_specifier declaration_specifiers  */
+#line 364 "parser.yy"
+            { (yyval.declarationSpecifierList) = (yyvsp[0].declarationSpecifierList); if ((yyvsp[-1].integer) != -1) (yyval.declarationSpecifierList)->add(DeclarationSpecifierList::Specifier((yyvsp[-1].integer))); }
+#line 2064 "parser.cc"
     break;
 
-  case 39:
-#line 318 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declarationSpecifierList) = new DeclarationSpecifierList(); (yyval.declarationSpecifierList)->add(*(yyvsp[0].typeSpecifier)); delete (yyvsp[0].typeSpecifier); }
-#line 2165 "parser.cc" /* yacc.c:1646  */
+  case 39: /* declaration_specifiers: type_specifier  */
+#line 366 "parser.yy"
+            { (yyval.declarationSpecifierList) = new DeclarationSpecifierList(); (yyval.declarationSpecifierList)->add(*(yyvsp[0].typeSpecifier)); delete (yyvsp[0].typeSpecifier); }
+#line 2070 "parser.cc"
     break;
 
-  case 40:
-#line 320 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declarationSpecifierList) = (yyvsp[0].declarationSpecifierList); (yyval.declarationSpecifierList)->add(*(yyvsp[-1].typeSpecifier)); delete (yyvsp[-1].typeSpecifier); }
-#line 2171 "parser.cc" /* yacc.c:1646  */
+  case 40: /* declaration_specifiers: type_specifier declaration_specifiers  */
+#line 368 "parser.yy"
+            { (yyval.declarationSpecifierList) = (yyvsp[0].declarationSpecifierList); (yyval.declarationSpecifierList)->add(*(yyvsp[-1].typeSpecifier)); delete (yyvsp[-1].typeSpecifier); }
+#line 2076 "parser.cc"
     break;
 
-  case 41:
-#line 322 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declarationSpecifierList) = new DeclarationSpecifierList(); if ((yyvsp[0].integer) != -1) (yyval.declarationSpecifierList)->add(DeclarationSpecifierList::Specifier((yyvsp[0].integer))); }
-#line 2177 "parser.cc" /* yacc.c:1646  */
+  case 41: /* declaration_specifiers: type_qualifier  */
+#line 370 "parser.yy"
+            { (yyval.declarationSpecifierList) = new DeclarationSpecifierList(); if ((yyvsp[0].integer) != -1) (yyval.declarationSpecifierList)->add(DeclarationSpecifierList::Specifier((yyvsp[0].integer))); }
+#line 2082 "parser.cc"
     break;
 
-  case 42:
-#line 324 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declarationSpecifierList) = (yyvsp[0].declarationSpecifierList); if ((yyvsp[-1].integer) != -1) (yyval.declarationSpecifierList)->add(DeclarationSpecifierList::Specifier((yyvsp[-1].integer))); }
-#line 2183 "parser.cc" /* yacc.c:1646  */
+  case 42: /* declaration_specifiers: type_qualifier declaration_specifiers  */
+#line 372 "parser.yy"
+            { (yyval.declarationSpecifierList) = (yyvsp[0].declarationSpecifierList); if ((yyvsp[-1].integer) != -1) (yyval.declarationSpecifierList)->add(DeclarationSpecifierList::Specifier((yyvsp[-1].integer))); }
+#line 2088 "parser.cc"
     break;
 
-  case 43:
-#line 328 "parser.yy" /* yacc.c:1646  */
-    { (yyval.integer) = DeclarationSpecifierList::INTERRUPT_SPEC; }
-#line 2189 "parser.cc" /* yacc.c:1646  */
+  case 43: /* storage_class_specifier: INTERRUPT  */
+#line 376 "parser.yy"
+                    { (yyval.integer) = DeclarationSpecifierList::INTERRUPT_SPEC; }
+#line 2094 "parser.cc"
     break;
 
-  case 44:
-#line 329 "parser.yy" /* yacc.c:1646  */
-    { (yyval.integer) = DeclarationSpecifierList::FUNC_RECEIVES_FIRST_PARAM_IN_REG_SPEC; }
-#line 2195 "parser.cc" /* yacc.c:1646  */
+  case 44: /* storage_class_specifier: FUNC_RECEIVES_FIRST_PARAM_IN_REG  */
+#line 377 "parser.yy"
+                                       { (yyval.integer) = DeclarationSpecifierList::FUNC_RECEIVES_FIRST_PARAM_IN_REG_SPEC; }
+#line 2100 "parser.cc"
     break;
 
-  case 45:
-#line 330 "parser.yy" /* yacc.c:1646  */
-    { (yyval.integer) = DeclarationSpecifierList::TYPEDEF_SPEC; }
-#line 2201 "parser.cc" /* yacc.c:1646  */
+  case 45: /* storage_class_specifier: TYPEDEF  */
+#line 378 "parser.yy"
+                    { (yyval.integer) = DeclarationSpecifierList::TYPEDEF_SPEC; }
+#line 2106 "parser.cc"
     break;
 
-  case 46:
-#line 331 "parser.yy" /* yacc.c:1646  */
-    { (yyval.integer) = DeclarationSpecifierList::ASSEMBLY_ONLY_SPEC; }
-#line 2207 "parser.cc" /* yacc.c:1646  */
+  case 46: /* storage_class_specifier: ASM  */
+#line 379 "parser.yy"
+                    { (yyval.integer) = DeclarationSpecifierList::ASSEMBLY_ONLY_SPEC; }
+#line 2112 "parser.cc"
     break;
 
-  case 47:
-#line 332 "parser.yy" /* yacc.c:1646  */
-    { (yyval.integer) = DeclarationSpecifierList::NO_RETURN_INSTRUCTION; }
-#line 2213 "parser.cc" /* yacc.c:1646  */
+  case 47: /* storage_class_specifier: NORTS  */
+#line 380 "parser.yy"
+                    { (yyval.integer) = DeclarationSpecifierList::NO_RETURN_INSTRUCTION; }
+#line 2118 "parser.cc"
     break;
 
-  case 48:
-#line 333 "parser.yy" /* yacc.c:1646  */
-    { (yyval.integer) = -1; /* not supported, ignored */ }
-#line 2219 "parser.cc" /* yacc.c:1646  */
+  case 48: /* storage_class_specifier: REGISTER  */
+#line 381 "parser.yy"
+                    { (yyval.integer) = -1; /* not supported, ignored */ }
+#line 2124 "parser.cc"
     break;
 
-  case 49:
-#line 334 "parser.yy" /* yacc.c:1646  */
-    { (yyval.integer) = -1; /* not supported, ignored */ }
-#line 2225 "parser.cc" /* yacc.c:1646  */
+  case 49: /* storage_class_specifier: AUTO  */
+#line 382 "parser.yy"
+                    { (yyval.integer) = -1; /* not supported, ignored */ }
+#line 2130 "parser.cc"
     break;
 
-  case 50:
-#line 335 "parser.yy" /* yacc.c:1646  */
-    { (yyval.integer) = DeclarationSpecifierList::STATIC_SPEC; }
-#line 2231 "parser.cc" /* yacc.c:1646  */
+  case 50: /* storage_class_specifier: STATIC  */
+#line 383 "parser.yy"
+                    { (yyval.integer) = DeclarationSpecifierList::STATIC_SPEC; }
+#line 2136 "parser.cc"
     break;
 
-  case 51:
-#line 336 "parser.yy" /* yacc.c:1646  */
-    { (yyval.integer) = DeclarationSpecifierList::EXTERN_SPEC; }
-#line 2237 "parser.cc" /* yacc.c:1646  */
+  case 51: /* storage_class_specifier: EXTERN  */
+#line 384 "parser.yy"
+                    { (yyval.integer) = DeclarationSpecifierList::EXTERN_SPEC; }
+#line 2142 "parser.cc"
     break;
 
-  case 52:
-#line 340 "parser.yy" /* yacc.c:1646  */
-    { (yyval.typeSpecifier) = new TypeSpecifier((yyvsp[0].typeDesc), "", NULL); }
-#line 2243 "parser.cc" /* yacc.c:1646  */
+  case 52: /* type_specifier: basic_type  */
+#line 388 "parser.yy"
+                                    { (yyval.typeSpecifier) = new TypeSpecifier((yyvsp[0].typeDesc), "", NULL); }
+#line 2148 "parser.cc"
     break;
 
-  case 53:
-#line 341 "parser.yy" /* yacc.c:1646  */
-    { (yyval.typeSpecifier) = new TypeSpecifier((yyvsp[0].typeDesc), "", NULL); }
-#line 2249 "parser.cc" /* yacc.c:1646  */
+  case 53: /* type_specifier: struct_or_union_specifier  */
+#line 389 "parser.yy"
+                                    { (yyval.typeSpecifier) = new TypeSpecifier((yyvsp[0].typeDesc), "", NULL); }
+#line 2154 "parser.cc"
     break;
 
-  case 54:
-#line 342 "parser.yy" /* yacc.c:1646  */
-    { const TypeDesc *td = TranslationUnit::getTypeManager().getClassType((yyvsp[0].str), (yyvsp[-1].integer) == UNION, true);
+  case 54: /* type_specifier: struct_or_union ID  */
+#line 390 "parser.yy"
+                                    { const TypeDesc *td = TranslationUnit::getTypeManager().getClassType((yyvsp[0].str), (yyvsp[-1].integer) == UNION, true);
                                       (yyval.typeSpecifier) = new TypeSpecifier(td, "", NULL);
                                       free((yyvsp[0].str)); }
-#line 2257 "parser.cc" /* yacc.c:1646  */
+#line 2162 "parser.cc"
     break;
 
-  case 55:
-#line 345 "parser.yy" /* yacc.c:1646  */
-    { (yyval.typeSpecifier) = new TypeSpecifier((yyvsp[0].typeDesc), "", NULL); }
-#line 2263 "parser.cc" /* yacc.c:1646  */
+  case 55: /* type_specifier: struct_or_union TYPE_NAME  */
+#line 393 "parser.yy"
+                                    { (yyval.typeSpecifier) = new TypeSpecifier((yyvsp[0].typeDesc), "", NULL); }
+#line 2168 "parser.cc"
     break;
 
-  case 56:
-#line 346 "parser.yy" /* yacc.c:1646  */
-    { (yyval.typeSpecifier) = (yyvsp[0].typeSpecifier); }
-#line 2269 "parser.cc" /* yacc.c:1646  */
+  case 56: /* type_specifier: enum_specifier  */
+#line 394 "parser.yy"
+                                    { (yyval.typeSpecifier) = (yyvsp[0].typeSpecifier); }
+#line 2174 "parser.cc"
     break;
 
-  case 57:
-#line 347 "parser.yy" /* yacc.c:1646  */
-    { (yyval.typeSpecifier) = new TypeSpecifier((yyvsp[0].typeDesc), "", NULL); }
-#line 2275 "parser.cc" /* yacc.c:1646  */
+  case 57: /* type_specifier: TYPE_NAME  */
+#line 395 "parser.yy"
+                                    { (yyval.typeSpecifier) = new TypeSpecifier((yyvsp[0].typeDesc), "", NULL); }
+#line 2180 "parser.cc"
     break;
 
-  case 58:
-#line 351 "parser.yy" /* yacc.c:1646  */
-    { (yyval.integer) = DeclarationSpecifierList::CONST_QUALIFIER; }
-#line 2281 "parser.cc" /* yacc.c:1646  */
+  case 58: /* type_qualifier: CONST  */
+#line 399 "parser.yy"
+                                    { (yyval.integer) = DeclarationSpecifierList::CONST_QUALIFIER; }
+#line 2186 "parser.cc"
     break;
 
-  case 59:
-#line 352 "parser.yy" /* yacc.c:1646  */
-    { (yyval.integer) = DeclarationSpecifierList::VOLATILE_QUALIFIER; TranslationUnit::instance().warnAboutVolatile(); }
-#line 2287 "parser.cc" /* yacc.c:1646  */
+  case 59: /* type_qualifier: VOLATILE  */
+#line 400 "parser.yy"
+                                    { (yyval.integer) = DeclarationSpecifierList::VOLATILE_QUALIFIER; TranslationUnit::instance().warnAboutVolatile(); }
+#line 2192 "parser.cc"
     break;
 
-  case 60:
-#line 356 "parser.yy" /* yacc.c:1646  */
-    { (yyval.integer) = ((yyvsp[0].integer) == DeclarationSpecifierList::CONST_QUALIFIER ? CONST_BIT : VOLATILE_BIT); }
-#line 2293 "parser.cc" /* yacc.c:1646  */
+  case 60: /* type_qualifier_list: type_qualifier  */
+#line 404 "parser.yy"
+                                            { (yyval.integer) = ((yyvsp[0].integer) == DeclarationSpecifierList::CONST_QUALIFIER ? CONST_BIT : VOLATILE_BIT); }
+#line 2198 "parser.cc"
     break;
 
-  case 61:
-#line 357 "parser.yy" /* yacc.c:1646  */
-    { (yyval.integer) = (yyvsp[-1].integer) | ((yyvsp[0].integer) == DeclarationSpecifierList::CONST_QUALIFIER ? CONST_BIT : VOLATILE_BIT); }
-#line 2299 "parser.cc" /* yacc.c:1646  */
+  case 61: /* type_qualifier_list: type_qualifier_list type_qualifier  */
+#line 405 "parser.yy"
+                                            { (yyval.integer) = (yyvsp[-1].integer) | ((yyvsp[0].integer) == DeclarationSpecifierList::CONST_QUALIFIER ? CONST_BIT : VOLATILE_BIT); }
+#line 2204 "parser.cc"
     break;
 
-  case 62:
-#line 362 "parser.yy" /* yacc.c:1646  */
-    {
+  case 62: /* struct_or_union_specifier: struct_or_union ID '{' struct_declaration_list_opt '}'  */
+#line 410 "parser.yy"
+                    {
                         ClassDef *classDef = (yyvsp[-1].classDef);
                         assert(classDef);
                         classDef->setName((yyvsp[-3].str));
@@ -2312,12 +2217,12 @@ yyreduce:
                         (yyval.typeDesc) = td;
                         free((yyvsp[-3].str));
                     }
-#line 2316 "parser.cc" /* yacc.c:1646  */
+#line 2221 "parser.cc"
     break;
 
-  case 63:
-#line 375 "parser.yy" /* yacc.c:1646  */
-    {
+  case 63: /* struct_or_union_specifier: struct_or_union '{' struct_declaration_list_opt '}'  */
+#line 423 "parser.yy"
+                    {
                         string anonStructName = "AnonStruct_" + (yyvsp[-1].classDef)->getLineNo();
                         ClassDef *classDef = (yyvsp[-1].classDef);
                         assert(classDef);
@@ -2329,369 +2234,365 @@ yyreduce:
                         classDef->setTypeDesc(td);
                         (yyval.typeDesc) = td;
                     }
-#line 2333 "parser.cc" /* yacc.c:1646  */
+#line 2238 "parser.cc"
     break;
 
-  case 64:
-#line 391 "parser.yy" /* yacc.c:1646  */
-    { (yyval.integer) = STRUCT; }
-#line 2339 "parser.cc" /* yacc.c:1646  */
+  case 64: /* struct_or_union: STRUCT  */
+#line 439 "parser.yy"
+                    { (yyval.integer) = STRUCT; }
+#line 2244 "parser.cc"
     break;
 
-  case 65:
-#line 392 "parser.yy" /* yacc.c:1646  */
-    { (yyval.integer) = UNION;  }
-#line 2345 "parser.cc" /* yacc.c:1646  */
+  case 65: /* struct_or_union: UNION  */
+#line 440 "parser.yy"
+                    { (yyval.integer) = UNION;  }
+#line 2250 "parser.cc"
     break;
 
-  case 66:
-#line 397 "parser.yy" /* yacc.c:1646  */
-    {
+  case 66: /* enum_specifier: ENUM ID '{' enumerator_list comma_opt '}'  */
+#line 445 "parser.yy"
+                        {
                             const TypeDesc *td = TranslationUnit::getTypeManager().getIntType(WORD_TYPE, true);
                             (yyval.typeSpecifier) = new TypeSpecifier(td, (yyvsp[-4].str), (yyvsp[-2].enumeratorList));
                             free((yyvsp[-4].str));
                         }
-#line 2355 "parser.cc" /* yacc.c:1646  */
+#line 2260 "parser.cc"
     break;
 
-  case 67:
-#line 403 "parser.yy" /* yacc.c:1646  */
-    {
+  case 67: /* enum_specifier: ENUM '{' enumerator_list comma_opt '}'  */
+#line 451 "parser.yy"
+                        {
                             const TypeDesc *td = TranslationUnit::getTypeManager().getIntType(WORD_TYPE, true);
                             (yyval.typeSpecifier) = new TypeSpecifier(td, "", (yyvsp[-2].enumeratorList));
                         }
-#line 2364 "parser.cc" /* yacc.c:1646  */
+#line 2269 "parser.cc"
     break;
 
-  case 68:
-#line 408 "parser.yy" /* yacc.c:1646  */
-    {
+  case 68: /* enum_specifier: ENUM ID  */
+#line 456 "parser.yy"
+                        {
                             const TypeDesc *td = TranslationUnit::getTypeManager().getIntType(WORD_TYPE, true);
                             (yyval.typeSpecifier) = new TypeSpecifier(td, (yyvsp[0].str), NULL);
                             free((yyvsp[0].str));
                         }
-#line 2374 "parser.cc" /* yacc.c:1646  */
+#line 2279 "parser.cc"
     break;
 
-  case 69:
-#line 416 "parser.yy" /* yacc.c:1646  */
-    { (yyval.enumeratorList) = new vector<Enumerator *>(); (yyval.enumeratorList)->push_back((yyvsp[0].enumerator)); }
-#line 2380 "parser.cc" /* yacc.c:1646  */
+  case 69: /* enumerator_list: enumerator  */
+#line 464 "parser.yy"
+                                            { (yyval.enumeratorList) = new vector<Enumerator *>(); (yyval.enumeratorList)->push_back((yyvsp[0].enumerator)); }
+#line 2285 "parser.cc"
     break;
 
-  case 70:
-#line 417 "parser.yy" /* yacc.c:1646  */
-    { (yyval.enumeratorList) = (yyvsp[-2].enumeratorList); (yyval.enumeratorList)->push_back((yyvsp[0].enumerator)); }
-#line 2386 "parser.cc" /* yacc.c:1646  */
+  case 70: /* enumerator_list: enumerator_list ',' enumerator  */
+#line 465 "parser.yy"
+                                            { (yyval.enumeratorList) = (yyvsp[-2].enumeratorList); (yyval.enumeratorList)->push_back((yyvsp[0].enumerator)); }
+#line 2291 "parser.cc"
     break;
 
-  case 71:
-#line 421 "parser.yy" /* yacc.c:1646  */
-    { (yyval.enumerator) = new Enumerator((yyvsp[0].str), NULL, getSourceLineNo()); free((yyvsp[0].str)); }
-#line 2392 "parser.cc" /* yacc.c:1646  */
+  case 71: /* enumerator: ID  */
+#line 469 "parser.yy"
+                                            { (yyval.enumerator) = new Enumerator((yyvsp[0].str), NULL, getSourceLineNo()); free((yyvsp[0].str)); }
+#line 2297 "parser.cc"
     break;
 
-  case 72:
-#line 422 "parser.yy" /* yacc.c:1646  */
-    { (yyval.enumerator) = new Enumerator((yyvsp[-2].str), (yyvsp[0].tree),   getSourceLineNo()); free((yyvsp[-2].str)); }
-#line 2398 "parser.cc" /* yacc.c:1646  */
+  case 72: /* enumerator: ID '=' constant_expr  */
+#line 470 "parser.yy"
+                                            { (yyval.enumerator) = new Enumerator((yyvsp[-2].str), (yyvsp[0].tree),   getSourceLineNo()); free((yyvsp[-2].str)); }
+#line 2303 "parser.cc"
     break;
 
-  case 75:
-#line 431 "parser.yy" /* yacc.c:1646  */
-    { (yyval.typeDesc) = TranslationUnit::getTypeManager().getIntType(WORD_TYPE, true); }
-#line 2404 "parser.cc" /* yacc.c:1646  */
+  case 75: /* non_void_basic_type: INT  */
+#line 479 "parser.yy"
+                { (yyval.typeDesc) = TranslationUnit::getTypeManager().getIntType(WORD_TYPE, true); }
+#line 2309 "parser.cc"
     break;
 
-  case 76:
-#line 432 "parser.yy" /* yacc.c:1646  */
-    { (yyval.typeDesc) = TranslationUnit::getTypeManager().getIntType(BYTE_TYPE, true); }
-#line 2410 "parser.cc" /* yacc.c:1646  */
+  case 76: /* non_void_basic_type: CHAR  */
+#line 480 "parser.yy"
+                { (yyval.typeDesc) = TranslationUnit::getTypeManager().getIntType(BYTE_TYPE, true); }
+#line 2315 "parser.cc"
     break;
 
-  case 77:
-#line 433 "parser.yy" /* yacc.c:1646  */
-    { (yyval.typeDesc) = TranslationUnit::getTypeManager().getIntType(WORD_TYPE, true); }
-#line 2416 "parser.cc" /* yacc.c:1646  */
+  case 77: /* non_void_basic_type: SHORT  */
+#line 481 "parser.yy"
+                { (yyval.typeDesc) = TranslationUnit::getTypeManager().getIntType(WORD_TYPE, true); }
+#line 2321 "parser.cc"
     break;
 
-  case 78:
-#line 434 "parser.yy" /* yacc.c:1646  */
-    { (yyval.typeDesc) = TranslationUnit::getTypeManager().getSizelessType(true);  }
-#line 2422 "parser.cc" /* yacc.c:1646  */
+  case 78: /* non_void_basic_type: SIGNED  */
+#line 482 "parser.yy"
+                { (yyval.typeDesc) = TranslationUnit::getTypeManager().getSizelessType(true);  }
+#line 2327 "parser.cc"
     break;
 
-  case 79:
-#line 435 "parser.yy" /* yacc.c:1646  */
-    { (yyval.typeDesc) = TranslationUnit::getTypeManager().getSizelessType(false); }
-#line 2428 "parser.cc" /* yacc.c:1646  */
+  case 79: /* non_void_basic_type: UNSIGNED  */
+#line 483 "parser.yy"
+                { (yyval.typeDesc) = TranslationUnit::getTypeManager().getSizelessType(false); }
+#line 2333 "parser.cc"
     break;
 
-  case 80:
-#line 436 "parser.yy" /* yacc.c:1646  */
-    { (yyval.typeDesc) = TranslationUnit::getTypeManager().getLongType(true); }
-#line 2434 "parser.cc" /* yacc.c:1646  */
+  case 80: /* non_void_basic_type: LONG  */
+#line 484 "parser.yy"
+                { (yyval.typeDesc) = TranslationUnit::getTypeManager().getLongType(true); }
+#line 2339 "parser.cc"
     break;
 
-  case 81:
-#line 437 "parser.yy" /* yacc.c:1646  */
-    {
+  case 81: /* non_void_basic_type: FLOAT  */
+#line 485 "parser.yy"
+                {
                     TranslationUnit::instance().warnIfFloatUnsupported();
                     (yyval.typeDesc) = TranslationUnit::getTypeManager().getRealType(false);
                 }
-#line 2443 "parser.cc" /* yacc.c:1646  */
+#line 2348 "parser.cc"
     break;
 
-  case 82:
-#line 441 "parser.yy" /* yacc.c:1646  */
-    {
+  case 82: /* non_void_basic_type: DOUBLE  */
+#line 489 "parser.yy"
+                {
                     TranslationUnit::instance().warnIfFloatUnsupported();
                     (yyval.typeDesc) = TranslationUnit::getTypeManager().getRealType(false);
-                    if (!doubleTypeWarningIssued)
-                    {
-                        warnmsg("`double' is an alias for `float' for this compiler");
-                        doubleTypeWarningIssued = true;
-                    }
+                    TranslationUnit::instance().warnAboutDoubleType();
                 }
-#line 2457 "parser.cc" /* yacc.c:1646  */
+#line 2358 "parser.cc"
     break;
 
-  case 83:
-#line 453 "parser.yy" /* yacc.c:1646  */
-    { (yyval.typeDesc) = (yyvsp[0].typeDesc); }
-#line 2463 "parser.cc" /* yacc.c:1646  */
+  case 83: /* basic_type: non_void_basic_type  */
+#line 497 "parser.yy"
+                            { (yyval.typeDesc) = (yyvsp[0].typeDesc); }
+#line 2364 "parser.cc"
     break;
 
-  case 84:
-#line 454 "parser.yy" /* yacc.c:1646  */
-    { (yyval.typeDesc) = TranslationUnit::getTypeManager().getVoidType(); }
-#line 2469 "parser.cc" /* yacc.c:1646  */
+  case 84: /* basic_type: VOID  */
+#line 498 "parser.yy"
+                            { (yyval.typeDesc) = TranslationUnit::getTypeManager().getVoidType(); }
+#line 2370 "parser.cc"
     break;
 
-  case 85:
-#line 458 "parser.yy" /* yacc.c:1646  */
-    { (yyval.str) = strdup(sourceFilename.c_str()); }
-#line 2475 "parser.cc" /* yacc.c:1646  */
+  case 85: /* save_src_fn: %empty  */
+#line 502 "parser.yy"
+                                { (yyval.str) = strdup(TranslationUnit::instance().getCurrentSourceFilename().c_str()); }
+#line 2376 "parser.cc"
     break;
 
-  case 86:
-#line 462 "parser.yy" /* yacc.c:1646  */
-    { (yyval.integer) = lineno; }
-#line 2481 "parser.cc" /* yacc.c:1646  */
+  case 86: /* save_line_no: %empty  */
+#line 506 "parser.yy"
+                                { (yyval.integer) = TranslationUnit::instance().getCurrentLineNo(); }
+#line 2382 "parser.cc"
     break;
 
-  case 87:
-#line 466 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declaratorVector) = new std::vector<Declarator *>(); (yyval.declaratorVector)->push_back((yyvsp[0].declarator)); }
-#line 2487 "parser.cc" /* yacc.c:1646  */
+  case 87: /* init_declarator_list: init_declarator  */
+#line 510 "parser.yy"
+                                                { (yyval.declaratorVector) = new std::vector<Declarator *>(); (yyval.declaratorVector)->push_back((yyvsp[0].declarator)); }
+#line 2388 "parser.cc"
     break;
 
-  case 88:
-#line 467 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declaratorVector) = (yyvsp[-2].declaratorVector); (yyval.declaratorVector)->push_back((yyvsp[0].declarator)); }
-#line 2493 "parser.cc" /* yacc.c:1646  */
+  case 88: /* init_declarator_list: init_declarator_list ',' init_declarator  */
+#line 511 "parser.yy"
+                                                { (yyval.declaratorVector) = (yyvsp[-2].declaratorVector); (yyval.declaratorVector)->push_back((yyvsp[0].declarator)); }
+#line 2394 "parser.cc"
     break;
 
-  case 89:
-#line 473 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declarator) = (yyvsp[0].declarator); }
-#line 2499 "parser.cc" /* yacc.c:1646  */
+  case 89: /* init_declarator: declarator  */
+#line 517 "parser.yy"
+                                        { (yyval.declarator) = (yyvsp[0].declarator); }
+#line 2400 "parser.cc"
     break;
 
-  case 90:
-#line 474 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declarator) = (yyvsp[-2].declarator); (yyval.declarator)->setInitExpr((yyvsp[0].tree)); }
-#line 2505 "parser.cc" /* yacc.c:1646  */
+  case 90: /* init_declarator: declarator '=' initializer  */
+#line 518 "parser.yy"
+                                        { (yyval.declarator) = (yyvsp[-2].declarator); (yyval.declarator)->setInitExpr((yyvsp[0].tree)); }
+#line 2406 "parser.cc"
     break;
 
-  case 91:
-#line 478 "parser.yy" /* yacc.c:1646  */
-    {
+  case 91: /* declarator: pointer declarator  */
+#line 522 "parser.yy"
+                                        {
                                             (yyval.declarator) = (yyvsp[0].declarator);
                                             (yyval.declarator)->setPointerLevel((yyvsp[-1].typeQualifierBitFieldVector));  // ownership of $1 transfered to the Declarator
                                         }
-#line 2514 "parser.cc" /* yacc.c:1646  */
+#line 2415 "parser.cc"
     break;
 
-  case 92:
-#line 482 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declarator) = (yyvsp[0].declarator); }
-#line 2520 "parser.cc" /* yacc.c:1646  */
+  case 92: /* declarator: direct_declarator  */
+#line 526 "parser.yy"
+                                        { (yyval.declarator) = (yyvsp[0].declarator); }
+#line 2421 "parser.cc"
     break;
 
-  case 93:
-#line 487 "parser.yy" /* yacc.c:1646  */
-    {
-                (yyval.declarator) = new Declarator((yyvsp[0].str), sourceFilename, lineno);
+  case 93: /* direct_declarator: ID  */
+#line 531 "parser.yy"
+            {
+                (yyval.declarator) = newDeclarator((yyvsp[0].str));
                 free((yyvsp[0].str));
             }
-#line 2529 "parser.cc" /* yacc.c:1646  */
+#line 2430 "parser.cc"
     break;
 
-  case 94:
-#line 492 "parser.yy" /* yacc.c:1646  */
-    {
-                (yyval.declarator) = new Declarator(string(), sourceFilename, lineno);
+  case 94: /* direct_declarator: %empty  */
+#line 536 "parser.yy"
+            {
+                (yyval.declarator) = newDeclarator(string());
             }
-#line 2537 "parser.cc" /* yacc.c:1646  */
+#line 2438 "parser.cc"
     break;
 
-  case 95:
-#line 496 "parser.yy" /* yacc.c:1646  */
-    {
+  case 95: /* direct_declarator: direct_declarator '[' expr_opt ']'  */
+#line 540 "parser.yy"
+            {
                 (yyval.declarator) = (yyvsp[-3].declarator);
                 (yyval.declarator)->checkForFunctionReturningArray();
                 (yyval.declarator)->addArraySizeExpr((yyvsp[-1].tree));
             }
-#line 2547 "parser.cc" /* yacc.c:1646  */
+#line 2448 "parser.cc"
     break;
 
-  case 96:
-#line 502 "parser.yy" /* yacc.c:1646  */
-    {
+  case 96: /* direct_declarator: direct_declarator '(' parameter_type_list ')'  */
+#line 546 "parser.yy"
+            {
                 (yyval.declarator) = (yyvsp[-3].declarator);
                 (yyval.declarator)->setFormalParamList((yyvsp[-1].formalParamList));
             }
-#line 2556 "parser.cc" /* yacc.c:1646  */
+#line 2457 "parser.cc"
     break;
 
-  case 97:
-#line 507 "parser.yy" /* yacc.c:1646  */
-    {
+  case 97: /* direct_declarator: direct_declarator '(' ')'  */
+#line 551 "parser.yy"
+            {
                 (yyval.declarator) = (yyvsp[-2].declarator);
                 (yyval.declarator)->setFormalParamList(new FormalParamList());
             }
-#line 2565 "parser.cc" /* yacc.c:1646  */
+#line 2466 "parser.cc"
     break;
 
-  case 98:
-#line 512 "parser.yy" /* yacc.c:1646  */
-    {
+  case 98: /* direct_declarator: direct_declarator '(' VOID ')'  */
+#line 556 "parser.yy"
+            {
                 (yyval.declarator) = (yyvsp[-3].declarator);
                 (yyval.declarator)->setFormalParamList(new FormalParamList());
             }
-#line 2574 "parser.cc" /* yacc.c:1646  */
+#line 2475 "parser.cc"
     break;
 
-  case 99:
-#line 517 "parser.yy" /* yacc.c:1646  */
-    {
-                (yyval.declarator) = new Declarator((yyvsp[-4].str), sourceFilename, lineno);
+  case 99: /* direct_declarator: '(' '*' ID ')' '(' parameter_type_list_opt ')'  */
+#line 561 "parser.yy"
+            {
+                (yyval.declarator) = newDeclarator((yyvsp[-4].str));
                 (yyval.declarator)->setAsFunctionPointer((yyvsp[-1].formalParamList));  // takes ownership of FormalParamList
                 free((yyvsp[-4].str));
                 TranslationUnit::checkForEllipsisWithoutNamedArgument((yyvsp[-1].formalParamList));
             }
-#line 2585 "parser.cc" /* yacc.c:1646  */
+#line 2486 "parser.cc"
     break;
 
-  case 100:
-#line 524 "parser.yy" /* yacc.c:1646  */
-    {
-                (yyval.declarator) = new Declarator(string(), sourceFilename, lineno);
+  case 100: /* direct_declarator: '(' '*' ')' '(' parameter_type_list_opt ')'  */
+#line 568 "parser.yy"
+            {
+                (yyval.declarator) = newDeclarator(string());
                 (yyval.declarator)->setAsFunctionPointer((yyvsp[-1].formalParamList));  // takes ownership of FormalParamList
                 TranslationUnit::checkForEllipsisWithoutNamedArgument((yyvsp[-1].formalParamList));
             }
-#line 2595 "parser.cc" /* yacc.c:1646  */
+#line 2496 "parser.cc"
     break;
 
-  case 101:
-#line 530 "parser.yy" /* yacc.c:1646  */
-    {
-                (yyval.declarator) = new Declarator((yyvsp[-5].str), sourceFilename, lineno);
+  case 101: /* direct_declarator: '(' '*' ID subscript_list ')' '(' parameter_type_list_opt ')'  */
+#line 574 "parser.yy"
+            {
+                (yyval.declarator) = newDeclarator((yyvsp[-5].str));
                 (yyval.declarator)->setAsArrayOfFunctionPointers((yyvsp[-1].formalParamList), (yyvsp[-4].treeSequence));  // takes ownership of FormalParamList ($7), deletes $4
                 free((yyvsp[-5].str));
                 TranslationUnit::checkForEllipsisWithoutNamedArgument((yyvsp[-1].formalParamList));
             }
-#line 2606 "parser.cc" /* yacc.c:1646  */
+#line 2507 "parser.cc"
     break;
 
-  case 102:
-#line 540 "parser.yy" /* yacc.c:1646  */
-    { (yyval.treeSequence) = new TreeSequence(); (yyval.treeSequence)->addTree((yyvsp[0].tree)); }
-#line 2612 "parser.cc" /* yacc.c:1646  */
+  case 102: /* subscript_list: subscript  */
+#line 584 "parser.yy"
+                                     { (yyval.treeSequence) = new TreeSequence(); (yyval.treeSequence)->addTree((yyvsp[0].tree)); }
+#line 2513 "parser.cc"
     break;
 
-  case 103:
-#line 541 "parser.yy" /* yacc.c:1646  */
-    { (yyval.treeSequence) = (yyvsp[-1].treeSequence); (yyval.treeSequence)->addTree((yyvsp[0].tree)); }
-#line 2618 "parser.cc" /* yacc.c:1646  */
+  case 103: /* subscript_list: subscript_list subscript  */
+#line 585 "parser.yy"
+                                     { (yyval.treeSequence) = (yyvsp[-1].treeSequence); (yyval.treeSequence)->addTree((yyvsp[0].tree)); }
+#line 2519 "parser.cc"
     break;
 
-  case 104:
-#line 545 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[-1].tree); }
-#line 2624 "parser.cc" /* yacc.c:1646  */
+  case 104: /* subscript: '[' expr_opt ']'  */
+#line 589 "parser.yy"
+                                     { (yyval.tree) = (yyvsp[-1].tree); }
+#line 2525 "parser.cc"
     break;
 
-  case 105:
-#line 549 "parser.yy" /* yacc.c:1646  */
-    { (yyval.formalParamList) = new FormalParamList(); }
-#line 2630 "parser.cc" /* yacc.c:1646  */
+  case 105: /* parameter_type_list_opt: %empty  */
+#line 593 "parser.yy"
+                                     { (yyval.formalParamList) = new FormalParamList(); }
+#line 2531 "parser.cc"
     break;
 
-  case 106:
-#line 550 "parser.yy" /* yacc.c:1646  */
-    { (yyval.formalParamList) = (yyvsp[0].formalParamList); }
-#line 2636 "parser.cc" /* yacc.c:1646  */
+  case 106: /* parameter_type_list_opt: parameter_type_list  */
+#line 594 "parser.yy"
+                                     { (yyval.formalParamList) = (yyvsp[0].formalParamList); }
+#line 2537 "parser.cc"
     break;
 
-  case 107:
-#line 554 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 2642 "parser.cc" /* yacc.c:1646  */
+  case 107: /* initializer: assignment_expr  */
+#line 598 "parser.yy"
+                                     { (yyval.tree) = (yyvsp[0].tree); }
+#line 2543 "parser.cc"
     break;
 
-  case 108:
-#line 555 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[-1].treeSequence); }
-#line 2648 "parser.cc" /* yacc.c:1646  */
+  case 108: /* initializer: '{' initializer_list '}'  */
+#line 599 "parser.yy"
+                                     { (yyval.tree) = (yyvsp[-1].tree); }
+#line 2549 "parser.cc"
     break;
 
-  case 109:
-#line 556 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[-2].treeSequence); }
-#line 2654 "parser.cc" /* yacc.c:1646  */
+  case 109: /* initializer: '{' initializer_list ',' '}'  */
+#line 600 "parser.yy"
+                                     { (yyval.tree) = (yyvsp[-2].tree); }
+#line 2555 "parser.cc"
     break;
 
-  case 110:
-#line 557 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new TreeSequence(); }
-#line 2660 "parser.cc" /* yacc.c:1646  */
+  case 110: /* initializer: '{' '}'  */
+#line 601 "parser.yy"
+                    { (yyval.tree) = new TreeSequence(); }
+#line 2561 "parser.cc"
     break;
 
-  case 111:
-#line 558 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new TreeSequence(); }
-#line 2666 "parser.cc" /* yacc.c:1646  */
+  case 111: /* initializer: '{' ',' '}'  */
+#line 602 "parser.yy"
+                    { (yyval.tree) = new TreeSequence(); }
+#line 2567 "parser.cc"
     break;
 
-  case 112:
-#line 562 "parser.yy" /* yacc.c:1646  */
-    { (yyval.treeSequence) = new TreeSequence(); (yyval.treeSequence)->addTree((yyvsp[0].tree)); }
-#line 2672 "parser.cc" /* yacc.c:1646  */
+  case 112: /* initializer_list: initializer  */
+#line 606 "parser.yy"
+                                            { TreeSequence *seq = new TreeSequence(); seq->addTree((yyvsp[0].tree)); (yyval.tree) = seq; }
+#line 2573 "parser.cc"
     break;
 
-  case 113:
-#line 563 "parser.yy" /* yacc.c:1646  */
-    { (yyval.treeSequence) = (yyvsp[-2].treeSequence); (yyval.treeSequence)->addTree((yyvsp[0].tree)); }
-#line 2678 "parser.cc" /* yacc.c:1646  */
+  case 113: /* initializer_list: initializer_list ',' initializer  */
+#line 607 "parser.yy"
+                                            { (yyval.tree) = PackedInitializer::append((yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 2579 "parser.cc"
     break;
 
-  case 114:
-#line 567 "parser.yy" /* yacc.c:1646  */
-    { (yyval.classDef) = new ClassDef(); }
-#line 2684 "parser.cc" /* yacc.c:1646  */
+  case 114: /* struct_declaration_list_opt: %empty  */
+#line 611 "parser.yy"
+                                 { (yyval.classDef) = new ClassDef(); }
+#line 2585 "parser.cc"
     break;
 
-  case 115:
-#line 568 "parser.yy" /* yacc.c:1646  */
-    { (yyval.classDef) = (yyvsp[0].classDef); }
-#line 2690 "parser.cc" /* yacc.c:1646  */
+  case 115: /* struct_declaration_list_opt: struct_declaration_list  */
+#line 612 "parser.yy"
+                                 { (yyval.classDef) = (yyvsp[0].classDef); }
+#line 2591 "parser.cc"
     break;
 
-  case 116:
-#line 573 "parser.yy" /* yacc.c:1646  */
-    {
+  case 116: /* struct_declaration_list: struct_declaration  */
+#line 617 "parser.yy"
+                {
                     (yyval.classDef) = new ClassDef();
                     if ((yyvsp[0].classMemberList))
                         for (std::vector<ClassDef::ClassMember *>::iterator it = (yyvsp[0].classMemberList)->begin(); it != (yyvsp[0].classMemberList)->end(); ++it)
@@ -2700,12 +2601,12 @@ yyreduce:
                         assert(0);
                     delete (yyvsp[0].classMemberList);  // destroy the std::vector<ClassDef::ClassMember *>
                 }
-#line 2704 "parser.cc" /* yacc.c:1646  */
+#line 2605 "parser.cc"
     break;
 
-  case 117:
-#line 583 "parser.yy" /* yacc.c:1646  */
-    {
+  case 117: /* struct_declaration_list: struct_declaration_list struct_declaration  */
+#line 627 "parser.yy"
+                {
                     (yyval.classDef) = (yyvsp[-1].classDef);
                     if ((yyvsp[0].classMemberList))
                         for (std::vector<ClassDef::ClassMember *>::iterator it = (yyvsp[0].classMemberList)->begin(); it != (yyvsp[0].classMemberList)->end(); ++it)
@@ -2714,227 +2615,227 @@ yyreduce:
                         assert(0);
                     delete (yyvsp[0].classMemberList);  // destroy the std::vector<ClassDef::ClassMember *>
                 }
-#line 2718 "parser.cc" /* yacc.c:1646  */
+#line 2619 "parser.cc"
     break;
 
-  case 118:
-#line 595 "parser.yy" /* yacc.c:1646  */
-    { (yyval.classMemberList) = ClassDef::createClassMembers((yyvsp[-2].declarationSpecifierList), (yyvsp[-1].declaratorVector)); }
-#line 2724 "parser.cc" /* yacc.c:1646  */
+  case 118: /* struct_declaration: specifier_qualifier_list struct_declarator_list ';'  */
+#line 639 "parser.yy"
+                                                             { (yyval.classMemberList) = ClassDef::createClassMembers((yyvsp[-2].declarationSpecifierList), (yyvsp[-1].declaratorVector)); }
+#line 2625 "parser.cc"
     break;
 
-  case 119:
-#line 599 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declaratorVector) = new std::vector<Declarator *>(); if ((yyvsp[0].declarator)) (yyval.declaratorVector)->push_back((yyvsp[0].declarator)); }
-#line 2730 "parser.cc" /* yacc.c:1646  */
+  case 119: /* struct_declarator_list: struct_declarator  */
+#line 643 "parser.yy"
+                                                    { (yyval.declaratorVector) = new std::vector<Declarator *>(); if ((yyvsp[0].declarator)) (yyval.declaratorVector)->push_back((yyvsp[0].declarator)); }
+#line 2631 "parser.cc"
     break;
 
-  case 120:
-#line 600 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declaratorVector) = (yyvsp[-2].declaratorVector); if ((yyvsp[0].declarator)) (yyval.declaratorVector)->push_back((yyvsp[0].declarator)); }
-#line 2736 "parser.cc" /* yacc.c:1646  */
+  case 120: /* struct_declarator_list: struct_declarator_list ',' struct_declarator  */
+#line 644 "parser.yy"
+                                                    { (yyval.declaratorVector) = (yyvsp[-2].declaratorVector); if ((yyvsp[0].declarator)) (yyval.declaratorVector)->push_back((yyvsp[0].declarator)); }
+#line 2637 "parser.cc"
     break;
 
-  case 121:
-#line 605 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declarator) = (yyvsp[0].declarator); }
-#line 2742 "parser.cc" /* yacc.c:1646  */
+  case 121: /* struct_declarator: declarator  */
+#line 649 "parser.yy"
+                                        { (yyval.declarator) = (yyvsp[0].declarator); }
+#line 2643 "parser.cc"
     break;
 
-  case 122:
-#line 606 "parser.yy" /* yacc.c:1646  */
-    { (yyval.declarator) = NULL; }
-#line 2748 "parser.cc" /* yacc.c:1646  */
+  case 122: /* struct_declarator: ':' conditional_expr  */
+#line 650 "parser.yy"
+                                        { (yyval.declarator) = NULL; }
+#line 2649 "parser.cc"
     break;
 
-  case 123:
-#line 608 "parser.yy" /* yacc.c:1646  */
-    {
+  case 123: /* struct_declarator: declarator ':' conditional_expr  */
+#line 652 "parser.yy"
+                {
                     (yyval.declarator) = (yyvsp[-2].declarator);
                     (yyval.declarator)->setBitFieldWidth(*(yyvsp[0].tree));  // emits error if $3 is not constant expression
                     delete (yyvsp[0].tree);
                 }
-#line 2758 "parser.cc" /* yacc.c:1646  */
+#line 2659 "parser.cc"
     break;
 
-  case 124:
-#line 616 "parser.yy" /* yacc.c:1646  */
-    { (yyval.compoundStmt) = new CompoundStmt(); if ((yyvsp[0].tree) != NULL) (yyval.compoundStmt)->addTree((yyvsp[0].tree)); }
-#line 2764 "parser.cc" /* yacc.c:1646  */
+  case 124: /* stmt_list: stmt  */
+#line 660 "parser.yy"
+                        { (yyval.compoundStmt) = new CompoundStmt(); if ((yyvsp[0].tree) != NULL) (yyval.compoundStmt)->addTree((yyvsp[0].tree)); }
+#line 2665 "parser.cc"
     break;
 
-  case 125:
-#line 617 "parser.yy" /* yacc.c:1646  */
-    { (yyval.compoundStmt) = (yyvsp[-1].compoundStmt); if ((yyvsp[0].tree) != NULL) (yyval.compoundStmt)->addTree((yyvsp[0].tree)); }
-#line 2770 "parser.cc" /* yacc.c:1646  */
+  case 125: /* stmt_list: stmt_list stmt  */
+#line 661 "parser.yy"
+                        { (yyval.compoundStmt) = (yyvsp[-1].compoundStmt); if ((yyvsp[0].tree) != NULL) (yyval.compoundStmt)->addTree((yyvsp[0].tree)); }
+#line 2671 "parser.cc"
     break;
 
-  case 126:
-#line 621 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 2776 "parser.cc" /* yacc.c:1646  */
+  case 126: /* stmt: expr_stmt  */
+#line 665 "parser.yy"
+                        { (yyval.tree) = (yyvsp[0].tree); }
+#line 2677 "parser.cc"
     break;
 
-  case 127:
-#line 622 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = ((yyvsp[0].declarationSequence) ? (yyvsp[0].declarationSequence) : new TreeSequence()); }
-#line 2782 "parser.cc" /* yacc.c:1646  */
+  case 127: /* stmt: declaration  */
+#line 666 "parser.yy"
+                        { (yyval.tree) = ((yyvsp[0].declarationSequence) ? (yyvsp[0].declarationSequence) : new TreeSequence()); }
+#line 2683 "parser.cc"
     break;
 
-  case 128:
-#line 623 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].compoundStmt); }
-#line 2788 "parser.cc" /* yacc.c:1646  */
+  case 128: /* stmt: compound_stmt  */
+#line 667 "parser.yy"
+                        { (yyval.tree) = (yyvsp[0].compoundStmt); }
+#line 2689 "parser.cc"
     break;
 
-  case 129:
-#line 624 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 2794 "parser.cc" /* yacc.c:1646  */
+  case 129: /* stmt: selection_stmt  */
+#line 668 "parser.yy"
+                        { (yyval.tree) = (yyvsp[0].tree); }
+#line 2695 "parser.cc"
     break;
 
-  case 130:
-#line 625 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 2800 "parser.cc" /* yacc.c:1646  */
+  case 130: /* stmt: labeled_stmt  */
+#line 669 "parser.yy"
+                        { (yyval.tree) = (yyvsp[0].tree); }
+#line 2701 "parser.cc"
     break;
 
-  case 131:
-#line 626 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 2806 "parser.cc" /* yacc.c:1646  */
+  case 131: /* stmt: while_stmt  */
+#line 670 "parser.yy"
+                        { (yyval.tree) = (yyvsp[0].tree); }
+#line 2707 "parser.cc"
     break;
 
-  case 132:
-#line 627 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 2812 "parser.cc" /* yacc.c:1646  */
+  case 132: /* stmt: do_while_stmt  */
+#line 671 "parser.yy"
+                        { (yyval.tree) = (yyvsp[0].tree); }
+#line 2713 "parser.cc"
     break;
 
-  case 133:
-#line 628 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 2818 "parser.cc" /* yacc.c:1646  */
+  case 133: /* stmt: for_stmt  */
+#line 672 "parser.yy"
+                        { (yyval.tree) = (yyvsp[0].tree); }
+#line 2719 "parser.cc"
     break;
 
-  case 134:
-#line 629 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new JumpStmt((yyvsp[-1].str)); free((yyvsp[-1].str)); }
-#line 2824 "parser.cc" /* yacc.c:1646  */
+  case 134: /* stmt: GOTO ID ';'  */
+#line 673 "parser.yy"
+                        { (yyval.tree) = new JumpStmt((yyvsp[-1].str)); free((yyvsp[-1].str)); }
+#line 2725 "parser.cc"
     break;
 
-  case 135:
-#line 630 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new JumpStmt(JumpStmt::BRK, NULL); }
-#line 2830 "parser.cc" /* yacc.c:1646  */
+  case 135: /* stmt: BREAK ';'  */
+#line 674 "parser.yy"
+                        { (yyval.tree) = new JumpStmt(JumpStmt::BRK, NULL); }
+#line 2731 "parser.cc"
     break;
 
-  case 136:
-#line 631 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new JumpStmt(JumpStmt::CONT, NULL); }
-#line 2836 "parser.cc" /* yacc.c:1646  */
+  case 136: /* stmt: CONTINUE ';'  */
+#line 675 "parser.yy"
+                        { (yyval.tree) = new JumpStmt(JumpStmt::CONT, NULL); }
+#line 2737 "parser.cc"
     break;
 
-  case 137:
-#line 632 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new JumpStmt(JumpStmt::RET, NULL); }
-#line 2842 "parser.cc" /* yacc.c:1646  */
+  case 137: /* stmt: RETURN ';'  */
+#line 676 "parser.yy"
+                        { (yyval.tree) = new JumpStmt(JumpStmt::RET, NULL); }
+#line 2743 "parser.cc"
     break;
 
-  case 138:
-#line 633 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new JumpStmt(JumpStmt::RET, (yyvsp[-1].tree)); }
-#line 2848 "parser.cc" /* yacc.c:1646  */
+  case 138: /* stmt: RETURN expr ';'  */
+#line 677 "parser.yy"
+                        { (yyval.tree) = new JumpStmt(JumpStmt::RET, (yyvsp[-1].tree)); }
+#line 2749 "parser.cc"
     break;
 
-  case 139:
-#line 635 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new AssemblerStmt((yyvsp[-4].str), (yyvsp[-2].str), true);
+  case 139: /* stmt: ASM '(' STRLIT ',' ID ')' ';'  */
+#line 679 "parser.yy"
+                        { (yyval.tree) = new AssemblerStmt((yyvsp[-4].str), (yyvsp[-2].str), true);
                           free((yyvsp[-4].str)); free((yyvsp[-2].str)); }
-#line 2855 "parser.cc" /* yacc.c:1646  */
+#line 2756 "parser.cc"
     break;
 
-  case 140:
-#line 638 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new AssemblerStmt((yyvsp[-4].str), (yyvsp[-2].str), false);
+  case 140: /* stmt: ASM '(' STRLIT ',' STRLIT ')' ';'  */
+#line 682 "parser.yy"
+                        { (yyval.tree) = new AssemblerStmt((yyvsp[-4].str), (yyvsp[-2].str), false);
                           free((yyvsp[-4].str)); free((yyvsp[-2].str)); }
-#line 2862 "parser.cc" /* yacc.c:1646  */
+#line 2763 "parser.cc"
     break;
 
-  case 141:
-#line 641 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new AssemblerStmt((yyvsp[-2].str), "", false);
+  case 141: /* stmt: ASM '(' STRLIT ')' ';'  */
+#line 685 "parser.yy"
+                        { (yyval.tree) = new AssemblerStmt((yyvsp[-2].str), "", false);
                           free((yyvsp[-2].str)); }
-#line 2869 "parser.cc" /* yacc.c:1646  */
+#line 2770 "parser.cc"
     break;
 
-  case 142:
-#line 643 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new AssemblerStmt(yytext); }
-#line 2875 "parser.cc" /* yacc.c:1646  */
+  case 142: /* stmt: VERBATIM_ASM  */
+#line 687 "parser.yy"
+                        { (yyval.tree) = new AssemblerStmt(yyget_text(scanner)); }
+#line 2776 "parser.cc"
     break;
 
-  case 143:
-#line 648 "parser.yy" /* yacc.c:1646  */
-    {
+  case 143: /* labeled_stmt: ID save_src_fn save_line_no ':' stmt  */
+#line 692 "parser.yy"
+                                    {
                                       (yyval.tree) = new LabeledStmt((yyvsp[-4].str), TranslationUnit::instance().generateLabel('L'), (yyvsp[0].tree));
                                       (yyval.tree)->setLineNo((yyvsp[-3].str), (yyvsp[-2].integer));
                                       free((yyvsp[-4].str)); free((yyvsp[-3].str));
                                     }
-#line 2885 "parser.cc" /* yacc.c:1646  */
+#line 2786 "parser.cc"
     break;
 
-  case 144:
-#line 653 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new LabeledStmt((yyvsp[-2].tree), (yyvsp[0].tree)); }
-#line 2891 "parser.cc" /* yacc.c:1646  */
+  case 144: /* labeled_stmt: CASE constant_expr ':' stmt  */
+#line 697 "parser.yy"
+                                        { (yyval.tree) = new LabeledStmt((yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 2792 "parser.cc"
     break;
 
-  case 145:
-#line 654 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new LabeledStmt((yyvsp[0].tree)); }
-#line 2897 "parser.cc" /* yacc.c:1646  */
+  case 145: /* labeled_stmt: DEFAULT ':' stmt  */
+#line 698 "parser.yy"
+                                        { (yyval.tree) = new LabeledStmt((yyvsp[0].tree)); }
+#line 2798 "parser.cc"
     break;
 
-  case 146:
-#line 658 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 2903 "parser.cc" /* yacc.c:1646  */
+  case 146: /* constant_expr: conditional_expr  */
+#line 702 "parser.yy"
+                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 2804 "parser.cc"
     break;
 
-  case 147:
-#line 662 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new TreeSequence(); }
-#line 2909 "parser.cc" /* yacc.c:1646  */
+  case 147: /* expr_stmt: ';'  */
+#line 706 "parser.yy"
+                                { (yyval.tree) = new TreeSequence(); }
+#line 2810 "parser.cc"
     break;
 
-  case 148:
-#line 663 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[-1].tree); }
-#line 2915 "parser.cc" /* yacc.c:1646  */
+  case 148: /* expr_stmt: expr ';'  */
+#line 707 "parser.yy"
+                                { (yyval.tree) = (yyvsp[-1].tree); }
+#line 2816 "parser.cc"
     break;
 
-  case 149:
-#line 667 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = NULL; }
-#line 2921 "parser.cc" /* yacc.c:1646  */
+  case 149: /* expr_opt: %empty  */
+#line 711 "parser.yy"
+                                { (yyval.tree) = NULL; }
+#line 2822 "parser.cc"
     break;
 
-  case 150:
-#line 668 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 2927 "parser.cc" /* yacc.c:1646  */
+  case 150: /* expr_opt: expr  */
+#line 712 "parser.yy"
+                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 2828 "parser.cc"
     break;
 
-  case 151:
-#line 672 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 2933 "parser.cc" /* yacc.c:1646  */
+  case 151: /* expr: assignment_expr  */
+#line 716 "parser.yy"
+                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 2834 "parser.cc"
     break;
 
-  case 152:
-#line 673 "parser.yy" /* yacc.c:1646  */
-    {
+  case 152: /* expr: expr ',' assignment_expr  */
+#line 717 "parser.yy"
+                                {
                                     Tree *left = (yyvsp[-2].tree);
                                     Tree *right = (yyvsp[0].tree);
                                     if (CommaExpr *ts = dynamic_cast<CommaExpr *>(left))
@@ -2945,314 +2846,314 @@ yyreduce:
                                     else
                                         (yyval.tree) = new CommaExpr(left, right);
                                 }
-#line 2949 "parser.cc" /* yacc.c:1646  */
+#line 2850 "parser.cc"
     break;
 
-  case 153:
-#line 687 "parser.yy" /* yacc.c:1646  */
-    { (yyval.treeSequence) = new TreeSequence(); (yyval.treeSequence)->addTree((yyvsp[0].tree)); }
-#line 2955 "parser.cc" /* yacc.c:1646  */
+  case 153: /* arg_expr_list: assignment_expr  */
+#line 731 "parser.yy"
+                                            { (yyval.treeSequence) = new TreeSequence(); (yyval.treeSequence)->addTree((yyvsp[0].tree)); }
+#line 2856 "parser.cc"
     break;
 
-  case 154:
-#line 688 "parser.yy" /* yacc.c:1646  */
-    { (yyvsp[-2].treeSequence)->addTree((yyvsp[0].tree)); (yyval.treeSequence) = (yyvsp[-2].treeSequence); }
-#line 2961 "parser.cc" /* yacc.c:1646  */
+  case 154: /* arg_expr_list: arg_expr_list ',' assignment_expr  */
+#line 732 "parser.yy"
+                                            { (yyvsp[-2].treeSequence)->addTree((yyvsp[0].tree)); (yyval.treeSequence) = (yyvsp[-2].treeSequence); }
+#line 2862 "parser.cc"
     break;
 
-  case 155:
-#line 692 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 2967 "parser.cc" /* yacc.c:1646  */
+  case 155: /* assignment_expr: conditional_expr  */
+#line 736 "parser.yy"
+                                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 2868 "parser.cc"
     break;
 
-  case 156:
-#line 698 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new BinaryOpExpr((yyvsp[-1].binop), (yyvsp[-4].tree), (yyvsp[0].tree)); free((yyvsp[-3].str)); }
-#line 2973 "parser.cc" /* yacc.c:1646  */
+  case 156: /* assignment_expr: cast_expr save_src_fn save_line_no assignment_op assignment_expr  */
+#line 742 "parser.yy"
+                { (yyval.tree) = new BinaryOpExpr((yyvsp[-1].binop), (yyvsp[-4].tree), (yyvsp[0].tree)); free((yyvsp[-3].str)); }
+#line 2874 "parser.cc"
     break;
 
-  case 157:
-#line 702 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::ASSIGNMENT; }
-#line 2979 "parser.cc" /* yacc.c:1646  */
+  case 157: /* assignment_op: '='  */
+#line 746 "parser.yy"
+                                                { (yyval.binop) = BinaryOpExpr::ASSIGNMENT; }
+#line 2880 "parser.cc"
     break;
 
-  case 158:
-#line 703 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::INC_ASSIGN; }
-#line 2985 "parser.cc" /* yacc.c:1646  */
+  case 158: /* assignment_op: PLUS_EQUALS  */
+#line 747 "parser.yy"
+                                                { (yyval.binop) = BinaryOpExpr::INC_ASSIGN; }
+#line 2886 "parser.cc"
     break;
 
-  case 159:
-#line 704 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::DEC_ASSIGN; }
-#line 2991 "parser.cc" /* yacc.c:1646  */
+  case 159: /* assignment_op: MINUS_EQUALS  */
+#line 748 "parser.yy"
+                                                { (yyval.binop) = BinaryOpExpr::DEC_ASSIGN; }
+#line 2892 "parser.cc"
     break;
 
-  case 160:
-#line 705 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::MUL_ASSIGN; }
-#line 2997 "parser.cc" /* yacc.c:1646  */
+  case 160: /* assignment_op: ASTERISK_EQUALS  */
+#line 749 "parser.yy"
+                                                { (yyval.binop) = BinaryOpExpr::MUL_ASSIGN; }
+#line 2898 "parser.cc"
     break;
 
-  case 161:
-#line 706 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::DIV_ASSIGN; }
-#line 3003 "parser.cc" /* yacc.c:1646  */
+  case 161: /* assignment_op: SLASH_EQUALS  */
+#line 750 "parser.yy"
+                                                { (yyval.binop) = BinaryOpExpr::DIV_ASSIGN; }
+#line 2904 "parser.cc"
     break;
 
-  case 162:
-#line 707 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::MOD_ASSIGN; }
-#line 3009 "parser.cc" /* yacc.c:1646  */
+  case 162: /* assignment_op: PERCENT_EQUALS  */
+#line 751 "parser.yy"
+                                                { (yyval.binop) = BinaryOpExpr::MOD_ASSIGN; }
+#line 2910 "parser.cc"
     break;
 
-  case 163:
-#line 708 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::XOR_ASSIGN; }
-#line 3015 "parser.cc" /* yacc.c:1646  */
+  case 163: /* assignment_op: CARET_EQUALS  */
+#line 752 "parser.yy"
+                                                { (yyval.binop) = BinaryOpExpr::XOR_ASSIGN; }
+#line 2916 "parser.cc"
     break;
 
-  case 164:
-#line 709 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::AND_ASSIGN; }
-#line 3021 "parser.cc" /* yacc.c:1646  */
+  case 164: /* assignment_op: AMP_EQUALS  */
+#line 753 "parser.yy"
+                                                { (yyval.binop) = BinaryOpExpr::AND_ASSIGN; }
+#line 2922 "parser.cc"
     break;
 
-  case 165:
-#line 710 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::OR_ASSIGN; }
-#line 3027 "parser.cc" /* yacc.c:1646  */
+  case 165: /* assignment_op: PIPE_EQUALS  */
+#line 754 "parser.yy"
+                                                { (yyval.binop) = BinaryOpExpr::OR_ASSIGN; }
+#line 2928 "parser.cc"
     break;
 
-  case 166:
-#line 711 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::LEFT_ASSIGN; }
-#line 3033 "parser.cc" /* yacc.c:1646  */
+  case 166: /* assignment_op: LT_LT_EQUALS  */
+#line 755 "parser.yy"
+                                                { (yyval.binop) = BinaryOpExpr::LEFT_ASSIGN; }
+#line 2934 "parser.cc"
     break;
 
-  case 167:
-#line 712 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::RIGHT_ASSIGN; }
-#line 3039 "parser.cc" /* yacc.c:1646  */
+  case 167: /* assignment_op: GT_GT_EQUALS  */
+#line 756 "parser.yy"
+                                                { (yyval.binop) = BinaryOpExpr::RIGHT_ASSIGN; }
+#line 2940 "parser.cc"
     break;
 
-  case 168:
-#line 716 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 3045 "parser.cc" /* yacc.c:1646  */
+  case 168: /* conditional_expr: logical_or_expr  */
+#line 760 "parser.yy"
+                                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 2946 "parser.cc"
     break;
 
-  case 169:
-#line 718 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new ConditionalExpr((yyvsp[-4].tree), (yyvsp[-2].tree), (yyvsp[0].tree)); }
-#line 3051 "parser.cc" /* yacc.c:1646  */
+  case 169: /* conditional_expr: logical_or_expr '?' expr ':' conditional_expr  */
+#line 762 "parser.yy"
+                                                { (yyval.tree) = new ConditionalExpr((yyvsp[-4].tree), (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 2952 "parser.cc"
     break;
 
-  case 170:
-#line 722 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 3057 "parser.cc" /* yacc.c:1646  */
+  case 170: /* logical_or_expr: logical_and_expr  */
+#line 766 "parser.yy"
+                                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 2958 "parser.cc"
     break;
 
-  case 171:
-#line 724 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new BinaryOpExpr(BinaryOpExpr::LOGICAL_OR, (yyvsp[-2].tree), (yyvsp[0].tree)); }
-#line 3063 "parser.cc" /* yacc.c:1646  */
+  case 171: /* logical_or_expr: logical_or_expr PIPE_PIPE logical_and_expr  */
+#line 768 "parser.yy"
+                { (yyval.tree) = new BinaryOpExpr(BinaryOpExpr::LOGICAL_OR, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 2964 "parser.cc"
     break;
 
-  case 172:
-#line 728 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 3069 "parser.cc" /* yacc.c:1646  */
+  case 172: /* logical_and_expr: inclusive_or_expr  */
+#line 772 "parser.yy"
+                                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 2970 "parser.cc"
     break;
 
-  case 173:
-#line 730 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new BinaryOpExpr(BinaryOpExpr::LOGICAL_AND, (yyvsp[-2].tree), (yyvsp[0].tree)); }
-#line 3075 "parser.cc" /* yacc.c:1646  */
+  case 173: /* logical_and_expr: logical_and_expr AMP_AMP inclusive_or_expr  */
+#line 774 "parser.yy"
+                { (yyval.tree) = new BinaryOpExpr(BinaryOpExpr::LOGICAL_AND, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 2976 "parser.cc"
     break;
 
-  case 174:
-#line 734 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 3081 "parser.cc" /* yacc.c:1646  */
+  case 174: /* inclusive_or_expr: exclusive_or_expr  */
+#line 778 "parser.yy"
+                                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 2982 "parser.cc"
     break;
 
-  case 175:
-#line 736 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new BinaryOpExpr(BinaryOpExpr::BITWISE_OR, (yyvsp[-2].tree), (yyvsp[0].tree)); }
-#line 3087 "parser.cc" /* yacc.c:1646  */
+  case 175: /* inclusive_or_expr: inclusive_or_expr '|' exclusive_or_expr  */
+#line 780 "parser.yy"
+                { (yyval.tree) = newBinaryOpExpr(BinaryOpExpr::BITWISE_OR, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 2988 "parser.cc"
     break;
 
-  case 176:
-#line 739 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 3093 "parser.cc" /* yacc.c:1646  */
+  case 176: /* exclusive_or_expr: and_expr  */
+#line 783 "parser.yy"
+                                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 2994 "parser.cc"
     break;
 
-  case 177:
-#line 741 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new BinaryOpExpr(BinaryOpExpr::BITWISE_XOR, (yyvsp[-2].tree), (yyvsp[0].tree)); }
-#line 3099 "parser.cc" /* yacc.c:1646  */
+  case 177: /* exclusive_or_expr: exclusive_or_expr '^' and_expr  */
+#line 785 "parser.yy"
+                { (yyval.tree) = newBinaryOpExpr(BinaryOpExpr::BITWISE_XOR, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 3000 "parser.cc"
     break;
 
-  case 178:
-#line 744 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 3105 "parser.cc" /* yacc.c:1646  */
+  case 178: /* and_expr: equality_expr  */
+#line 788 "parser.yy"
+                                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 3006 "parser.cc"
     break;
 
-  case 179:
-#line 746 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new BinaryOpExpr(BinaryOpExpr::BITWISE_AND, (yyvsp[-2].tree), (yyvsp[0].tree)); }
-#line 3111 "parser.cc" /* yacc.c:1646  */
+  case 179: /* and_expr: and_expr '&' equality_expr  */
+#line 790 "parser.yy"
+                { (yyval.tree) = newBinaryOpExpr(BinaryOpExpr::BITWISE_AND, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 3012 "parser.cc"
     break;
 
-  case 180:
-#line 749 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 3117 "parser.cc" /* yacc.c:1646  */
+  case 180: /* equality_expr: rel_expr  */
+#line 793 "parser.yy"
+                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 3018 "parser.cc"
     break;
 
-  case 181:
-#line 751 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new BinaryOpExpr((yyvsp[-1].binop), (yyvsp[-2].tree), (yyvsp[0].tree)); }
-#line 3123 "parser.cc" /* yacc.c:1646  */
+  case 181: /* equality_expr: equality_expr equality_op rel_expr  */
+#line 795 "parser.yy"
+                                { (yyval.tree) = new BinaryOpExpr((yyvsp[-1].binop), (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 3024 "parser.cc"
     break;
 
-  case 182:
-#line 755 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::EQUALITY; }
-#line 3129 "parser.cc" /* yacc.c:1646  */
+  case 182: /* equality_op: EQUALS_EQUALS  */
+#line 799 "parser.yy"
+                                { (yyval.binop) = BinaryOpExpr::EQUALITY; }
+#line 3030 "parser.cc"
     break;
 
-  case 183:
-#line 756 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::INEQUALITY; }
-#line 3135 "parser.cc" /* yacc.c:1646  */
+  case 183: /* equality_op: BANG_EQUALS  */
+#line 800 "parser.yy"
+                                { (yyval.binop) = BinaryOpExpr::INEQUALITY; }
+#line 3036 "parser.cc"
     break;
 
-  case 184:
-#line 760 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 3141 "parser.cc" /* yacc.c:1646  */
+  case 184: /* rel_expr: shift_expr  */
+#line 804 "parser.yy"
+                                        { (yyval.tree) = (yyvsp[0].tree); }
+#line 3042 "parser.cc"
     break;
 
-  case 185:
-#line 761 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new BinaryOpExpr((yyvsp[-1].binop), (yyvsp[-2].tree), (yyvsp[0].tree)); }
-#line 3147 "parser.cc" /* yacc.c:1646  */
+  case 185: /* rel_expr: rel_expr rel_op shift_expr  */
+#line 805 "parser.yy"
+                                        { (yyval.tree) = new BinaryOpExpr((yyvsp[-1].binop), (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 3048 "parser.cc"
     break;
 
-  case 186:
-#line 765 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 3153 "parser.cc" /* yacc.c:1646  */
+  case 186: /* shift_expr: add_expr  */
+#line 809 "parser.yy"
+                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 3054 "parser.cc"
     break;
 
-  case 187:
-#line 766 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new BinaryOpExpr(
+  case 187: /* shift_expr: shift_expr LT_LT add_expr  */
+#line 810 "parser.yy"
+                                { (yyval.tree) = newBinaryOpExpr(
                                         BinaryOpExpr::LEFT_SHIFT, (yyvsp[-2].tree), (yyvsp[0].tree)); }
-#line 3160 "parser.cc" /* yacc.c:1646  */
+#line 3061 "parser.cc"
     break;
 
-  case 188:
-#line 768 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new BinaryOpExpr(
+  case 188: /* shift_expr: shift_expr GT_GT add_expr  */
+#line 812 "parser.yy"
+                                { (yyval.tree) = newBinaryOpExpr(
                                         BinaryOpExpr::RIGHT_SHIFT, (yyvsp[-2].tree), (yyvsp[0].tree)); }
-#line 3167 "parser.cc" /* yacc.c:1646  */
+#line 3068 "parser.cc"
     break;
 
-  case 189:
-#line 773 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::INFERIOR; }
-#line 3173 "parser.cc" /* yacc.c:1646  */
+  case 189: /* rel_op: '<'  */
+#line 817 "parser.yy"
+                                { (yyval.binop) = BinaryOpExpr::INFERIOR; }
+#line 3074 "parser.cc"
     break;
 
-  case 190:
-#line 774 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::INFERIOR_OR_EQUAL; }
-#line 3179 "parser.cc" /* yacc.c:1646  */
+  case 190: /* rel_op: LOWER_EQUALS  */
+#line 818 "parser.yy"
+                                { (yyval.binop) = BinaryOpExpr::INFERIOR_OR_EQUAL; }
+#line 3080 "parser.cc"
     break;
 
-  case 191:
-#line 775 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::SUPERIOR; }
-#line 3185 "parser.cc" /* yacc.c:1646  */
+  case 191: /* rel_op: '>'  */
+#line 819 "parser.yy"
+                                { (yyval.binop) = BinaryOpExpr::SUPERIOR; }
+#line 3086 "parser.cc"
     break;
 
-  case 192:
-#line 776 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::SUPERIOR_OR_EQUAL; }
-#line 3191 "parser.cc" /* yacc.c:1646  */
+  case 192: /* rel_op: GREATER_EQUALS  */
+#line 820 "parser.yy"
+                                { (yyval.binop) = BinaryOpExpr::SUPERIOR_OR_EQUAL; }
+#line 3092 "parser.cc"
     break;
 
-  case 193:
-#line 780 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 3197 "parser.cc" /* yacc.c:1646  */
+  case 193: /* add_expr: mul_expr  */
+#line 824 "parser.yy"
+                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 3098 "parser.cc"
     break;
 
-  case 194:
-#line 781 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new BinaryOpExpr((yyvsp[-1].binop), (yyvsp[-2].tree), (yyvsp[0].tree)); }
-#line 3203 "parser.cc" /* yacc.c:1646  */
+  case 194: /* add_expr: add_expr add_op mul_expr  */
+#line 825 "parser.yy"
+                                { (yyval.tree) = newBinaryOpExpr((yyvsp[-1].binop), (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 3104 "parser.cc"
     break;
 
-  case 195:
-#line 785 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::ADD; }
-#line 3209 "parser.cc" /* yacc.c:1646  */
+  case 195: /* add_op: '+'  */
+#line 829 "parser.yy"
+                                { (yyval.binop) = BinaryOpExpr::ADD; }
+#line 3110 "parser.cc"
     break;
 
-  case 196:
-#line 786 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::SUB; }
-#line 3215 "parser.cc" /* yacc.c:1646  */
+  case 196: /* add_op: '-'  */
+#line 830 "parser.yy"
+                                { (yyval.binop) = BinaryOpExpr::SUB; }
+#line 3116 "parser.cc"
     break;
 
-  case 197:
-#line 790 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 3221 "parser.cc" /* yacc.c:1646  */
+  case 197: /* mul_expr: cast_expr  */
+#line 834 "parser.yy"
+                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 3122 "parser.cc"
     break;
 
-  case 198:
-#line 791 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new BinaryOpExpr((yyvsp[-1].binop), (yyvsp[-2].tree), (yyvsp[0].tree)); }
-#line 3227 "parser.cc" /* yacc.c:1646  */
+  case 198: /* mul_expr: mul_expr mul_op cast_expr  */
+#line 835 "parser.yy"
+                                { (yyval.tree) = newBinaryOpExpr((yyvsp[-1].binop), (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 3128 "parser.cc"
     break;
 
-  case 199:
-#line 795 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::MUL; }
-#line 3233 "parser.cc" /* yacc.c:1646  */
+  case 199: /* mul_op: '*'  */
+#line 839 "parser.yy"
+                                { (yyval.binop) = BinaryOpExpr::MUL; }
+#line 3134 "parser.cc"
     break;
 
-  case 200:
-#line 796 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::DIV; }
-#line 3239 "parser.cc" /* yacc.c:1646  */
+  case 200: /* mul_op: '/'  */
+#line 840 "parser.yy"
+                                { (yyval.binop) = BinaryOpExpr::DIV; }
+#line 3140 "parser.cc"
     break;
 
-  case 201:
-#line 797 "parser.yy" /* yacc.c:1646  */
-    { (yyval.binop) = BinaryOpExpr::MOD; }
-#line 3245 "parser.cc" /* yacc.c:1646  */
+  case 201: /* mul_op: '%'  */
+#line 841 "parser.yy"
+                                { (yyval.binop) = BinaryOpExpr::MOD; }
+#line 3146 "parser.cc"
     break;
 
-  case 202:
-#line 801 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 3251 "parser.cc" /* yacc.c:1646  */
+  case 202: /* unary_expr: postfix_expr  */
+#line 845 "parser.yy"
+                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 3152 "parser.cc"
     break;
 
-  case 203:
-#line 802 "parser.yy" /* yacc.c:1646  */
-    {
+  case 203: /* unary_expr: unary_op cast_expr  */
+#line 846 "parser.yy"
+                                {
                                     RealConstantExpr *rce;
                                     DWordConstantExpr *dwce;
                                     if ((yyvsp[-1].unop) == UnaryOpExpr::NEG && (rce = dynamic_cast<RealConstantExpr *>((yyvsp[0].tree))) != NULL)
@@ -3267,145 +3168,151 @@ yyreduce:
                                         dwce->negateValue();
                                         (yyval.tree) = dwce;
                                     }
+                                    else if ((yyvsp[-1].unop) == UnaryOpExpr::BITWISE_NOT && (dwce = dynamic_cast<DWordConstantExpr *>((yyvsp[0].tree))) != NULL)
+                                    {
+                                        // ~x is -1 - x.
+                                        (yyval.tree) = newBinaryOpExpr(BinaryOpExpr::SUB, new DWordConstantExpr(-1, dwce->isSigned()), dwce);
+                                    }
                                     else
                                     {
                                         (yyval.tree) = new UnaryOpExpr((yyvsp[-1].unop), (yyvsp[0].tree));
                                     }
                                 }
-#line 3276 "parser.cc" /* yacc.c:1646  */
+#line 3182 "parser.cc"
     break;
 
-  case 204:
-#line 822 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new UnaryOpExpr(UnaryOpExpr::PREINC, (yyvsp[0].tree)); }
-#line 3282 "parser.cc" /* yacc.c:1646  */
+  case 204: /* unary_expr: PLUS_PLUS unary_expr  */
+#line 871 "parser.yy"
+                                { (yyval.tree) = new UnaryOpExpr(UnaryOpExpr::PREINC, (yyvsp[0].tree)); }
+#line 3188 "parser.cc"
     break;
 
-  case 205:
-#line 823 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new UnaryOpExpr(UnaryOpExpr::PREDEC, (yyvsp[0].tree)); }
-#line 3288 "parser.cc" /* yacc.c:1646  */
+  case 205: /* unary_expr: MINUS_MINUS unary_expr  */
+#line 872 "parser.yy"
+                                { (yyval.tree) = new UnaryOpExpr(UnaryOpExpr::PREDEC, (yyvsp[0].tree)); }
+#line 3194 "parser.cc"
     break;
 
-  case 206:
-#line 824 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new UnaryOpExpr((yyvsp[-1].typeDesc)); }
-#line 3294 "parser.cc" /* yacc.c:1646  */
+  case 206: /* unary_expr: SIZEOF '(' type_name ')'  */
+#line 873 "parser.yy"
+                                { (yyval.tree) = new UnaryOpExpr((yyvsp[-1].typeDesc)); }
+#line 3200 "parser.cc"
     break;
 
-  case 207:
-#line 825 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new UnaryOpExpr(UnaryOpExpr::SIZE_OF, (yyvsp[0].tree)); }
-#line 3300 "parser.cc" /* yacc.c:1646  */
+  case 207: /* unary_expr: SIZEOF unary_expr  */
+#line 874 "parser.yy"
+                                { (yyval.tree) = new UnaryOpExpr(UnaryOpExpr::SIZE_OF, (yyvsp[0].tree)); }
+#line 3206 "parser.cc"
     break;
 
-  case 208:
-#line 829 "parser.yy" /* yacc.c:1646  */
-    { (yyval.unop) = UnaryOpExpr::IDENTITY; }
-#line 3306 "parser.cc" /* yacc.c:1646  */
+  case 208: /* unary_op: '+'  */
+#line 878 "parser.yy"
+                        { (yyval.unop) = UnaryOpExpr::IDENTITY; }
+#line 3212 "parser.cc"
     break;
 
-  case 209:
-#line 830 "parser.yy" /* yacc.c:1646  */
-    { (yyval.unop) = UnaryOpExpr::NEG; }
-#line 3312 "parser.cc" /* yacc.c:1646  */
+  case 209: /* unary_op: '-'  */
+#line 879 "parser.yy"
+                        { (yyval.unop) = UnaryOpExpr::NEG; }
+#line 3218 "parser.cc"
     break;
 
-  case 210:
-#line 831 "parser.yy" /* yacc.c:1646  */
-    { (yyval.unop) = UnaryOpExpr::ADDRESS_OF; }
-#line 3318 "parser.cc" /* yacc.c:1646  */
+  case 210: /* unary_op: '&'  */
+#line 880 "parser.yy"
+                        { (yyval.unop) = UnaryOpExpr::ADDRESS_OF; }
+#line 3224 "parser.cc"
     break;
 
-  case 211:
-#line 832 "parser.yy" /* yacc.c:1646  */
-    { (yyval.unop) = UnaryOpExpr::INDIRECTION; }
-#line 3324 "parser.cc" /* yacc.c:1646  */
+  case 211: /* unary_op: '*'  */
+#line 881 "parser.yy"
+                        { (yyval.unop) = UnaryOpExpr::INDIRECTION; }
+#line 3230 "parser.cc"
     break;
 
-  case 212:
-#line 833 "parser.yy" /* yacc.c:1646  */
-    { (yyval.unop) = UnaryOpExpr::BOOLEAN_NEG; }
-#line 3330 "parser.cc" /* yacc.c:1646  */
+  case 212: /* unary_op: '!'  */
+#line 882 "parser.yy"
+                        { (yyval.unop) = UnaryOpExpr::BOOLEAN_NEG; }
+#line 3236 "parser.cc"
     break;
 
-  case 213:
-#line 834 "parser.yy" /* yacc.c:1646  */
-    { (yyval.unop) = UnaryOpExpr::BITWISE_NOT; }
-#line 3336 "parser.cc" /* yacc.c:1646  */
+  case 213: /* unary_op: '~'  */
+#line 883 "parser.yy"
+                        { (yyval.unop) = UnaryOpExpr::BITWISE_NOT; }
+#line 3242 "parser.cc"
     break;
 
-  case 214:
-#line 838 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 3342 "parser.cc" /* yacc.c:1646  */
+  case 214: /* cast_expr: unary_expr  */
+#line 887 "parser.yy"
+                                    { (yyval.tree) = (yyvsp[0].tree); }
+#line 3248 "parser.cc"
     break;
 
-  case 215:
-#line 839 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new CastExpr((yyvsp[-2].typeDesc), (yyvsp[0].tree)); }
-#line 3348 "parser.cc" /* yacc.c:1646  */
+  case 215: /* cast_expr: '(' type_name ')' cast_expr  */
+#line 888 "parser.yy"
+                                    { (yyval.tree) = newCastExpr((yyvsp[-2].typeDesc), (yyvsp[0].tree)); }
+#line 3254 "parser.cc"
     break;
 
-  case 216:
-#line 843 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 3354 "parser.cc" /* yacc.c:1646  */
+  case 216: /* postfix_expr: primary_expr  */
+#line 892 "parser.yy"
+                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 3260 "parser.cc"
     break;
 
-  case 217:
-#line 845 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new FunctionCallExpr((yyvsp[-4].tree), new TreeSequence());
+  case 217: /* postfix_expr: postfix_expr save_src_fn save_line_no '(' ')'  */
+#line 894 "parser.yy"
+                        { (yyval.tree) = new FunctionCallExpr((yyvsp[-4].tree), new TreeSequence());
                           free((yyvsp[-3].str)); }
-#line 3361 "parser.cc" /* yacc.c:1646  */
+#line 3267 "parser.cc"
     break;
 
-  case 218:
-#line 848 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new FunctionCallExpr((yyvsp[-5].tree), (yyvsp[-1].treeSequence));
+  case 218: /* postfix_expr: postfix_expr save_src_fn save_line_no '(' arg_expr_list ')'  */
+#line 897 "parser.yy"
+                        { (yyval.tree) = new FunctionCallExpr((yyvsp[-5].tree), (yyvsp[-1].treeSequence));
                           free((yyvsp[-4].str)); }
-#line 3368 "parser.cc" /* yacc.c:1646  */
+#line 3274 "parser.cc"
     break;
 
-  case 219:
-#line 851 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new BinaryOpExpr(BinaryOpExpr::ARRAY_REF, (yyvsp[-3].tree), (yyvsp[-1].tree)); }
-#line 3374 "parser.cc" /* yacc.c:1646  */
+  case 219: /* postfix_expr: postfix_expr '[' expr ']'  */
+#line 900 "parser.yy"
+                        { (yyval.tree) = new BinaryOpExpr(BinaryOpExpr::ARRAY_REF, (yyvsp[-3].tree), (yyvsp[-1].tree)); }
+#line 3280 "parser.cc"
     break;
 
-  case 220:
-#line 853 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new UnaryOpExpr(UnaryOpExpr::POSTINC, (yyvsp[-1].tree)); }
-#line 3380 "parser.cc" /* yacc.c:1646  */
+  case 220: /* postfix_expr: postfix_expr PLUS_PLUS  */
+#line 902 "parser.yy"
+                        { (yyval.tree) = new UnaryOpExpr(UnaryOpExpr::POSTINC, (yyvsp[-1].tree)); }
+#line 3286 "parser.cc"
     break;
 
-  case 221:
-#line 855 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new UnaryOpExpr(UnaryOpExpr::POSTDEC, (yyvsp[-1].tree)); }
-#line 3386 "parser.cc" /* yacc.c:1646  */
+  case 221: /* postfix_expr: postfix_expr MINUS_MINUS  */
+#line 904 "parser.yy"
+                        { (yyval.tree) = new UnaryOpExpr(UnaryOpExpr::POSTDEC, (yyvsp[-1].tree)); }
+#line 3292 "parser.cc"
     break;
 
-  case 222:
-#line 857 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new ObjectMemberExpr((yyvsp[-2].tree), (yyvsp[0].str), true); free((yyvsp[0].str)); }
-#line 3392 "parser.cc" /* yacc.c:1646  */
+  case 222: /* postfix_expr: postfix_expr '.' ID  */
+#line 906 "parser.yy"
+                        { (yyval.tree) = new ObjectMemberExpr((yyvsp[-2].tree), (yyvsp[0].str), true); free((yyvsp[0].str)); }
+#line 3298 "parser.cc"
     break;
 
-  case 223:
-#line 859 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new ObjectMemberExpr((yyvsp[-2].tree), (yyvsp[0].str), false); free((yyvsp[0].str)); }
-#line 3398 "parser.cc" /* yacc.c:1646  */
+  case 223: /* postfix_expr: postfix_expr RIGHT_ARROW ID  */
+#line 908 "parser.yy"
+                        { (yyval.tree) = new ObjectMemberExpr((yyvsp[-2].tree), (yyvsp[0].str), false); free((yyvsp[0].str)); }
+#line 3304 "parser.cc"
     break;
 
-  case 224:
-#line 863 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new IdentifierExpr((yyvsp[0].str)); free((yyvsp[0].str)); }
-#line 3404 "parser.cc" /* yacc.c:1646  */
+  case 224: /* primary_expr: ID  */
+#line 912 "parser.yy"
+                        { (yyval.tree) = new IdentifierExpr((yyvsp[0].str)); free((yyvsp[0].str)); }
+#line 3310 "parser.cc"
     break;
 
-  case 225:
-#line 864 "parser.yy" /* yacc.c:1646  */
-    {
+  case 225: /* primary_expr: REAL  */
+#line 913 "parser.yy"
+                        {
+                            const char *yytext = yyget_text(scanner);
                             bool isHexOrBin = (yytext[0] == '0' && (tolower(yytext[1]) == 'x' || tolower(yytext[1]) == 'b'));
                             double value = (yyvsp[0].real);
                             if (!isHexOrBin
@@ -3423,141 +3330,142 @@ yyreduce:
                                 (yyval.tree) = new WordConstantExpr(value, yytext);
                             }
                         }
-#line 3427 "parser.cc" /* yacc.c:1646  */
+#line 3334 "parser.cc"
     break;
 
-  case 226:
-#line 882 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new WordConstantExpr((int8_t) (yyvsp[0].character), false, true); }
-#line 3433 "parser.cc" /* yacc.c:1646  */
+  case 226: /* primary_expr: CHARLIT  */
+#line 932 "parser.yy"
+                        { (yyval.tree) = new WordConstantExpr((int8_t) (yyvsp[0].character), false, true); }
+#line 3340 "parser.cc"
     break;
 
-  case 227:
-#line 883 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new StringLiteralExpr((yyvsp[0].str)); free((yyvsp[0].str)); }
-#line 3439 "parser.cc" /* yacc.c:1646  */
+  case 227: /* primary_expr: strlit_seq  */
+#line 933 "parser.yy"
+                        { (yyval.tree) = new StringLiteralExpr((yyvsp[0].str)); free((yyvsp[0].str)); }
+#line 3346 "parser.cc"
     break;
 
-  case 228:
-#line 884 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[-1].tree); }
-#line 3445 "parser.cc" /* yacc.c:1646  */
+  case 228: /* primary_expr: '(' expr ')'  */
+#line 934 "parser.yy"
+                        { (yyval.tree) = (yyvsp[-1].tree); }
+#line 3352 "parser.cc"
     break;
 
-  case 229:
-#line 888 "parser.yy" /* yacc.c:1646  */
-    { (yyval.str) = (yyvsp[0].str); }
-#line 3451 "parser.cc" /* yacc.c:1646  */
+  case 229: /* strlit_seq: STRLIT  */
+#line 938 "parser.yy"
+                        { (yyval.str) = (yyvsp[0].str); }
+#line 3358 "parser.cc"
     break;
 
-  case 230:
-#line 889 "parser.yy" /* yacc.c:1646  */
-    {
+  case 230: /* strlit_seq: strlit_seq STRLIT  */
+#line 939 "parser.yy"
+                        {
                             (yyval.str) = (char *) malloc(strlen((yyvsp[-1].str)) + strlen((yyvsp[0].str)) + 1);
                             strcpy((yyval.str), (yyvsp[-1].str));
                             strcat((yyval.str), (yyvsp[0].str));
                             free((yyvsp[-1].str)); free((yyvsp[0].str));
                         }
-#line 3462 "parser.cc" /* yacc.c:1646  */
+#line 3369 "parser.cc"
     break;
 
-  case 231:
-#line 898 "parser.yy" /* yacc.c:1646  */
-    { (yyval.treeSequence) = NULL; }
-#line 3468 "parser.cc" /* yacc.c:1646  */
+  case 231: /* expr_list_opt: %empty  */
+#line 948 "parser.yy"
+                        { (yyval.treeSequence) = NULL; }
+#line 3375 "parser.cc"
     break;
 
-  case 232:
-#line 899 "parser.yy" /* yacc.c:1646  */
-    { (yyval.treeSequence) = (yyvsp[0].treeSequence); }
-#line 3474 "parser.cc" /* yacc.c:1646  */
+  case 232: /* expr_list_opt: expr_list  */
+#line 949 "parser.yy"
+                        { (yyval.treeSequence) = (yyvsp[0].treeSequence); }
+#line 3381 "parser.cc"
     break;
 
-  case 233:
-#line 903 "parser.yy" /* yacc.c:1646  */
-    { (yyval.treeSequence) = new TreeSequence(); (yyval.treeSequence)->addTree((yyvsp[0].tree)); }
-#line 3480 "parser.cc" /* yacc.c:1646  */
+  case 233: /* expr_list: expr  */
+#line 953 "parser.yy"
+                                { (yyval.treeSequence) = new TreeSequence(); (yyval.treeSequence)->addTree((yyvsp[0].tree)); }
+#line 3387 "parser.cc"
     break;
 
-  case 234:
-#line 904 "parser.yy" /* yacc.c:1646  */
-    { (yyval.treeSequence) = (yyvsp[-2].treeSequence); (yyval.treeSequence)->addTree((yyvsp[0].tree)); }
-#line 3486 "parser.cc" /* yacc.c:1646  */
+  case 234: /* expr_list: expr_list ',' expr  */
+#line 954 "parser.yy"
+                                { (yyval.treeSequence) = (yyvsp[-2].treeSequence); (yyval.treeSequence)->addTree((yyvsp[0].tree)); }
+#line 3393 "parser.cc"
     break;
 
-  case 235:
-#line 908 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new IfStmt((yyvsp[-3].tree), (yyvsp[-1].tree), (yyvsp[0].tree)); }
-#line 3492 "parser.cc" /* yacc.c:1646  */
+  case 235: /* selection_stmt: IF '(' if_cond ')' stmt else_part_opt  */
+#line 958 "parser.yy"
+                                                { (yyval.tree) = new IfStmt((yyvsp[-3].tree), (yyvsp[-1].tree), (yyvsp[0].tree)); }
+#line 3399 "parser.cc"
     break;
 
-  case 236:
-#line 909 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new SwitchStmt((yyvsp[-2].tree), (yyvsp[0].tree)); }
-#line 3498 "parser.cc" /* yacc.c:1646  */
+  case 236: /* selection_stmt: SWITCH '(' expr ')' stmt  */
+#line 959 "parser.yy"
+                                                { (yyval.tree) = new SwitchStmt((yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 3405 "parser.cc"
     break;
 
-  case 237:
-#line 913 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 3504 "parser.cc" /* yacc.c:1646  */
+  case 237: /* if_cond: expr  */
+#line 963 "parser.yy"
+                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 3411 "parser.cc"
     break;
 
-  case 238:
-#line 917 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = NULL; }
-#line 3510 "parser.cc" /* yacc.c:1646  */
+  case 238: /* else_part_opt: %empty  */
+#line 967 "parser.yy"
+                                { (yyval.tree) = NULL; }
+#line 3417 "parser.cc"
     break;
 
-  case 239:
-#line 918 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 3516 "parser.cc" /* yacc.c:1646  */
+  case 239: /* else_part_opt: ELSE stmt  */
+#line 968 "parser.yy"
+                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 3423 "parser.cc"
     break;
 
-  case 240:
-#line 922 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new WhileStmt((yyvsp[-2].tree), (yyvsp[0].tree), false); }
-#line 3522 "parser.cc" /* yacc.c:1646  */
+  case 240: /* while_stmt: WHILE '(' while_cond ')' stmt  */
+#line 972 "parser.yy"
+                                        { (yyval.tree) = new WhileStmt((yyvsp[-2].tree), (yyvsp[0].tree), false); }
+#line 3429 "parser.cc"
     break;
 
-  case 241:
-#line 926 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].tree); }
-#line 3528 "parser.cc" /* yacc.c:1646  */
+  case 241: /* while_cond: expr  */
+#line 976 "parser.yy"
+                                { (yyval.tree) = (yyvsp[0].tree); }
+#line 3435 "parser.cc"
     break;
 
-  case 242:
-#line 930 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = new WhileStmt((yyvsp[-2].tree), (yyvsp[-5].tree), true); }
-#line 3534 "parser.cc" /* yacc.c:1646  */
+  case 242: /* do_while_stmt: DO stmt WHILE '(' while_cond ')' ';'  */
+#line 980 "parser.yy"
+                                                { (yyval.tree) = new WhileStmt((yyvsp[-2].tree), (yyvsp[-5].tree), true); }
+#line 3441 "parser.cc"
     break;
 
-  case 243:
-#line 934 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[-1].treeSequence); }
-#line 3540 "parser.cc" /* yacc.c:1646  */
+  case 243: /* for_init: expr_list_opt ';'  */
+#line 984 "parser.yy"
+                                { (yyval.tree) = (yyvsp[-1].treeSequence); }
+#line 3447 "parser.cc"
     break;
 
-  case 244:
-#line 935 "parser.yy" /* yacc.c:1646  */
-    { (yyval.tree) = (yyvsp[0].declarationSequence); }
-#line 3546 "parser.cc" /* yacc.c:1646  */
+  case 244: /* for_init: declaration  */
+#line 985 "parser.yy"
+                                { (yyval.tree) = (yyvsp[0].declarationSequence); }
+#line 3453 "parser.cc"
     break;
 
-  case 245:
-#line 943 "parser.yy" /* yacc.c:1646  */
-    { if ( (yyvsp[-11].tree))  (yyvsp[-11].tree)->setLineNo((yyvsp[-13].str), (yyvsp[-12].integer));
+  case 245: /* for_stmt: FOR '(' save_src_fn save_line_no for_init save_src_fn save_line_no expr_opt ';' save_src_fn save_line_no expr_list_opt ')' save_src_fn save_line_no stmt  */
+#line 993 "parser.yy"
+                                { if ( (yyvsp[-11].tree))  (yyvsp[-11].tree)->setLineNo((yyvsp[-13].str), (yyvsp[-12].integer));
                                   if ( (yyvsp[-8].tree))  (yyvsp[-8].tree)->setLineNo((yyvsp[-10].str), (yyvsp[-9].integer));
                                   if ((yyvsp[-4].treeSequence)) (yyvsp[-4].treeSequence)->setLineNo((yyvsp[-6].str), (yyvsp[-5].integer));
                                   (yyval.tree) = new ForStmt((yyvsp[-11].tree), (yyvsp[-8].tree), (yyvsp[-4].treeSequence), (yyvsp[0].tree));
                                   free((yyvsp[-13].str)); free((yyvsp[-10].str)); free((yyvsp[-6].str)); free((yyvsp[-2].str));
                                 }
-#line 3557 "parser.cc" /* yacc.c:1646  */
+#line 3464 "parser.cc"
     break;
 
 
-#line 3561 "parser.cc" /* yacc.c:1646  */
+#line 3468 "parser.cc"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -3571,25 +3479,23 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -3600,50 +3506,14 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
+      yyerror (scanner, YY_("syntax error"));
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -3658,7 +3528,7 @@ yyerrlab:
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval);
+                      yytoken, &yylval, scanner);
           yychar = YYEMPTY;
         }
     }
@@ -3672,12 +3542,11 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
-
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -3694,13 +3563,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -3714,7 +3584,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, scanner);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -3726,7 +3596,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -3737,33 +3607,37 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (scanner, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval);
+                  yytoken, &yylval, scanner);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -3772,26 +3646,24 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, scanner);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
+
   return yyresult;
 }
-#line 951 "parser.yy" /* yacc.c:1906  */
+
+#line 1001 "parser.yy"
 
 
 #if 0
 void _PARSERTRACE(int parserLineNo, const char *fmt, ...)
 {
-    printf("# P%d U%d: ", parserLineNo, lineno);
+    printf("# P%d U%d: ", parserLineNo, TranslationUnit::instance().getCurrentLineNo());
     va_list ap;
     va_start(ap, fmt);
     vprintf(fmt, ap);
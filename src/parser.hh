@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -30,6 +31,10 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 #ifndef YY_YY_PARSER_HH_INCLUDED
 # define YY_YY_PARSER_HH_INCLUDED
 /* Debug traces.  */
@@ -39,154 +44,101 @@
 #if YYDEBUG
 extern int yydebug;
 #endif
+/* "%code requires" blocks.  */
+#line 103 "parser.yy"
+
+// The scanner generated from lexer.ll is reentrant: its state is in an object of this type.
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void *yyscan_t;
+#endif
 
-/* Token type.  */
+#line 57 "parser.hh"
+
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    ID = 258,
-    STRLIT = 259,
-    PRAGMA = 260,
-    CHARLIT = 261,
-    REAL = 262,
-    TYPE_NAME = 263,
-    INT = 264,
-    CHAR = 265,
-    SHORT = 266,
-    LONG = 267,
-    FLOAT = 268,
-    DOUBLE = 269,
-    SIGNED = 270,
-    UNSIGNED = 271,
-    VOID = 272,
-    PLUS_PLUS = 273,
-    MINUS_MINUS = 274,
-    IF = 275,
-    ELSE = 276,
-    WHILE = 277,
-    DO = 278,
-    FOR = 279,
-    EQUALS_EQUALS = 280,
-    BANG_EQUALS = 281,
-    LOWER_EQUALS = 282,
-    GREATER_EQUALS = 283,
-    AMP_AMP = 284,
-    PIPE_PIPE = 285,
-    LT_LT = 286,
-    GT_GT = 287,
-    BREAK = 288,
-    CONTINUE = 289,
-    RETURN = 290,
-    ASM = 291,
-    NORTS = 292,
-    VERBATIM_ASM = 293,
-    STRUCT = 294,
-    UNION = 295,
-    THIS = 296,
-    PLUS_EQUALS = 297,
-    MINUS_EQUALS = 298,
-    ASTERISK_EQUALS = 299,
-    SLASH_EQUALS = 300,
-    PERCENT_EQUALS = 301,
-    LT_LT_EQUALS = 302,
-    GT_GT_EQUALS = 303,
-    CARET_EQUALS = 304,
-    AMP_EQUALS = 305,
-    PIPE_EQUALS = 306,
-    RIGHT_ARROW = 307,
-    INTERRUPT = 308,
-    SIZEOF = 309,
-    ELLIPSIS = 310,
-    TYPEDEF = 311,
-    ENUM = 312,
-    SWITCH = 313,
-    CASE = 314,
-    DEFAULT = 315,
-    REGISTER = 316,
-    GOTO = 317,
-    EXTERN = 318,
-    STATIC = 319,
-    CONST = 320,
-    VOLATILE = 321,
-    AUTO = 322,
-    FUNC_RECEIVES_FIRST_PARAM_IN_REG = 323
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    ID = 258,                      /* ID  */
+    STRLIT = 259,                  /* STRLIT  */
+    PRAGMA = 260,                  /* PRAGMA  */
+    CHARLIT = 261,                 /* CHARLIT  */
+    REAL = 262,                    /* REAL  */
+    TYPE_NAME = 263,               /* TYPE_NAME  */
+    INT = 264,                     /* INT  */
+    CHAR = 265,                    /* CHAR  */
+    SHORT = 266,                   /* SHORT  */
+    LONG = 267,                    /* LONG  */
+    FLOAT = 268,                   /* FLOAT  */
+    DOUBLE = 269,                  /* DOUBLE  */
+    SIGNED = 270,                  /* SIGNED  */
+    UNSIGNED = 271,                /* UNSIGNED  */
+    VOID = 272,                    /* VOID  */
+    PLUS_PLUS = 273,               /* PLUS_PLUS  */
+    MINUS_MINUS = 274,             /* MINUS_MINUS  */
+    IF = 275,                      /* IF  */
+    ELSE = 276,                    /* ELSE  */
+    WHILE = 277,                   /* WHILE  */
+    DO = 278,                      /* DO  */
+    FOR = 279,                     /* FOR  */
+    EQUALS_EQUALS = 280,           /* EQUALS_EQUALS  */
+    BANG_EQUALS = 281,             /* BANG_EQUALS  */
+    LOWER_EQUALS = 282,            /* LOWER_EQUALS  */
+    GREATER_EQUALS = 283,          /* GREATER_EQUALS  */
+    AMP_AMP = 284,                 /* AMP_AMP  */
+    PIPE_PIPE = 285,               /* PIPE_PIPE  */
+    LT_LT = 286,                   /* LT_LT  */
+    GT_GT = 287,                   /* GT_GT  */
+    BREAK = 288,                   /* BREAK  */
+    CONTINUE = 289,                /* CONTINUE  */
+    RETURN = 290,                  /* RETURN  */
+    ASM = 291,                     /* ASM  */
+    NORTS = 292,                   /* NORTS  */
+    VERBATIM_ASM = 293,            /* VERBATIM_ASM  */
+    STRUCT = 294,                  /* STRUCT  */
+    UNION = 295,                   /* UNION  */
+    THIS = 296,                    /* THIS  */
+    PLUS_EQUALS = 297,             /* PLUS_EQUALS  */
+    MINUS_EQUALS = 298,            /* MINUS_EQUALS  */
+    ASTERISK_EQUALS = 299,         /* ASTERISK_EQUALS  */
+    SLASH_EQUALS = 300,            /* SLASH_EQUALS  */
+    PERCENT_EQUALS = 301,          /* PERCENT_EQUALS  */
+    LT_LT_EQUALS = 302,            /* LT_LT_EQUALS  */
+    GT_GT_EQUALS = 303,            /* GT_GT_EQUALS  */
+    CARET_EQUALS = 304,            /* CARET_EQUALS  */
+    AMP_EQUALS = 305,              /* AMP_EQUALS  */
+    PIPE_EQUALS = 306,             /* PIPE_EQUALS  */
+    RIGHT_ARROW = 307,             /* RIGHT_ARROW  */
+    INTERRUPT = 308,               /* INTERRUPT  */
+    SIZEOF = 309,                  /* SIZEOF  */
+    ELLIPSIS = 310,                /* ELLIPSIS  */
+    TYPEDEF = 311,                 /* TYPEDEF  */
+    ENUM = 312,                    /* ENUM  */
+    SWITCH = 313,                  /* SWITCH  */
+    CASE = 314,                    /* CASE  */
+    DEFAULT = 315,                 /* DEFAULT  */
+    REGISTER = 316,                /* REGISTER  */
+    GOTO = 317,                    /* GOTO  */
+    EXTERN = 318,                  /* EXTERN  */
+    STATIC = 319,                  /* STATIC  */
+    CONST = 320,                   /* CONST  */
+    VOLATILE = 321,                /* VOLATILE  */
+    AUTO = 322,                    /* AUTO  */
+    FUNC_RECEIVES_FIRST_PARAM_IN_REG = 323 /* FUNC_RECEIVES_FIRST_PARAM_IN_REG  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
-#define ID 258
-#define STRLIT 259
-#define PRAGMA 260
-#define CHARLIT 261
-#define REAL 262
-#define TYPE_NAME 263
-#define INT 264
-#define CHAR 265
-#define SHORT 266
-#define LONG 267
-#define FLOAT 268
-#define DOUBLE 269
-#define SIGNED 270
-#define UNSIGNED 271
-#define VOID 272
-#define PLUS_PLUS 273
-#define MINUS_MINUS 274
-#define IF 275
-#define ELSE 276
-#define WHILE 277
-#define DO 278
-#define FOR 279
-#define EQUALS_EQUALS 280
-#define BANG_EQUALS 281
-#define LOWER_EQUALS 282
-#define GREATER_EQUALS 283
-#define AMP_AMP 284
-#define PIPE_PIPE 285
-#define LT_LT 286
-#define GT_GT 287
-#define BREAK 288
-#define CONTINUE 289
-#define RETURN 290
-#define ASM 291
-#define NORTS 292
-#define VERBATIM_ASM 293
-#define STRUCT 294
-#define UNION 295
-#define THIS 296
-#define PLUS_EQUALS 297
-#define MINUS_EQUALS 298
-#define ASTERISK_EQUALS 299
-#define SLASH_EQUALS 300
-#define PERCENT_EQUALS 301
-#define LT_LT_EQUALS 302
-#define GT_GT_EQUALS 303
-#define CARET_EQUALS 304
-#define AMP_EQUALS 305
-#define PIPE_EQUALS 306
-#define RIGHT_ARROW 307
-#define INTERRUPT 308
-#define SIZEOF 309
-#define ELLIPSIS 310
-#define TYPEDEF 311
-#define ENUM 312
-#define SWITCH 313
-#define CASE 314
-#define DEFAULT 315
-#define REGISTER 316
-#define GOTO 317
-#define EXTERN 318
-#define STATIC 319
-#define CONST 320
-#define VOLATILE 321
-#define AUTO 322
-#define FUNC_RECEIVES_FIRST_PARAM_IN_REG 323
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
 union YYSTYPE
 {
-#line 75 "parser.yy" /* yacc.c:1909  */
+#line 123 "parser.yy"
 
     char *str;
     signed char character;
@@ -217,17 +169,18 @@ union YYSTYPE
     std::vector<Enumerator *> *enumeratorList;
     TypeQualifierBitFieldVector *typeQualifierBitFieldVector;
 
-#line 221 "parser.hh" /* yacc.c:1909  */
-};
+#line 173 "parser.hh"
 
+};
 typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
 
-extern YYSTYPE yylval;
 
-int yyparse (void);
+
+int yyparse (yyscan_t scanner);
+
 
 #endif /* !YY_YY_PARSER_HH_INCLUDED  */
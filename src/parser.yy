@@ -22,6 +22,7 @@
 #include "WordConstantExpr.h"
 #include "RealConstantExpr.h"
 #include "DWordConstantExpr.h"
+#include "PackedInitializer.h"
 #include "IdentifierExpr.h"
 #include "VariableExpr.h"
 #include "FunctionCallExpr.h"
@@ -54,22 +55,69 @@
 
 using namespace std;
 
-int yyparse(void);
-int yylex(void);
-void yyerror(const char *msg);
-extern char *yytext;
-
-extern string sourceFilename;  // defined in lexer.ll
-extern int lineno;  // defined in lexer.ll
-int numErrors = 0;  // error counter for yyerror()
-int numWarnings = 0;
-static bool doubleTypeWarningIssued = false;
-
 void _PARSERTRACE(int parserLineNo, const char *fmt, ...);
 #define PARSERTRACE(...) _PARSERTRACE(__LINE__, __VA_ARGS__)
 
+// Creates a BinaryOpExpr, unless the operation can be done at compile time
+// (see BinaryOpExpr::foldLongOrRealConstants()), in which case the operands
+// are destroyed and the resulting constant is returned.
+//
+static Tree *
+newBinaryOpExpr(BinaryOpExpr::Op op, Tree *left, Tree *right)
+{
+    if (Tree *folded = BinaryOpExpr::foldLongOrRealConstants(op, left, right))
+    {
+        delete left;
+        delete right;
+        return folded;
+    }
+    return new BinaryOpExpr(op, left, right);
+}
+
+
+// Like newBinaryOpExpr(), but for a cast.
+//
+static Tree *
+newCastExpr(const TypeDesc *td, Tree *subExpr)
+{
+    if (Tree *folded = CastExpr::foldLongOrRealConstant(td, subExpr))
+    {
+        delete subExpr;
+        return folded;
+    }
+    return new CastExpr(td, subExpr);
+}
+
+
+// Creates a Declarator at the current source position.
+//
+static Declarator *
+newDeclarator(const string &id)
+{
+    const TranslationUnit &tu = TranslationUnit::instance();
+    return new Declarator(id, tu.getCurrentSourceFilename(), tu.getCurrentLineNo());
+}
+
 %}
 
+%code requires {
+// The scanner generated from lexer.ll is reentrant: its state is in an object of this type.
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void *yyscan_t;
+#endif
+}
+
+%code {
+int yylex(YYSTYPE *lvalp, yyscan_t scanner);  // defined in lexer.ll
+char *yyget_text(yyscan_t scanner);  // defined in lexer.ll
+void yyerror(yyscan_t scanner, const char *msg);  // defined in util.cpp
+}
+
+%define api.pure full
+%parse-param {yyscan_t scanner}
+%lex-param {yyscan_t scanner}
+
 %expect 20  /* 1 shift/reduce conflict expected for if-else */
 
 %union {
@@ -119,13 +167,13 @@ void _PARSERTRACE(int parserLineNo, const char *fmt, ...);
 %type <tree> expr expr_opt logical_or_expr logical_and_expr rel_expr add_expr mul_expr
 %type <tree> inclusive_or_expr exclusive_or_expr and_expr
 %type <tree> if_cond while_cond assignment_expr equality_expr shift_expr conditional_expr constant_expr
-%type <tree> unary_expr cast_expr postfix_expr primary_expr initializer for_init subscript
+%type <tree> unary_expr cast_expr postfix_expr primary_expr initializer initializer_list for_init subscript
 %type <declarationSequence> declaration
 %type <compoundStmt> compound_stmt stmt_list stmt_list_opt
 %type <treeSequence> expr_list_opt expr_list translation_unit arg_expr_list
 %type <formalParamList> parameter_list parameter_type_list parameter_type_list_opt function_pointer_cast function_pointer_cast_opt
 %type <formalParameter> parameter_declaration
-%type <treeSequence> initializer_list subscript_list
+%type <treeSequence> subscript_list
 %type <declaratorVector> init_declarator_list struct_declarator_list
 %type <declarator> init_declarator declarator direct_declarator struct_declarator
 %type <functionDef> function_definition
@@ -441,11 +489,7 @@ non_void_basic_type:
     | DOUBLE    {
                     TranslationUnit::instance().warnIfFloatUnsupported();
                     $$ = TranslationUnit::getTypeManager().getRealType(false);
-                    if (!doubleTypeWarningIssued)
-                    {
-                        warnmsg("`double' is an alias for `float' for this compiler");
-                        doubleTypeWarningIssued = true;
-                    }
+                    TranslationUnit::instance().warnAboutDoubleType();
                 }
     ;
 
@@ -455,11 +499,11 @@ basic_type:
     ;
 
 save_src_fn:
-      /* empty */               { $$ = strdup(sourceFilename.c_str()); }
+      /* empty */               { $$ = strdup(TranslationUnit::instance().getCurrentSourceFilename().c_str()); }
     ;
 
 save_line_no:
-      /* empty */               { $$ = lineno; }
+      /* empty */               { $$ = TranslationUnit::instance().getCurrentLineNo(); }
     ;
 
 init_declarator_list:
@@ -485,12 +529,12 @@ declarator:
 direct_declarator:
       ID
             {
-                $$ = new Declarator($1, sourceFilename, lineno);
+                $$ = newDeclarator($1);
                 free($1);
             }
     | /* empty (unnamed function parameter) */
             {
-                $$ = new Declarator(string(), sourceFilename, lineno);
+                $$ = newDeclarator(string());
             }
     | direct_declarator '[' expr_opt ']'
             {
@@ -515,20 +559,20 @@ direct_declarator:
             }
     | '(' '*' ID ')' '(' parameter_type_list_opt ')'  /* function pointer variable */
             {
-                $$ = new Declarator($3, sourceFilename, lineno);
+                $$ = newDeclarator($3);
                 $$->setAsFunctionPointer($6);  // takes ownership of FormalParamList
                 free($3);
                 TranslationUnit::checkForEllipsisWithoutNamedArgument($6);
             }
     | '(' '*' ')' '(' parameter_type_list_opt ')'  /* unnamed function pointer variable */
             {
-                $$ = new Declarator(string(), sourceFilename, lineno);
+                $$ = newDeclarator(string());
                 $$->setAsFunctionPointer($5);  // takes ownership of FormalParamList
                 TranslationUnit::checkForEllipsisWithoutNamedArgument($5);
             }
     | '(' '*' ID subscript_list ')' '(' parameter_type_list_opt ')'  /* array of function pointer variables */
             {
-                $$ = new Declarator($3, sourceFilename, lineno);
+                $$ = newDeclarator($3);
                 $$->setAsArrayOfFunctionPointers($7, $4);  // takes ownership of FormalParamList ($7), deletes $4
                 free($3);
                 TranslationUnit::checkForEllipsisWithoutNamedArgument($7);
@@ -559,8 +603,8 @@ initializer:
     ; 
 
 initializer_list:
-      initializer                           { $$ = new TreeSequence(); $$->addTree($1); }
-    | initializer_list ',' initializer      { $$ = $1; $$->addTree($3); }
+      initializer                           { TreeSequence *seq = new TreeSequence(); seq->addTree($1); $$ = seq; }
+    | initializer_list ',' initializer      { $$ = PackedInitializer::append($1, $3); }
     ;
 
 struct_declaration_list_opt:
@@ -640,7 +684,7 @@ stmt:
     | ASM '(' STRLIT ')' ';'
                         { $$ = new AssemblerStmt($3, "", false);
                           free($3); }
-    | VERBATIM_ASM      { $$ = new AssemblerStmt(yytext); }
+    | VERBATIM_ASM      { $$ = new AssemblerStmt(yyget_text(scanner)); }
     ;
 
 labeled_stmt:
@@ -733,17 +777,17 @@ logical_and_expr:
 inclusive_or_expr:
       exclusive_or_expr                         { $$ = $1; }
     | inclusive_or_expr '|' exclusive_or_expr
-                { $$ = new BinaryOpExpr(BinaryOpExpr::BITWISE_OR, $1, $3); }
+                { $$ = newBinaryOpExpr(BinaryOpExpr::BITWISE_OR, $1, $3); }
 
 exclusive_or_expr:
       and_expr                                  { $$ = $1; }
     | exclusive_or_expr '^' and_expr
-                { $$ = new BinaryOpExpr(BinaryOpExpr::BITWISE_XOR, $1, $3); }
+                { $$ = newBinaryOpExpr(BinaryOpExpr::BITWISE_XOR, $1, $3); }
 
 and_expr:
       equality_expr                             { $$ = $1; }
     | and_expr '&' equality_expr
-                { $$ = new BinaryOpExpr(BinaryOpExpr::BITWISE_AND, $1, $3); }
+                { $$ = newBinaryOpExpr(BinaryOpExpr::BITWISE_AND, $1, $3); }
 
 equality_expr:
       rel_expr                  { $$ = $1; }
@@ -763,9 +807,9 @@ rel_expr:
 
 shift_expr:
       add_expr                  { $$ = $1; }
-    | shift_expr LT_LT add_expr { $$ = new BinaryOpExpr(
+    | shift_expr LT_LT add_expr { $$ = newBinaryOpExpr(
                                         BinaryOpExpr::LEFT_SHIFT, $1, $3); }
-    | shift_expr GT_GT add_expr { $$ = new BinaryOpExpr(
+    | shift_expr GT_GT add_expr { $$ = newBinaryOpExpr(
                                         BinaryOpExpr::RIGHT_SHIFT, $1, $3); }
     ;
 
@@ -778,7 +822,7 @@ rel_op:
 
 add_expr:
       mul_expr                  { $$ = $1; }
-    | add_expr add_op mul_expr  { $$ = new BinaryOpExpr($2, $1, $3); }
+    | add_expr add_op mul_expr  { $$ = newBinaryOpExpr($2, $1, $3); }
     ;
 
 add_op:
@@ -788,7 +832,7 @@ add_op:
 
 mul_expr:
       cast_expr                 { $$ = $1; }
-    | mul_expr mul_op cast_expr { $$ = new BinaryOpExpr($2, $1, $3); }
+    | mul_expr mul_op cast_expr { $$ = newBinaryOpExpr($2, $1, $3); }
     ;
 
 mul_op:
@@ -814,6 +858,11 @@ unary_expr:
                                         dwce->negateValue();
                                         $$ = dwce;
                                     }
+                                    else if ($1 == UnaryOpExpr::BITWISE_NOT && (dwce = dynamic_cast<DWordConstantExpr *>($2)) != NULL)
+                                    {
+                                        // ~x is -1 - x.
+                                        $$ = newBinaryOpExpr(BinaryOpExpr::SUB, new DWordConstantExpr(-1, dwce->isSigned()), dwce);
+                                    }
                                     else
                                     {
                                         $$ = new UnaryOpExpr($1, $2);
@@ -836,7 +885,7 @@ unary_op:
 
 cast_expr:
       unary_expr                    { $$ = $1; }
-    | '(' type_name ')' cast_expr   { $$ = new CastExpr($2, $4); }
+    | '(' type_name ')' cast_expr   { $$ = newCastExpr($2, $4); }
     ;
 
 postfix_expr:
@@ -862,6 +911,7 @@ postfix_expr:
 primary_expr:
       ID                { $$ = new IdentifierExpr($1); free($1); }
     | REAL              {
+                            const char *yytext = yyget_text(scanner);
                             bool isHexOrBin = (yytext[0] == '0' && (tolower(yytext[1]) == 'x' || tolower(yytext[1]) == 'b'));
                             double value = $1;
                             if (!isHexOrBin
@@ -953,7 +1003,7 @@ for_stmt:
 #if 0
 void _PARSERTRACE(int parserLineNo, const char *fmt, ...)
 {
-    printf("# P%d U%d: ", parserLineNo, lineno);
+    printf("# P%d U%d: ", parserLineNo, TranslationUnit::instance().getCurrentLineNo());
     va_list ap;
     va_start(ap, fmt);
     vprintf(fmt, ap);
@@ -17,10 +17,14 @@ copyMem
 	leau	d,u		end of source region
 	pshs	u		store for loop condition
 	ldu	6,s		source address
+	lsrb			C = 1 if number of bytes is odd
+	bcc	@cond
+	lda	,u+		copy odd byte, then copy words
+	sta	,x+
 	bra	@cond
 @loop
-	lda	,u+
-	sta	,x+
+	ldd	,u++
+	std	,x++
 @cond
 	cmpu	,s		compare with end address
 	bne	@loop
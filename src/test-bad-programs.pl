@@ -3042,6 +3042,104 @@ expected => [
 },
 
 
+{
+title => q{Invalid usage of "#pragma embed"},
+program => q!
+    #pragma embed ",no-such-file.bin" as data
+    #pragma embed ",no-such-file.bin"
+    int main()
+    {
+        return 0;
+    }
+    !,
+expected => [
+    qq!,check-prog.c:2: __error__: #pragma embed: cannot open `,no-such-file.bin': No such file or directory!,
+    qq!,check-prog.c:3: __error__: invalid pragma directive: embed ",no-such-file.bin"!,
+    ]
+},
+
+
+{
+title => q{Preprocessor errors},
+program => q!
+    #define F(a, b) a + b
+    int n = F(1);
+    #if 1 +
+    #endif
+    #error stop here
+    #include "no-such-header.h"
+    int main()
+    {
+        return 0;
+    }
+    !,
+expected => [
+    qq!,check-prog.c:3: __error__: macro "F" requires 2 arguments, but only 1 given!,
+    qq!,check-prog.c:4: __error__: #if with no expression!,
+    qq!,check-prog.c:6: __error__: #error stop here!,
+    qq!,check-prog.c:7: __error__: no-such-header.h: No such file or directory!,
+    ]
+},
+
+
+{
+title => q{Division in #if expressions},
+program => q!
+    #if 0 && 1/0
+    #error 0 && 1/0
+    #endif
+    #if 1 || 1/0
+    #else
+    #error 1 || 1/0
+    #endif
+    #if 1 ? 2 : 1/0
+    #else
+    #error 1 ? 2 : 1/0
+    #endif
+    #if 0 ? 1/0 : 2
+    #else
+    #error 0 ? 1/0 : 2
+    #endif
+    #if (-9223372036854775807-1) / -1 >= 0 || (-9223372036854775807-1) % -1 < 0
+    #error LLONG_MIN / -1
+    #endif
+    #if 1 % 0
+    #endif
+    int main()
+    {
+        return 0;
+    }
+    !,
+expected => [
+    qq!,check-prog.c:17: __warning__: integer overflow in #if!,
+    qq!,check-prog.c:20: __error__: division by zero in #if!,
+    ]
+},
+
+
+{
+title => q{Out of range values in a long initializer of a byte array},
+program => q!
+    unsigned char u[] = { 1, 2, 3, 4, 5, 6, 7, 8,
+                          9, 10, 11, 12, 13, 14, 15,
+                          300, 17 };
+    char c[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                 16,
+                 -129 };
+    int main()
+    {
+        return u[0] + c[0];
+    }
+    !,
+expected => [
+    qq!,check-prog.c:4: __warning__: initializer of type `int' is too large for `unsigned char`!,
+    qq!,check-prog.c:7: __warning__: initializer of type `int' is too large for `char`!,
+    qq!,check-prog.c:2: __warning__: value 300 (0x12c) does not fit in an unsigned character (value will be truncated)!,
+    qq!,check-prog.c:5: __warning__: value 65407 (0xff7f) does not fit in a signed character (value will be truncated)!,
+    ]
+},
+
+
 #{
 #title => q{Sample test},
 #program => q!
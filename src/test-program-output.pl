@@ -10207,6 +10207,633 @@ expected => ""
 },
 
 
+{
+title => q{Word expressions narrowed to byte when only the low byte is used},
+tolerateWarnings => 1,
+program => q`
+    word w = 0x1234, x = 0x01F3;
+    int i = -300;
+    byte b = 7;
+    char c = -5;
+    byte addCast(byte a, int n) { return (byte) (a + n); }
+    int main()
+    {
+        byte r;
+        char s;
+        r = w + b;              assert_eq(r, 0x3B);
+        r = (w & 0x0F) + '0';   assert_eq(r, '4');
+        r = x * 3 + w;          assert_eq(r, 0x0D);
+        r = ~w;                 assert_eq(r, 0xCB);
+        r = -x + b;             assert_eq(r, 0x14);
+        r = x - 300;            assert_eq(r, 0xC7);
+        r = (w << 3) ^ 0xFF;    assert_eq(r, 0x5F);
+        r = (int) b + (int) r;  assert_eq(r, 0x66);
+        r = 1; r += w;          assert_eq(r, 0x35);
+        r = 0xF0; r &= w | 1;   assert_eq(r, 0x30);
+        s = i + c;              assert_eq(s, -49);
+        s = (char) (i * 2);     assert_eq(s, -88);
+        assert_eq(addCast(250, 262), 0x00);
+        assert_eq((byte) (x - w), 0xBF);
+        assert_eq(w / 3, 0x0611);  // not narrowed
+        r = w / 3;              assert_eq(r, 0x11);
+        r = w >> 4;             assert_eq(r, 0x23);
+        return 0;
+    }
+    `,
+expected => ""
+},
+
+
+{
+title => q{Inline long addition, subtraction, comparison, inc/dec and constant shifts},
+program => q`
+    long a = 0x1234FFFFL, b = -2L;
+    unsigned long u = 0xFFFFFFFFUL;
+    unsigned w = 0xFFFE;
+    int main()
+    {
+        long c = a + b;         assert_eq(c, 0x1234FFFDL);
+        c -= 0x0000FFFEL;       assert_eq(c, 0x1233FFFFL);
+        c += w;                 assert_eq(c, 0x1234FFFDL);
+        c = b - a;              assert_eq(c, 0xEDCB0000L - 1);
+        ++u;                    assert_eq(u, 0UL);
+        u--;                    assert_eq(u, 0xFFFFFFFFUL);
+        c = a++;                assert_eq(c, 0x1234FFFFL);
+                                assert_eq(a, 0x12350000L);
+        --a;                    assert_eq(a, 0x1234FFFFL);
+        assert(b < a);
+        assert(!(a < b));
+        assert(a > 0x1234FFFEL);
+        assert(a >= 0x1234FFFFL);
+        assert(b <= -2);
+        assert(b != -1);
+        assert(u > 0x7FFFFFFFUL);
+        assert(w < u);
+        c = a << 12;            assert_eq(c, 0x4FFFF000L);
+        c = b >> 9;             assert_eq(c, -1L);
+        c = a >> 17;            assert_eq(c, 0x091AL);
+        c = -0x7EDCBA99L >> 8;  assert_eq(c, 0xFF812345L);
+        u >>= 26;               assert_eq(u, 63UL);
+        u <<= 2;                assert_eq(u, 252UL);
+        return 0;
+    }
+    `,
+expected => ""
+},
+
+
+{
+title => q{Long constant expressions folded at compile time},
+program => q`
+    long g = 100000L * 3 + 7;
+    unsigned long mask = ~0UL >> 4;
+    int main()
+    {
+        long a = (long) 1 << 20;
+        long b = -7L / 2;
+        long c = -7L % 2;
+        long d = 0x12345678L & 0xFFFF;
+        long e = -256L >> 4;
+        unsigned long f = 0xFFFFFFF0UL + 0x20;
+        int i = (int) 70000L;
+        char j = (char) 0x1FFL;
+        long k = (long) (16777216.0f + 1.25f - 16777216.0f);  // 2 in float precision, not 1 as in double
+        assert_eq(g, 300007L);
+        assert_eq(mask, 0x0FFFFFFFUL);
+        assert_eq(a, 0x00100000L);
+        assert_eq(b, -3L);
+        assert_eq(c, -1L);
+        assert_eq(d, 0x5678L);
+        assert_eq(e, -16L);
+        assert_eq(f, 0x10UL);
+        assert_eq(i, 4464);
+        assert_eq(j, -1);
+        assert_eq(k, 2L);
+        return 0;
+    }
+    `,
+expected => ""
+},
+
+
+{
+title => q{Static functions receive their first two arguments in D and X},
+program => q`
+    static int add3(int a, char b, int c) { return a + b + c; }
+    static unsigned fact(unsigned n) { return n <= 1 ? 1U : n * fact(n - 1); }
+    static char *skip(char *s, char c) { while (*s == c) ++s; return s; }
+    static int sub(int a, int b) { return a - b; }
+    static int withLong(int a, int b, long c) { return a + b + (int) c; }
+    int g = 7;
+    int main()
+    {
+        int (*pf)(int, int) = sub;
+        long n = 100000;
+        char buf[] = "  hi";
+        assert_eq(add3(g, -2, 10), 15);
+        assert_eq(add3(fact(3), (char) (g + 1), add3(1, 2, 3)), 20);
+        assert_eq(fact(5), 120);
+        assert_eq(*skip(buf, ' '), 'h');
+        assert_eq(pf(9, 4), 5);
+        assert_eq(sub(9, 4), 5);
+        assert_eq(withLong(1, 2, n), 3 + (int) n);
+        assert_eq(add3(n, 1, 1), (int) n + 2);
+        return 0;
+    }
+    `,
+expected => ""
+},
+
+
+{
+title => q{Register values kept across calls that do not modify them},
+program => q`
+    static int twice(int n) { return n + n; }
+    int clobber(int n) { int *p = &n; return *p + 1; }
+    long total;
+    int main()
+    {
+        int a[3];
+        long v = 5;
+        a[0] = twice(3);
+        a[1] = clobber(a[0]);
+        a[2] = twice(a[1]);
+        assert_eq(a[0], 6);
+        assert_eq(a[1], 7);
+        assert_eq(a[2], 14);
+        total = v;
+        ++total;
+        total += v;
+        assert_eq(total, 11);
+        return 0;
+    }
+    `,
+expected => ""
+},
+
+
+{
+title => q{Branches to branches go directly to the final destination},
+program => q`
+    int classify(int a, int b)
+    {
+        int r = 0;
+        for (int i = 0; i < 3; ++i)
+        {
+            switch (a + i)
+            {
+            case 1: if (b) r += 1; else r += 2; break;
+            case 2: if (a && b && i) r += 10; break;
+            default: if (b > 5) break; r += 100;
+            }
+        }
+        return r;
+    }
+    int main()
+    {
+        assert_eq(classify(0, 0), 102);
+        assert_eq(classify(0, 1), 101);
+        assert_eq(classify(1, 9), 11);
+        assert_eq(classify(5, 9), 0);
+        return 0;
+    }
+    `,
+expected => ""
+},
+
+
+{
+title => q{Small structs copied inline and returned in registers},
+program => q`
+    struct B1 { char c; };
+    struct B2 { int w; };
+    struct B3 { char a, b, c; };
+    struct B5 { int x, y; char z; };
+    struct B8 { int a, b, c, d; };
+    struct B3 g3;
+    struct B5 tab[3];
+    int calls;
+    int index(int i) { ++calls; return i; }
+    struct B1 mk1(char c) { struct B1 s; s.c = c; return s; }
+    struct B2 mk2(int w) { struct B2 s; s.w = w; return s; }
+    struct B5 mk5(int x) { struct B5 s; s.x = x; s.y = -x; s.z = 5; return s; }
+    int sum(struct B3 a, struct B1 b, struct B5 c, struct B8 d)
+    {
+        return a.a + a.b + a.c + b.c + c.x + c.y + c.z + d.a + d.b + d.c + d.d;
+    }
+    int main()
+    {
+        struct B3 s3 = { 1, 2, 3 };
+        struct B5 s5 = { 1000, 2000, 7 };
+        struct B8 s8 = { 1, 2, 3, 4 };
+        struct B8 t8 = s8;
+        struct B5 *p5 = &tab[0];
+        struct B2 (*pf)(int) = mk2;
+        g3 = s3;
+        assert_eq(g3.a + g3.b + g3.c, 6);
+        *p5 = s5;
+        assert_eq(tab[0].y, 2000);
+        tab[index(2)] = s5;
+        assert_eq(calls, 1);
+        assert_eq(tab[2].x, 1000);
+        assert_eq(tab[2].z, 7);
+        assert_eq(t8.d, 4);
+        assert_eq(sum(s3, mk1(10), s5, t8), 6 + 10 + 3007 + 10);
+        assert_eq(mk1(42).c, 42);
+        assert_eq(mk2(-1234).w, -1234);
+        assert_eq((*pf)(4321).w, 4321);
+        struct B1 s1 = mk1(99);
+        assert_eq(s1.c, 99);
+        s5 = mk5(300);
+        assert_eq(s5.x + s5.y + s5.z, 5);
+        return 0;
+    }
+    `,
+expected => ""
+},
+
+
+{
+title => q{Local arrays and structs initialized from a constant image},
+program => q`
+    struct Entry { char key; int value; long big; char tag[3]; };
+    int twice(int n) { return n * 2; }
+    int check(int n)
+    {
+        int squares[12] = { 0, 1, 4, 9, 16, 25, 36, 49, 64, 81, 100, 121 };
+        char odd[11] = { 1, -2, 3, -4, 5, -6, 7, -8, 9, -10, 'k' };
+        int mixed[16] = { 10, 20, n, 40, 50, twice(n), 70, 80, 90, n + 1, 110, 120, 130, 140, 150, 160 };
+        long longs[4] = { 1, -2, 70000, -70000 };
+        struct Entry entries[2] = { { 'a', -300, 123456L, "xy" }, { 'b', n, -1, "z" } };
+        int sum = 0;
+        for (int i = 0; i < 12; ++i)
+            sum += squares[i];
+        assert_eq(sum, 506);
+        sum = 0;
+        for (int i = 0; i < 10; ++i)
+            sum += odd[i];
+        assert_eq(sum, -5);
+        assert_eq(odd[10], 'k');
+        assert_eq(mixed[2], n);
+        assert_eq(mixed[5], n * 2);
+        assert_eq(mixed[9], n + 1);
+        assert_eq(mixed[0] + mixed[8] + mixed[15], 260);
+        assert(longs[2] == 70000);
+        assert(longs[3] == -70000);
+        assert(longs[1] == -2);
+        assert_eq(entries[0].key, 'a');
+        assert_eq(entries[0].value, -300);
+        assert(entries[0].big == 123456L);
+        assert_eq(entries[0].tag[1], 'y');
+        assert_eq(entries[1].value, n);
+        assert(entries[1].big == -1);
+        assert_eq(entries[1].tag[0], 'z');
+        squares[0] = n;  // image must not be shared with the next call
+        return squares[0];
+    }
+    int main()
+    {
+        assert_eq(check(7), 7);
+        assert_eq(check(-3), -3);
+        return 0;
+    }
+    `,
+expected => ""
+},
+
+
+{
+compilerOptions => "--check-null",
+title => q{--check-null omits checks of pointers already known to be non-null},
+program => q`
+    struct Node { int v; struct Node *next; };
+    int failures = 0;
+    void handler(void *addressOfFailedCheck) { ++failures; }
+    int sumList(struct Node *p)
+    {
+        int s = 0;
+        while (p)
+        {
+            s += p->v;
+            if (p->next)
+                s += p->next->v * 0;
+            p = p->next;
+        }
+        return s;
+    }
+    int twice(int *q)
+    {
+        return *q + *q;  // only the first dereference is checked
+    }
+    int afterStore(int *p, int **pp)
+    {
+        int a = *p;
+        *pp = 0;  // may modify p: check again
+        return a + *p;
+    }
+    int main()
+    {
+        set_null_ptr_handler(handler);
+        struct Node n2 = { 3, 0 }, n1 = { 2, &n2 }, n0 = { 1, &n1 };
+        int array[3] = { 4, 5, 6 };
+        int x = 5;
+        int *px = &x;
+        assert_eq(sumList(&n0), 6);
+        assert_eq(sumList(0), 0);
+        assert_eq(array[1] + array[2], 11);
+        assert_eq(twice(&x), 10);
+        assert_eq(failures, 0);
+        twice(0);
+        assert_eq(failures, 1);
+        assert_eq(afterStore(&x, &px), 10);
+        assert_eq(failures, 1);
+        afterStore(0, &px);
+        assert_eq(failures, 3);
+        return 0;
+    }
+    `,
+expected => ""
+},
+
+
+{
+compilerOptions => "--check-null --switch=jump",
+title => q{--check-null keeps the checks after a pointer is changed in a switch case},
+program => q`
+    struct S { int v; };
+    int failures = 0;
+    void handler(void *addressOfFailedCheck) { ++failures; }
+    int f(struct S *p, struct S *q, int k)
+    {
+        int r = p->v;
+        if (k < 100)
+        {
+            switch (k)  // dense: jump table
+            {
+            case 0: r += 1; break;
+            case 1: p = q; break;
+            case 2: r += 3; break;
+            case 3: r += 4; break;
+            case 4: r += 5; break;
+            }
+        }
+        return r + p->v;  // p may be null if case 1 was taken
+    }
+    int main()
+    {
+        set_null_ptr_handler(handler);
+        struct S a = { 10 }, b = { 20 };
+        assert_eq(f(&a, &b, 1), 30);
+        assert_eq(f(&a, &b, 2), 23);
+        assert_eq(failures, 0);
+        f(&a, 0, 1);
+        assert_eq(failures, 1);
+        return 0;
+    }
+    `,
+expected => ""
+},
+
+
+{
+compilerOptions => "--check-stack",
+title => q{--check-stack hoists the checks of static functions into their callers},
+program => q`
+    unsigned level = 0;
+    void stackOverflowHandler(void *addressOfFailedCheck, void *stackRegister)
+    {
+        assert(level > 10 && level < 1000);
+        exit(0);  // expected point of exit
+    }
+    static unsigned leaf(unsigned n)  // checked by its callers
+    {
+        unsigned char buf[64];
+        memset(buf, (unsigned char) n, sizeof(buf));
+        return buf[n & 63];
+    }
+    static unsigned middle(unsigned n)  // checked by its callers
+    {
+        return leaf(n) + leaf(n + 1);
+    }
+    unsigned recurse(unsigned n)
+    {
+        ++level;
+        if (level >= 1000)
+        {
+            printf("ER""ROR: level %u\n", level);
+            exit(2);
+        }
+        return middle(n) + recurse(n + 1);
+    }
+    int main()
+    {
+        set_stack_overflow_handler(stackOverflowHandler);
+        printf("%u\n", middle(3));
+        recurse(0);
+        return 0;
+    }
+    `,
+expected => "7\n"
+},
+
+
+{
+title => q{Large initializer lists of integer literals},
+program => q`
+    unsigned char bitmap[] = { 0x00, 0x18, 0x3C, 0x7E, 0xFF, 0x7E, 0x3C, 0x18,
+                               0x00, 0x81, 0x42, 0x24, 'A', 0x24, 0x42, 0x81, 255 };
+    int levels[18] = { -1, 2, -300, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 1000, -32767 };
+    char grid[2][16] = { { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, -16 },
+                         { 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p' } };
+    unsigned words[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 'z', -2 };
+    struct S { int n; char a[16]; } s = { 3, { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 } };
+    int mixed[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 2 * 3, 19 };
+    int main()
+    {
+        int local[16] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, -16 };
+        int n = 5;
+        int afterLiterals[18] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, n, -n };
+        assert_eq(sizeof(bitmap), 17);
+        assert_eq(bitmap[4], 255);
+        assert_eq(bitmap[12], 'A');
+        assert_eq(bitmap[16], 255);
+        assert_eq(levels[0], -1);
+        assert_eq(levels[2], -300);
+        assert_eq(levels[16], 1000);
+        assert_eq(levels[17], -32767);
+        assert_eq(grid[0][15], -16);
+        assert_eq(grid[1][0], 'a');
+        assert_eq(grid[1][15], 'p');
+        assert_eq(sizeof(words), 36);
+        assert_eq(words[16], 'z');
+        assert(words[17] == 0xFFFE);
+        assert_eq(s.n, 3);
+        assert_eq(s.a[15], 16);
+        assert_eq(local[15], -16);
+        assert_eq(sizeof(mixed), 38);
+        assert_eq(mixed[15], 16);
+        assert_eq(mixed[16], 17);
+        assert_eq(mixed[17], 6);
+        assert_eq(mixed[18], 19);
+        assert_eq(afterLiterals[15], 16);
+        assert_eq(afterLiterals[16], 5);
+        assert_eq(afterLiterals[17], -5);
+        return 0;
+    }
+    `,
+expected => ""
+},
+
+
+{
+title => q{Preprocessor: stringification, token pasting, variadic macros and #if},
+program => q`
+    #define STR(x) #x
+    #define XSTR(x) STR(x)
+    #define CAT(a, b) a ## b
+    #define CAT3(a, b, c) a ## b ## c
+    #define SUM(first, ...) sum(first, ## __VA_ARGS__, -1)
+    #define TWICE(x) ((x) + (x))
+    #define LIMIT 10
+    #define SELF SELF
+    #if defined(LIMIT) && !defined NO_SUCH_MACRO && LIMIT * 2 == 20 && (LIMIT > 5 ? 1 : 0) && 'A' == 65
+    #define CONDITION_OK 1
+    #elif 1
+    #define CONDITION_OK 2
+    #else
+    #define CONDITION_OK 3
+    #endif
+    #if NO_SUCH_MACRO
+    #error undefined identifier must be 0 in #if
+    #endif
+    int sum(int first, ...)
+    {
+        int *p = &first, total = 0;
+        for ( ; *p != -1; ++p)
+            total += *p;
+        return total;
+    }
+    int main()
+    {
+        int CAT(var, 1) = 42, SELF = 7;
+        int line = __LINE__;
+        assert(!strcmp(STR(a  +  b), "a + b"));
+        assert(!strcmp(STR("q"), "\"q\""));
+        assert(!strcmp(XSTR(LIMIT), "10"));
+        assert_eq(var1, 42);
+        assert_eq(CAT3(1, 2, 3), 123);
+        assert_eq(CAT3(, 4, 5), 45);
+        assert_eq(SUM(1), 1);
+        assert_eq(SUM(1, 2, 3), 6);
+        assert_eq(TWICE(TWICE(LIMIT)), 40);
+        assert_eq(SELF, 7);
+        assert_eq(CONDITION_OK, 1);
+        assert_eq(__LINE__, line + 12);
+        return 0;
+    }
+    `,
+expected => ""
+},
+
+
+{
+title => q{Block layout with --wfo keeps the loops in place},
+compilerOptions => "--wfo",
+program => q`
+    unsigned char iter;
+    char buf[16];
+    unsigned char copyWord(const char **input)
+    {
+        unsigned char index = 0;
+        for ( ; ; ++iter)
+        {
+            char c = **input;
+            if (!c)
+                break;
+            if (index < sizeof(buf) - 1)
+                buf[index++] = c;
+            ++*input;
+            if (c == ' ')
+                break;
+        }
+        buf[index] = '\0';
+        return index;
+    }
+    int sumOdd(int n)
+    {
+        int sum = 0, i = 0;
+        while (i < n)
+        {
+            ++i;
+            if (i % 2 == 0)
+                continue;
+            sum += i;
+        }
+        return sum;
+    }
+    int countPairs(void)
+    {
+        int count = 0, i, j;
+        for (i = 0; i < 5; ++i)
+        {
+            j = 0;
+            do
+            {
+                if (j == i)
+                    break;
+                ++count;
+            } while (++j < 4);
+        }
+        return count;
+    }
+    int main()
+    {
+        const char *text = "ABC DEFGHIJKLMNOPQRSTU";
+        assert_eq(copyWord(&text), 4);
+        assert(!strcmp(buf, "ABC "));
+        assert_eq(iter, 3);
+        assert_eq(copyWord(&text), 15);
+        assert(!strcmp(buf, "DEFGHIJKLMNOPQR"));
+        assert_eq(iter, 21);
+        assert_eq(*text, '\0');
+        assert_eq(sumOdd(10), 25);
+        assert_eq(sumOdd(0), 0);
+        assert_eq(countPairs(), 10);
+        return 0;
+    }
+    `,
+expected => ""
+},
+
+
+{
+noPreamble => 1,  # the program embeds itself, so its size must not depend on the preamble
+title => q{#pragma embed},
+program => q`
+    #include <cmoc.h>
+    #pragma embed ",check-prog.c" as self
+    extern const unsigned char self[];
+    extern const unsigned self_size;
+    int rw = 1;
+    int main()
+    {
+        unsigned i;
+        printf("%u %u %u\n", self_size, self[0], self[self_size - 1]);
+        for (i = 5; i < 13; ++i)
+            putchar(self[i]);
+        putchar('\n');
+        // The data is in rodata, between the code and the writable globals,
+        // right after its size.
+        if ((unsigned) main < (unsigned) self && (unsigned) self < (unsigned) &rw
+                && (unsigned) &self_size + 2 == (unsigned) self)
+            printf("rodata\n");
+        return rw - 1;
+    }
+    `,
+expected => "677 10 32\n#include\nrodata\n"
+},
+
+
 #{
 #title => q{Sample test},
 #program => q`
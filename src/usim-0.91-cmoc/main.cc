@@ -365,8 +365,9 @@ void update(int)
 int main(int argc, char *argv[])
 {
 	if (argc < 2 || !strcmp(argv[1], "--help")) {
-		fprintf(stderr, "Usage: usim <hexfile|srecfile> [--binary] [<hex load offset>]\n");
+		fprintf(stderr, "Usage: usim <hexfile|srecfile> [--binary] [--profile=FILE] [<hex load offset>]\n");
 		fprintf(stderr, "--binary turns off carriage return to line feed translation on output to $FF00.\n");
+		fprintf(stderr, "--profile=FILE writes the number of instructions executed at each address to FILE.\n");
 		return EXIT_FAILURE;
 	}
 
@@ -379,9 +380,13 @@ int main(int argc, char *argv[])
 	const char *progFilename = NULL;
 	Word loadOffset = 0;
 	bool gotLoadOffset = false;
+	const char *profileFilename = NULL;
 	for (int argi = 1; argi < argc; ++argi) {
 	if (!strcmp(argv[argi], "--binary")) {
 		sys.setBinaryMode(true);
+	} else if (!strncmp(argv[argi], "--profile=", 10)) {
+		profileFilename = argv[argi] + 10;
+		sys.enable_profiling();
 	} else if (argv[argi][0] == '-') {
 		fprintf(stderr, "usim: Invalid option %s\n", argv[argi]);
 		return EXIT_FAILURE;
@@ -412,5 +417,10 @@ int main(int argc, char *argv[])
 		sys.load_intelhex(progFilename, loadOffset);
 	sys.run();
 
+	if (profileFilename && !sys.write_profile(profileFilename)) {
+		fprintf(stderr, "usim: failed to write profile %s\n", profileFilename);
+		return EXIT_FAILURE;
+	}
+
 	return EXIT_SUCCESS;
 }
@@ -31,6 +31,8 @@ void USim::run(void)
 	double timeOfLastIRQ = getCurrentTimeInMicroseconds();
 
 	while (!halted) {
+		if (executionCounts)
+			++executionCounts[pc];
 		execute();
 
 		double now = getCurrentTimeInMicroseconds();
@@ -70,6 +72,24 @@ Word USim::fetch_word(void)
 	return val;
 }
 
+void USim::enable_profiling(void)
+{
+	if (!executionCounts)
+		executionCounts = new unsigned long[0x10000]();
+}
+
+bool USim::write_profile(const char *filename) const
+{
+	FILE *f = fopen(filename, "w");
+	if (!f)
+		return false;
+	fprintf(f, "# usim execution profile: address (hex), instruction count\n");
+	for (unsigned long addr = 0; addr < 0x10000; ++addr)
+		if (executionCounts && executionCounts[addr])
+			fprintf(f, "%04lX %lu\n", addr, executionCounts[addr]);
+	return fclose(f) == 0;
+}
+
 void USim::invalid(const char *msg)
 {
 	if (ir != 0x0013)  // use SYNC instruction to leave the simulator
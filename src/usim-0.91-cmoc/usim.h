@@ -27,6 +27,10 @@ protected:
 		Word		ir;
 		Word		pc;
 
+// Number of times an instruction was started at each address (null if not profiling)
+
+		unsigned long	*executionCounts;
+
 // Generic read/write/execute functions
 public:
 
@@ -58,8 +62,14 @@ public:
 		void		 load_intelhex(const char *filename, Word loadOffset);
 		void		 load_srec(const char *filename, Word loadOffset);
 
-	USim() : halted(0), memory(0), port(0), ir(0), pc(0) {}
-	virtual ~USim() {}
+// Execution profile: one line per executed address, giving the address
+// in hex and the number of instructions started there, in decimal.
+
+		void		 enable_profiling(void);
+		bool		 write_profile(const char *filename) const;
+
+	USim() : halted(0), memory(0), port(0), ir(0), pc(0), executionCounts(0) {}
+	virtual ~USim() { delete [] executionCounts; }
 
 private:
 	// Forbidden:
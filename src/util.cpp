@@ -373,11 +373,10 @@ isPointerInitConstCorrect(const TypeDesc *declPointedTypeDesc, const TypeDesc *i
 string
 getSourceLineNo()
 {
-    extern int lineno;
-    extern string sourceFilename;
+    const TranslationUnit &tu = TranslationUnit::instance();
 
     char s[1024];
-    snprintf(s, sizeof(s), "%s:%d", sourceFilename.c_str(), lineno);
+    snprintf(s, sizeof(s), "%s:%d", tu.getCurrentSourceFilename().c_str(), tu.getCurrentLineNo());
     return s;
 }
 
@@ -385,12 +384,7 @@ getSourceLineNo()
 void
 diagnoseVa(const char *diagType, const string &explicitLineNo, const char *fmt, va_list ap)
 {
-    extern int numErrors, numWarnings;
-
-    if (strcmp(diagType, "error") == 0)
-        numErrors++;
-    else
-        numWarnings++;
+    TranslationUnit::instance().countDiagnostic(strcmp(diagType, "error") == 0);
 
     char buffer[1024];
     vsnprintf(buffer, sizeof(buffer), fmt, ap);
@@ -402,15 +396,9 @@ diagnoseVa(const char *diagType, const string &explicitLineNo, const char *fmt,
 void
 errormsg(const char *fmt, ...)
 {
-    extern int lineno;
-    extern string sourceFilename;
-
-    char s[1024];
-    snprintf(s, sizeof(s), "%s:%d", sourceFilename.c_str(), lineno);
-
     va_list ap;
     va_start(ap, fmt);
-    diagnoseVa("error", s, fmt, ap);
+    diagnoseVa("error", getSourceLineNo(), fmt, ap);
     va_end(ap);
 }
 
@@ -441,23 +429,31 @@ errormsgEx(const std::string &sourceFilename, int lineno, const char *fmt, ...)
 void
 warnmsg(const char *fmt, ...)
 {
-    extern int lineno;
-    extern string sourceFilename;
+    va_list ap;
+    va_start(ap, fmt);
+    diagnoseVa("warning", getSourceLineNo(), fmt, ap);
+    va_end(ap);
+}
 
-    char s[1024];
-    snprintf(s, sizeof(s), "%s:%d", sourceFilename.c_str(), lineno);
 
+void
+warnmsgEx(const string &explicitLineNo, const char *fmt, ...)
+{
     va_list ap;
     va_start(ap, fmt);
-    diagnoseVa("warning", s, fmt, ap);
+    diagnoseVa("warning", explicitLineNo, fmt, ap);
     va_end(ap);
 }
 
 
+// Called by the parser generated from parser.yy.
+// scanner: Scanner generated from lexer.ll (a yyscan_t), which read the offending token.
+//
 void
-yyerror(const char *msg)
+yyerror(void *scanner, const char *msg)
 {
-    extern char *yytext;
+    extern char *yyget_text(void *scanner);
+    const char *yytext = yyget_text(scanner);
 
     if (strcmp(msg, "parse error") == 0)
         msg = "syntax error";
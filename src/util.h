@@ -367,7 +367,8 @@ std::ostream &operator << (std::ostream &out, const VectorToString<T> &vts)
 }
 
 
-// Returns a string of the form "foo.cpp:42".
+// Returns a string of the form "foo.cpp:42", from the current source position
+// of the TranslationUnit.
 //
 std::string getSourceLineNo();
 
@@ -376,9 +377,11 @@ void errormsgEx(const std::string &explicitLineNo, const char *fmt, ...);
 void errormsgEx(const std::string &sourceFilename, int lineno, const char *fmt, ...);
 
 // diagType: "error" or "warning".
+// Counted by the TranslationUnit, which must exist.
 void diagnoseVa(const char *diagType, const std::string &explicitLineNo, const char *fmt, va_list ap);
 
 void warnmsg(const char *fmt, ...);
+void warnmsgEx(const std::string &explicitLineNo, const char *fmt, ...);
 
 
 #endif  /* _H_util */